@@ -0,0 +1,130 @@
+/// @example eagine/c_api_profile.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/c_api_profile.hpp>
+#include <eagine/config/platform.hpp>
+#include <eagine/memory/block.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <array>
+#include <iostream>
+
+#if EAGINE_POSIX
+#include <sys/types.h>
+#include <unistd.h>
+#define EXAMPLE_API_STATIC_FUNC(NAME) &::NAME
+#else
+#define EXAMPLE_API_STATIC_FUNC(NAME) nullptr
+#endif
+
+namespace eagine {
+//------------------------------------------------------------------------------
+struct example_sets_errno {};
+//------------------------------------------------------------------------------
+using example_api_traits = profiling_c_api_traits<default_c_api_traits>;
+//------------------------------------------------------------------------------
+struct example_pipe_api {
+
+    using api_traits = example_api_traits;
+
+    opt_c_api_function<
+      api_traits,
+      example_sets_errno,
+      int(int[2]),
+      EXAMPLE_API_STATIC_FUNC(pipe),
+      EAGINE_POSIX,
+      true>
+      make_pipe;
+
+    opt_c_api_function<
+      api_traits,
+      example_sets_errno,
+      ssize_t(int, void*, size_t),
+      EXAMPLE_API_STATIC_FUNC(read),
+      EAGINE_POSIX,
+      true>
+      read_file;
+
+    opt_c_api_function<
+      api_traits,
+      example_sets_errno,
+      ssize_t(int, const void*, size_t),
+      EXAMPLE_API_STATIC_FUNC(write),
+      EAGINE_POSIX,
+      true>
+      write_file;
+
+    opt_c_api_function<
+      api_traits,
+      example_sets_errno,
+      int(int),
+      EXAMPLE_API_STATIC_FUNC(close),
+      EAGINE_POSIX,
+      true>
+      close_file;
+
+    example_pipe_api(api_traits& traits)
+      : make_pipe{"pipe", traits, *this}
+      , read_file{"read", traits, *this}
+      , write_file{"write", traits, *this}
+      , close_file{"close", traits, *this} {
+#if EAGINE_POSIX
+        // the statically linked functions are known to the profile only
+        // by their addresses, so the names are registered explicitly
+        auto& profile = api_traits::profile();
+        profile.register_function(
+          reinterpret_cast<const void*>(&::pipe), "pipe");
+        profile.register_function(
+          reinterpret_cast<const void*>(&::read), "read");
+        profile.register_function(
+          reinterpret_cast<const void*>(&::write), "write");
+        profile.register_function(
+          reinterpret_cast<const void*>(&::close), "close");
+#endif
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+auto main() -> int {
+    using namespace eagine;
+    example_api_traits traits;
+    example_pipe_api api(traits);
+
+    auto& profile = example_api_traits::profile();
+    profile.enable_trace(8);
+
+    if(api.make_pipe && api.read_file && api.write_file && api.close_file) {
+        std::array<byte, 256> buffer{};
+        fill(cover(buffer), byte(0x5A));
+
+        for(int round = 0; round < 1000; ++round) {
+            int pfd[2] = {-1, -1};
+            api.make_pipe(pfd);
+            for(int i = 0; i < 16; ++i) {
+                api.write_file(pfd[1], buffer.data(), buffer.size());
+            }
+            api.close_file(pfd[1]);
+            while(api.read_file(pfd[0], buffer.data(), buffer.size()) > 0) {
+            }
+            api.close_file(pfd[0]);
+        }
+    } else {
+        std::cerr << "the pipe functions are not available" << std::endl;
+    }
+
+    profile.write_report(std::cout, 10);
+
+    const auto stats{profile.function_stats()};
+    std::cout << "Most recent calls:\n";
+    for(const auto& record : profile.trace()) {
+        std::cout << "  " << record.start_ns << " ns: "
+                  << stats[record.function_index].name << " ("
+                  << record.duration_ns << " ns)\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/// @example eagine/compress_chunked.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/chunked_compression.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/math/functions.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/timeout.hpp>
+#include <eagine/workshop.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+static void run_chunked_benchmark(
+  main_ctx& ctx,
+  memory::const_block original,
+  span_size_t thread_count,
+  span_size_t chunk_size) {
+    chunked_data_compressor comp{ctx.workers(), thread_count, chunk_size};
+    memory::buffer packed;
+    memory::buffer unpacked;
+
+    const time_measure compr_time;
+    const auto pck = comp.compress(original, packed);
+    const auto compress_seconds = compr_time.seconds().count();
+
+    const time_measure decompr_time;
+    const auto upk = comp.decompress(pck, unpacked);
+    const auto decompress_seconds = decompr_time.seconds().count();
+
+    if(!are_equal(original, upk)) {
+        ctx.log().error("original and unpacked block are different");
+    }
+
+    const auto mbytes = float(original.size()) / (1024.F * 1024.F);
+    ctx.log()
+      .stat("chunked compression throughput")
+      .arg(EAGINE_ID(threads), thread_count)
+      .arg(EAGINE_ID(chunkSize), EAGINE_ID(ByteSize), chunk_size)
+      .arg(EAGINE_ID(comprMBps), mbytes / compress_seconds)
+      .arg(EAGINE_ID(decomprMBs), mbytes / decompress_seconds)
+      .arg(
+        EAGINE_ID(comprRatio),
+        EAGINE_ID(Ratio),
+        float(pck.size()) / float(original.size()));
+}
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    span_size_t size_mb{256};
+    span_size_t chunk_size{chunked_data_compressor::default_chunk_size()};
+    auto max_threads = span_size(std::thread::hardware_concurrency());
+    ctx.config().fetch("compress.benchmark.size_mb", size_mb);
+    ctx.config().fetch("compress.benchmark.chunk_size", chunk_size);
+    ctx.config().fetch("compress.benchmark.max_threads", max_threads);
+
+    // text-like data with a limited alphabet and repetitions
+    std::vector<byte> original(std_size(size_mb * 1024 * 1024));
+    std::default_random_engine re{12345U};
+    std::uniform_int_distribution<int> dist{0, 63};
+    for(std::size_t i = 0; i < original.size(); ++i) {
+        original[i] = (i % 256 < 96) ? byte(0x20U + i % 64U)
+                                     : byte(0x30 + dist(re) % 40);
+    }
+
+    for(span_size_t t = 1; t <= math::maximum(max_threads, span_size(1));
+        t *= 2) {
+        run_chunked_benchmark(ctx, view(original), t, chunk_size);
+    }
+    ctx.workers().shutdown();
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
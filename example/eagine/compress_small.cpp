@@ -0,0 +1,124 @@
+/// @example eagine/compress_small.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/compression.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/timeout.hpp>
+#include <string>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+static inline auto small_message(int i) -> std::string {
+    return "{\"endpoint_id\":" + std::to_string(1000 + i % 37) +
+           ",\"instance_id\":" + std::to_string(i * 7919) +
+           ",\"status\":\"" + ((i % 3) ? "running" : "idle") +
+           "\",\"cpu_usage\":0." + std::to_string(i % 97) +
+           ",\"memory_usage\":" + std::to_string(i * 4099) +
+           ",\"uptime_seconds\":" + std::to_string(i * 13) + "}";
+}
+//------------------------------------------------------------------------------
+static void run_small_benchmark(
+  main_ctx& ctx,
+  data_compressor& comp,
+  const std::vector<std::string>& messages,
+  data_compression_level level,
+  data_compression_dictionary_id dictionary_id,
+  span_size_t rounds) {
+    memory::buffer packed;
+    memory::buffer unpacked;
+    span_size_t original_size{0};
+    span_size_t packed_size{0};
+    span_size_t count{0};
+    span_size_t errors{0};
+    std::chrono::duration<float> compress_time{};
+    std::chrono::duration<float> decompress_time{};
+
+    for(span_size_t r = 0; r < rounds; ++r) {
+        for(const auto& message : messages) {
+            const auto input = as_bytes(view(message));
+            const time_measure compr_time;
+            const auto pck = comp.compress(input, packed, level, dictionary_id);
+            compress_time += compr_time.seconds();
+
+            const time_measure decompr_time;
+            const auto upk = comp.decompress(pck, unpacked);
+            decompress_time += decompr_time.seconds();
+
+            if(!are_equal(input, upk)) {
+                ++errors;
+            }
+            original_size += input.size();
+            packed_size += pck.size();
+            ++count;
+        }
+    }
+
+    ctx.log()
+      .stat("small message compression")
+      .arg(EAGINE_ID(dictionary), dictionary_id)
+      .arg(EAGINE_ID(messages), count)
+      .arg(EAGINE_ID(errors), errors)
+      .arg(
+        EAGINE_ID(comprNs), 1.e9F * compress_time.count() / float(count))
+      .arg(
+        EAGINE_ID(decomprNs), 1.e9F * decompress_time.count() / float(count))
+      .arg(
+        EAGINE_ID(comprRatio),
+        EAGINE_ID(Ratio),
+        float(packed_size) / float(original_size));
+}
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    span_size_t message_count{1000};
+    span_size_t rounds{10};
+    span_size_t dictionary_size{4096};
+    ctx.config().fetch("compress.benchmark.message_count", message_count);
+    ctx.config().fetch("compress.benchmark.rounds", rounds);
+    ctx.config().fetch("compress.benchmark.dictionary_size", dictionary_size);
+
+    std::vector<std::string> samples;
+    std::vector<memory::const_block> sample_blocks;
+    for(int i = 0; i < 256; ++i) {
+        samples.push_back(small_message(-i - 1));
+    }
+    for(const auto& sample : samples) {
+        sample_blocks.push_back(as_bytes(view(sample)));
+    }
+
+    std::vector<std::string> messages;
+    for(span_size_t i = 0; i < message_count; ++i) {
+        messages.push_back(small_message(int(i)));
+    }
+
+    const time_measure train_time;
+    const auto dictionary =
+      data_compressor::make_dictionary(view(sample_blocks), dictionary_size);
+    ctx.log()
+      .stat("trained compression dictionary")
+      .arg(EAGINE_ID(size), EAGINE_ID(ByteSize), dictionary.size())
+      .arg(EAGINE_ID(trainTime), train_time.seconds());
+
+    data_compressor comp{};
+    const data_compression_dictionary_id dictionary_id{2U};
+    comp.add_dictionary(dictionary_id, view(dictionary));
+
+    for(auto level :
+        {data_compression_level::lowest,
+         data_compression_level::normal,
+         data_compression_level::highest}) {
+        run_small_benchmark(
+          ctx, comp, messages, level, no_compression_dictionary(), rounds);
+        run_small_benchmark(ctx, comp, messages, level, dictionary_id, rounds);
+    }
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
@@ -0,0 +1,55 @@
+/// @example eagine/compress_stream.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/compression_stream.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/timeout.hpp>
+#include <fstream>
+#include <iostream>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    const string_view input_path{ctx.args().find("--input").next()};
+    const string_view output_path{ctx.args().find("--output").next()};
+    const bool unpack{ctx.args().find("--decompress")};
+
+    std::ifstream input_file;
+    std::ofstream output_file;
+    if(input_path) {
+        input_file.open(to_string(input_path), std::ios::binary);
+    }
+    if(output_path) {
+        output_file.open(to_string(output_path), std::ios::binary);
+    }
+    std::istream& input = input_path ? input_file : std::cin;
+    std::ostream& output = output_path ? output_file : std::cout;
+
+    const time_measure run_time;
+    // the data is processed in constant memory, regardless of its size
+    if(unpack) {
+        data_decompress_istream unpacked{input};
+        output << unpacked.rdbuf();
+    } else {
+        data_compress_ostream packed{output, data_compression_level::highest};
+        packed << input.rdbuf();
+        if(!packed.finish()) {
+            ctx.log().error("failed to compress the input");
+        }
+    }
+
+    ctx.log()
+      .stat("${operation} finished in ${time}")
+      .arg(
+        EAGINE_ID(operation),
+        unpack ? string_view("decompression") : string_view("compression"))
+      .arg(EAGINE_ID(time), run_time.seconds());
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
@@ -0,0 +1,178 @@
+/// @example eagine/log_entry_speed.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/logging/entry.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <chrono>
+#include <string>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+// backend accepting all entries and just counting the received arguments
+class counting_log_backend final : public logger_backend {
+public:
+    auto count() const noexcept {
+        return _count;
+    }
+
+    auto entry_backend(identifier, log_event_severity) noexcept
+      -> logger_backend* final {
+        return this;
+    }
+
+    auto allocator() noexcept -> memory::shared_byte_allocator final {
+        return memory::default_byte_allocator();
+    }
+
+    auto type_id() noexcept -> identifier final {
+        return EAGINE_ID(Counting);
+    }
+
+    void enter_scope(identifier) noexcept final {}
+
+    void leave_scope(identifier) noexcept final {}
+
+    void set_description(
+      identifier,
+      logger_instance_id,
+      string_view,
+      string_view) noexcept final {}
+
+    auto begin_message(
+      identifier,
+      identifier,
+      logger_instance_id,
+      log_event_severity,
+      string_view) noexcept -> bool final {
+        return true;
+    }
+
+    void add_nothing(identifier, identifier) noexcept final {
+        ++_count;
+    }
+
+    void add_identifier(identifier, identifier, identifier) noexcept final {
+        ++_count;
+    }
+
+    void add_message_id(identifier, identifier, message_id) noexcept final {
+        ++_count;
+    }
+
+    void add_bool(identifier, identifier, bool) noexcept final {
+        ++_count;
+    }
+
+    void add_integer(identifier, identifier, std::intmax_t) noexcept final {
+        ++_count;
+    }
+
+    void add_unsigned(identifier, identifier, std::uintmax_t) noexcept final {
+        ++_count;
+    }
+
+    void add_float(identifier, identifier, float) noexcept final {
+        ++_count;
+    }
+
+    void add_float(identifier, identifier, float, float, float) noexcept final {
+        ++_count;
+    }
+
+    void add_duration(
+      identifier,
+      identifier,
+      std::chrono::duration<float>) noexcept final {
+        ++_count;
+    }
+
+    void add_string(identifier, identifier, string_view) noexcept final {
+        ++_count;
+    }
+
+    void add_blob(identifier, identifier, memory::const_block) noexcept final {
+        ++_count;
+    }
+
+    void finish_message() noexcept final {}
+
+    void finish_log() noexcept final {}
+
+    void log_chart_sample(
+      identifier,
+      logger_instance_id,
+      identifier,
+      float) noexcept final {}
+
+private:
+    span_size_t _count{0};
+};
+//------------------------------------------------------------------------------
+template <typename Func>
+auto measure_entries(span_size_t repeats, Func func) {
+    const auto start{std::chrono::steady_clock::now()};
+    for(span_size_t i = 0; i < repeats; ++i) {
+        func(i);
+    }
+    return std::chrono::duration<float, std::nano>(
+             std::chrono::steady_clock::now() - start) /
+           repeats;
+}
+//------------------------------------------------------------------------------
+// the identifiers are encoded at compile-time, to measure just the entries
+static constexpr const identifier id_speed{"Speed"};
+static constexpr const identifier id_index{"index"};
+static constexpr const identifier id_ratio{"ratio"};
+static constexpr const identifier id_source{"source"};
+static constexpr const identifier id_name{"name"};
+static constexpr const identifier id_unsigned{"unsigned"};
+static constexpr const identifier id_progress{"progress"};
+static constexpr const identifier id_elapsed{"elapsed"};
+static constexpr const identifier id_format{"format"};
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    const span_size_t repeats{1000000};
+    counting_log_backend backend;
+    const std::string name{"log entry"};
+
+    const auto args0{measure_entries(repeats, [&](span_size_t) {
+        log_entry(id_speed, 0U, log_event_severity::info, "", &backend);
+    })};
+
+    const auto args4{measure_entries(repeats, [&](span_size_t i) {
+        log_entry(id_speed, 0U, log_event_severity::info, "", &backend)
+          .arg(id_index, i)
+          .arg(id_ratio, float(i) / float(repeats))
+          .arg(id_source, id_speed)
+          .arg(id_name, name);
+    })};
+
+    const auto args8{measure_entries(repeats, [&](span_size_t i) {
+        log_entry(id_speed, 0U, log_event_severity::info, "", &backend)
+          .arg(id_index, i)
+          .arg(id_ratio, float(i) / float(repeats))
+          .arg(id_source, id_speed)
+          .arg(id_name, name)
+          .arg(id_unsigned, std::uint32_t(i))
+          .arg(id_progress, 0.F, float(i), float(repeats))
+          .arg(id_elapsed, std::chrono::milliseconds(i))
+          .arg(id_format, string_view("literal"));
+    })};
+
+    ctx.log()
+      .info("log entry construction speed")
+      .arg(EAGINE_ID(repeats), repeats)
+      .arg(EAGINE_ID(received), backend.count())
+      .arg(EAGINE_ID(args0), EAGINE_ID(ns), args0.count())
+      .arg(EAGINE_ID(args4), EAGINE_ID(ns), args4.count())
+      .arg(EAGINE_ID(args8), EAGINE_ID(ns), args8.count());
+
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
@@ -0,0 +1,191 @@
+/// @example eagine/message_bus/015_wakeup.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/main.hpp>
+#include <eagine/message_bus/acceptor.hpp>
+#include <eagine/message_bus/direct.hpp>
+#include <eagine/message_bus/endpoint.hpp>
+#include <eagine/message_bus/router.hpp>
+#include <eagine/message_bus/subscriber.hpp>
+#include <eagine/timeout.hpp>
+#include <atomic>
+#include <ctime>
+#include <thread>
+
+namespace eagine {
+namespace msgbus {
+//------------------------------------------------------------------------------
+struct wakeup_pong
+  : main_ctx_object
+  , static_subscriber<1> {
+    using this_class = wakeup_pong;
+    using base = static_subscriber<1>;
+    using base::bus_node;
+
+    wakeup_pong(endpoint& ep)
+      : main_ctx_object{EAGINE_ID(WakeupPong), ep}
+      , base{ep, this, EAGINE_MSG_MAP(WakeupTest, Ping, this_class, ping)} {}
+
+    auto ping(const message_context&, stored_message& msg) -> bool {
+        bus_node().post(EAGINE_MSG_ID(WakeupTest, Pong), msg.data());
+        return true;
+    }
+};
+//------------------------------------------------------------------------------
+struct wakeup_ping
+  : main_ctx_object
+  , static_subscriber<1> {
+    using this_class = wakeup_ping;
+    using base = static_subscriber<1>;
+    using base::bus_node;
+
+    wakeup_ping(endpoint& ep)
+      : main_ctx_object{EAGINE_ID(WakeupPing), ep}
+      , base{ep, this, EAGINE_MSG_MAP(WakeupTest, Pong, this_class, pong)} {}
+
+    auto send() -> bool {
+        if(!_pending && bus_node().has_id()) {
+            _pending = bus_node().post(EAGINE_MSG_ID(WakeupTest, Ping), {});
+            return _pending;
+        }
+        return false;
+    }
+
+    auto pong(const message_context&, stored_message&) -> bool {
+        _pending = false;
+        ++_rcvd;
+        return true;
+    }
+
+    auto received() const noexcept {
+        return _rcvd;
+    }
+
+private:
+    std::size_t _rcvd{0};
+    bool _pending{false};
+};
+//------------------------------------------------------------------------------
+class wakeup_benchmark : public main_ctx_object {
+public:
+    wakeup_benchmark(main_ctx_parent parent, bool use_wait)
+      : main_ctx_object{EAGINE_ID(WakeupBnch), parent}
+      , _use_wait{use_wait} {}
+
+    void run(std::chrono::milliseconds idle_time, std::size_t ping_count) {
+        auto acceptor = std::make_unique<direct_acceptor>(*this);
+
+        endpoint ping_endpoint{EAGINE_ID(PingEp), *this};
+        endpoint pong_endpoint{EAGINE_ID(PongEp), *this};
+        ping_endpoint.add_connection(acceptor->make_connection());
+        pong_endpoint.add_connection(acceptor->make_connection());
+
+        router the_router(*this);
+        the_router.add_acceptor(std::move(acceptor));
+
+        wakeup_ping the_ping(ping_endpoint);
+        wakeup_pong the_pong(pong_endpoint);
+
+        std::thread router_thread{[&]() {
+            while(!_done) {
+                if(!the_router.update()) {
+                    _idle(the_router);
+                }
+            }
+        }};
+
+        std::thread pong_thread{[&]() {
+            while(!_done) {
+                some_true something_done{};
+                something_done(pong_endpoint.update());
+                something_done(the_pong.process_all());
+                if(!something_done) {
+                    _idle(pong_endpoint);
+                }
+            }
+        }};
+
+        const auto update_ping = [&]() {
+            some_true something_done{};
+            something_done(ping_endpoint.update());
+            something_done(the_ping.process_all());
+            if(!something_done) {
+                _idle(ping_endpoint);
+            }
+        };
+
+        // let the endpoints get their ids and then idle
+        const timeout idle_timeout{idle_time};
+        const auto idle_cpu_start = std::clock();
+        while(!idle_timeout) {
+            update_ping();
+        }
+        const auto idle_cpu = _cpu_seconds(std::clock() - idle_cpu_start);
+
+        // flood the router with ping/pong round-trips
+        const timeout flood_timeout{std::chrono::seconds(60)};
+        const time_measure flood_time;
+        const auto flood_cpu_start = std::clock();
+        while((the_ping.received() < ping_count) && !flood_timeout) {
+            the_ping.send();
+            update_ping();
+        }
+        const auto flood_cpu = _cpu_seconds(std::clock() - flood_cpu_start);
+        const auto flood_seconds = flood_time.seconds().count();
+
+        _done = true;
+        pong_thread.join();
+        router_thread.join();
+
+        const auto rounds = the_ping.received();
+        log_stat("wakeup benchmark results")
+          .arg(EAGINE_ID(mode), _use_wait ? string_view("wait") : "poll")
+          .arg(EAGINE_ID(idleTime), idle_time)
+          .arg(EAGINE_ID(idleCpu), idle_cpu)
+          .arg(EAGINE_ID(idleCpuPct), 100.F * idle_cpu / _seconds(idle_time))
+          .arg(EAGINE_ID(roundTrips), rounds)
+          .arg(EAGINE_ID(floodCpu), flood_cpu)
+          .arg(EAGINE_ID(latencyUs), 1.e6F * flood_seconds / float(rounds))
+          .arg(EAGINE_ID(tripsPerS), float(rounds) / flood_seconds);
+    }
+
+private:
+    template <typename Node>
+    void _idle(Node& node) {
+        if(_use_wait) {
+            node.wait_for(std::chrono::milliseconds(50));
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    static auto _cpu_seconds(std::clock_t ticks) noexcept -> float {
+        return float(ticks) / float(CLOCKS_PER_SEC);
+    }
+
+    static auto _seconds(std::chrono::milliseconds ms) noexcept -> float {
+        return std::chrono::duration<float>(ms).count();
+    }
+
+    std::atomic<bool> _done{false};
+    const bool _use_wait;
+};
+//------------------------------------------------------------------------------
+} // namespace msgbus
+
+auto main(main_ctx& ctx) -> int {
+    std::chrono::milliseconds idle_time{2000};
+    std::size_t ping_count{10000};
+    ctx.config().fetch("msg_bus.benchmark.idle_time", idle_time);
+    ctx.config().fetch("msg_bus.benchmark.ping_count", ping_count);
+
+    msgbus::wakeup_benchmark{ctx, false}.run(idle_time, ping_count);
+    msgbus::wakeup_benchmark{ctx, true}.run(idle_time, ping_count);
+
+    return 0;
+}
+} // namespace eagine
@@ -0,0 +1,97 @@
+/// @example eagine/message_bus/016_mqueue_flood.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/main.hpp>
+#include <eagine/message_bus/posix_mqueue.hpp>
+#include <eagine/timeout.hpp>
+#include <array>
+
+namespace eagine {
+namespace msgbus {
+//------------------------------------------------------------------------------
+class mqueue_flood : public main_ctx_object {
+public:
+    mqueue_flood(main_ctx_parent parent, span_size_t batch_size)
+      : main_ctx_object{EAGINE_ID(MQueFlood), parent}
+      , _batch_size{batch_size} {}
+
+    void run(span_size_t message_count, span_size_t message_size) {
+        const auto queue_name = std::string("/eagine-mq-flood");
+        posix_mqueue_acceptor acceptor{*this, queue_name};
+        posix_mqueue_connector connector{*this, queue_name};
+        std::unique_ptr<connection> server;
+
+        const auto accept_handler = [&](std::unique_ptr<connection> conn) {
+            server = std::move(conn);
+        };
+
+        const timeout connect_timeout{std::chrono::seconds(10)};
+        while(!server && !connect_timeout) {
+            acceptor.update();
+            connector.update();
+            acceptor.process_accepted({construct_from, accept_handler});
+        }
+        if(!server) {
+            log_error("failed to connect through message queue");
+            return;
+        }
+
+        std::vector<byte> content(std_size(message_size), byte(0xA5U));
+        const auto msg_id = EAGINE_MSG_ID(MQueFlood, Message);
+        span_size_t sent{0};
+        span_size_t rcvd{0};
+
+        const auto fetch_handler =
+          [&rcvd](message_id, message_age, const message_view&) -> bool {
+            ++rcvd;
+            return true;
+        };
+
+        const timeout flood_timeout{std::chrono::seconds(60)};
+        const time_measure flood_time;
+        while((rcvd < message_count) && !flood_timeout) {
+            for(span_size_t b = 0; (b < _batch_size) && (sent < message_count);
+                ++b) {
+                if(connector.send(msg_id, message_view(view(content)))) {
+                    ++sent;
+                }
+            }
+            connector.update();
+            server->update();
+            server->fetch_messages({construct_from, fetch_handler});
+        }
+        const auto seconds = flood_time.seconds().count();
+
+        log_stat("message queue flood results")
+          .arg(EAGINE_ID(batchSize), _batch_size)
+          .arg(EAGINE_ID(msgSize), EAGINE_ID(ByteSize), message_size)
+          .arg(EAGINE_ID(sent), sent)
+          .arg(EAGINE_ID(received), rcvd)
+          .arg(EAGINE_ID(msgsPerSec), float(rcvd) / seconds);
+    }
+
+private:
+    const span_size_t _batch_size;
+};
+//------------------------------------------------------------------------------
+} // namespace msgbus
+
+auto main(main_ctx& ctx) -> int {
+    span_size_t message_count{1000000};
+    span_size_t message_size{64};
+    ctx.config().fetch("msg_bus.benchmark.message_count", message_count);
+    ctx.config().fetch("msg_bus.benchmark.message_size", message_size);
+
+    // one message per update is the same as one message per mq_send
+    for(span_size_t batch_size : std::array<span_size_t, 4>{{1, 8, 64, 512}}) {
+        msgbus::mqueue_flood{ctx, batch_size}.run(message_count, message_size);
+    }
+
+    return 0;
+}
+} // namespace eagine
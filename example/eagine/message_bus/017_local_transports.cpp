@@ -0,0 +1,200 @@
+/// @example eagine/message_bus/017_local_transports.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/main.hpp>
+#include <eagine/message_bus/asio.hpp>
+#include <eagine/message_bus/posix_mqueue.hpp>
+#include <eagine/message_bus/posix_shmem.hpp>
+#include <eagine/timeout.hpp>
+#include <atomic>
+#include <thread>
+
+namespace eagine {
+namespace msgbus {
+//------------------------------------------------------------------------------
+class local_transport_benchmark : public main_ctx_object {
+public:
+    local_transport_benchmark(
+      main_ctx_parent parent,
+      std::unique_ptr<connection_factory> factory,
+      std::string address)
+      : main_ctx_object{EAGINE_ID(LocTrnBnch), parent}
+      , _factory{std::move(factory)}
+      , _address{std::move(address)} {}
+
+    void run(span_size_t round_trips, span_size_t message_count) {
+        auto acceptor = _factory->make_acceptor(_address);
+        auto client = _factory->make_connector(_address);
+        if(!acceptor || !client) {
+            log_error("failed to create ${factory} connections")
+              .arg(EAGINE_ID(factory), _factory->type_id());
+            return;
+        }
+
+        std::thread server_thread{[&]() { _serve(*acceptor); }};
+
+        const timeout connect_timeout{std::chrono::seconds(10)};
+        while(!_connected && !connect_timeout) {
+            client->update();
+            client->send(EAGINE_MSG_ID(LocTrnBnch, Ping), {});
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        const auto trip_seconds = _ping_pong(*client, round_trips);
+        const auto bulk_seconds = _bulk(*client, message_count);
+
+        _done = true;
+        server_thread.join();
+
+        log_stat("local transport benchmark results")
+          .arg(EAGINE_ID(factory), _factory->type_id())
+          .arg(EAGINE_ID(roundTrips), _round_trips)
+          .arg(EAGINE_ID(latencyUs), 1.e6F * trip_seconds / float(_round_trips))
+          .arg(EAGINE_ID(bulkMsgs), _bulk_received.load())
+          .arg(EAGINE_ID(msgsPerSec), float(_bulk_received) / bulk_seconds);
+    }
+
+private:
+    void _serve(acceptor& the_acceptor) {
+        auto wakeup = std::make_shared<wakeup_event>();
+        std::unique_ptr<connection> server;
+
+        const auto accept_handler = [&](std::unique_ptr<connection> conn) {
+            server = std::move(conn);
+        };
+
+        span_size_t pings{0};
+        const auto fetch_handler = [&](
+                                     message_id msg_id,
+                                     message_age,
+                                     const message_view&) -> bool {
+            if(msg_id == EAGINE_MSG_ID(LocTrnBnch, Ping)) {
+                ++pings;
+            } else {
+                ++_bulk_received;
+            }
+            return true;
+        };
+
+        while(!_done) {
+            some_true something_done{};
+            something_done(the_acceptor.update());
+            something_done(
+              the_acceptor.process_accepted({construct_from, accept_handler}));
+            if(server) {
+                something_done(server->update());
+                something_done(
+                  server->fetch_messages({construct_from, fetch_handler}));
+                // the connections cannot be used from the fetch handler
+                for(; pings > 0; --pings) {
+                    _connected = true;
+                    server->send(EAGINE_MSG_ID(LocTrnBnch, Pong), {});
+                }
+                something_done(server->update());
+            }
+            if(!something_done) {
+                the_acceptor.prepare_wait(wakeup);
+                if(server) {
+                    server->prepare_wait(wakeup);
+                }
+                wakeup->wait_for(std::chrono::milliseconds(10));
+            }
+        }
+    }
+
+    auto _ping_pong(connection& client, span_size_t count) -> float {
+        auto wakeup = std::make_shared<wakeup_event>();
+        bool received{false};
+
+        const auto fetch_handler =
+          [&](message_id msg_id, message_age, const message_view&) -> bool {
+            if(msg_id == EAGINE_MSG_ID(LocTrnBnch, Pong)) {
+                received = true;
+            }
+            return true;
+        };
+
+        // drain the pongs for the connection pings
+        client.update();
+        client.fetch_messages({construct_from, fetch_handler});
+
+        const time_measure trip_time;
+        const timeout trip_timeout{std::chrono::seconds(30)};
+        for(_round_trips = 0; (_round_trips < count) && !trip_timeout;
+            ++_round_trips) {
+            client.send(EAGINE_MSG_ID(LocTrnBnch, Ping), {});
+            received = false;
+            while(!received && !trip_timeout) {
+                some_true something_done{};
+                something_done(client.update());
+                something_done(
+                  client.fetch_messages({construct_from, fetch_handler}));
+                if(!something_done) {
+                    client.prepare_wait(wakeup);
+                    wakeup->wait_for(std::chrono::milliseconds(10));
+                }
+            }
+        }
+        return trip_time.seconds().count();
+    }
+
+    auto _bulk(connection& client, span_size_t count) -> float {
+        std::vector<byte> content(64, byte(0x5AU));
+        const time_measure bulk_time;
+        const timeout bulk_timeout{std::chrono::seconds(60)};
+        span_size_t sent{0};
+        while((_bulk_received < count) && !bulk_timeout) {
+            for(span_size_t b = 0; (b < 64) && (sent < count); ++b) {
+                if(client.send(
+                     EAGINE_MSG_ID(LocTrnBnch, Bulk),
+                     message_view(view(content)))) {
+                    ++sent;
+                }
+            }
+            client.update();
+        }
+        return bulk_time.seconds().count();
+    }
+
+    std::unique_ptr<connection_factory> _factory;
+    std::string _address;
+    std::atomic<bool> _connected{false};
+    std::atomic<bool> _done{false};
+    std::atomic<span_size_t> _bulk_received{0};
+    span_size_t _round_trips{0};
+};
+//------------------------------------------------------------------------------
+} // namespace msgbus
+
+auto main(main_ctx& ctx) -> int {
+    span_size_t round_trips{100000};
+    span_size_t message_count{1000000};
+    ctx.config().fetch("msg_bus.benchmark.round_trips", round_trips);
+    ctx.config().fetch("msg_bus.benchmark.message_count", message_count);
+
+    msgbus::local_transport_benchmark{
+      ctx,
+      std::make_unique<msgbus::posix_shmem_connection_factory>(ctx),
+      "eagine-bench-shmem"}
+      .run(round_trips, message_count);
+
+    msgbus::local_transport_benchmark{
+      ctx,
+      std::make_unique<msgbus::posix_mqueue_connection_factory>(ctx),
+      "eagine-bench-mqueue"}
+      .run(round_trips, message_count);
+
+    msgbus::local_transport_benchmark{
+      ctx,
+      std::make_unique<msgbus::asio_local_stream_connection_factory>(ctx),
+      "/tmp/eagine-bench-asio"}
+      .run(round_trips, message_count);
+
+    return 0;
+}
+} // namespace eagine
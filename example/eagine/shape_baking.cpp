@@ -0,0 +1,97 @@
+/// @example eagine/shape_baking.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/math/functions.hpp>
+#include <eagine/shapes/centered.hpp>
+#include <eagine/shapes/scaled.hpp>
+#include <eagine/shapes/sphere.hpp>
+#include <eagine/shapes/torus.hpp>
+#include <eagine/shapes/translated.hpp>
+#include <eagine/timeout.hpp>
+#include <eagine/workshop.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+static void run_baking_benchmark(
+  main_ctx& ctx,
+  identifier shape_name,
+  shapes::generator& gen,
+  span_size_t thread_count) {
+    gen.use_workers(ctx.workers(), thread_count);
+
+    std::vector<float> values;
+    std::vector<std::uint32_t> indices;
+    const auto vertex_count = gen.vertex_count();
+
+    const time_measure attrib_time;
+    for(auto attr : {shapes::vertex_attrib_kind::position,
+                     shapes::vertex_attrib_kind::normal,
+                     shapes::vertex_attrib_kind::tangential,
+                     shapes::vertex_attrib_kind::bitangential,
+                     shapes::vertex_attrib_kind::wrap_coord}) {
+        values.resize(std_size(vertex_count * gen.values_per_vertex(attr)));
+        gen.attrib_values(attr, cover(values));
+    }
+    const auto attrib_seconds = attrib_time.seconds().count();
+
+    const time_measure index_time;
+    indices.resize(std_size(gen.index_count(0)));
+    gen.indices(0, cover(indices));
+    const auto index_seconds = index_time.seconds().count();
+
+    const auto mverts = float(vertex_count) / 1000000.F;
+    ctx.log()
+      .stat("shape baking throughput")
+      .arg(EAGINE_ID(shape), shape_name)
+      .arg(EAGINE_ID(threads), thread_count)
+      .arg(EAGINE_ID(vertices), vertex_count)
+      .arg(EAGINE_ID(indices), span_size(indices.size()))
+      .arg(EAGINE_ID(attribMVps), mverts / attrib_seconds)
+      .arg(EAGINE_ID(indexMVps), mverts / index_seconds);
+}
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    int rings{1000};
+    int sections{1000};
+    auto max_threads = span_size(std::thread::hardware_concurrency());
+    ctx.config().fetch("shapes.benchmark.rings", rings);
+    ctx.config().fetch("shapes.benchmark.sections", sections);
+    ctx.config().fetch("shapes.benchmark.max_threads", max_threads);
+
+    using shapes::vertex_attrib_kind;
+    const auto attrs = vertex_attrib_kind::position |
+                       vertex_attrib_kind::normal |
+                       vertex_attrib_kind::tangential |
+                       vertex_attrib_kind::bitangential |
+                       vertex_attrib_kind::wrap_coord;
+
+    for(span_size_t t = 1; t <= math::maximum(max_threads, span_size(1));
+        t *= 2) {
+        auto torus = shapes::unit_torus(attrs, rings, sections, 0.5F);
+        run_baking_benchmark(ctx, EAGINE_ID(torus), *torus, t);
+
+        auto sphere = shapes::unit_sphere(attrs, rings, sections);
+        run_baking_benchmark(ctx, EAGINE_ID(sphere), *sphere, t);
+
+        auto modified = shapes::center(shapes::translate(
+          shapes::scale(
+            shapes::unit_torus(attrs, rings, sections, 0.5F),
+            {{2.F, 0.5F, 3.F}}),
+          {{1.F, -2.F, 5.F}}));
+        run_baking_benchmark(ctx, EAGINE_ID(modified), *modified, t);
+    }
+    ctx.workers().shutdown();
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
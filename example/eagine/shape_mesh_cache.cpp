@@ -0,0 +1,75 @@
+/// @example eagine/shape_mesh_cache.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/shapes/mesh_cache.hpp>
+#include <eagine/shapes/torus.hpp>
+#include <eagine/timeout.hpp>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+static auto bake_shape(shapes::generator& gen) -> span_size_t {
+    std::vector<float> values;
+    span_size_t total{0};
+    for(auto attr : {shapes::vertex_attrib_kind::position,
+                     shapes::vertex_attrib_kind::normal,
+                     shapes::vertex_attrib_kind::wrap_coord}) {
+        values.resize(std_size(gen.value_count(attr)));
+        gen.attrib_values(attr, cover(values));
+        total += span_size(values.size());
+    }
+    std::vector<std::uint32_t> indices(std_size(gen.index_count()));
+    gen.indices(cover(indices));
+    return total + span_size(indices.size());
+}
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    int rings{1000};
+    int sections{1000};
+    std::string path{"shape_mesh.cache"};
+    ctx.config().fetch("shapes.cache.rings", rings);
+    ctx.config().fetch("shapes.cache.sections", sections);
+    ctx.config().fetch("shapes.cache.path", path);
+
+    using shapes::vertex_attrib_kind;
+    auto torus = shapes::unit_torus(
+      vertex_attrib_kind::position | vertex_attrib_kind::normal |
+        vertex_attrib_kind::wrap_coord,
+      rings,
+      sections,
+      0.5F);
+
+    const time_measure generate_time;
+    const auto generated = bake_shape(*torus);
+    const auto generate_seconds = generate_time.seconds().count();
+
+    if(!shapes::save_mesh_cache(*torus, path)) {
+        ctx.log().error("failed to save mesh cache to ${path}").arg(
+          EAGINE_ID(path), EAGINE_ID(FsPath), path);
+        return 1;
+    }
+
+    const time_measure load_time;
+    auto cached = shapes::from_mesh_cache(path);
+    const auto loaded = cached->is_valid() ? bake_shape(*cached) : 0;
+    const auto load_seconds = load_time.seconds().count();
+
+    ctx.log()
+      .stat("mesh cache loading")
+      .arg(EAGINE_ID(path), EAGINE_ID(FsPath), path)
+      .arg(EAGINE_ID(valid), cached->is_valid())
+      .arg(EAGINE_ID(generated), generated)
+      .arg(EAGINE_ID(loaded), loaded)
+      .arg(EAGINE_ID(generateS), generate_seconds)
+      .arg(EAGINE_ID(loadS), load_seconds);
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
@@ -0,0 +1,73 @@
+/// @example eagine/shape_optimize.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/shapes/icosahedron.hpp>
+#include <eagine/shapes/optimized.hpp>
+#include <eagine/shapes/sphere.hpp>
+#include <eagine/shapes/torus.hpp>
+#include <eagine/timeout.hpp>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+static void run_optimize_benchmark(
+  main_ctx& ctx,
+  identifier shape_name,
+  std::shared_ptr<shapes::generator> gen,
+  const shapes::mesh_optimization_options& options) {
+    shapes::optimized_gen optimized{std::move(gen), options};
+
+    const time_measure optimize_time;
+    const auto& stats = optimized.statistics(0);
+    const auto seconds = optimize_time.seconds().count();
+
+    ctx.log()
+      .stat("shape mesh optimization")
+      .arg(EAGINE_ID(shape), shape_name)
+      .arg(EAGINE_ID(triangles), stats.triangle_count)
+      .arg(EAGINE_ID(origVerts), stats.original_vertex_count)
+      .arg(EAGINE_ID(vertices), stats.vertex_count)
+      .arg(EAGINE_ID(acmrBefore), stats.acmr_before)
+      .arg(EAGINE_ID(acmrAfter), stats.acmr_after)
+      .arg(EAGINE_ID(seconds), seconds);
+}
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    int rings{256};
+    int sections{256};
+    shapes::mesh_optimization_options options;
+    ctx.config().fetch("shapes.optimize.rings", rings);
+    ctx.config().fetch("shapes.optimize.sections", sections);
+    ctx.config().fetch("shapes.optimize.cache_size", options.cache_size);
+    ctx.config().fetch("shapes.optimize.overdraw", options.reduce_overdraw);
+    ctx.config().fetch("shapes.optimize.dedup", options.deduplicate_vertices);
+
+    using shapes::vertex_attrib_kind;
+    const auto attrs =
+      vertex_attrib_kind::position | vertex_attrib_kind::normal;
+
+    run_optimize_benchmark(
+      ctx,
+      EAGINE_ID(torus),
+      shapes::unit_torus(attrs, rings, sections, 0.5F),
+      options);
+    run_optimize_benchmark(
+      ctx,
+      EAGINE_ID(sphere),
+      shapes::unit_sphere(attrs, rings, sections),
+      options);
+    run_optimize_benchmark(
+      ctx,
+      EAGINE_ID(icosahedr),
+      shapes::unit_icosahedron(attrs),
+      options);
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
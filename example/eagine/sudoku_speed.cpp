@@ -0,0 +1,147 @@
+/// @example eagine/sudoku_speed.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/integer_range.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/maybe_unused.hpp>
+#include <eagine/sudoku.hpp>
+#include <chrono>
+#include <stack>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+// solver recalculating the alternatives cell-by-cell without propagation,
+// used as the baseline for the propagating basic_sudoku_solver
+template <unsigned S>
+class reference_sudoku_solver {
+public:
+    using board_type = basic_sudoku_board<S>;
+    using coord_type = typename board_type::coord_type;
+
+    static auto calculate_alternatives(board_type& board) -> board_type& {
+        board.for_each_coord([&](const auto& coord) {
+            if(!board.get(coord).is_single()) {
+                board.set_available_alternatives(coord);
+            }
+            return true;
+        });
+        return board;
+    }
+
+    auto solve(board_type board) -> board_type {
+        std::stack<board_type> solutions;
+        solutions.push(calculate_alternatives(board));
+
+        bool done = false;
+        while(!(solutions.empty() || done)) {
+            board = solutions.top();
+            solutions.pop();
+
+            const auto coord{board.find_unsolved()};
+            if(coord == board_type::invalid_coord()) {
+                continue;
+            }
+            board.get(coord).for_each_alternative([&](unsigned alt) {
+                auto candidate = board_type(board).set(coord, alt);
+                if(!candidate.is_possible(coord, alt)) {
+                    return;
+                }
+                if(calculate_alternatives(candidate).has_empty()) {
+                    return;
+                }
+                if(candidate.is_solved()) {
+                    board = candidate;
+                    done = true;
+                } else if(!done) {
+                    solutions.push(candidate);
+                }
+            });
+        }
+        return board;
+    }
+};
+//------------------------------------------------------------------------------
+template <unsigned S>
+auto is_valid_solution(const basic_sudoku_board<S>& board) -> bool {
+    bool result = board.is_solved();
+    board.for_each_coord([&](const auto& coord) {
+        result = result && board.is_possible(coord, board.get(coord));
+        return result;
+    });
+    return result;
+}
+//------------------------------------------------------------------------------
+template <unsigned S, typename Solver>
+auto measure_solver(
+  const std::vector<basic_sudoku_board<S>>& boards,
+  Solver solver,
+  span_size_t& solved) {
+    solved = 0;
+    const auto start{std::chrono::steady_clock::now()};
+    for(const auto& board : boards) {
+        if(is_valid_solution(solver.solve(board))) {
+            ++solved;
+        }
+    }
+    return std::chrono::duration<float, std::milli>(
+             std::chrono::steady_clock::now() - start) /
+           span_size(boards.size());
+}
+//------------------------------------------------------------------------------
+template <unsigned S>
+void measure_sudoku(main_ctx& ctx, span_size_t count, bool with_reference) {
+    default_sudoku_board_traits<S> traits;
+    auto generator{traits.make_generator()};
+
+    std::vector<basic_sudoku_board<S>> boards;
+    boards.reserve(std_size(count));
+    for(const auto i : integer_range(count)) {
+        EAGINE_MAYBE_UNUSED(i);
+        boards.push_back(generator.generate_few());
+    }
+
+    span_size_t solved{0};
+    const auto propagating{
+      measure_solver(boards, basic_sudoku_solver<S>{}, solved)};
+
+    if(with_reference) {
+        span_size_t ref_solved{0};
+        const auto reference{
+          measure_solver(boards, reference_sudoku_solver<S>{}, ref_solved)};
+        ctx.log()
+          .info("sudoku solver speed")
+          .arg(EAGINE_ID(rank), S)
+          .arg(EAGINE_ID(boards), count)
+          .arg(EAGINE_ID(solved), solved)
+          .arg(EAGINE_ID(perBoard), EAGINE_ID(ms), propagating.count())
+          .arg(EAGINE_ID(refSolved), ref_solved)
+          .arg(EAGINE_ID(refBoard), EAGINE_ID(ms), reference.count())
+          .arg(EAGINE_ID(speedup), reference / propagating);
+    } else {
+        ctx.log()
+          .info("sudoku solver speed")
+          .arg(EAGINE_ID(rank), S)
+          .arg(EAGINE_ID(boards), count)
+          .arg(EAGINE_ID(solved), solved)
+          .arg(EAGINE_ID(perBoard), EAGINE_ID(ms), propagating.count());
+    }
+}
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    const span_size_t count{8};
+    // the reference solver is too slow for the bigger boards
+    measure_sudoku<3>(ctx, count, true);
+    measure_sudoku<4>(ctx, count, true);
+    measure_sudoku<5>(ctx, count, ctx.args().find("--rank-5-reference"));
+    measure_sudoku<6>(ctx, count, false);
+
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
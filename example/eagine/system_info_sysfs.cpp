@@ -0,0 +1,150 @@
+/// @example eagine/system_info_sysfs.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/main.hpp>
+#include <eagine/system_info.hpp>
+#include <eagine/timeout.hpp>
+#include <eagine/value_tree/filesystem.hpp>
+#include <eagine/value_tree/wrappers.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+// Builds a fake sysfs tree with the specified number of unrelated devices
+// and thermal zones, cooling devices and power supplies linked from the
+// class directories, like in the real sysfs.
+static void make_fake_sysfs(
+  const std::filesystem::path& root,
+  int device_count,
+  int zone_count) {
+    namespace fs = std::filesystem;
+    auto write = [](const fs::path& path, const std::string& value) {
+        std::ofstream file(path);
+        file << value << '\n';
+    };
+    auto add_class_device = [&](
+                              const fs::path& device,
+                              const char* class_name) {
+        const auto class_dir = root / "class" / class_name;
+        fs::create_directories(class_dir);
+        fs::create_directory_symlink(device, class_dir / device.filename());
+    };
+
+    for(int d = 0; d < device_count; ++d) {
+        const auto device = root / "devices" / "platform" /
+                            ("device." + std::to_string(d));
+        fs::create_directories(device / "power");
+        write(device / "uevent", "DRIVER=fake");
+        write(device / "power" / "control", "auto");
+    }
+
+    const auto thermal = root / "devices" / "virtual" / "thermal";
+    for(int z = 0; z < zone_count; ++z) {
+        const auto zone = thermal / ("thermal_zone" + std::to_string(z));
+        fs::create_directories(zone);
+        write(zone / "type", z == 0 ? "acpitz" : "fake-thermal");
+        write(zone / "temp", std::to_string(40000 + z * 100));
+        add_class_device(zone, "thermal");
+
+        const auto cdev = thermal / ("cooling_device" + std::to_string(z));
+        fs::create_directories(cdev);
+        write(cdev / "cur_state", std::to_string(z % 4));
+        write(cdev / "max_state", "3");
+        add_class_device(cdev, "thermal");
+    }
+
+    const auto acpi = root / "devices" / "LNXSYSTM:00" / "power_supply";
+    for(const auto& [name, type, attrib, value] :
+        {std::make_tuple("BAT0", "Battery", "capacity", "87"),
+         std::make_tuple("AC", "Mains", "online", "1")}) {
+        const auto supply = acpi / name;
+        fs::create_directories(supply);
+        write(supply / "type", type);
+        write(supply / attrib, value);
+        add_class_device(supply, "power_supply");
+    }
+}
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    int device_count{20000};
+    int zone_count{16};
+    int sample_count{10000};
+    ctx.config().fetch("system.sysfs_bench.devices", device_count);
+    ctx.config().fetch("system.sysfs_bench.zones", zone_count);
+    ctx.config().fetch("system.sysfs_bench.samples", sample_count);
+
+    const auto root =
+      std::filesystem::temp_directory_path() / "eagine_fake_sysfs";
+    std::filesystem::remove_all(root);
+    make_fake_sysfs(root, device_count, zone_count);
+
+    // the previous discovery, walking the whole devices subtree
+    const time_measure walk_time;
+    span_size_t walked{0};
+    const auto devices = (root / "devices").string();
+    if(auto tree{valtree::from_filesystem_path(devices, ctx)}) {
+        tree.traverse(valtree::compound::visit_handler{
+          construct_from,
+          [&walked](
+            valtree::compound& c,
+            const valtree::attribute& a,
+            const basic_string_path&) {
+              ++walked;
+              return !c.is_link(a);
+          }});
+    }
+    const auto walk_seconds = walk_time.seconds().count();
+
+    // the discovery through the class directories
+    ::setenv("EAGINE_SYSTEM_SYSFS_ROOT", root.c_str(), 1);
+    system_info sys{ctx};
+
+    const time_measure startup_time;
+    sys.preinitialize();
+    const auto startup_seconds = startup_time.seconds().count();
+
+    const time_measure discovery_time;
+    const auto sensors = sys.thermal_sensor_count();
+    const auto coolers = sys.cooling_device_count();
+    const auto batteries = sys.battery_count();
+    const auto ac_supplies = sys.ac_supply_count();
+    const auto discovery_seconds = discovery_time.seconds().count();
+
+    const time_measure sample_time;
+    float checksum{0.F};
+    for(int s = 0; s < sample_count; ++s) {
+        const auto [t_min, t_max] = sys.temperature_min_max();
+        checksum += extract_or(t_max, kelvins_(0.F)).value() -
+                    extract_or(t_min, kelvins_(0.F)).value();
+    }
+    const auto sample_seconds = sample_time.seconds().count();
+
+    std::filesystem::remove_all(root);
+
+    ctx.log()
+      .stat("sysfs discovery")
+      .arg(EAGINE_ID(devices), device_count)
+      .arg(EAGINE_ID(walked), walked)
+      .arg(EAGINE_ID(sensors), sensors)
+      .arg(EAGINE_ID(coolers), coolers)
+      .arg(EAGINE_ID(batteries), batteries)
+      .arg(EAGINE_ID(acSupplies), ac_supplies)
+      .arg(EAGINE_ID(walkS), walk_seconds)
+      .arg(EAGINE_ID(startupS), startup_seconds)
+      .arg(EAGINE_ID(discoverS), discovery_seconds)
+      .arg(EAGINE_ID(samples), sample_count)
+      .arg(EAGINE_ID(sampleS), sample_seconds)
+      .arg(EAGINE_ID(checksum), checksum);
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
@@ -14,10 +14,13 @@
 #include <eagine/valid_if/not_empty.hpp>
 #include <eagine/value_tree/json.hpp>
 #include <eagine/value_tree/yaml.hpp>
+#include <atomic>
 #include <cctype>
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace eagine {
 //------------------------------------------------------------------------------
@@ -79,7 +82,124 @@ public:
         return {};
     }
 
+    auto memo_generation() const noexcept -> std::uint64_t {
+        return _memo_generation.load(std::memory_order_acquire);
+    }
+
+    auto find_memo(
+      string_view key,
+      string_view tag,
+      const std::type_info& type) noexcept -> std::shared_ptr<const std::any> {
+        const auto hash{_memo_hash(key, tag, type)};
+        std::unique_lock lck{_memo_mutex};
+        if(const auto entry{_find_memo_entry(hash, key, tag, type)}) {
+            return entry->value;
+        }
+        return {};
+    }
+
+    void memoize(
+      string_view key,
+      string_view tag,
+      const std::type_info& type,
+      std::any value,
+      std::uint64_t generation) noexcept {
+        try {
+            const auto hash{_memo_hash(key, tag, type)};
+            auto memo{std::make_shared<const std::any>(std::move(value))};
+            std::unique_lock lck{_memo_mutex};
+            // the value could have been resolved from configuration files
+            // that were discarded by a reload since the lookup started
+            if(generation != _memo_generation.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if(!_find_memo_entry(hash, key, tag, type)) {
+                _memo.emplace(
+                  hash,
+                  _memo_entry{
+                    to_string(key), to_string(tag), &type, std::move(memo)});
+            }
+        } catch(...) {
+        }
+    }
+
+    void reload() noexcept {
+        std::unique_lock lck{_mutex};
+        std::unique_lock memo_lck{_memo_mutex};
+        _memo_generation.fetch_add(1U, std::memory_order_release);
+        _memo.clear();
+        _open_configs.clear();
+        _probed_configs.clear();
+    }
+
+    auto has_changed_files() noexcept -> bool {
+        std::unique_lock lck{_mutex};
+        for(const auto& [cfg_path, mod_time] : _probed_configs) {
+            if(_modification_time(cfg_path) != mod_time) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
+    struct _memo_entry {
+        std::string key;
+        std::string tag;
+        const std::type_info* type{nullptr};
+        // held by the lookups even if the memo is reloaded meanwhile
+        std::shared_ptr<const std::any> value;
+    };
+
+    using _memo_map = std::unordered_multimap<std::size_t, _memo_entry>;
+
+    auto _find_memo_entry(
+      std::size_t hash,
+      string_view key,
+      string_view tag,
+      const std::type_info& type) const noexcept -> const _memo_entry* {
+        const auto range{_memo.equal_range(hash)};
+        for(auto pos = range.first; pos != range.second; ++pos) {
+            const auto& entry = pos->second;
+            if(
+              (*entry.type == type) && are_equal(view(entry.key), key) &&
+              are_equal(view(entry.tag), tag)) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    static auto _memo_hash(
+      string_view key,
+      string_view tag,
+      const std::type_info& type) noexcept -> std::size_t {
+        // FNV-1a of the key and tag, combined with the hash of the type
+        std::uint64_t hash{0xCBF29CE484222325U};
+        const auto add = [&hash](char c) {
+            hash ^= std::uint8_t(c);
+            hash *= 0x100000001B3U;
+        };
+        for(const char c : key) {
+            add(c);
+        }
+        add('\0');
+        for(const char c : tag) {
+            add(c);
+        }
+        return std::size_t(hash) ^ type.hash_code();
+    }
+
+    static auto _modification_time(const std::filesystem::path& cfg_path)
+      -> std::filesystem::file_time_type {
+        std::error_code error;
+        const auto result{last_write_time(cfg_path, error)};
+        if(error) {
+            return std::filesystem::file_time_type::min();
+        }
+        return result;
+    }
+
     auto _cat(string_view l, string_view r) noexcept -> const std::string& {
         return append_to(assign_to(_config_name, l), r);
     }
@@ -125,6 +245,7 @@ private:
       string_view key,
       span<const string_view> tags) -> valtree::compound_attribute {
         if(!cfg_path.empty()) {
+            _probed_configs.try_emplace(cfg_path, _modification_time(cfg_path));
             if(is_regular_file(cfg_path) || is_fifo(cfg_path)) {
                 if(auto comp{_get_config(cfg_path)}) {
                     if(auto attr{comp.find(
@@ -177,6 +298,12 @@ private:
 
     std::mutex _mutex;
     std::map<std::string, valtree::compound> _open_configs;
+    std::map<std::filesystem::path, std::filesystem::file_time_type>
+      _probed_configs;
+    std::mutex _memo_mutex;
+    _memo_map _memo;
+    // incremented on each reload, the values resolved before are not memoized
+    std::atomic<std::uint64_t> _memo_generation{0U};
     std::vector<string_view> _tag_list;
     std::string _config_name;
     std::filesystem::path _config_path;
@@ -194,6 +321,54 @@ auto application_config::_impl() noexcept -> application_config_impl* {
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+void application_config::reload() noexcept {
+    if(_pimpl) {
+        _pimpl->reload();
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto application_config::refresh() noexcept -> bool {
+    if(_pimpl && _pimpl->has_changed_files()) {
+        log_info("configuration files changed, reloading");
+        _pimpl->reload();
+        return true;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto application_config::_memo_generation() noexcept -> std::uint64_t {
+    if(auto impl{_impl()}) {
+        return extract(impl).memo_generation();
+    }
+    return 0U;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto application_config::_find_memo(
+  string_view key,
+  string_view tag,
+  const std::type_info& type) noexcept -> std::shared_ptr<const std::any> {
+    if(auto impl{_impl()}) {
+        return extract(impl).find_memo(key, tag, type);
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void application_config::_memoize(
+  string_view key,
+  string_view tag,
+  const std::type_info& type,
+  std::any value,
+  std::uint64_t generation) noexcept {
+    if(auto impl{_impl()}) {
+        extract(impl).memoize(key, tag, type, std::move(value), generation);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto application_config::_find_comp_attr(
   string_view key,
   string_view tag) noexcept -> valtree::compound_attribute {
@@ -0,0 +1,245 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/assert.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+c_api_call_profile::c_api_call_profile() noexcept
+  : _epoch{_clock::now()} {}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void c_api_call_profile::register_function(
+  const void* address,
+  string_view name) {
+    const std::lock_guard<std::mutex> lock{_names_mutex};
+    const auto pos{std::find_if(
+      _names.begin(), _names.end(), [address](const auto& entry) {
+          return std::get<0>(entry) == address;
+      })};
+    if(pos == _names.end()) {
+        _names.emplace_back(address, to_string(name));
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void c_api_call_profile::enable_trace(span_size_t capacity) {
+    EAGINE_ASSERT(capacity >= 0);
+    _trace = std::vector<_trace_entry>(std_size(capacity));
+    _trace_pos.store(0U, std::memory_order_relaxed);
+    if(capacity > 0) {
+        enable_timing();
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void c_api_call_profile::reset() noexcept {
+    for(auto& slot : _slots) {
+        slot.call_count.store(0U, std::memory_order_relaxed);
+        slot.total_ns.store(0U, std::memory_order_relaxed);
+    }
+    for(auto& entry : _trace) {
+        entry.stamp.store(0U, std::memory_order_relaxed);
+    }
+    _trace_pos.store(0U, std::memory_order_relaxed);
+    _epoch = _clock::now();
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto c_api_call_profile::_find_slot(
+  const void* address,
+  std_size_t index) noexcept -> std_size_t {
+    // linear probing, the slots are never released so a lookup can stop
+    // at the first empty slot
+    for(std_size_t probe = 0; probe < _slot_count - 1U; ++probe) {
+        auto& slot = _slots[index];
+        const void* current{slot.address.load(std::memory_order_acquire)};
+        if(current == address) {
+            return index;
+        }
+        if(current == nullptr) {
+            if(slot.address.compare_exchange_strong(
+                 current, address, std::memory_order_acq_rel)) {
+                return index;
+            }
+            if(current == address) {
+                return index;
+            }
+        }
+        index = (index + 1U) % (_slot_count - 1U);
+    }
+    return _slot_count - 1U;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void c_api_call_profile::_record(
+  std_size_t index,
+  _clock::time_point start,
+  _clock::time_point finish) noexcept {
+    const auto duration{
+      std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start)
+        .count()};
+    _slots[index].total_ns.fetch_add(
+      std::uint64_t(duration), std::memory_order_relaxed);
+
+    if(!_trace.empty()) {
+        const auto pos{_trace_pos.fetch_add(1U, std::memory_order_relaxed)};
+        auto& entry = _trace[pos % _trace.size()];
+        // only one writer may own the entry, if it is being written or holds
+        // a newer record then this record is dropped
+        auto stamp{entry.stamp.load(std::memory_order_relaxed)};
+        do {
+            if(((stamp & 1U) != 0U) || (stamp > 2U * pos)) {
+                return;
+            }
+        } while(!entry.stamp.compare_exchange_weak(
+          stamp, 2U * pos + 1U, std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_release);
+
+        entry.start_ns.store(
+          std::uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+              start - _epoch)
+              .count()),
+          std::memory_order_relaxed);
+        entry.function_index.store(
+          std::uint32_t(index), std::memory_order_relaxed);
+        entry.duration_ns.store(
+          std::uint32_t(std::min<std::int64_t>(
+            duration, std::numeric_limits<std::uint32_t>::max())),
+          std::memory_order_relaxed);
+        entry.stamp.store(2U * pos + 2U, std::memory_order_release);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto c_api_call_profile::function_stats() const
+  -> std::vector<c_api_function_stats> {
+    std::vector<c_api_function_stats> result;
+    const std::lock_guard<std::mutex> lock{_names_mutex};
+    for(std_size_t index = 0; index < _slot_count; ++index) {
+        const auto& slot = _slots[index];
+        const void* address{slot.address.load(std::memory_order_acquire)};
+        const auto call_count{slot.call_count.load(std::memory_order_relaxed)};
+        if(address || (call_count > 0U)) {
+            c_api_function_stats stats;
+            stats.address = address;
+            stats.call_count = call_count;
+            stats.total_time = std::chrono::nanoseconds{
+              slot.total_ns.load(std::memory_order_relaxed)};
+            const auto pos{std::find_if(
+              _names.begin(), _names.end(), [address](const auto& entry) {
+                  return std::get<0>(entry) == address;
+              })};
+            if(pos != _names.end()) {
+                stats.name = std::get<1>(*pos);
+            } else if(!address) {
+                stats.name = "(other)";
+            }
+            result.emplace_back(std::move(stats));
+        }
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto c_api_call_profile::trace() const -> std::vector<c_api_trace_record> {
+    // map the slot indices to the indices in the result of function_stats
+    std::array<std::uint32_t, _slot_count> indices{};
+    std::uint32_t used{0U};
+    for(std_size_t index = 0; index < _slot_count; ++index) {
+        const auto& slot = _slots[index];
+        if(
+          slot.address.load(std::memory_order_acquire) ||
+          (slot.call_count.load(std::memory_order_relaxed) > 0U)) {
+            indices[index] = used++;
+        }
+    }
+
+    std::vector<c_api_trace_record> result;
+    if(!_trace.empty()) {
+        const auto end{_trace_pos.load(std::memory_order_relaxed)};
+        const auto size{std::min<std::uint64_t>(end, _trace.size())};
+        result.reserve(std_size(size));
+        for(auto pos = end - size; pos < end; ++pos) {
+            const auto& entry = _trace[pos % _trace.size()];
+            const auto stamp{2U * pos + 2U};
+            if(entry.stamp.load(std::memory_order_acquire) != stamp) {
+                continue;
+            }
+            c_api_trace_record record;
+            record.start_ns = entry.start_ns.load(std::memory_order_relaxed);
+            record.function_index =
+              entry.function_index.load(std::memory_order_relaxed);
+            record.duration_ns =
+              entry.duration_ns.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // the record was overwritten while it was being read
+            if(entry.stamp.load(std::memory_order_relaxed) != stamp) {
+                continue;
+            }
+            record.function_index = indices[record.function_index];
+            result.push_back(record);
+        }
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto c_api_call_profile::write_report(std::ostream& out, span_size_t count)
+  const -> std::ostream& {
+    auto stats{function_stats()};
+    const auto limit{std::min(std_size(count), stats.size())};
+
+    const auto print = [&](const c_api_function_stats& s) {
+        out << "  " << std::setw(32) << std::left;
+        if(s.name.empty()) {
+            out << s.address;
+        } else {
+            out << s.name;
+        }
+        out << std::right << std::setw(12) << s.call_count << std::setw(14)
+            << std::fixed << std::setprecision(3)
+            << float(s.total_time.count()) * 1e-6F << " ms" << std::setw(12)
+            << std::setprecision(1)
+            << (s.call_count ? float(s.total_time.count()) /
+                                 float(s.call_count)
+                             : 0.F)
+            << " ns/call\n";
+    };
+
+    const auto by_count = [](const auto& l, const auto& r) {
+        return l.call_count > r.call_count;
+    };
+    std::partial_sort(
+      stats.begin(), stats.begin() + limit, stats.end(), by_count);
+    out << "Top C-API functions by call count:\n";
+    for(std_size_t i = 0; i < limit; ++i) {
+        print(stats[i]);
+    }
+
+    if(is_timing()) {
+        const auto by_time = [](const auto& l, const auto& r) {
+            return l.total_time > r.total_time;
+        };
+        std::partial_sort(
+          stats.begin(), stats.begin() + limit, stats.end(), by_time);
+        out << "Top C-API functions by time:\n";
+        for(std_size_t i = 0; i < limit; ++i) {
+            print(stats[i]);
+        }
+    }
+    return out;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
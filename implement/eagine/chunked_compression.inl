@@ -0,0 +1,265 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#include <eagine/main_ctx_fwd.hpp>
+#include <eagine/math/functions.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/workshop.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+// container layout (all integers are little-endian):
+//  [0-3] magic "EChk"
+//  [4-7] format version
+//  [8-11] uncompressed chunk size
+//  [12-15] chunk count
+//  [16-23] total uncompressed size
+//  [24-...] chunk count x 8-byte end offsets of the chunks after the index
+//------------------------------------------------------------------------------
+static constexpr const span_size_t chunked_compression_header_size = 24;
+static constexpr const std::uint32_t chunked_compression_version = 1U;
+//------------------------------------------------------------------------------
+static inline auto
+chunked_compression_magic(memory::const_block data) noexcept -> bool {
+    return (data.size() >= 4) && (data[0] == 'E') && (data[1] == 'C') &&
+           (data[2] == 'h') && (data[3] == 'k');
+}
+//------------------------------------------------------------------------------
+template <typename T>
+static inline auto chunked_compression_read(
+  memory::const_block data,
+  span_size_t offs) noexcept -> T {
+    T result{0U};
+    for(span_size_t i = 0; i < span_size(sizeof(T)); ++i) {
+        result |= T(data[offs + i]) << (8U * unsigned(i));
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+template <typename T>
+static inline void chunked_compression_write(
+  memory::block data,
+  span_size_t offs,
+  T value) noexcept {
+    for(span_size_t i = 0; i < span_size(sizeof(T)); ++i) {
+        data[offs + i] = byte((value >> (8U * unsigned(i))) & 0xFFU);
+    }
+}
+//------------------------------------------------------------------------------
+// chunked_compressed_view
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto chunked_compressed_view::is_chunked(memory::const_block data) noexcept
+  -> bool {
+    return (data.size() >= chunked_compression_header_size) &&
+           chunked_compression_magic(data) &&
+           (chunked_compression_read<std::uint32_t>(data, 4) ==
+            chunked_compression_version);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+chunked_compressed_view::chunked_compressed_view(
+  memory::const_block data) noexcept {
+    if(is_chunked(data)) {
+        const auto chunk_size =
+          span_size(chunked_compression_read<std::uint32_t>(data, 8));
+        const auto chunk_count =
+          span_size(chunked_compression_read<std::uint32_t>(data, 12));
+        const auto total_size =
+          span_size(chunked_compression_read<std::uint64_t>(data, 16));
+        const auto index_size = chunk_count * 8;
+
+        if(
+          (chunk_size > 0) &&
+          (data.size() >= chunked_compression_header_size + index_size) &&
+          ((total_size + chunk_size - 1) / chunk_size == chunk_count)) {
+            _index =
+              head(skip(data, chunked_compression_header_size), index_size);
+            _chunks = skip(data, chunked_compression_header_size + index_size);
+            const auto last_end =
+              chunk_count ? span_size(chunked_compression_read<std::uint64_t>(
+                              _index, index_size - 8))
+                          : 0;
+            if(last_end <= _chunks.size()) {
+                _total_size = total_size;
+                _chunk_size = chunk_size;
+                _chunk_count = chunk_count;
+            }
+        }
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto chunked_compressed_view::unpacked_size(span_size_t index) const noexcept
+  -> span_size_t {
+    EAGINE_ASSERT((index >= 0) && (index < _chunk_count));
+    return math::minimum(_chunk_size, _total_size - chunk_offset(index));
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto chunked_compressed_view::packed_chunk(span_size_t index) const noexcept
+  -> memory::const_block {
+    EAGINE_ASSERT((index >= 0) && (index < _chunk_count));
+    const auto end_offset = [this](span_size_t i) {
+        using T = std::uint64_t;
+        return span_size(chunked_compression_read<T>(_index, i * 8));
+    };
+    const auto begin = index ? end_offset(index - 1) : 0;
+    const auto end = end_offset(index);
+    if(begin <= end) {
+        return head(skip(_chunks, begin), end - begin);
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto chunked_compressed_view::unpack_chunk(
+  data_compressor& compressor,
+  span_size_t index,
+  memory::buffer& output) const -> memory::const_block {
+    const auto result = compressor.decompress(packed_chunk(index), output);
+    if(result.size() == unpacked_size(index)) {
+        return result;
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+// chunked_data_compressor
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+chunked_data_compressor::chunked_data_compressor(
+  workshop& workers,
+  span_size_t thread_count,
+  span_size_t chunk_size)
+  : _workers{workers}
+  , _chunk_size{chunk_size > 0 ? chunk_size : default_chunk_size()} {
+    thread_count = math::maximum(thread_count, span_size(1));
+    _compressors.resize(std_size(thread_count));
+    if(thread_count > 1) {
+        _workers.ensure_workers(thread_count);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+chunked_data_compressor::chunked_data_compressor(main_ctx_getters& ctx)
+  : chunked_data_compressor{
+      ctx.workers(),
+      span_size(std::thread::hardware_concurrency())} {}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto chunked_data_compressor::compress(
+  memory::const_block input,
+  memory::buffer& output,
+  data_compression_level level) -> memory::const_block {
+    const auto chunk_count = (input.size() + _chunk_size - 1) / _chunk_size;
+    if(_packed_chunks.size() < std_size(chunk_count)) {
+        _packed_chunks.resize(std_size(chunk_count));
+    }
+
+    std::atomic<bool> failed{false};
+    auto compress_chunk = [&](span_size_t task, span_size_t index) {
+        auto& compressor = _compressors[std_size(task)];
+        const auto chunk = head(skip(input, index * _chunk_size), _chunk_size);
+        auto& packed = _packed_chunks[std_size(index)];
+        if(!compressor.compress(chunk, packed, level)) {
+            failed = true;
+        }
+    };
+    _workers.parallel_for(
+      chunk_count,
+      thread_count(),
+      [&](span_size_t task, span_size_t begin, span_size_t end) {
+          for(auto index = begin; index < end; ++index) {
+              compress_chunk(task, index);
+          }
+      });
+
+    if(failed) {
+        return {};
+    }
+
+    const auto index_size = chunk_count * 8;
+    span_size_t packed_size{0};
+    for(span_size_t i = 0; i < chunk_count; ++i) {
+        packed_size += _packed_chunks[std_size(i)].size();
+    }
+
+    output.resize(chunked_compression_header_size + index_size + packed_size);
+    auto dst = cover(output);
+    dst[0] = 'E';
+    dst[1] = 'C';
+    dst[2] = 'h';
+    dst[3] = 'k';
+    chunked_compression_write(dst, 4, chunked_compression_version);
+    chunked_compression_write(dst, 8, std::uint32_t(_chunk_size));
+    chunked_compression_write(dst, 12, std::uint32_t(chunk_count));
+    chunked_compression_write(dst, 16, std::uint64_t(input.size()));
+
+    auto chunks = skip(dst, chunked_compression_header_size + index_size);
+    span_size_t offset{0};
+    for(span_size_t i = 0; i < chunk_count; ++i) {
+        const auto& packed = _packed_chunks[std_size(i)];
+        copy(view(packed), skip(chunks, offset));
+        offset += packed.size();
+        chunked_compression_write(
+          dst, chunked_compression_header_size + i * 8, std::uint64_t(offset));
+    }
+    return view(output);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto chunked_data_compressor::decompress(
+  memory::const_block input,
+  memory::buffer& output) -> memory::const_block {
+    const chunked_compressed_view packed{input};
+    if(!packed) {
+        return {};
+    }
+    output.resize(packed.total_size());
+
+    std::atomic<bool> failed{false};
+    auto decompress_chunk = [&](span_size_t task, span_size_t index) {
+        auto& compressor = _compressors[std_size(task)];
+        auto dst = head(
+          skip(cover(output), packed.chunk_offset(index)),
+          packed.unpacked_size(index));
+        auto append = [&dst](memory::const_block blk) {
+            if(blk.size() <= dst.size()) {
+                copy(blk, dst);
+                dst = skip(dst, blk.size());
+                return true;
+            }
+            return false;
+        };
+        if(
+          !compressor.decompress(
+            packed.packed_chunk(index),
+            data_compressor::data_handler(construct_from, append)) ||
+          !dst.empty()) {
+            failed = true;
+        }
+    };
+    _workers.parallel_for(
+      packed.chunk_count(),
+      thread_count(),
+      [&](span_size_t task, span_size_t begin, span_size_t end) {
+          for(auto index = begin; index < end; ++index) {
+              decompress_chunk(task, index);
+          }
+      });
+
+    if(failed) {
+        return {};
+    }
+    return view(output);
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
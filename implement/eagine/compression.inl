@@ -6,8 +6,15 @@
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
 
+#include <eagine/flat_map.hpp>
 #include <eagine/memory/span_algo.hpp>
+#include <eagine/string_span.hpp>
+#include <algorithm>
 #include <array>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 #if EAGINE_USE_ZLIB
 #include <eagine/span.hpp>
 #include <zlib.h>
@@ -15,13 +22,48 @@
 
 namespace eagine {
 //------------------------------------------------------------------------------
+static inline auto
+data_compression_header(data_compression_dictionary_id dictionary_id) noexcept
+  -> byte {
+    return (dictionary_id == no_compression_dictionary()) ? byte(0x01U)
+                                                          : byte(dictionary_id);
+}
+//------------------------------------------------------------------------------
+static inline auto data_compression_unpack_chunks(
+  memory::const_block input,
+  const data_compressor::data_handler& handler) -> bool {
+    while(input.size() >= 4) {
+        std::uint32_t size{0U};
+        for(span_size_t i = 0; i < 4; ++i) {
+            size |= std::uint32_t(input[i]) << (8U * unsigned(i));
+        }
+        input = skip(input, 4);
+        if(size == 0U) {
+            // nothing may follow the terminating empty chunk
+            return input.empty();
+        }
+        if(span_size(size) > input.size()) {
+            return false;
+        }
+        if(!handler(head(input, span_size(size)))) {
+            return false;
+        }
+        input = skip(input, span_size(size));
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
 #if EAGINE_USE_ZLIB
 class data_compressor_impl {
 private:
     memory::buffer _buff{};
     std::array<byte, 16 * 1024> _temp{};
-    ::z_stream _zsd{};
+    // one deflate stream per compression level, reset between uses
+    std::array<::z_stream, 4> _zsd{};
+    std::array<bool, 4> _zsd_init{};
     ::z_stream _zsi{};
+    bool _zsi_init{false};
+    flat_map<data_compression_dictionary_id, memory::buffer> _dictionaries;
 
     static constexpr auto _translate(data_compression_level level) noexcept
       -> int {
@@ -38,81 +80,162 @@ private:
         return Z_DEFAULT_COMPRESSION;
     }
 
+    static void _clear(::z_stream& zs) noexcept {
+        zero(as_bytes(cover_one(zs)));
+        zs.zalloc = nullptr;
+        zs.zfree = nullptr;
+        zs.opaque = nullptr;
+    }
+
+    auto _find_dictionary(data_compression_dictionary_id dictionary_id) const
+      noexcept -> memory::const_block {
+        const auto pos = _dictionaries.find(dictionary_id);
+        if(pos != _dictionaries.end()) {
+            return view(pos->second);
+        }
+        return {};
+    }
+
+    auto _deflate_stream(data_compression_level level) -> ::z_stream* {
+        const auto idx = static_cast<std::size_t>(level);
+        auto& zsd = _zsd[idx];
+        if(_zsd_init[idx]) {
+            if(::deflateReset(&zsd) == Z_OK) {
+                return &zsd;
+            }
+            ::deflateEnd(&zsd);
+            _zsd_init[idx] = false;
+        }
+        _clear(zsd);
+        if(::deflateInit(&zsd, _translate(level)) == Z_OK) {
+            _zsd_init[idx] = true;
+            return &zsd;
+        }
+        return nullptr;
+    }
+
+    auto _inflate_stream() -> ::z_stream* {
+        if(_zsi_init) {
+            if(::inflateReset(&_zsi) == Z_OK) {
+                return &_zsi;
+            }
+            ::inflateEnd(&_zsi);
+            _zsi_init = false;
+        }
+        _clear(_zsi);
+        if(::inflateInit(&_zsi) == Z_OK) {
+            _zsi_init = true;
+            return &_zsi;
+        }
+        return nullptr;
+    }
+
 public:
     using data_handler = callable_ref<bool(memory::const_block)>;
 
     data_compressor_impl() noexcept {
-        zero(as_bytes(cover_one(_zsd)));
-        _zsd.zalloc = nullptr;
-        _zsd.zfree = nullptr;
-        _zsd.opaque = nullptr;
-        zero(as_bytes(cover_one(_zsi)));
-        _zsi.zalloc = nullptr;
-        _zsi.zfree = nullptr;
-        _zsi.opaque = nullptr;
+        for(auto& zsd : _zsd) {
+            _clear(zsd);
+        }
+        _clear(_zsi);
+    }
+
+    data_compressor_impl(data_compressor_impl&&) = delete;
+    data_compressor_impl(const data_compressor_impl&) = delete;
+    auto operator=(data_compressor_impl&&) = delete;
+    auto operator=(const data_compressor_impl&) = delete;
+
+    ~data_compressor_impl() noexcept {
+        for(std::size_t i = 0; i < _zsd.size(); ++i) {
+            if(_zsd_init[i]) {
+                ::deflateEnd(&_zsd[i]);
+            }
+        }
+        if(_zsi_init) {
+            ::inflateEnd(&_zsi);
+        }
+    }
+
+    auto add_dictionary(
+      data_compression_dictionary_id dictionary_id,
+      memory::const_block dictionary) -> bool {
+        if(
+          (dictionary_id > 1U) &&
+          (dictionary_id != stored_chunks_compression_header()) &&
+          dictionary) {
+            auto& dict = _dictionaries[dictionary_id];
+            dict.resize(dictionary.size());
+            copy(dictionary, cover(dict));
+            return true;
+        }
+        return false;
     }
 
     auto compress(
       memory::const_block input,
       const data_handler& handler,
-      data_compression_level level) -> bool {
-        _zsd.next_in = const_cast<byte*>(input.data());
-        _zsd.avail_in = input.size();
-        _zsd.next_out = _temp.data();
-        _zsd.avail_out = _temp.size();
+      data_compression_level level,
+      data_compression_dictionary_id dictionary_id) -> bool {
+        auto* zsd = _deflate_stream(level);
+        if(!zsd) {
+            return false;
+        }
+        if(dictionary_id != no_compression_dictionary()) {
+            const auto dict = _find_dictionary(dictionary_id);
+            if(!dict) {
+                return false;
+            }
+            if(
+              ::deflateSetDictionary(
+                zsd, dict.data(), static_cast<::uInt>(dict.size())) != Z_OK) {
+                return false;
+            }
+        }
+
+        const std::array<byte, 1> header{
+          {data_compression_header(dictionary_id)}};
+        if(!handler(view(header))) {
+            return false;
+        }
+
+        zsd->next_in = const_cast<byte*>(input.data());
+        zsd->avail_in = static_cast<::uInt>(input.size());
+        zsd->next_out = _temp.data();
+        zsd->avail_out = static_cast<::uInt>(_temp.size());
 
         auto append = [&](span_size_t size) -> bool {
             if(handler(head(view(_temp), size))) {
-                _zsd.next_out = _temp.data();
-                _zsd.avail_out = _temp.size();
+                zsd->next_out = _temp.data();
+                zsd->avail_out = static_cast<::uInt>(_temp.size());
                 return true;
             }
             return false;
         };
 
-        int zres{};
-        if((zres = ::deflateInit(&_zsd, _translate(level))) != Z_OK) {
-            return false;
-        }
-
-        while(_zsd.avail_in > 0) {
-            if((zres = ::deflate(&_zsd, Z_NO_FLUSH)) != Z_OK) {
-                if(zres != Z_STREAM_END) {
-                    return false;
-                }
+        while(true) {
+            const auto zres = ::deflate(zsd, Z_FINISH);
+            if(zres == Z_STREAM_END) {
+                break;
             }
-            if(_zsd.avail_out == 0) {
-                if(!append(span_size(_temp.size()))) {
-                    return false;
-                }
+            if((zres != Z_OK) && (zres != Z_BUF_ERROR)) {
+                return false;
             }
-        }
-
-        while(zres == Z_OK) {
-            if(_zsd.avail_out == 0) {
-                if(!append(span_size(_temp.size()))) {
-                    return false;
-                }
+            if(zsd->avail_out != 0) {
+                return false;
+            }
+            if(!append(span_size(_temp.size()))) {
+                return false;
             }
-            zres = ::deflate(&_zsd, Z_FINISH);
-        }
-
-        if((zres != Z_OK) && (zres != Z_STREAM_END)) {
-            return false;
-        }
-
-        if(!append(span_size(_temp.size() - _zsd.avail_out))) {
-            return false;
         }
-        ::deflateEnd(&_zsd);
 
-        return true;
+        return append(span_size(_temp.size() - zsd->avail_out));
     }
 
     auto compress(
       memory::const_block input,
       memory::buffer& output,
-      data_compression_level level) -> memory::const_block {
+      data_compression_level level,
+      data_compression_dictionary_id dictionary_id) -> memory::const_block {
         auto append = [&](memory::const_block blk) {
             const auto sk = output.size();
             output.enlarge_by(blk.size());
@@ -120,18 +243,22 @@ public:
             return true;
         };
 
-        output.resize(1);
-        cover(output).front() = 0x01U;
-
-        if(compress(input, data_handler(construct_from, append), level)) {
+        output.clear();
+        if(compress(
+             input,
+             data_handler(construct_from, append),
+             level,
+             dictionary_id)) {
             return view(output);
         }
         return {};
     }
 
-    auto compress(memory::const_block input, data_compression_level level)
-      -> memory::const_block {
-        return compress(input, _buff, level);
+    auto compress(
+      memory::const_block input,
+      data_compression_level level,
+      data_compression_dictionary_id dictionary_id) -> memory::const_block {
+        return compress(input, _buff, level, dictionary_id);
     }
 
     auto decompress(memory::const_block input, const data_handler& handler)
@@ -139,63 +266,67 @@ public:
         if(!input) {
             return false;
         }
-        if(input.front() != 0x01U) {
-            return false;
+        const auto header = input.front();
+        input = skip(input, 1);
+        if(header == 0x00U) {
+            return handler(input);
         }
+        if(header == stored_chunks_compression_header()) {
+            return data_compression_unpack_chunks(input, handler);
+        }
+        const auto dictionary_id = (header == 0x01U)
+                                     ? no_compression_dictionary()
+                                     : data_compression_dictionary_id(header);
 
-        input = skip(input, 1);
+        auto* zsi = _inflate_stream();
+        if(!zsi) {
+            return false;
+        }
 
-        _zsi.next_in = const_cast<byte*>(input.data());
-        _zsi.avail_in = input.size();
-        _zsi.next_out = _temp.data();
-        _zsi.avail_out = _temp.size();
+        zsi->next_in = const_cast<byte*>(input.data());
+        zsi->avail_in = static_cast<::uInt>(input.size());
+        zsi->next_out = _temp.data();
+        zsi->avail_out = static_cast<::uInt>(_temp.size());
 
         auto append = [&](span_size_t size) -> bool {
             if(handler(head(view(_temp), size))) {
-                _zsi.next_out = _temp.data();
-                _zsi.avail_out = _temp.size();
+                zsi->next_out = _temp.data();
+                zsi->avail_out = static_cast<::uInt>(_temp.size());
                 return true;
             }
             return false;
         };
 
-        int zres{};
-        if((zres = ::inflateInit(&_zsi)) != Z_OK) {
-            return false;
-        }
-
-        while(_zsi.avail_in > 0) {
-            if((zres = ::inflate(&_zsi, Z_NO_FLUSH)) != Z_OK) {
-                if(zres != Z_STREAM_END) {
-                    return false;
-                }
+        while(true) {
+            const auto zres = ::inflate(zsi, Z_NO_FLUSH);
+            if(zres == Z_STREAM_END) {
+                break;
             }
-            if(_zsi.avail_out == 0) {
-                if(!append(span_size(_temp.size()))) {
+            if(zres == Z_NEED_DICT) {
+                const auto dict = _find_dictionary(dictionary_id);
+                if(
+                  !dict ||
+                  (::inflateSetDictionary(
+                     zsi, dict.data(), static_cast<::uInt>(dict.size())) !=
+                   Z_OK)) {
                     return false;
                 }
+                continue;
             }
-        }
-
-        while(zres == Z_OK) {
-            if(_zsd.avail_out == 0) {
+            if((zres != Z_OK) && (zres != Z_BUF_ERROR)) {
+                return false;
+            }
+            if(zsi->avail_out == 0) {
                 if(!append(span_size(_temp.size()))) {
                     return false;
                 }
+            } else if(zsi->avail_in == 0) {
+                // truncated input
+                return false;
             }
-            zres = ::inflate(&_zsd, Z_FINISH);
         }
 
-        if((zres != Z_OK) && (zres != Z_STREAM_END)) {
-            return false;
-        }
-
-        if(!append(span_size(_temp.size() - _zsi.avail_out))) {
-            return false;
-        }
-        ::inflateEnd(&_zsi);
-
-        return true;
+        return append(span_size(_temp.size() - zsi->avail_out));
     }
 
     auto decompress(memory::const_block input, memory::buffer& output)
@@ -204,8 +335,6 @@ public:
             const auto sk = output.size();
             output.enlarge_by(blk.size());
             copy(blk, skip(cover(output), sk));
-            _zsi.next_out = _temp.data();
-            _zsi.avail_out = _temp.size();
             return true;
         };
         output.clear();
@@ -228,46 +357,74 @@ class data_compressor_impl {
 public:
     using data_handler = callable_ref<bool(memory::const_block)>;
 
-    auto
-    compress(memory::const_block, const data_handler&, data_compression_level)
+    auto add_dictionary(data_compression_dictionary_id, memory::const_block)
       -> bool {
         return false;
     }
 
+    auto compress(
+      memory::const_block,
+      const data_handler&,
+      data_compression_level,
+      data_compression_dictionary_id) -> bool {
+        return false;
+    }
+
     auto compress(
       memory::const_block input,
       memory::buffer& output,
-      data_compression_level level) -> memory::const_block {
+      data_compression_level,
+      data_compression_dictionary_id) -> memory::const_block {
         output.resize(input.size() + 1);
         copy(input, skip(cover(output), 1));
         cover(output).front() = 0x00U;
         return view(output);
     }
 
-    auto compress(memory::const_block block, data_compression_level level)
-      -> memory::const_block {
-        return compress(block, _buff, level);
+    auto compress(
+      memory::const_block block,
+      data_compression_level level,
+      data_compression_dictionary_id dictionary_id) -> memory::const_block {
+        return compress(block, _buff, level, dictionary_id);
     }
 
-    auto decompress(memory::const_block, const data_handler&) -> bool {
+    auto decompress(memory::const_block input, const data_handler& handler)
+      -> bool {
+        if(input && (input.front() == 0x00U)) {
+            return handler(skip(input, 1));
+        }
+        if(input && (input.front() == stored_chunks_compression_header())) {
+            return data_compression_unpack_chunks(skip(input, 1), handler);
+        }
         return false;
     }
 
-    auto decompress(memory::const_block input, memory::buffer& output) const
+    auto decompress(memory::const_block input, memory::buffer& output)
       -> memory::const_block {
         if(input.front() == 0x00U) {
             output.resize(input.size() - 1);
             copy(skip(input, 1), cover(output));
             return view(output);
         }
+        auto append = [&](memory::const_block blk) {
+            const auto sk = output.size();
+            output.enlarge_by(blk.size());
+            copy(blk, skip(cover(output), sk));
+            return true;
+        };
+        output.clear();
+
+        if(decompress(input, data_handler(construct_from, append))) {
+            return view(output);
+        }
         return {};
     }
 
-    auto decompress(memory::const_block input) const -> memory::const_block {
+    auto decompress(memory::const_block input) -> memory::const_block {
         if(input.front() == 0x00U) {
             return skip(input, 1);
         }
-        return {};
+        return decompress(input, _buff);
     }
 
 private:
@@ -284,21 +441,103 @@ data_compressor::data_compressor()
   : _pimpl{make_data_compressor_impl()} {}
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+auto data_compressor::make_dictionary(
+  span<const memory::const_block> samples,
+  span_size_t max_size) -> memory::buffer {
+    // length of the sequences counted in the samples
+    const std::size_t k{8U};
+
+    std::unordered_map<std::string_view, span_size_t> gram_counts;
+    for(const auto& sample : samples) {
+        const auto str = as_chars(sample);
+        const std::string_view sv{str.data(), std_size(str.size())};
+        for(std::size_t i = 0; i + k <= sv.size(); ++i) {
+            ++gram_counts[sv.substr(i, k)];
+        }
+    }
+
+    // merge overlapping repeated sequences into longer segments
+    std::unordered_map<std::string_view, span_size_t> segment_scores;
+    for(const auto& sample : samples) {
+        const auto str = as_chars(sample);
+        const std::string_view sv{str.data(), std_size(str.size())};
+        std::size_t i = 0;
+        while(i + k <= sv.size()) {
+            span_size_t score{0};
+            std::size_t j = i;
+            while((j + k <= sv.size()) && (gram_counts[sv.substr(j, k)] > 1)) {
+                score += gram_counts[sv.substr(j, k)];
+                ++j;
+            }
+            if(j > i) {
+                segment_scores[sv.substr(i, j - i + k - 1)] += score;
+                i = j + k - 1;
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    std::vector<std::tuple<span_size_t, std::string_view>> segments;
+    segments.reserve(segment_scores.size());
+    for(const auto& [segment, score] : segment_scores) {
+        segments.emplace_back(score, segment);
+    }
+    std::sort(segments.begin(), segments.end(), [](auto& l, auto& r) {
+        return l > r;
+    });
+
+    std::vector<std::string_view> selected;
+    std::string joined;
+    for(const auto& [score, segment] : segments) {
+        EAGINE_MAYBE_UNUSED(score);
+        if(span_size(joined.size() + segment.size()) > max_size) {
+            continue;
+        }
+        if(joined.find(segment) == std::string::npos) {
+            joined.append(segment);
+            selected.push_back(segment);
+        }
+    }
+
+    // zlib finds the matches at the end of the dictionary more cheaply
+    memory::buffer result;
+    result.resize(span_size(joined.size()));
+    auto dest = cover(result);
+    for(auto pos = selected.rbegin(); pos != selected.rend(); ++pos) {
+        const auto src = as_bytes(string_view(*pos));
+        copy(src, dest);
+        dest = skip(dest, src.size());
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compressor::add_dictionary(
+  data_compression_dictionary_id dictionary_id,
+  memory::const_block dictionary) -> bool {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->add_dictionary(dictionary_id, dictionary);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto data_compressor::compress(
   memory::const_block input,
   const data_handler& handler,
-  data_compression_level level) -> bool {
+  data_compression_level level,
+  data_compression_dictionary_id dictionary_id) -> bool {
     EAGINE_ASSERT(_pimpl);
-    return _pimpl->compress(input, handler, level);
+    return _pimpl->compress(input, handler, level, dictionary_id);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
 auto data_compressor::compress(
   memory::const_block input,
   memory::buffer& output,
-  data_compression_level level) -> memory::const_block {
+  data_compression_level level,
+  data_compression_dictionary_id dictionary_id) -> memory::const_block {
     EAGINE_ASSERT(_pimpl);
-    if(auto result{_pimpl->compress(input, output, level)}) {
+    if(auto result{_pimpl->compress(input, output, level, dictionary_id)}) {
         return result;
     }
     output.resize(input.size() + 1);
@@ -310,9 +549,10 @@ auto data_compressor::compress(
 EAGINE_LIB_FUNC
 auto data_compressor::compress(
   memory::const_block input,
-  data_compression_level level) -> memory::const_block {
+  data_compression_level level,
+  data_compression_dictionary_id dictionary_id) -> memory::const_block {
     EAGINE_ASSERT(_pimpl);
-    if(auto result{_pimpl->compress(input, level)}) {
+    if(auto result{_pimpl->compress(input, level, dictionary_id)}) {
         return result;
     }
     return {};
@@ -0,0 +1,706 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#include <eagine/math/functions.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/span.hpp>
+#include <array>
+#include <limits>
+#if EAGINE_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace eagine {
+//------------------------------------------------------------------------------
+// unpacks the data stored in size-prefixed chunks, the chunks and their
+// sizes may be split between the pushed blocks arbitrarily
+class data_decompress_chunks {
+private:
+    std::uint32_t _chunk_size{0U};
+    unsigned _size_bytes{0U};
+    bool _finished{false};
+
+public:
+    auto push(
+      memory::const_block input,
+      const data_decompress_stream::data_handler& handler,
+      span_size_t& output_size) -> bool {
+        while(!input.empty()) {
+            if(_finished) {
+                // trailing data after the terminating empty chunk
+                return false;
+            }
+            if(_size_bytes < 4U) {
+                _chunk_size |= std::uint32_t(input.front())
+                               << (8U * _size_bytes);
+                input = skip(input, 1);
+                if(++_size_bytes == 4U) {
+                    _finished = _chunk_size == 0U;
+                }
+            } else {
+                const auto piece = head(input, span_size(_chunk_size));
+                input = skip(input, piece.size());
+                _chunk_size -= static_cast<std::uint32_t>(piece.size());
+                output_size += piece.size();
+                if(!handler(piece)) {
+                    return false;
+                }
+                if(_chunk_size == 0U) {
+                    _size_bytes = 0U;
+                }
+            }
+        }
+        return true;
+    }
+
+    auto is_finished() const noexcept -> bool {
+        return _finished;
+    }
+
+    void reset() noexcept {
+        _chunk_size = 0U;
+        _size_bytes = 0U;
+        _finished = false;
+    }
+};
+//------------------------------------------------------------------------------
+#if EAGINE_USE_ZLIB
+class data_compress_stream_impl {
+private:
+    ::z_stream _zsd{};
+    std::array<byte, 16 * 1024> _temp{};
+    span_size_t _input_size{0};
+    span_size_t _output_size{0};
+    int _level{Z_DEFAULT_COMPRESSION};
+    bool _initialized{false};
+    bool _header_done{false};
+    bool _finished{false};
+
+    static constexpr auto _translate(data_compression_level level) noexcept
+      -> int {
+        switch(level) {
+            case data_compression_level::none:
+                return 0;
+            case data_compression_level::lowest:
+                return 1;
+            case data_compression_level::normal:
+                break;
+            case data_compression_level::highest:
+                return 9;
+        }
+        return Z_DEFAULT_COMPRESSION;
+    }
+
+    auto _emit(
+      memory::const_block blk,
+      const data_compress_stream::data_handler& handler) -> bool {
+        _output_size += blk.size();
+        return handler(blk);
+    }
+
+    auto _deflate(
+      memory::const_block input,
+      int flush,
+      const data_compress_stream::data_handler& handler) -> bool {
+        if(EAGINE_UNLIKELY(_finished || !_initialized)) {
+            return false;
+        }
+        if(!_header_done) {
+            const std::array<byte, 1> header{{0x01U}};
+            if(!_emit(view(header), handler)) {
+                return false;
+            }
+            _header_done = true;
+        }
+        _input_size += input.size();
+
+        // avail_in is limited, split huge blocks into several steps
+        const auto max_step = span_size(std::numeric_limits<::uInt>::max() / 2);
+        do {
+            const auto step = head(input, max_step);
+            input = skip(input, step.size());
+            const auto step_flush = input.empty() ? flush : Z_NO_FLUSH;
+
+            _zsd.next_in = const_cast<byte*>(step.data());
+            _zsd.avail_in = static_cast<::uInt>(step.size());
+            int zres = Z_OK;
+            do {
+                _zsd.next_out = _temp.data();
+                _zsd.avail_out = static_cast<::uInt>(_temp.size());
+                zres = ::deflate(&_zsd, step_flush);
+                if(zres == Z_STREAM_ERROR) {
+                    return false;
+                }
+                const auto produced = span_size(_temp.size() - _zsd.avail_out);
+                if(produced > 0) {
+                    if(!_emit(head(view(_temp), produced), handler)) {
+                        return false;
+                    }
+                }
+            } while(_zsd.avail_out == 0);
+
+            if(step_flush == Z_FINISH) {
+                if(zres != Z_STREAM_END) {
+                    return false;
+                }
+                _finished = true;
+            }
+        } while(!input.empty());
+        return true;
+    }
+
+public:
+    data_compress_stream_impl(data_compression_level level) noexcept
+      : _level{_translate(level)} {
+        _initialized = ::deflateInit(&_zsd, _level) == Z_OK;
+    }
+
+    data_compress_stream_impl(data_compress_stream_impl&&) = delete;
+    data_compress_stream_impl(const data_compress_stream_impl&) = delete;
+    auto operator=(data_compress_stream_impl&&) = delete;
+    auto operator=(const data_compress_stream_impl&) = delete;
+
+    ~data_compress_stream_impl() noexcept {
+        if(_initialized) {
+            ::deflateEnd(&_zsd);
+        }
+    }
+
+    auto push(
+      memory::const_block input,
+      const data_compress_stream::data_handler& handler) -> bool {
+        return input.empty() || _deflate(input, Z_NO_FLUSH, handler);
+    }
+
+    auto flush(const data_compress_stream::data_handler& handler) -> bool {
+        return _deflate({}, Z_SYNC_FLUSH, handler);
+    }
+
+    auto finish(const data_compress_stream::data_handler& handler) -> bool {
+        return _finished || _deflate({}, Z_FINISH, handler);
+    }
+
+    auto is_finished() const noexcept -> bool {
+        return _finished;
+    }
+
+    void reset() {
+        if(_initialized) {
+            _initialized = ::deflateReset(&_zsd) == Z_OK;
+        } else {
+            _initialized = ::deflateInit(&_zsd, _level) == Z_OK;
+        }
+        _input_size = 0;
+        _output_size = 0;
+        _header_done = false;
+        _finished = false;
+    }
+
+    auto input_size() const noexcept {
+        return _input_size;
+    }
+
+    auto output_size() const noexcept {
+        return _output_size;
+    }
+};
+//------------------------------------------------------------------------------
+class data_decompress_stream_impl {
+private:
+    ::z_stream _zsi{};
+    std::array<byte, 16 * 1024> _temp{};
+    data_decompress_chunks _chunks{};
+    span_size_t _input_size{0};
+    span_size_t _output_size{0};
+    bool _initialized{false};
+    bool _header_done{false};
+    bool _stored{false};
+    bool _chunked{false};
+    bool _finished{false};
+
+public:
+    data_decompress_stream_impl() noexcept {
+        _initialized = ::inflateInit(&_zsi) == Z_OK;
+    }
+
+    data_decompress_stream_impl(data_decompress_stream_impl&&) = delete;
+    data_decompress_stream_impl(const data_decompress_stream_impl&) = delete;
+    auto operator=(data_decompress_stream_impl&&) = delete;
+    auto operator=(const data_decompress_stream_impl&) = delete;
+
+    ~data_decompress_stream_impl() noexcept {
+        if(_initialized) {
+            ::inflateEnd(&_zsi);
+        }
+    }
+
+    auto push(
+      memory::const_block input,
+      const data_decompress_stream::data_handler& handler) -> bool {
+        if(input.empty()) {
+            return true;
+        }
+        _input_size += input.size();
+        if(!_header_done) {
+            const auto header = input.front();
+            input = skip(input, 1);
+            _header_done = true;
+            if(header == 0x00U) {
+                _stored = true;
+            } else if(header == stored_chunks_compression_header()) {
+                _chunked = true;
+            } else if(header != 0x01U) {
+                // preset dictionaries are not supported
+                return false;
+            }
+        }
+        if(_stored) {
+            _output_size += input.size();
+            return handler(input);
+        }
+        if(_chunked) {
+            return _chunks.push(input, handler, _output_size);
+        }
+        if(EAGINE_UNLIKELY(!_initialized)) {
+            return false;
+        }
+
+        const auto max_step = span_size(std::numeric_limits<::uInt>::max() / 2);
+        while(!input.empty()) {
+            if(_finished) {
+                // trailing data after the end of the compressed stream
+                return false;
+            }
+            const auto step = head(input, max_step);
+            input = skip(input, step.size());
+
+            _zsi.next_in = const_cast<byte*>(step.data());
+            _zsi.avail_in = static_cast<::uInt>(step.size());
+            do {
+                _zsi.next_out = _temp.data();
+                _zsi.avail_out = static_cast<::uInt>(_temp.size());
+                const auto zres = ::inflate(&_zsi, Z_NO_FLUSH);
+                if(
+                  (zres != Z_OK) && (zres != Z_STREAM_END) &&
+                  (zres != Z_BUF_ERROR)) {
+                    return false;
+                }
+                const auto produced = span_size(_temp.size() - _zsi.avail_out);
+                if(produced > 0) {
+                    _output_size += produced;
+                    if(!handler(head(view(_temp), produced))) {
+                        return false;
+                    }
+                }
+                if(zres == Z_STREAM_END) {
+                    _finished = true;
+                    if(_zsi.avail_in > 0) {
+                        return false;
+                    }
+                    break;
+                }
+            } while(_zsi.avail_out == 0);
+        }
+        return true;
+    }
+
+    auto is_finished() const noexcept -> bool {
+        return _finished || _chunks.is_finished();
+    }
+
+    void reset() {
+        if(_initialized) {
+            _initialized = ::inflateReset(&_zsi) == Z_OK;
+        } else {
+            _initialized = ::inflateInit(&_zsi) == Z_OK;
+        }
+        _chunks.reset();
+        _input_size = 0;
+        _output_size = 0;
+        _header_done = false;
+        _stored = false;
+        _chunked = false;
+        _finished = false;
+    }
+
+    auto input_size() const noexcept {
+        return _input_size;
+    }
+
+    auto output_size() const noexcept {
+        return _output_size;
+    }
+};
+#else
+class data_compress_stream_impl {
+private:
+    span_size_t _input_size{0};
+    span_size_t _output_size{0};
+    bool _header_done{false};
+    bool _finished{false};
+
+    auto _header(const data_compress_stream::data_handler& handler) -> bool {
+        if(!_header_done) {
+            const std::array<byte, 1> header{
+              {stored_chunks_compression_header()}};
+            _header_done = true;
+            _output_size += 1;
+            return handler(view(header));
+        }
+        return true;
+    }
+
+    // the size of the chunk is stored, so that the receiver can detect
+    // the end of the data marked by an empty chunk
+    auto _chunk(
+      memory::const_block input,
+      const data_compress_stream::data_handler& handler) -> bool {
+        const auto size = static_cast<std::uint32_t>(input.size());
+        const std::array<byte, 4> prefix{
+          {byte(size), byte(size >> 8U), byte(size >> 16U), byte(size >> 24U)}};
+        _output_size += span_size(prefix.size()) + input.size();
+        return handler(view(prefix)) && (input.empty() || handler(input));
+    }
+
+public:
+    data_compress_stream_impl(data_compression_level) noexcept {}
+
+    auto push(
+      memory::const_block input,
+      const data_compress_stream::data_handler& handler) -> bool {
+        if(EAGINE_UNLIKELY(_finished) || !_header(handler)) {
+            return false;
+        }
+        _input_size += input.size();
+
+        const auto max_step =
+          span_size(std::numeric_limits<std::uint32_t>::max());
+        while(!input.empty()) {
+            const auto step = head(input, max_step);
+            input = skip(input, step.size());
+            if(!_chunk(step, handler)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto flush(const data_compress_stream::data_handler& handler) -> bool {
+        return !_finished && _header(handler);
+    }
+
+    auto finish(const data_compress_stream::data_handler& handler) -> bool {
+        _finished = _header(handler) && _chunk({}, handler);
+        return _finished;
+    }
+
+    auto is_finished() const noexcept -> bool {
+        return _finished;
+    }
+
+    void reset() {
+        _input_size = 0;
+        _output_size = 0;
+        _header_done = false;
+        _finished = false;
+    }
+
+    auto input_size() const noexcept {
+        return _input_size;
+    }
+
+    auto output_size() const noexcept {
+        return _output_size;
+    }
+};
+//------------------------------------------------------------------------------
+class data_decompress_stream_impl {
+private:
+    data_decompress_chunks _chunks{};
+    span_size_t _input_size{0};
+    span_size_t _output_size{0};
+    bool _header_done{false};
+    bool _chunked{false};
+
+public:
+    auto push(
+      memory::const_block input,
+      const data_decompress_stream::data_handler& handler) -> bool {
+        if(input.empty()) {
+            return true;
+        }
+        _input_size += input.size();
+        if(!_header_done) {
+            const auto header = input.front();
+            if(header == stored_chunks_compression_header()) {
+                _chunked = true;
+            } else if(header != 0x00U) {
+                return false;
+            }
+            input = skip(input, 1);
+            _header_done = true;
+        }
+        if(_chunked) {
+            return _chunks.push(input, handler, _output_size);
+        }
+        _output_size += input.size();
+        return handler(input);
+    }
+
+    auto is_finished() const noexcept -> bool {
+        return _chunks.is_finished();
+    }
+
+    void reset() {
+        _chunks.reset();
+        _input_size = 0;
+        _output_size = 0;
+        _header_done = false;
+        _chunked = false;
+    }
+
+    auto input_size() const noexcept {
+        return _input_size;
+    }
+
+    auto output_size() const noexcept {
+        return _output_size;
+    }
+};
+#endif
+//------------------------------------------------------------------------------
+// data_compress_stream
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_compress_stream::data_compress_stream(data_compression_level level)
+  : _pimpl{std::make_unique<data_compress_stream_impl>(level)} {}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_compress_stream::data_compress_stream(data_compress_stream&&) noexcept =
+  default;
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::operator=(data_compress_stream&&) noexcept
+  -> data_compress_stream& = default;
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_compress_stream::~data_compress_stream() noexcept = default;
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::push(
+  memory::const_block input,
+  const data_handler& handler) -> bool {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->push(input, handler);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::flush(const data_handler& handler) -> bool {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->flush(handler);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::finish(const data_handler& handler) -> bool {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->finish(handler);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::is_finished() const noexcept -> bool {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->is_finished();
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::reset() -> data_compress_stream& {
+    EAGINE_ASSERT(_pimpl);
+    _pimpl->reset();
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::input_size() const noexcept -> span_size_t {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->input_size();
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_stream::output_size() const noexcept -> span_size_t {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->output_size();
+}
+//------------------------------------------------------------------------------
+// data_decompress_stream
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_decompress_stream::data_decompress_stream()
+  : _pimpl{std::make_unique<data_decompress_stream_impl>()} {}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_decompress_stream::data_decompress_stream(
+  data_decompress_stream&&) noexcept = default;
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_decompress_stream::operator=(data_decompress_stream&&) noexcept
+  -> data_decompress_stream& = default;
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_decompress_stream::~data_decompress_stream() noexcept = default;
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_decompress_stream::push(
+  memory::const_block input,
+  const data_handler& handler) -> bool {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->push(input, handler);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_decompress_stream::is_finished() const noexcept -> bool {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->is_finished();
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_decompress_stream::reset() -> data_decompress_stream& {
+    EAGINE_ASSERT(_pimpl);
+    _pimpl->reset();
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_decompress_stream::input_size() const noexcept -> span_size_t {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->input_size();
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_decompress_stream::output_size() const noexcept -> span_size_t {
+    EAGINE_ASSERT(_pimpl);
+    return _pimpl->output_size();
+}
+//------------------------------------------------------------------------------
+// data_compress_streambuf
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_compress_streambuf::data_compress_streambuf(
+  std::ostream& output,
+  data_compression_level level,
+  span_size_t buffer_size)
+  : _output{output}
+  , _stream{level}
+  , _buffer(std_size(math::maximum(buffer_size, span_size(1)))) {
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_compress_streambuf::~data_compress_streambuf() noexcept {
+    try {
+        finish();
+    } catch(...) {
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_streambuf::_pack_buffered() -> bool {
+    const auto write = [this](memory::const_block blk) {
+        return write_to_stream(_output, blk).good();
+    };
+    const auto buffered = as_bytes(memory::view(pbase(), pptr() - pbase()));
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    return _stream.push(
+      buffered, data_compress_stream::data_handler(construct_from, write));
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_streambuf::finish() -> bool {
+    if(_stream.is_finished()) {
+        return true;
+    }
+    const auto write = [this](memory::const_block blk) {
+        return write_to_stream(_output, blk).good();
+    };
+    return _pack_buffered() &&
+           _stream.finish(
+             data_compress_stream::data_handler(construct_from, write)) &&
+           _output.flush().good();
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_streambuf::overflow(int_type c) -> int_type {
+    if(_stream.is_finished() || !_pack_buffered()) {
+        return traits_type::eof();
+    }
+    if(!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_compress_streambuf::sync() -> int {
+    if(_stream.is_finished()) {
+        return 0;
+    }
+    const auto write = [this](memory::const_block blk) {
+        return write_to_stream(_output, blk).good();
+    };
+    if(
+      _pack_buffered() &&
+      _stream.flush(
+        data_compress_stream::data_handler(construct_from, write)) &&
+      _output.flush().good()) {
+        return 0;
+    }
+    return -1;
+}
+//------------------------------------------------------------------------------
+// data_decompress_streambuf
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+data_decompress_streambuf::data_decompress_streambuf(
+  std::istream& input,
+  span_size_t buffer_size)
+  : _input{input}
+  , _packed(std_size(math::maximum(buffer_size, span_size(1)))) {
+    setg(_unpacked.data(), _unpacked.data(), _unpacked.data());
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto data_decompress_streambuf::underflow() -> int_type {
+    if(gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    const auto append = [this](memory::const_block blk) {
+        const auto src = as_chars(blk);
+        _unpacked.insert(_unpacked.end(), src.begin(), src.end());
+        return true;
+    };
+    _unpacked.clear();
+    // read until some data is unpacked, the input may contain only headers
+    while(_unpacked.empty() && !_failed && !_stream.is_finished()) {
+        _input.read(_packed.data(), std::streamsize(_packed.size()));
+        const auto count = span_size(_input.gcount());
+        if(count <= 0) {
+            break;
+        }
+        _failed = !_stream.push(
+          head(as_bytes(view(_packed)), count),
+          data_decompress_stream::data_handler(construct_from, append));
+    }
+    auto* const begin = _unpacked.data();
+    setg(begin, begin, begin + _unpacked.size());
+    if(_unpacked.empty()) {
+        return traits_type::eof();
+    }
+    return traits_type::to_int_type(*gptr());
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
@@ -8,6 +8,14 @@
 #include <eagine/config/platform.hpp>
 #include <eagine/input_data.hpp>
 
+#if EAGINE_POSIX
+#include <eagine/scope_exit.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace eagine {
 //------------------------------------------------------------------------------
 class buffered_file_contents : public file_contents_intf {
@@ -33,10 +41,56 @@ inline auto make_file_contents_impl(string_view path)
     }
 }
 //------------------------------------------------------------------------------
+#if EAGINE_POSIX
+class mapped_file_contents : public file_contents_intf {
+private:
+    void* _addr{nullptr};
+    span_size_t _size{0};
+
+public:
+    mapped_file_contents(void* addr, span_size_t size) noexcept
+      : _addr{addr}
+      , _size{size} {}
+
+    ~mapped_file_contents() noexcept override {
+        ::munmap(_addr, std_size(_size));
+    }
+
+    auto block() noexcept -> memory::const_block override {
+        return {static_cast<const byte*>(_addr), _size};
+    }
+};
+#endif
+//------------------------------------------------------------------------------
+inline auto make_mapped_file_contents_impl(string_view path)
+  -> std::shared_ptr<file_contents_intf> {
+#if EAGINE_POSIX
+    const int fd = ::open(c_str(path), O_RDONLY | O_CLOEXEC);
+    if(fd >= 0) {
+        auto close_fd = finally([fd] { ::close(fd); });
+        struct ::stat st {};
+        // special files (procfs, sysfs, etc.) cannot be mapped reliably
+        if((::fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+            const auto size = span_size(st.st_size);
+            void* addr =
+              ::mmap(nullptr, std_size(size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr != MAP_FAILED) {
+                return std::make_shared<mapped_file_contents>(addr, size);
+            }
+        }
+    }
+#endif
+    return make_file_contents_impl(path);
+}
+//------------------------------------------------------------------------------
 // file_contents::file_contents
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
 file_contents::file_contents(string_view path)
   : _pimpl{make_file_contents_impl(path)} {}
 //------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+file_contents::file_contents(string_view path, map_file_tag)
+  : _pimpl{make_mapped_file_contents_impl(path)} {}
+//------------------------------------------------------------------------------
 } // namespace eagine
@@ -5,6 +5,7 @@
 /// See accompanying file LICENSE_1_0.txt or copy at
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
+#include <algorithm>
 
 namespace eagine {
 //------------------------------------------------------------------------------
@@ -13,15 +14,7 @@ auto log_entry::arg(
   identifier name,
   identifier tag,
   span<const std::int64_t> values) noexcept -> log_entry& {
-
-    if(_backend) {
-        _args.add([=](logger_backend& backend) {
-            for(auto value : values) {
-                backend.add_integer(name, tag, value);
-            }
-        });
-    }
-    return *this;
+    return _add_arg(name, tag, values);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -29,14 +22,7 @@ auto log_entry::arg(
   identifier name,
   identifier tag,
   span<const std::int32_t> values) noexcept -> log_entry& {
-    if(_backend) {
-        _args.add([=](logger_backend& backend) {
-            for(auto value : values) {
-                backend.add_integer(name, tag, value);
-            }
-        });
-    }
-    return *this;
+    return _add_arg(name, tag, values);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -44,14 +30,7 @@ auto log_entry::arg(
   identifier name,
   identifier tag,
   span<const std::int16_t> values) noexcept -> log_entry& {
-    if(_backend) {
-        _args.add([=](logger_backend& backend) {
-            for(auto value : values) {
-                backend.add_integer(name, tag, value);
-            }
-        });
-    }
-    return *this;
+    return _add_arg(name, tag, values);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -59,14 +38,7 @@ auto log_entry::arg(
   identifier name,
   identifier tag,
   span<const std::uint64_t> values) noexcept -> log_entry& {
-    if(_backend) {
-        _args.add([=](logger_backend& backend) {
-            for(auto value : values) {
-                backend.add_unsigned(name, tag, value);
-            }
-        });
-    }
-    return *this;
+    return _add_arg(name, tag, values);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -74,14 +46,7 @@ auto log_entry::arg(
   identifier name,
   identifier tag,
   span<const std::uint32_t> values) noexcept -> log_entry& {
-    if(_backend) {
-        _args.add([=](logger_backend& backend) {
-            for(auto value : values) {
-                backend.add_unsigned(name, tag, value);
-            }
-        });
-    }
-    return *this;
+    return _add_arg(name, tag, values);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -89,14 +54,7 @@ auto log_entry::arg(
   identifier name,
   identifier tag,
   span<const std::uint16_t> values) noexcept -> log_entry& {
-    if(_backend) {
-        _args.add([=](logger_backend& backend) {
-            for(auto value : values) {
-                backend.add_unsigned(name, tag, value);
-            }
-        });
-    }
-    return *this;
+    return _add_arg(name, tag, values);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -104,15 +62,46 @@ auto log_entry::arg(
   identifier name,
   identifier tag,
   span<const float> values) noexcept -> log_entry& {
+    return _add_arg(name, tag, values);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_entry::arg(
+  identifier name,
+  identifier tag,
+  const std::string& value) noexcept -> log_entry& {
     if(_backend) {
-        for(auto value : values) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_float(name, tag, value);
-            });
+        const auto len{span_size(value.size())};
+        if((_arg_count < _max_args) && (_char_count + len <= _max_chars)) {
+            auto* dst{_chars.data() + _char_count};
+            std::copy(value.begin(), value.end(), dst);
+            _char_count += len;
+            return _add_arg(name, tag, string_view{dst, len});
         }
+        _add_deferred([=](logger_backend& backend) {
+            backend.add_string(name, tag, value);
+        });
     }
     return *this;
 }
-
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void log_entry::_write_args(logger_backend& backend) noexcept {
+    span_size_t deferred_index{0};
+    for(span_size_t i = 0; i < _arg_count; ++i) {
+        const auto& arg = _args[std_size(i)];
+        if(EAGINE_LIKELY(!arg.is_deferred())) {
+            arg.write_to(backend);
+        } else {
+            _deferred->call(deferred_index++, backend);
+        }
+    }
+    if(_deferred) {
+        // the arguments that did not fit into the inline records
+        while(deferred_index < _deferred->size()) {
+            _deferred->call(deferred_index++, backend);
+        }
+    }
+}
 //------------------------------------------------------------------------------
 } // namespace eagine
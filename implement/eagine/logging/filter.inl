@@ -0,0 +1,181 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/application_config.hpp>
+#include <eagine/from_string.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::_rule_index(identifier source) noexcept -> std::size_t {
+    const auto hash{source.value() * 0x9E3779B97F4A7C15U};
+    return std::size_t(hash >> 32U) % std_size(max_source_rules());
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::_find_rule(identifier source, bool insert) noexcept
+  -> _source_rule* {
+    auto index{_rule_index(source)};
+    for(span_size_t i = 0; i < max_source_rules(); ++i) {
+        auto& rule = _source_rules[index];
+        const auto slot_source{rule.source.load(std::memory_order_acquire)};
+        if(slot_source == 0U) {
+            if(insert) {
+                // only the writers holding the mutex take free slots
+                rule.source.store(source.value(), std::memory_order_release);
+                return &rule;
+            }
+            break;
+        }
+        if(slot_source == source.value()) {
+            return &rule;
+        }
+        index = (index + 1U) % _source_rules.size();
+    }
+    return nullptr;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::set_min_severity(
+  identifier source,
+  log_event_severity severity) -> log_filter& {
+    if(source) {
+        const std::lock_guard<std::mutex> lock{_rules_mutex};
+        if(auto rule{_find_rule(source, true)}) {
+            rule->severity.store(severity, std::memory_order_relaxed);
+            if(!rule->active.exchange(true, std::memory_order_release)) {
+                ++_active_rules;
+            }
+            _has_source_rules.store(true, std::memory_order_release);
+        }
+    }
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::reset_min_severity(identifier source) -> log_filter& {
+    const std::lock_guard<std::mutex> lock{_rules_mutex};
+    if(auto rule{_find_rule(source, false)}) {
+        if(rule->active.exchange(false, std::memory_order_release)) {
+            --_active_rules;
+        }
+        _has_source_rules.store(_active_rules > 0, std::memory_order_release);
+    }
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::reset_min_severities() -> log_filter& {
+    const std::lock_guard<std::mutex> lock{_rules_mutex};
+    _has_source_rules.store(false, std::memory_order_release);
+    for(auto& rule : _source_rules) {
+        rule.active.store(false, std::memory_order_release);
+    }
+    _active_rules = 0;
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::_is_enabled(
+  identifier source,
+  log_event_severity severity) noexcept -> bool {
+    if(const auto rule{_find_rule(source, false)}) {
+        if(rule->active.load(std::memory_order_acquire)) {
+            return severity >= rule->severity.load(std::memory_order_relaxed);
+        }
+    }
+    return severity >= min_severity();
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::set_rate_limit(float per_second, float burst) noexcept
+  -> log_filter& {
+    const std::lock_guard<std::mutex> lock{_buckets_mutex};
+    _rate = per_second;
+    _burst = std::max(burst, 1.F);
+    for(auto& bucket : _buckets) {
+        bucket = {};
+    }
+    _is_rate_limited.store(per_second > 0.F, std::memory_order_relaxed);
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto log_filter::_throttle(identifier source, const void* call_site) noexcept
+  -> std::tuple<bool, span_size_t> {
+    const auto now{_clock::now()};
+    const auto site{reinterpret_cast<std::uintptr_t>(call_site)};
+    const auto index{((site >> 4U) ^ (site >> 12U) ^ source.value()) %
+                     _buckets.size()};
+
+    const std::lock_guard<std::mutex> lock{_buckets_mutex};
+    auto& bucket = _buckets[index];
+    if((bucket.call_site != call_site) || (bucket.source != source)) {
+        bucket.call_site = call_site;
+        bucket.source = source;
+        bucket.refilled = now;
+        bucket.tokens = _burst;
+        bucket.suppressed = 0;
+    } else {
+        const std::chrono::duration<float> elapsed{now - bucket.refilled};
+        bucket.tokens =
+          std::min(bucket.tokens + elapsed.count() * _rate, _burst);
+        bucket.refilled = now;
+    }
+
+    if(bucket.tokens >= 1.F) {
+        bucket.tokens -= 1.F;
+        const auto suppressed{bucket.suppressed};
+        bucket.suppressed = 0;
+        return {true, suppressed};
+    }
+    ++bucket.suppressed;
+    _suppressed_count.fetch_add(1, std::memory_order_relaxed);
+    return {false, bucket.suppressed};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void log_filter::configure(application_config& config) {
+    log_event_severity severity{min_severity()};
+    if(config.fetch("log.severity", severity)) {
+        set_min_severity(severity);
+    }
+
+    std::vector<std::string> rules;
+    if(config.fetch("log.source_severity", rules)) {
+        for(auto& rule : rules) {
+            const auto sep{std::find(rule.begin(), rule.end(), ':')};
+            const auto source_len{span_size(std::distance(rule.begin(), sep))};
+            if(
+              (sep != rule.end()) && (source_len > 0) &&
+              (source_len <= span_size(identifier::max_size()))) {
+                const string_view source_str{rule.data(), source_len};
+                const string_view severity_str{
+                  skip(string_view(rule), source_len + 1)};
+                if(const auto opt_sev{
+                     from_string<log_event_severity>(severity_str)}) {
+                    set_min_severity(
+                      identifier(source_str), extract(opt_sev));
+                }
+            }
+        }
+    }
+
+    float per_second{0.F};
+    float burst{1.F};
+    if(config.fetch("log.rate_limit.per_second", per_second)) {
+        config.fetch("log.rate_limit.burst", burst);
+        set_rate_limit(per_second, burst);
+    }
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
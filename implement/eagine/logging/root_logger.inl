@@ -9,6 +9,7 @@
 #include <eagine/environment.hpp>
 #include <eagine/git_info.hpp>
 #include <eagine/logging/asio_backend.hpp>
+#include <eagine/logging/filtering_backend.hpp>
 #include <eagine/logging/null_backend.hpp>
 #include <eagine/logging/ostream_backend.hpp>
 #include <eagine/logging/proxy_backend.hpp>
@@ -84,9 +85,11 @@ auto root_logger::_init_backend(
         }
     }
 
-    auto backend = root_logger_choose_backend(args, opts, min_severity);
-
-    return backend;
+    // the chosen backend accepts all entries enabled at compile-time,
+    // the filter decides at run-time, possibly per log source
+    return std::make_unique<filtering_log_backend>(
+      root_logger_choose_backend(args, opts, min_log_severity_t::value),
+      min_severity);
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -31,6 +31,7 @@ main_ctx::main_ctx(main_ctx_getters& src) noexcept
   , _msg_bus{src.bus()}
   , _scratch_space{src.scratch_space()}
   , _compressor{src.compressor()}
+  , _workers{src.workers()}
   , _exe_path{src.exe_path()}
   , _app_name{src.app_name()} {
     EAGINE_ASSERT(!_single_ptr());
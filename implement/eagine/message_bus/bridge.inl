@@ -80,6 +80,14 @@ public:
         _outgoing.back().push(msg_id, message);
     }
 
+    void set_wakeup(const shared_wakeup_event& event) {
+        std::unique_lock lock{_input_mutex};
+        _wakeup = event;
+        if(event && !_incoming.back().empty()) {
+            event->notify();
+        }
+    }
+
     void notify_output_ready() {
         _output_ready.notify_one();
     }
@@ -169,6 +177,9 @@ public:
 
                 std::unique_lock lock{_input_mutex};
                 _incoming.back().push({class_id, method_id}, _recv_dest);
+                if(_wakeup) {
+                    _wakeup->notify();
+                }
             }
             _source.pop(extract(pos) + 1);
         } else {
@@ -193,6 +204,7 @@ private:
     memory::buffer _buffer{};
     double_buffer<message_storage> _outgoing{};
     double_buffer<message_storage> _incoming{};
+    shared_wakeup_event _wakeup{};
     stored_message _recv_dest{};
     span_size_t _forwarded_messages{0};
     span_size_t _dropped_messages{0};
@@ -569,6 +581,37 @@ auto bridge::update() -> work_done {
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+void bridge::prepare_wait(const shared_wakeup_event& event) {
+    EAGINE_ASSERT(event);
+    if(EAGINE_LIKELY(_connection)) {
+        _connection->prepare_wait(event);
+    }
+    if(_state) {
+        _state->set_wakeup(event);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto bridge::next_deadline() const noexcept
+  -> std::chrono::steady_clock::time_point {
+    // the bridge is done when the no-connection timeout expires
+    auto result{_no_connection_timeout.deadline()};
+    if(_connection && !has_id()) {
+        result = std::min(result, _no_id_timeout.deadline());
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto bridge::wait_for(std::chrono::milliseconds max_time) -> bool {
+    if(EAGINE_UNLIKELY(!_wakeup)) {
+        _wakeup = std::make_shared<wakeup_event>();
+    }
+    prepare_wait(_wakeup);
+    return _wakeup->wait_for(max_time, next_deadline());
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto bridge::is_done() const noexcept -> bool {
     return no_connection_timeout() || !_recoverable_state();
 }
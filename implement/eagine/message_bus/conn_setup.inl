@@ -12,6 +12,7 @@
 #include <eagine/message_bus/direct.hpp>
 #if EAGINE_POSIX
 #include <eagine/message_bus/posix_mqueue.hpp>
+#include <eagine/message_bus/posix_shmem.hpp>
 #endif
 
 namespace eagine::msgbus {
@@ -158,6 +159,9 @@ void connection_setup_configure(
     if(config.is_set("msg_bus.posix_mqueue")) {
         setup.make_factory<posix_mqueue_connection_factory>();
     }
+    if(config.is_set("msg_bus.posix_shmem")) {
+        setup.make_factory<posix_shmem_connection_factory>();
+    }
 #endif
     if(config.is_set("msg_bus.direct")) {
         setup.make_factory<direct_connection_factory>();
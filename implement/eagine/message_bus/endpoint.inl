@@ -460,6 +460,37 @@ auto endpoint::update() -> work_done {
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+void endpoint::prepare_wait(const shared_wakeup_event& event) {
+    EAGINE_ASSERT(event);
+    if(EAGINE_LIKELY(_connection)) {
+        _connection->prepare_wait(event);
+    }
+    if(EAGINE_UNLIKELY(
+         (has_id() && !_outgoing.empty()) || _blobs.has_outgoing())) {
+        event->notify();
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto endpoint::next_deadline() const noexcept
+  -> std::chrono::steady_clock::time_point {
+    auto result{_should_notify_alive.deadline()};
+    if(_connection && !has_id()) {
+        result = std::min(result, _no_id_timeout.deadline());
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto endpoint::wait_for(std::chrono::milliseconds max_time) -> bool {
+    if(EAGINE_UNLIKELY(!_wakeup)) {
+        _wakeup = std::make_shared<wakeup_event>();
+    }
+    prepare_wait(_wakeup);
+    return _wakeup->wait_for(max_time, next_deadline());
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 void endpoint::subscribe(message_id msg_id) {
     auto& state = _ensure_incoming(msg_id);
     if(!state.subscription_count) {
@@ -493,6 +524,7 @@ auto endpoint::say_still_alive() -> bool {
     log_trace("saying still alive");
     message_view msg{};
     msg.set_sequence_no(_instance_id);
+    msg.set_latest_wins();
     return post(EAGINE_MSGBUS_ID(stillAlive), msg);
 }
 //------------------------------------------------------------------------------
@@ -114,10 +114,36 @@ void message_storage::cleanup(cleanup_predicate predicate) {
 // serialized_message_storage
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+auto serialized_message_storage::push_or_replace(
+  memory::const_block message,
+  const replace_key& key) -> bool {
+    EAGINE_ASSERT(!message.empty());
+    const auto pos = std::find_if(
+      _messages.rbegin(), _messages.rend(), [&key](const auto& entry) {
+          return !std::get<3>(entry) && (std::get<2>(entry) == key);
+      });
+    auto buf = _buffers.get(message.size());
+    memory::copy_into(message, buf);
+    if(pos != _messages.rend()) {
+        auto& [old_buf, timestamp, old_key, is_packed] = *pos;
+        EAGINE_MAYBE_UNUSED(old_key);
+        EAGINE_MAYBE_UNUSED(is_packed);
+        _buffers.eat(std::move(old_buf));
+        old_buf = std::move(buf);
+        timestamp = _clock_t::now();
+        return true;
+    }
+    _messages.emplace_back(std::move(buf), _clock_t::now(), key, false);
+    return false;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto serialized_message_storage::fetch_all(fetch_handler handler) -> bool {
     bool fetched_some = false;
     bool keep_some = false;
-    for(auto& [message, timestamp] : _messages) {
+    for(auto& [message, timestamp, key, is_packed] : _messages) {
+        EAGINE_MAYBE_UNUSED(key);
+        EAGINE_MAYBE_UNUSED(is_packed);
         if(handler(timestamp, view(message))) {
             _buffers.eat(std::move(message));
             fetched_some = true;
@@ -182,13 +208,16 @@ auto serialized_message_storage::pack_into(memory::block dest)
   -> message_pack_info {
     message_packing_context packing{dest};
 
-    for(auto& [message, timestamp] : _messages) {
+    for(auto& [message, timestamp, key, is_packed] : _messages) {
         EAGINE_MAYBE_UNUSED(timestamp);
+        EAGINE_MAYBE_UNUSED(key);
         if(packing.is_full()) {
             break;
         }
+        is_packed = false;
         if(auto packed{store_data_with_size(view(message), packing.dest())}) {
             packing.add(packed.size());
+            is_packed = true;
         }
         packing.next();
     }
@@ -231,9 +260,20 @@ auto connection_outgoing_messages::enqueue(
     default_serializer_backend backend(sink);
     auto errors = serialize_message(msg_id, message, backend);
     if(!errors) {
+        if(message.latest_wins) {
+            if(_serialized.push_or_replace(
+                 sink.done(),
+                 {msg_id, message.source_id, message.target_id})) {
+                user.log_trace("replaced enqueued message ${message}")
+                  .arg(EAGINE_ID(message), msg_id);
+                ++_replaced_count;
+                return true;
+            }
+        } else {
+            _serialized.push(sink.done());
+        }
         user.log_trace("enqueuing message ${message} to be sent")
           .arg(EAGINE_ID(message), msg_id);
-        _serialized.push(sink.done());
         return true;
     }
     user.log_error("failed to serialize message ${message}")
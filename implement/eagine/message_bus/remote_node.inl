@@ -62,6 +62,7 @@ public:
     std::chrono::microseconds last_ping_timeout{};
     std::chrono::microseconds message_age{};
     std::chrono::seconds uptime{};
+    optionally_valid<process_resource_usage> resource_usage;
 
     std::int64_t sent_messages{-1};
     std::int64_t received_messages{-1};
@@ -675,6 +676,18 @@ auto remote_node::uptime() const noexcept
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+auto remote_node::resource_usage() const noexcept
+  -> optional_reference_wrapper<const process_resource_usage> {
+    if(auto impl{_impl()}) {
+        auto& i = extract(impl);
+        if(i.resource_usage) {
+            return {extract(i.resource_usage)};
+        }
+    }
+    return {nothing};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto remote_node::connections() const noexcept -> node_connections {
     std::vector<identifier_t> remote_ids;
     _tracker.for_each_connection([&](const auto& conn) {
@@ -937,6 +950,17 @@ auto remote_node_state::assign(const endpoint_statistics& stats)
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+auto remote_node_state::assign(const process_resource_usage& usage)
+  -> remote_node_state& {
+    if(auto impl{_impl()}) {
+        auto& i = extract(impl);
+        i.resource_usage = {usage, true};
+        i.changes |= remote_node_change::statistics;
+    }
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto remote_node_state::add_subscription(message_id msg_id)
   -> remote_node_state& {
     if(auto impl{_impl()}) {
@@ -241,6 +241,11 @@ void router::_setup_from_config() {
     }
     _id_sequence = _id_base + 1;
 
+    _flow_histograms_enabled = extract_or(
+      app_config().get<bool>("msg_bus.router.flow_histograms"), false);
+
+    _setup_latest_wins_from_config();
+
     log_info("using router id range ${base} - ${end} (${count})")
       .arg(EAGINE_ID(count), id_count)
       .arg(EAGINE_ID(base), _id_base)
@@ -248,6 +253,32 @@ void router::_setup_from_config() {
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+void router::_setup_latest_wins_from_config() {
+    // periodic status messages where only the newest one is relevant
+    _latest_wins_msg_ids.insert(EAGINE_MSGBUS_ID(stillAlive));
+
+    std::vector<std::string> msg_id_strs;
+    app_config().fetch("msg_bus.router.latest_wins", msg_id_strs);
+    for(auto& msg_id_str : msg_id_strs) {
+        const auto [class_str, method_str] =
+          split_by_first(string_view(msg_id_str), string_view("."));
+        if(
+          class_str && method_str &&
+          (class_str.size() <= identifier::max_size()) &&
+          (method_str.size() <= identifier::max_size())) {
+            const message_id msg_id{
+              identifier(class_str), identifier(method_str)};
+            _latest_wins_msg_ids.insert(msg_id);
+            log_info("using latest-wins queuing for ${message}")
+              .arg(EAGINE_ID(message), msg_id);
+        } else {
+            log_error("invalid latest-wins message id '${value}'")
+              .arg(EAGINE_ID(value), msg_id_str);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto router::_handle_accept() -> work_done {
     some_true something_done{};
 
@@ -711,6 +742,102 @@ auto router::_handle_topology_query(const message_view& message)
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+auto router::_flow_histograms(flow_histogram_map& hists, identifier_t key)
+  -> router_flow_histograms& {
+    auto& hist = hists[key];
+    if(EAGINE_UNLIKELY(!hist)) {
+        hist = std::make_unique<router_flow_histograms>();
+    }
+    return *hist;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void router::_record_flow(
+  router_flow_histograms& conn_hist,
+  message_id msg_id,
+  const message_view& message,
+  std::chrono::steady_clock::time_point start) {
+    const auto latency = std::chrono::steady_clock::now() - start;
+    const auto msg_size = message.data().size();
+    conn_hist.add(message.age(), msg_size, latency);
+
+    if(EAGINE_UNLIKELY(msg_id.class_id() != _last_flow_class)) {
+        _last_flow_class = msg_id.class_id();
+        _last_flow_class_hist =
+          &_flow_histograms(_class_flow_hists, _last_flow_class);
+    }
+    _last_flow_class_hist->add(message.age(), msg_size, latency);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void router::_send_flow_stats(const message_view& request) {
+    const auto respond = [&](
+                           identifier_t remote_id,
+                           identifier_t message_class,
+                           const router_flow_histograms& hist) {
+        message_flow_statistics flow_stats{};
+        flow_stats.router_id = _id_base;
+        flow_stats.remote_id = remote_id;
+        flow_stats.message_class = message_class;
+        hist.summarize(flow_stats);
+        auto fs_buf{default_serialize_buffer_for(flow_stats)};
+        if(auto serialized{default_serialize(flow_stats, cover(fs_buf))}) {
+            message_view response{extract(serialized)};
+            response.setup_response(request);
+            response.set_source_id(_id_base);
+            this->_do_route_message(
+              EAGINE_MSGBUS_ID(statsFlow), _id_base, response);
+        }
+    };
+
+    for(auto& [remote_id, hist] : _connection_flow_hists) {
+        respond(remote_id, 0U, *hist);
+    }
+    for(auto& [message_class, hist] : _class_flow_hists) {
+        respond(0U, message_class, *hist);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void router::_log_flow_stats() {
+    const auto log_hist = [&](
+                            identifier_t remote_id,
+                            identifier_t message_class,
+                            const router_flow_histograms& hist) {
+        message_flow_statistics flow_stats{};
+        hist.summarize(flow_stats);
+        log_stat("message flow of ${source}")
+          .arg(EAGINE_ID(source), remote_id)
+          .arg(EAGINE_ID(msgClass), identifier(message_class))
+          .arg(EAGINE_ID(count), flow_stats.message_count)
+          .arg(
+            EAGINE_ID(ageP50), std::chrono::microseconds(flow_stats.age_p50_us))
+          .arg(
+            EAGINE_ID(ageP99), std::chrono::microseconds(flow_stats.age_p99_us))
+          .arg(
+            EAGINE_ID(ageMax), std::chrono::microseconds(flow_stats.age_max_us))
+          .arg(EAGINE_ID(sizeP50), EAGINE_ID(ByteSize), flow_stats.size_p50)
+          .arg(EAGINE_ID(sizeMax), EAGINE_ID(ByteSize), flow_stats.size_max)
+          .arg(
+            EAGINE_ID(latP50),
+            std::chrono::nanoseconds(flow_stats.latency_p50_ns))
+          .arg(
+            EAGINE_ID(latP99),
+            std::chrono::nanoseconds(flow_stats.latency_p99_ns))
+          .arg(
+            EAGINE_ID(latMax),
+            std::chrono::nanoseconds(flow_stats.latency_max_ns));
+    };
+
+    for(auto& [remote_id, hist] : _connection_flow_hists) {
+        log_hist(remote_id, 0U, *hist);
+    }
+    for(auto& [message_class, hist] : _class_flow_hists) {
+        log_hist(0U, message_class, *hist);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto router::_update_stats() -> work_done {
     some_true something_done;
 
@@ -794,6 +921,7 @@ auto router::_handle_stats_query(const message_view& message)
     if(_parent_router.confirmed_id) {
         respond(_parent_router.confirmed_id, _parent_router.the_connection);
     }
+    _send_flow_stats(message);
     return should_be_forwarded;
 }
 //------------------------------------------------------------------------------
@@ -859,7 +987,8 @@ auto router::_handle_special_common(
       msg_id.has_method(EAGINE_ID(statsRutr)) ||
       msg_id.has_method(EAGINE_ID(statsBrdg)) ||
       msg_id.has_method(EAGINE_ID(statsEndpt)) ||
-      msg_id.has_method(EAGINE_ID(statsConn))) {
+      msg_id.has_method(EAGINE_ID(statsConn)) ||
+      msg_id.has_method(EAGINE_ID(statsFlow))) {
         return should_be_forwarded;
     } else if(msg_id.has_method(EAGINE_ID(annEndptId))) {
         return was_handled;
@@ -985,6 +1114,9 @@ auto router::_do_route_message(
     } else {
         const auto& nodes = this->_nodes;
         message.add_hop();
+        if(_latest_wins_msg_ids.contains(msg_id)) {
+            message.set_latest_wins();
+        }
         const bool is_targeted = (message.target_id != broadcast_endpoint_id());
 
         const auto forward_to = [&](auto& node_out) {
@@ -1082,6 +1214,10 @@ auto router::_route_messages() -> work_done {
     _prev_route_time = now;
 
     for(auto& nd : _nodes) {
+        router_flow_histograms* flow_hist =
+          _flow_histograms_enabled
+            ? &_flow_histograms(_connection_flow_hists, std::get<0>(nd))
+            : nullptr;
         auto handler =
           [&](message_id msg_id, message_age msg_age, message_view message) {
               auto& [incoming_id, node_in] = nd;
@@ -1096,6 +1232,13 @@ auto router::_route_messages() -> work_done {
                   ++_stats.dropped_messages;
                   return true;
               }
+              if(EAGINE_UNLIKELY(flow_hist)) {
+                  const auto start = std::chrono::steady_clock::now();
+                  const bool result =
+                    this->_do_route_message(msg_id, incoming_id, message);
+                  _record_flow(*flow_hist, msg_id, message, start);
+                  return result;
+              }
               return this->_do_route_message(msg_id, incoming_id, message);
           };
 
@@ -1105,6 +1248,10 @@ auto router::_route_messages() -> work_done {
         }
     }
 
+    router_flow_histograms* flow_hist =
+      (_flow_histograms_enabled && _parent_router.confirmed_id)
+        ? &_flow_histograms(_connection_flow_hists, _parent_router.confirmed_id)
+        : nullptr;
     auto handler =
       [&](message_id msg_id, message_age msg_age, message_view message) {
           _message_age_sum +=
@@ -1118,6 +1265,13 @@ auto router::_route_messages() -> work_done {
               ++_stats.dropped_messages;
               return true;
           }
+          if(EAGINE_UNLIKELY(flow_hist)) {
+              const auto start = std::chrono::steady_clock::now();
+              const bool result =
+                this->_do_route_message(msg_id, _id_base, message);
+              _record_flow(*flow_hist, msg_id, message, start);
+              return result;
+          }
           return this->_do_route_message(msg_id, _id_base, message);
       };
     something_done(_parent_router.fetch_messages(*this, handler));
@@ -1186,6 +1340,58 @@ auto router::update(const valid_if_positive<int>& count) -> work_done {
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+void router::prepare_wait(const shared_wakeup_event& event) {
+    EAGINE_ASSERT(event);
+    for(auto& an_acceptor : _acceptors) {
+        an_acceptor->prepare_wait(event);
+    }
+    for(auto& pending : _pending) {
+        pending.the_connection->prepare_wait(event);
+    }
+    for(auto& [id, node] : _nodes) {
+        EAGINE_MAYBE_UNUSED(id);
+        if(const auto& conn = node.the_connection) {
+            conn->prepare_wait(event);
+        }
+    }
+    if(_parent_router.the_connection) {
+        _parent_router.the_connection->prepare_wait(event);
+    }
+    if(EAGINE_UNLIKELY(_blobs.has_outgoing())) {
+        event->notify();
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto router::next_deadline() -> std::chrono::steady_clock::time_point {
+    // only the timeouts that are reset by update when they expire
+    auto result{_forwarded_since_stat + std::chrono::seconds{15}};
+    for(const auto& pending : _pending) {
+        result = std::min(result, pending.create_time + _pending_timeout);
+    }
+    for(const auto& [id, info] : _endpoint_infos) {
+        EAGINE_MAYBE_UNUSED(id);
+        result = std::min(result, info.is_outdated.deadline());
+    }
+    if(const auto& conn = _parent_router.the_connection) {
+        if(!_parent_router.confirmed_id && conn->is_usable()) {
+            result = std::min(
+              result, _parent_router.confirm_id_timeout.deadline());
+        }
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto router::wait_for(std::chrono::milliseconds max_time) -> bool {
+    if(EAGINE_UNLIKELY(!_wakeup)) {
+        _wakeup = std::make_shared<wakeup_event>();
+    }
+    prepare_wait(_wakeup);
+    return _wakeup->wait_for(max_time, next_deadline());
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 void router::say_bye() {
     const auto msgid = EAGINE_MSGBUS_ID(byeByeRutr);
     message_view msg{};
@@ -1217,6 +1423,8 @@ void router::cleanup() {
       .arg(EAGINE_ID(dropped), _stats.dropped_messages)
       .arg(
         EAGINE_ID(avgMsgAge), std::chrono::microseconds(_stats.message_age_us));
+
+    _log_flow_stats();
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -0,0 +1,138 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#include <eagine/from_string.hpp>
+#include <eagine/string_span.hpp>
+
+#if EAGINE_POSIX
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace eagine {
+//------------------------------------------------------------------------------
+#if EAGINE_POSIX
+static inline auto process_resources_read(int fd, span<char> buffer) noexcept
+  -> string_view {
+    if(fd >= 0) {
+        const auto got = ::pread(fd, buffer.data(), std_size(buffer.size()), 0);
+        if(got > 0) {
+            return head(string_view(buffer), span_size(got));
+        }
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+static inline auto
+process_resources_field(string_view text, string_view name) noexcept
+  -> std::int64_t {
+    // the fields in /proc/self/io are "name: value" pairs on separate lines
+    while(!text.empty()) {
+        const auto line = take_until(text, [](char c) { return c == '\n'; });
+        if(starts_with(line, name) && (line.size() > name.size())) {
+            if(line[name.size()] == ':') {
+                const auto value = skip(line, name.size() + 1);
+                return extract_or(
+                  from_string<std::int64_t>(
+                    skip_until(value, [](char c) { return c != ' '; })),
+                  -1);
+            }
+        }
+        text = skip(text, line.size() + 1);
+    }
+    return -1;
+}
+//------------------------------------------------------------------------------
+static inline auto process_resources_fd_count() noexcept -> std::int64_t {
+    std::int64_t result{-1};
+    if(auto dir{::opendir("/proc/self/fd")}) {
+        result = 0;
+        while(auto entry{::readdir(dir)}) {
+            if(entry->d_name[0] != '.') {
+                ++result;
+            }
+        }
+        ::closedir(dir);
+        // the descriptor used by opendir
+        --result;
+    }
+    return result;
+}
+#endif
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+process_resource_sampler::process_resource_sampler() noexcept {
+#if EAGINE_LINUX
+    _statm_fd = ::open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    _io_fd = ::open("/proc/self/io", O_RDONLY | O_CLOEXEC);
+#endif
+    _sample(_samples[0]);
+    _samples[1] = _samples[0];
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+process_resource_sampler::~process_resource_sampler() noexcept {
+#if EAGINE_POSIX
+    if(_statm_fd >= 0) {
+        ::close(_statm_fd);
+    }
+    if(_io_fd >= 0) {
+        ::close(_io_fd);
+    }
+#endif
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto process_resource_sampler::update() noexcept -> process_resource_sampler& {
+    _current = 1U - _current;
+    _sample(_samples[_current]);
+    return *this;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void process_resource_sampler::_sample(process_resource_sample& s) noexcept {
+    s = {};
+    s.time = std::chrono::steady_clock::now();
+#if EAGINE_POSIX
+    // getrusage is a single system call and avoids parsing /proc/self/stat
+    // and /proc/self/status for the CPU times and context switch counts
+    struct ::rusage usage {};
+    if(::getrusage(RUSAGE_SELF, &usage) == 0) {
+        using std::chrono::microseconds;
+        using std::chrono::seconds;
+        s.user_cpu_time = seconds(usage.ru_utime.tv_sec) +
+                          microseconds(usage.ru_utime.tv_usec);
+        s.system_cpu_time = seconds(usage.ru_stime.tv_sec) +
+                            microseconds(usage.ru_stime.tv_usec);
+        s.voluntary_context_switches = usage.ru_nvcsw;
+        s.involuntary_context_switches = usage.ru_nivcsw;
+    }
+
+    std::array<char, 512> buffer{};
+    if(auto statm{process_resources_read(_statm_fd, cover(buffer))}) {
+        // the second field is the resident size in pages
+        const auto is_space = [](char c) { return c == ' '; };
+        const auto resident = take_until(
+          skip(statm, take_until(statm, is_space).size() + 1), is_space);
+        if(const auto pages{from_string<std::int64_t>(resident)}) {
+            s.resident_size = extract(pages) * ::sysconf(_SC_PAGESIZE);
+        }
+    }
+    if(auto io{process_resources_read(_io_fd, cover(buffer))}) {
+        s.read_bytes = process_resources_field(io, string_view("read_bytes"));
+        s.written_bytes =
+          process_resources_field(io, string_view("write_bytes"));
+    }
+    s.open_file_count = process_resources_fd_count();
+#endif
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
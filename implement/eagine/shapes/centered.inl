@@ -5,8 +5,7 @@
 /// See accompanying file LICENSE_1_0.txt or copy at
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
-#include <eagine/math/functions.hpp>
-#include <limits>
+#include <eagine/shapes/vertex_transform.hpp>
 
 namespace eagine {
 namespace shapes {
@@ -23,28 +22,12 @@ void centered_gen::attrib_values(vertex_attrib_variant vav, span<float> dest) {
 
         delegated_gen::attrib_values({vertex_attrib_kind::position, vav}, dest);
 
-        std::array<float, 4> min{
-          std::numeric_limits<float>::max(),
-          std::numeric_limits<float>::max(),
-          std::numeric_limits<float>::max(),
-          std::numeric_limits<float>::max()};
-
-        std::array<float, 4> max{
-          std::numeric_limits<float>::lowest(),
-          std::numeric_limits<float>::lowest(),
-          std::numeric_limits<float>::lowest(),
-          std::numeric_limits<float>::lowest()};
-
         const span_size_t m = values_per_vertex(vav);
+        const auto values = head(dest, vertex_count() * m);
 
-        for(const auto v : integer_range(vertex_count())) {
-            for(const auto c : integer_range(m)) {
-                const auto k = std_size(c);
-
-                min[k] = eagine::math::minimum(min[k], dest[v * m + c]);
-                max[k] = eagine::math::maximum(max[k], dest[v * m + c]);
-            }
-        }
+        std::array<float, 4> min{};
+        std::array<float, 4> max{};
+        vertex_value_bounds(values, m, min, max);
 
         std::array<float, 4> offs{{}};
         for(const auto c : integer_range(m)) {
@@ -56,11 +39,10 @@ void centered_gen::attrib_values(vertex_attrib_variant vav, span<float> dest) {
             delegated_gen::attrib_values(vav, dest);
         }
 
-        for(const auto v : integer_range(vertex_count())) {
-            for(const auto c : integer_range(m)) {
-                dest[v * m + c] -= offs[std_size(c)];
-            }
+        for(auto& offset : offs) {
+            offset = -offset;
         }
+        translate_vertex_values(values, m, offs);
     } else {
         delegated_gen::attrib_values(vav, dest);
     }
@@ -48,6 +48,13 @@ auto combined_gen::is_enabled(generator_capability cap) noexcept -> bool {
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
+void combined_gen::use_workers(workshop& workers, span_size_t max_threads) {
+    for(const auto& gen : _gens) {
+        gen->use_workers(workers, max_threads);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
 auto combined_gen::vertex_count() -> span_size_t {
     span_size_t result{0};
     for(const auto& gen : _gens) {
@@ -0,0 +1,752 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#include <eagine/assert.hpp>
+#include <eagine/math/functions.hpp>
+#include <eagine/memory/copy.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/reflect/enumerators.hpp>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace eagine {
+namespace shapes {
+//------------------------------------------------------------------------------
+// the layout of the mesh cache; all offsets are in bytes from the start
+// of the cache and all blocks are aligned to mesh_cache_alignment
+//------------------------------------------------------------------------------
+static constexpr const span_size_t mesh_cache_alignment = 16;
+static constexpr const std::uint32_t mesh_cache_version = 1;
+static constexpr const std::uint32_t mesh_cache_byte_order = 0x01020304U;
+//------------------------------------------------------------------------------
+struct mesh_cache_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t attrib_bits;
+    std::uint32_t attrib_count;
+    std::uint32_t draw_variant_count;
+    std::uint32_t reserved;
+    std::int64_t vertex_count;
+    std::int64_t attrib_table_offset;
+    std::int64_t draw_variant_table_offset;
+    std::array<float, 4> bounding_sphere;
+};
+//------------------------------------------------------------------------------
+struct mesh_cache_attrib {
+    std::uint32_t kind;
+    std::int32_t variant_index;
+    std::int32_t values_per_vertex;
+    std::uint8_t data_type;
+    std::uint8_t normalized;
+    std::array<std::uint8_t, 2> reserved;
+    std::int64_t name_offset;
+    std::int64_t name_size;
+    std::int64_t data_offset;
+    std::int64_t data_size;
+};
+//------------------------------------------------------------------------------
+struct mesh_cache_draw_variant {
+    std::int64_t index_offset;
+    std::int64_t index_count;
+    std::int64_t operation_offset;
+    std::int64_t operation_count;
+    std::uint8_t index_type;
+    std::array<std::uint8_t, 7> reserved;
+};
+//------------------------------------------------------------------------------
+struct mesh_cache_operation {
+    std::int64_t first;
+    std::int64_t count;
+    std::uint32_t phase;
+    std::uint32_t primitive_restart_index;
+    std::uint16_t patch_vertices;
+    std::uint8_t mode;
+    std::uint8_t idx_type;
+    std::uint8_t primitive_restart;
+    std::uint8_t cw_face_winding;
+    std::array<std::uint8_t, 2> reserved;
+};
+//------------------------------------------------------------------------------
+static constexpr const std::array<char, 8> mesh_cache_magic{
+  {'E', 'A', 'G', 'I', 'M', 'E', 'S', 'H'}};
+//------------------------------------------------------------------------------
+template <typename T>
+static inline auto mesh_cache_read(memory::const_block data, span_size_t offs)
+  -> T {
+    EAGINE_ASSERT(offs + span_size_of<T>() <= data.size());
+    T result{};
+    std::memcpy(&result, data.data() + offs, sizeof(T));
+    return result;
+}
+//------------------------------------------------------------------------------
+static inline auto mesh_cache_fits(
+  memory::const_block data,
+  std::int64_t offs,
+  std::int64_t size) noexcept -> bool {
+    return (offs >= 0) && (size >= 0) && (offs <= data.size()) &&
+           (size <= data.size() - offs);
+}
+//------------------------------------------------------------------------------
+static inline auto mesh_cache_known_index_type(std::uint8_t type) noexcept
+  -> bool {
+    switch(static_cast<index_data_type>(type)) {
+        case index_data_type::none:
+        case index_data_type::unsigned_8:
+        case index_data_type::unsigned_16:
+        case index_data_type::unsigned_32:
+            return true;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+static inline auto attrib_data_type_size(attrib_data_type type) noexcept
+  -> span_size_t {
+    switch(type) {
+        case attrib_data_type::ubyte:
+            return 1;
+        case attrib_data_type::int_16:
+        case attrib_data_type::uint_16:
+            return 2;
+        case attrib_data_type::int_32:
+        case attrib_data_type::uint_32:
+        case attrib_data_type::float_:
+            return 4;
+        case attrib_data_type::none:
+            break;
+    }
+    return 0;
+}
+//------------------------------------------------------------------------------
+// mesh cache writer
+//------------------------------------------------------------------------------
+class mesh_cache_writer {
+public:
+    mesh_cache_writer(memory::buffer& dest) noexcept
+      : _dest{dest} {}
+
+    auto reserve(span_size_t size) -> span_size_t {
+        const auto offs = _align(_dest.size());
+        _dest.resize(offs + size);
+        zero(skip(cover(_dest), _offset));
+        _offset = _dest.size();
+        return offs;
+    }
+
+    auto append(memory::const_block data) -> span_size_t {
+        const auto offs = reserve(data.size());
+        copy(data, skip(cover(_dest), offs));
+        return offs;
+    }
+
+    template <typename T>
+    void write(span_size_t offs, const T& value) {
+        EAGINE_ASSERT(offs + span_size_of<T>() <= _dest.size());
+        std::memcpy(_dest.data() + offs, &value, sizeof(T));
+    }
+
+private:
+    static auto _align(span_size_t offs) noexcept -> span_size_t {
+        const auto rem = offs % mesh_cache_alignment;
+        return rem ? offs + mesh_cache_alignment - rem : offs;
+    }
+
+    memory::buffer& _dest;
+    span_size_t _offset{0};
+};
+//------------------------------------------------------------------------------
+template <typename T>
+static inline auto mesh_cache_append_values(
+  mesh_cache_writer& writer,
+  generator& gen,
+  vertex_attrib_variant vav) -> span_size_t {
+    std::vector<T> values(std_size(gen.value_count(vav)));
+    gen.attrib_values(vav, cover(values));
+    return writer.append(as_bytes(view(values)));
+}
+//------------------------------------------------------------------------------
+template <typename T>
+static inline auto mesh_cache_append_indices(
+  mesh_cache_writer& writer,
+  generator& gen,
+  drawing_variant var) -> span_size_t {
+    std::vector<T> values(std_size(gen.index_count(var)));
+    gen.indices(var, cover(values));
+    return writer.append(as_bytes(view(values)));
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto store_mesh_cache(generator& gen, memory::buffer& dest) -> bool {
+    dest.clear();
+    mesh_cache_writer writer{dest};
+
+    std::vector<vertex_attrib_variant> vavs;
+    for(const auto& info : enumerator_mapping(
+          type_identity<vertex_attrib_kind>{}, default_selector)) {
+        if(gen.has(info.enumerator)) {
+            const auto variants = gen.attribute_variants(info.enumerator);
+            for(span_size_t v = 0; v < variants; ++v) {
+                vavs.emplace_back(info.enumerator, v);
+            }
+        }
+    }
+    const auto draw_variant_count = gen.draw_variant_count();
+
+    mesh_cache_header header{};
+    header.magic = mesh_cache_magic;
+    header.version = mesh_cache_version;
+    header.byte_order = mesh_cache_byte_order;
+    header.attrib_bits = gen.attrib_bits().bits();
+    header.attrib_count = limit_cast<std::uint32_t>(vavs.size());
+    header.draw_variant_count = limit_cast<std::uint32_t>(draw_variant_count);
+    header.vertex_count = gen.vertex_count();
+
+    const auto header_offs = writer.reserve(span_size_of<mesh_cache_header>());
+    header.attrib_table_offset = writer.reserve(
+      span_size(vavs.size()) * span_size_of<mesh_cache_attrib>());
+    header.draw_variant_table_offset = writer.reserve(
+      draw_variant_count * span_size_of<mesh_cache_draw_variant>());
+
+    for(const auto i : integer_range(span_size(vavs.size()))) {
+        const auto vav = vavs[std_size(i)];
+        const auto name = gen.variant_name(vav);
+        const auto type = gen.attrib_type(vav);
+
+        mesh_cache_attrib entry{};
+        entry.kind = static_cast<std::uint32_t>(vav.attribute());
+        entry.variant_index = limit_cast<std::int32_t>(vav.index());
+        entry.values_per_vertex =
+          limit_cast<std::int32_t>(gen.values_per_vertex(vav));
+        entry.data_type = static_cast<std::uint8_t>(type);
+        entry.normalized = gen.is_attrib_normalized(vav) ? 1U : 0U;
+        entry.name_offset = writer.append(as_bytes(name));
+        entry.name_size = name.size();
+        switch(type) {
+            case attrib_data_type::ubyte:
+                entry.data_offset =
+                  mesh_cache_append_values<byte>(writer, gen, vav);
+                break;
+            case attrib_data_type::int_16:
+                entry.data_offset =
+                  mesh_cache_append_values<std::int16_t>(writer, gen, vav);
+                break;
+            case attrib_data_type::int_32:
+                entry.data_offset =
+                  mesh_cache_append_values<std::int32_t>(writer, gen, vav);
+                break;
+            case attrib_data_type::uint_16:
+                entry.data_offset =
+                  mesh_cache_append_values<std::uint16_t>(writer, gen, vav);
+                break;
+            case attrib_data_type::uint_32:
+                entry.data_offset =
+                  mesh_cache_append_values<std::uint32_t>(writer, gen, vav);
+                break;
+            case attrib_data_type::float_:
+                entry.data_offset =
+                  mesh_cache_append_values<float>(writer, gen, vav);
+                break;
+            case attrib_data_type::none:
+                return false;
+        }
+        entry.data_size = gen.value_count(vav) * attrib_data_type_size(type);
+        writer.write(
+          header.attrib_table_offset + i * span_size_of<mesh_cache_attrib>(),
+          entry);
+    }
+
+    std::vector<draw_operation> ops;
+    std::vector<mesh_cache_operation> cached_ops;
+    for(const auto var : integer_range(draw_variant_count)) {
+        mesh_cache_draw_variant entry{};
+        const auto type = gen.index_type(var);
+        entry.index_type = static_cast<std::uint8_t>(type);
+        entry.index_count = gen.index_count(var);
+        switch(type) {
+            case index_data_type::unsigned_8:
+                entry.index_offset =
+                  mesh_cache_append_indices<std::uint8_t>(writer, gen, var);
+                break;
+            case index_data_type::unsigned_16:
+                entry.index_offset =
+                  mesh_cache_append_indices<std::uint16_t>(writer, gen, var);
+                break;
+            case index_data_type::unsigned_32:
+                entry.index_offset =
+                  mesh_cache_append_indices<std::uint32_t>(writer, gen, var);
+                break;
+            case index_data_type::none:
+                entry.index_count = 0;
+                break;
+        }
+
+        ops.resize(std_size(gen.operation_count(var)));
+        gen.instructions(var, cover(ops));
+        cached_ops.clear();
+        for(const auto& op : ops) {
+            mesh_cache_operation cached{};
+            cached.first = op.first;
+            cached.count = op.count;
+            cached.phase = op.phase;
+            cached.primitive_restart_index = op.primitive_restart_index;
+            cached.patch_vertices = op.patch_vertices;
+            cached.mode = static_cast<std::uint8_t>(op.mode);
+            cached.idx_type = static_cast<std::uint8_t>(op.idx_type);
+            cached.primitive_restart = op.primitive_restart ? 1U : 0U;
+            cached.cw_face_winding = op.cw_face_winding ? 1U : 0U;
+            cached_ops.push_back(cached);
+        }
+        entry.operation_offset = writer.append(as_bytes(view(cached_ops)));
+        entry.operation_count = span_size(cached_ops.size());
+        writer.write(
+          header.draw_variant_table_offset +
+            var * span_size_of<mesh_cache_draw_variant>(),
+          entry);
+    }
+
+    if(gen.has(vertex_attrib_kind::position)) {
+        const auto bs = gen.bounding_sphere();
+        header.bounding_sphere = {
+          {bs.center().x(), bs.center().y(), bs.center().z(), bs.radius()}};
+    }
+    writer.write(header_offs, header);
+    return true;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto save_mesh_cache(generator& gen, string_view path) -> bool {
+    memory::buffer data;
+    if(store_mesh_cache(gen, data)) {
+        std::ofstream output{c_str(path), std::ios::out | std::ios::binary};
+        output.write(
+          static_cast<const char*>(data.addr()),
+          static_cast<std::streamsize>(data.size()));
+        return output.good();
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+// mesh_cache_loader
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::_validate(memory::const_block data) noexcept
+  -> memory::const_block {
+    if(data.size() < span_size_of<mesh_cache_header>()) {
+        return {};
+    }
+    const auto header = mesh_cache_read<mesh_cache_header>(data, 0);
+    if(
+      (header.magic != mesh_cache_magic) ||
+      (header.version != mesh_cache_version) ||
+      (header.byte_order != mesh_cache_byte_order) ||
+      (header.vertex_count < 0)) {
+        return {};
+    }
+    if(!mesh_cache_fits(
+         data,
+         header.attrib_table_offset,
+         header.attrib_count * span_size_of<mesh_cache_attrib>())) {
+        return {};
+    }
+    if(!mesh_cache_fits(
+         data,
+         header.draw_variant_table_offset,
+         header.draw_variant_count *
+           span_size_of<mesh_cache_draw_variant>())) {
+        return {};
+    }
+    for(const auto i : integer_range(span_size(header.attrib_count))) {
+        const auto entry = mesh_cache_read<mesh_cache_attrib>(
+          data,
+          header.attrib_table_offset + i * span_size_of<mesh_cache_attrib>());
+        const auto value_size =
+          attrib_data_type_size(static_cast<attrib_data_type>(entry.data_type));
+        if(
+          !mesh_cache_fits(data, entry.name_offset, entry.name_size) ||
+          !mesh_cache_fits(data, entry.data_offset, entry.data_size) ||
+          (value_size == 0) || (entry.values_per_vertex < 0) ||
+          (entry.data_size !=
+           header.vertex_count * entry.values_per_vertex * value_size)) {
+            return {};
+        }
+    }
+    for(const auto var : integer_range(span_size(header.draw_variant_count))) {
+        const auto entry = mesh_cache_read<mesh_cache_draw_variant>(
+          data,
+          header.draw_variant_table_offset +
+            var * span_size_of<mesh_cache_draw_variant>());
+        if(!mesh_cache_known_index_type(entry.index_type)) {
+            return {};
+        }
+        const auto index_size = span_size(entry.index_type) / 8;
+        if(
+          !mesh_cache_fits(
+            data, entry.index_offset, entry.index_count * index_size) ||
+          !mesh_cache_fits(
+            data,
+            entry.operation_offset,
+            entry.operation_count * span_size_of<mesh_cache_operation>())) {
+            return {};
+        }
+        for(const auto i : integer_range(span_size(entry.operation_count))) {
+            const auto op = mesh_cache_read<mesh_cache_operation>(
+              data,
+              entry.operation_offset +
+                i * span_size_of<mesh_cache_operation>());
+            if(!mesh_cache_known_index_type(op.idx_type)) {
+                return {};
+            }
+            // indexed operations address the indices, others the vertices
+            const auto limit =
+              (static_cast<index_data_type>(op.idx_type) ==
+               index_data_type::none)
+                ? header.vertex_count
+                : entry.index_count;
+            if(
+              (op.first < 0) || (op.count < 0) || (op.first > limit) ||
+              (op.count > limit - op.first)) {
+                return {};
+            }
+        }
+    }
+    return data;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::_attr_bits(memory::const_block data) noexcept
+  -> vertex_attrib_bits {
+    if(!data.empty()) {
+        const auto header = mesh_cache_read<mesh_cache_header>(data, 0);
+        return vertex_attrib_bits{
+          limit_cast<vertex_attrib_bits::value_type>(header.attrib_bits)};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+mesh_cache_loader::mesh_cache_loader(
+  memory::const_block data,
+  file_contents&& contents) noexcept
+  : generator_base{_attr_bits(_validate(data))}
+  , _contents{std::move(contents)}
+  , _data{_validate(data)} {}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::_attrib_entry(vertex_attrib_variant vav) const noexcept
+  -> span_size_t {
+    if(!_data.empty()) {
+        const auto header = mesh_cache_read<mesh_cache_header>(_data, 0);
+        for(const auto i : integer_range(span_size(header.attrib_count))) {
+            const auto offs = header.attrib_table_offset +
+                              i * span_size_of<mesh_cache_attrib>();
+            const auto entry = mesh_cache_read<mesh_cache_attrib>(_data, offs);
+            if(
+              (entry.kind == static_cast<std::uint32_t>(vav.attribute())) &&
+              (entry.variant_index == vav.index())) {
+                return offs;
+            }
+        }
+    }
+    return -1;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::attrib_data(vertex_attrib_variant vav) const noexcept
+  -> memory::const_block {
+    const auto offs = _attrib_entry(vav);
+    if(offs >= 0) {
+        const auto entry = mesh_cache_read<mesh_cache_attrib>(_data, offs);
+        return slice(_data, entry.data_offset, entry.data_size);
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::index_data(drawing_variant var) const noexcept
+  -> memory::const_block {
+    if(!_data.empty()) {
+        const auto header = mesh_cache_read<mesh_cache_header>(_data, 0);
+        if((var >= 0) && (var < span_size(header.draw_variant_count))) {
+            const auto entry = mesh_cache_read<mesh_cache_draw_variant>(
+              _data,
+              header.draw_variant_table_offset +
+                var * span_size_of<mesh_cache_draw_variant>());
+            return slice(
+              _data,
+              entry.index_offset,
+              entry.index_count * span_size(entry.index_type) / 8);
+        }
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::vertex_count() -> span_size_t {
+    if(!_data.empty()) {
+        return span_size(
+          mesh_cache_read<mesh_cache_header>(_data, 0).vertex_count);
+    }
+    return 0;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::attribute_variants(vertex_attrib_kind attrib)
+  -> span_size_t {
+    span_size_t result{0};
+    while(_attrib_entry({attrib, result}) >= 0) {
+        ++result;
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::variant_name(vertex_attrib_variant vav)
+  -> string_view {
+    const auto offs = _attrib_entry(vav);
+    if(offs >= 0) {
+        const auto entry = mesh_cache_read<mesh_cache_attrib>(_data, offs);
+        return as_chars(slice(_data, entry.name_offset, entry.name_size));
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::values_per_vertex(vertex_attrib_variant vav)
+  -> span_size_t {
+    const auto offs = _attrib_entry(vav);
+    if(offs >= 0) {
+        return mesh_cache_read<mesh_cache_attrib>(_data, offs)
+          .values_per_vertex;
+    }
+    return 0;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::attrib_type(vertex_attrib_variant vav)
+  -> attrib_data_type {
+    const auto offs = _attrib_entry(vav);
+    if(offs >= 0) {
+        return static_cast<attrib_data_type>(
+          mesh_cache_read<mesh_cache_attrib>(_data, offs).data_type);
+    }
+    return attrib_data_type::none;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::is_attrib_normalized(vertex_attrib_variant vav)
+  -> bool {
+    const auto offs = _attrib_entry(vav);
+    if(offs >= 0) {
+        return mesh_cache_read<mesh_cache_attrib>(_data, offs).normalized != 0;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+template <typename S, typename T>
+static inline void
+mesh_cache_copy_values(memory::const_block src, span<T> dest) noexcept {
+    const auto n = math::minimum(src.size() / span_size_of<S>(), dest.size());
+    if constexpr(std::is_same_v<S, T>) {
+        std::memcpy(dest.data(), src.data(), std_size(n) * sizeof(T));
+    } else {
+        for(const auto i : integer_range(n)) {
+            dest[i] = static_cast<T>(
+              mesh_cache_read<S>(src, i * span_size_of<S>()));
+        }
+    }
+}
+//------------------------------------------------------------------------------
+template <typename T>
+void mesh_cache_loader::_attrib_values(
+  vertex_attrib_variant vav,
+  span<T> dest) {
+    const auto src = attrib_data(vav);
+    EAGINE_ASSERT(dest.size() >= value_count(vav));
+    switch(attrib_type(vav)) {
+        case attrib_data_type::ubyte:
+            mesh_cache_copy_values<byte>(src, dest);
+            break;
+        case attrib_data_type::int_16:
+            mesh_cache_copy_values<std::int16_t>(src, dest);
+            break;
+        case attrib_data_type::int_32:
+            mesh_cache_copy_values<std::int32_t>(src, dest);
+            break;
+        case attrib_data_type::uint_16:
+            mesh_cache_copy_values<std::uint16_t>(src, dest);
+            break;
+        case attrib_data_type::uint_32:
+            mesh_cache_copy_values<std::uint32_t>(src, dest);
+            break;
+        case attrib_data_type::float_:
+            mesh_cache_copy_values<float>(src, dest);
+            break;
+        case attrib_data_type::none:
+            break;
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::attrib_values(
+  vertex_attrib_variant vav,
+  span<byte> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::int16_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::int32_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::uint16_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::uint32_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::attrib_values(
+  vertex_attrib_variant vav,
+  span<float> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::draw_variant_count() -> span_size_t {
+    if(!_data.empty()) {
+        return span_size(
+          mesh_cache_read<mesh_cache_header>(_data, 0).draw_variant_count);
+    }
+    return 0;
+}
+//------------------------------------------------------------------------------
+static inline auto mesh_cache_draw_variant_entry(
+  memory::const_block data,
+  drawing_variant var) noexcept -> mesh_cache_draw_variant {
+    if(!data.empty()) {
+        const auto header = mesh_cache_read<mesh_cache_header>(data, 0);
+        if((var >= 0) && (var < span_size(header.draw_variant_count))) {
+            return mesh_cache_read<mesh_cache_draw_variant>(
+              data,
+              header.draw_variant_table_offset +
+                var * span_size_of<mesh_cache_draw_variant>());
+        }
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::index_type(drawing_variant var) -> index_data_type {
+    return static_cast<index_data_type>(
+      mesh_cache_draw_variant_entry(_data, var).index_type);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::index_count(drawing_variant var) -> span_size_t {
+    return span_size(mesh_cache_draw_variant_entry(_data, var).index_count);
+}
+//------------------------------------------------------------------------------
+template <typename T>
+void mesh_cache_loader::_indices(drawing_variant var, span<T> dest) {
+    const auto src = index_data(var);
+    EAGINE_ASSERT(dest.size() >= index_count(var));
+    switch(index_type(var)) {
+        case index_data_type::unsigned_8:
+            mesh_cache_copy_values<std::uint8_t>(src, dest);
+            break;
+        case index_data_type::unsigned_16:
+            mesh_cache_copy_values<std::uint16_t>(src, dest);
+            break;
+        case index_data_type::unsigned_32:
+            mesh_cache_copy_values<std::uint32_t>(src, dest);
+            break;
+        case index_data_type::none:
+            break;
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::indices(
+  drawing_variant var,
+  span<std::uint8_t> dest) {
+    _indices(var, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::indices(
+  drawing_variant var,
+  span<std::uint16_t> dest) {
+    _indices(var, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::indices(
+  drawing_variant var,
+  span<std::uint32_t> dest) {
+    _indices(var, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::operation_count(drawing_variant var) -> span_size_t {
+    return span_size(
+      mesh_cache_draw_variant_entry(_data, var).operation_count);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void mesh_cache_loader::instructions(
+  drawing_variant var,
+  span<draw_operation> ops) {
+    const auto entry = mesh_cache_draw_variant_entry(_data, var);
+    EAGINE_ASSERT(ops.size() >= entry.operation_count);
+    for(const auto i : integer_range(span_size(entry.operation_count))) {
+        const auto cached = mesh_cache_read<mesh_cache_operation>(
+          _data,
+          entry.operation_offset + i * span_size_of<mesh_cache_operation>());
+        auto& op = ops[i];
+        op.first = span_size(cached.first);
+        op.count = span_size(cached.count);
+        op.phase = cached.phase;
+        op.primitive_restart_index = cached.primitive_restart_index;
+        op.patch_vertices = cached.patch_vertices;
+        op.mode = static_cast<primitive_type>(cached.mode);
+        op.idx_type = static_cast<index_data_type>(cached.idx_type);
+        op.primitive_restart = cached.primitive_restart != 0;
+        op.cw_face_winding = cached.cw_face_winding != 0;
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto mesh_cache_loader::bounding_sphere() -> math::sphere<float, true> {
+    if(!_data.empty()) {
+        const auto bs =
+          mesh_cache_read<mesh_cache_header>(_data, 0).bounding_sphere;
+        return {{bs[0], bs[1], bs[2]}, bs[3]};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+} // namespace shapes
+} // namespace eagine
@@ -0,0 +1,647 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/assert.hpp>
+#include <eagine/math/functions.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/selector.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace eagine {
+namespace shapes {
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto vertex_cache_miss_ratio(
+  span<const unsigned> indices,
+  span_size_t cache_size) -> float {
+    const auto triangle_count = indices.size() / 3;
+    if(triangle_count < 1) {
+        return 0.F;
+    }
+    unsigned max_index{0U};
+    for(const auto index : indices) {
+        max_index = math::maximum(max_index, index);
+    }
+
+    // FIFO cache simulation, a vertex is cached if it was inserted
+    // less than cache_size insertions ago
+    std::vector<span_size_t> inserted(
+      std_size(max_index) + 1, -cache_size - 1);
+    span_size_t insertions{0};
+    span_size_t misses{0};
+    for(const auto index : indices) {
+        auto& when = inserted[std_size(index)];
+        if(insertions - when > cache_size) {
+            when = insertions++;
+            ++misses;
+        }
+    }
+    return float(misses) / float(triangle_count);
+}
+//------------------------------------------------------------------------------
+// Tipsify (Sander, Nehab, Barczak: Fast triangle reordering for vertex
+// locality and reduced overdraw). Returns the reordered triangle list
+// and the offsets (in triangles) of the clusters started at dead-ends.
+//------------------------------------------------------------------------------
+static inline auto mesh_tipsify(
+  const std::vector<unsigned>& indices,
+  span_size_t vertex_count,
+  span_size_t cache_size,
+  std::vector<span_size_t>& clusters) -> std::vector<unsigned> {
+    const auto triangle_count = indices.size() / 3;
+    const auto n = std_size(vertex_count);
+
+    // vertex -> triangle adjacency
+    std::vector<span_size_t> live(n, 0);
+    std::vector<std::size_t> offsets(n + 1, 0U);
+    for(const auto v : indices) {
+        ++live[v];
+        ++offsets[v + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<unsigned> adjacent(indices.size());
+    {
+        auto pos = offsets;
+        for(std::size_t i = 0; i < indices.size(); ++i) {
+            adjacent[pos[indices[i]]++] = unsigned(i / 3);
+        }
+    }
+
+    std::vector<span_size_t> stamps(n, 0);
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<unsigned> dead_ends;
+    std::vector<unsigned> candidates;
+    std::vector<unsigned> result;
+    result.reserve(indices.size());
+    clusters.clear();
+
+    span_size_t time = cache_size + 1;
+    std::size_t cursor = 0U;
+
+    const auto skip_dead_end = [&]() -> std::ptrdiff_t {
+        while(!dead_ends.empty()) {
+            const auto d = dead_ends.back();
+            dead_ends.pop_back();
+            if(live[d] > 0) {
+                return std::ptrdiff_t(d);
+            }
+        }
+        while(cursor < n) {
+            if(live[cursor] > 0) {
+                clusters.push_back(span_size(result.size() / 3));
+                return std::ptrdiff_t(cursor);
+            }
+            ++cursor;
+        }
+        return -1;
+    };
+
+    auto fanning = skip_dead_end();
+    while(fanning >= 0) {
+        const auto f = std::size_t(fanning);
+        candidates.clear();
+        for(auto a = offsets[f]; a < offsets[f + 1]; ++a) {
+            const auto t = adjacent[a];
+            if(!emitted[t]) {
+                for(std::size_t k = 0; k < 3; ++k) {
+                    const auto v = indices[t * 3 + k];
+                    result.push_back(v);
+                    dead_ends.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if(time - stamps[v] > cache_size) {
+                        stamps[v] = time++;
+                    }
+                }
+                emitted[t] = true;
+            }
+        }
+
+        // prefer vertices with live triangles that will still be cached
+        // after their remaining triangles are emitted
+        std::ptrdiff_t best = -1;
+        span_size_t best_priority = -1;
+        for(const auto v : candidates) {
+            if(live[v] > 0) {
+                span_size_t priority = 0;
+                if(time - stamps[v] + 2 * live[v] <= cache_size) {
+                    priority = time - stamps[v];
+                }
+                if(priority > best_priority) {
+                    best_priority = priority;
+                    best = std::ptrdiff_t(v);
+                }
+            }
+        }
+        fanning = (best >= 0) ? best : skip_dead_end();
+    }
+    EAGINE_ASSERT(result.size() == indices.size());
+    return result;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::_triangles(
+  drawing_variant var,
+  std::vector<unsigned>& triangles) -> bool {
+    std::vector<draw_operation> ops(
+      std_size(delegated_gen::operation_count(var)));
+    delegated_gen::instructions(var, cover(ops));
+
+    for(const auto& op : ops) {
+        if(
+          (op.mode != primitive_type::triangles) &&
+          (op.mode != primitive_type::triangle_strip) &&
+          (op.mode != primitive_type::triangle_fan)) {
+            return false;
+        }
+    }
+
+    std::vector<unsigned> idx(std_size(delegated_gen::index_count(var)));
+    if(!idx.empty()) {
+        delegated_gen::indices(var, cover(idx));
+    }
+
+    triangles.clear();
+    for(const auto& op : ops) {
+        const bool indexed = op.idx_type != index_data_type::none;
+        const auto vertex = [&](span_size_t i) -> unsigned {
+            return indexed ? idx[std_size(op.first + i)]
+                           : limit_cast<unsigned>(op.first + i);
+        };
+        const auto is_restart = [&](span_size_t i) {
+            return indexed && op.primitive_restart &&
+                   (vertex(i) == op.primitive_restart_index);
+        };
+        // the triangles are stored with clockwise winding
+        const auto add = [&](unsigned a, unsigned b, unsigned c) {
+            triangles.push_back(a);
+            triangles.push_back(op.cw_face_winding ? b : c);
+            triangles.push_back(op.cw_face_winding ? c : b);
+        };
+
+        if(op.mode == primitive_type::triangles) {
+            for(span_size_t i = 0; i + 2 < op.count; i += 3) {
+                add(vertex(i), vertex(i + 1), vertex(i + 2));
+            }
+        } else {
+            const bool is_strip = op.mode == primitive_type::triangle_strip;
+            span_size_t start = 0;
+            for(span_size_t i = 0; i < op.count; ++i) {
+                if(is_restart(i)) {
+                    start = i + 1;
+                    continue;
+                }
+                const auto j = i - start;
+                if(j >= 2) {
+                    if(!is_strip) {
+                        add(vertex(start), vertex(i - 1), vertex(i));
+                    } else if(j % 2 == 0) {
+                        add(vertex(i - 2), vertex(i - 1), vertex(i));
+                    } else {
+                        add(vertex(i - 1), vertex(i - 2), vertex(i));
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::_canonical_vertices() -> std::vector<unsigned> {
+    const auto n = std_size(_original_vertex_count);
+    std::vector<unsigned> canonical(n);
+    std::iota(canonical.begin(), canonical.end(), 0U);
+
+    if(!_options.deduplicate_vertices) {
+        return canonical;
+    }
+
+    // gather the values of all attribute variants into per-vertex rows
+    std::vector<vertex_attrib_variant> vavs;
+    span_size_t row_size{0};
+    for(const auto& info : enumerator_mapping(
+          type_identity<vertex_attrib_kind>{}, default_selector)) {
+        if(!has(info.enumerator)) {
+            continue;
+        }
+        const auto variants = attribute_variants(info.enumerator);
+        for(span_size_t v = 0; v < variants; ++v) {
+            const vertex_attrib_variant vav{info.enumerator, v};
+            if(attrib_type(vav) != attrib_data_type::float_) {
+                // only float attribute values are compared
+                return canonical;
+            }
+            vavs.push_back(vav);
+            row_size += values_per_vertex(vav);
+        }
+    }
+
+    std::vector<float> rows(n * std_size(row_size));
+    std::vector<float> values;
+    span_size_t offset{0};
+    for(const auto vav : vavs) {
+        const auto m = values_per_vertex(vav);
+        values.resize(n * std_size(m));
+        delegated_gen::attrib_values(vav, cover(values));
+        for(std::size_t v = 0; v < n; ++v) {
+            for(span_size_t c = 0; c < m; ++c) {
+                rows[v * std_size(row_size) + std_size(offset + c)] =
+                  values[v * std_size(m) + std_size(c)];
+            }
+        }
+        offset += m;
+    }
+
+    const auto row_bytes = std_size(row_size) * sizeof(float);
+    const auto row = [&](unsigned v) {
+        return rows.data() + std_size(v) * std_size(row_size);
+    };
+    std::vector<unsigned> order(canonical);
+    std::stable_sort(order.begin(), order.end(), [&](unsigned l, unsigned r) {
+        return std::memcmp(row(l), row(r), row_bytes) < 0;
+    });
+    for(std::size_t i = 1; i < n; ++i) {
+        const auto prev = order[i - 1];
+        const auto curr = order[i];
+        if(std::memcmp(row(prev), row(curr), row_bytes) == 0) {
+            canonical[curr] = canonical[prev];
+        }
+    }
+    return canonical;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::_reduce_overdraw(
+  std::vector<unsigned>& indices,
+  const std::vector<span_size_t>& clusters) {
+    const vertex_attrib_variant vav{vertex_attrib_kind::position};
+    const auto m = std_size(values_per_vertex(vav));
+    if((clusters.size() < 2) || (m < 3)) {
+        return;
+    }
+    std::vector<float> positions(std_size(_original_vertex_count) * m);
+    delegated_gen::attrib_values(vav, cover(positions));
+
+    using vec3 = std::array<float, 3>;
+    const auto pos = [&](unsigned v) -> vec3 {
+        const auto* p = positions.data() + std_size(v) * m;
+        return {{p[0], p[1], p[2]}};
+    };
+    const auto sub = [](const vec3& l, const vec3& r) -> vec3 {
+        return {{l[0] - r[0], l[1] - r[1], l[2] - r[2]}};
+    };
+    const auto dot = [](const vec3& l, const vec3& r) {
+        return l[0] * r[0] + l[1] * r[1] + l[2] * r[2];
+    };
+
+    const auto triangle_count = span_size(indices.size() / 3);
+    vec3 mesh_center{{0.F, 0.F, 0.F}};
+    for(const auto v : indices) {
+        const auto p = pos(v);
+        for(std::size_t c = 0; c < 3; ++c) {
+            mesh_center[c] += p[c] / float(indices.size());
+        }
+    }
+
+    // sort the clusters by how much they face outwards from the center,
+    // so that the probable occluders are drawn first
+    struct cluster_info {
+        span_size_t begin;
+        span_size_t end;
+        float outwardness;
+    };
+    std::vector<cluster_info> infos;
+    infos.reserve(clusters.size());
+    for(std::size_t c = 0; c < clusters.size(); ++c) {
+        cluster_info info{};
+        info.begin = clusters[c];
+        info.end =
+          (c + 1 < clusters.size()) ? clusters[c + 1] : triangle_count;
+        vec3 normal{{0.F, 0.F, 0.F}};
+        vec3 center{{0.F, 0.F, 0.F}};
+        for(auto t = info.begin; t < info.end; ++t) {
+            const auto a = pos(indices[std_size(t * 3 + 0)]);
+            const auto b = pos(indices[std_size(t * 3 + 1)]);
+            const auto c2 = pos(indices[std_size(t * 3 + 2)]);
+            // clockwise winding
+            const auto e1 = sub(c2, a);
+            const auto e2 = sub(b, a);
+            normal[0] += e1[1] * e2[2] - e1[2] * e2[1];
+            normal[1] += e1[2] * e2[0] - e1[0] * e2[2];
+            normal[2] += e1[0] * e2[1] - e1[1] * e2[0];
+            for(std::size_t k = 0; k < 3; ++k) {
+                center[k] += (a[k] + b[k] + c2[k]) / 3.F;
+            }
+        }
+        const auto count = float(info.end - info.begin);
+        for(auto& k : center) {
+            k /= count;
+        }
+        const auto length = std::sqrt(dot(normal, normal));
+        info.outwardness =
+          length > 0.F ? dot(sub(center, mesh_center), normal) / length : 0.F;
+        infos.push_back(info);
+    }
+    std::stable_sort(
+      infos.begin(), infos.end(), [](const auto& l, const auto& r) {
+          return l.outwardness > r.outwardness;
+      });
+
+    std::vector<unsigned> result;
+    result.reserve(indices.size());
+    for(const auto& info : infos) {
+        result.insert(
+          result.end(),
+          indices.begin() + info.begin * 3,
+          indices.begin() + info.end * 3);
+    }
+    indices.swap(result);
+}
+//------------------------------------------------------------------------------
+static inline auto mesh_index_type(unsigned max_index) noexcept
+  -> index_data_type {
+    if(max_index > 0xFFFFU) {
+        return index_data_type::unsigned_32;
+    }
+    if(max_index > 0xFFU) {
+        return index_data_type::unsigned_16;
+    }
+    return index_data_type::unsigned_8;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::_reindex(drawing_variant var, variant_data& vd) {
+    vd.operations.resize(std_size(delegated_gen::operation_count(var)));
+    delegated_gen::instructions(var, cover(vd.operations));
+
+    std::vector<unsigned> idx(std_size(delegated_gen::index_count(var)));
+    if(!idx.empty()) {
+        delegated_gen::indices(var, cover(idx));
+    }
+
+    // all operations are indexed, the non-indexed ones get new indices
+    const auto n = unsigned(_original_vertex_count);
+    unsigned max_index{0U};
+    vd.indices.clear();
+    for(auto& op : vd.operations) {
+        const bool indexed = op.idx_type != index_data_type::none;
+        const auto first = span_size(vd.indices.size());
+        for(span_size_t i = 0; i < op.count; ++i) {
+            auto v = indexed ? idx[std_size(op.first + i)]
+                             : limit_cast<unsigned>(op.first + i);
+            // keep the primitive restart index values
+            if(v < n) {
+                v = _vertex_map[v];
+            }
+            max_index = math::maximum(max_index, v);
+            vd.indices.push_back(v);
+        }
+        op.first = first;
+    }
+    vd.index_type = mesh_index_type(max_index);
+    for(auto& op : vd.operations) {
+        op.idx_type = vd.index_type;
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::_prepare() {
+    if(_prepared) {
+        return;
+    }
+    _prepared = true;
+    _original_vertex_count = delegated_gen::vertex_count();
+    const auto n = std_size(_original_vertex_count);
+    const auto canonical = _canonical_vertices();
+
+    std::vector<bool> is_triangle_list;
+    std::vector<span_size_t> clusters;
+    for(span_size_t var = 0; var < draw_variant_count(); ++var) {
+        auto& vd = _variants[var];
+        vd.stats.original_vertex_count = _original_vertex_count;
+        std::vector<unsigned> triangles;
+        is_triangle_list.push_back(_triangles(var, triangles));
+        if(!is_triangle_list.back()) {
+            continue;
+        }
+        vd.stats.acmr_before =
+          vertex_cache_miss_ratio(view(triangles), _options.cache_size);
+
+        // merge the duplicate vertices and drop the degenerate triangles
+        vd.indices.clear();
+        vd.indices.reserve(triangles.size());
+        for(std::size_t t = 0; t + 2 < triangles.size(); t += 3) {
+            const auto a = canonical[triangles[t + 0]];
+            const auto b = canonical[triangles[t + 1]];
+            const auto c = canonical[triangles[t + 2]];
+            if((a != b) && (b != c) && (c != a)) {
+                vd.indices.push_back(a);
+                vd.indices.push_back(b);
+                vd.indices.push_back(c);
+            }
+        }
+
+        if(_options.reorder_triangles) {
+            vd.indices = mesh_tipsify(
+              vd.indices,
+              _original_vertex_count,
+              _options.cache_size,
+              clusters);
+            if(_options.reduce_overdraw) {
+                _reduce_overdraw(vd.indices, clusters);
+            }
+        }
+    }
+
+    // renumber the vertices in the order of their first use
+    // in the first drawing variant and then in the original order
+    const auto unused = std::numeric_limits<unsigned>::max();
+    _vertex_map.assign(n, unused);
+    unsigned next{0U};
+    if(
+      _options.reorder_vertices && !is_triangle_list.empty() &&
+      is_triangle_list.front()) {
+        for(const auto v : _variants[0].indices) {
+            if(_vertex_map[v] == unused) {
+                _vertex_map[v] = next++;
+            }
+        }
+    }
+    for(std::size_t v = 0; v < n; ++v) {
+        const auto c = canonical[v];
+        if(_vertex_map[c] == unused) {
+            _vertex_map[c] = next++;
+        }
+        _vertex_map[v] = _vertex_map[c];
+    }
+    _vertex_source.resize(next);
+    for(std::size_t v = 0; v < n; ++v) {
+        if(canonical[v] == v) {
+            _vertex_source[_vertex_map[v]] = unsigned(v);
+        }
+    }
+
+    for(span_size_t var = 0; var < draw_variant_count(); ++var) {
+        auto& vd = _variants[var];
+        vd.stats.vertex_count = span_size(next);
+        if(is_triangle_list[std_size(var)]) {
+            unsigned max_index{0U};
+            for(auto& v : vd.indices) {
+                v = _vertex_map[v];
+                max_index = math::maximum(max_index, v);
+            }
+            vd.index_type = mesh_index_type(max_index);
+            vd.stats.triangle_count = span_size(vd.indices.size() / 3);
+            vd.stats.acmr_after =
+              vertex_cache_miss_ratio(view(vd.indices), _options.cache_size);
+
+            draw_operation op{};
+            op.mode = primitive_type::triangles;
+            op.idx_type = vd.index_type;
+            op.first = 0;
+            op.count = span_size(vd.indices.size());
+            op.cw_face_winding = true;
+            vd.operations.assign(1, op);
+        } else {
+            _reindex(var, vd);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::_variant(drawing_variant var) -> variant_data& {
+    _prepare();
+    auto pos = _variants.find(var);
+    EAGINE_ASSERT(pos != _variants.end());
+    return pos->second;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::statistics(drawing_variant var)
+  -> const mesh_optimization_statistics& {
+    return _variant(var).stats;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::vertex_count() -> span_size_t {
+    _prepare();
+    return span_size(_vertex_source.size());
+}
+//------------------------------------------------------------------------------
+template <typename T>
+void optimized_gen::_attrib_values(vertex_attrib_variant vav, span<T> dest) {
+    _prepare();
+    const auto m = values_per_vertex(vav);
+    std::vector<T> values(std_size(_original_vertex_count * m));
+    delegated_gen::attrib_values(vav, cover(values));
+
+    EAGINE_ASSERT(dest.size() >= vertex_count() * m);
+    span_size_t k = 0;
+    for(const auto v : _vertex_source) {
+        for(span_size_t c = 0; c < m; ++c) {
+            dest[k++] = values[std_size(v * m + c)];
+        }
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::attrib_values(vertex_attrib_variant vav, span<byte> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::int16_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::int32_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::uint16_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::attrib_values(
+  vertex_attrib_variant vav,
+  span<std::uint32_t> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::attrib_values(vertex_attrib_variant vav, span<float> dest) {
+    _attrib_values(vav, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::index_type(drawing_variant var) -> index_data_type {
+    return _variant(var).index_type;
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::index_count(drawing_variant var) -> span_size_t {
+    return span_size(_variant(var).indices.size());
+}
+//------------------------------------------------------------------------------
+template <typename T>
+void optimized_gen::_indices(drawing_variant var, span<T> dest) {
+    const auto& vd = _variant(var);
+    EAGINE_ASSERT(dest.size() >= span_size(vd.indices.size()));
+    span_size_t k = 0;
+    for(const auto v : vd.indices) {
+        dest[k++] = limit_cast<T>(v);
+    }
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::indices(drawing_variant var, span<std::uint8_t> dest) {
+    _indices(var, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::indices(drawing_variant var, span<std::uint16_t> dest) {
+    _indices(var, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::indices(drawing_variant var, span<std::uint32_t> dest) {
+    _indices(var, dest);
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+auto optimized_gen::operation_count(drawing_variant var) -> span_size_t {
+    return span_size(_variant(var).operations.size());
+}
+//------------------------------------------------------------------------------
+EAGINE_LIB_FUNC
+void optimized_gen::instructions(
+  drawing_variant var,
+  span<draw_operation> ops) {
+    const auto& vd = _variant(var);
+    EAGINE_ASSERT(ops.size() >= span_size(vd.operations.size()));
+    for(std::size_t i = 0; i < vd.operations.size(); ++i) {
+        ops[span_size(i)] = vd.operations[i];
+    }
+}
+//------------------------------------------------------------------------------
+} // namespace shapes
+} // namespace eagine
@@ -6,6 +6,7 @@
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
 #include <eagine/math/functions.hpp>
+#include <eagine/shapes/vertex_transform.hpp>
 
 namespace eagine {
 namespace shapes {
@@ -22,11 +23,7 @@ void scaled_gen::attrib_values(vertex_attrib_variant vav, span<float> dest) {
     if(is_scaled_attrib) {
         const auto m = values_per_vertex(vav);
         const auto n = vertex_count();
-        for(const auto v : integer_range(n)) {
-            for(const auto c : integer_range(m)) {
-                dest[v * m + c] *= _s[std_size(c)];
-            }
-        }
+        scale_vertex_values(head(dest, n * m), m, {{_s[0], _s[1], _s[2], 1.F}});
     }
 }
 //------------------------------------------------------------------------------
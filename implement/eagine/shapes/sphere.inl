@@ -45,21 +45,22 @@ void unit_sphere_gen::positions(span<float> dest) noexcept {
     EAGINE_ASSERT(has(vertex_attrib_kind::position));
     EAGINE_ASSERT(dest.size() >= vertex_count() * 3);
 
-    span_size_t k = 0;
-
     const auto s_step = 2 * math::pi / _sections;
     const auto r_step = 1 * math::pi / _rings;
 
-    for(const auto s : integer_range(_sections + 1)) {
-        for(const auto r : integer_range(_rings + 1)) {
-            const auto r_lat = std::cos(r * r_step);
-            const auto r_rad = std::sin(r * r_step);
+    parallel_for(_sections + 1, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * (_rings + 1) * 3;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings + 1)) {
+                const auto r_lat = std::cos(r * r_step);
+                const auto r_rad = std::sin(r * r_step);
 
-            dest[k++] = float(0.5F * r_rad * std::cos(s * s_step));
-            dest[k++] = float(0.5F * r_lat);
-            dest[k++] = float(0.5F * r_rad * -std::sin(s * s_step));
+                dest[k++] = float(0.5F * r_rad * std::cos(s * s_step));
+                dest[k++] = float(0.5F * r_lat);
+                dest[k++] = float(0.5F * r_rad * -std::sin(s * s_step));
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -67,21 +68,22 @@ void unit_sphere_gen::normals(span<float> dest) noexcept {
     EAGINE_ASSERT(has(vertex_attrib_kind::normal));
     EAGINE_ASSERT(dest.size() >= vertex_count() * 3);
 
-    span_size_t k = 0;
-
     const auto s_step = 2 * math::pi / _sections;
     const auto r_step = 1 * math::pi / _rings;
 
-    for(const auto s : integer_range(_sections + 1)) {
-        for(const auto r : integer_range(_rings + 1)) {
-            const auto r_lat = std::cos(r * r_step);
-            const auto r_rad = std::sin(r * r_step);
+    parallel_for(_sections + 1, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * (_rings + 1) * 3;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings + 1)) {
+                const auto r_lat = std::cos(r * r_step);
+                const auto r_rad = std::sin(r * r_step);
 
-            dest[k++] = float(r_rad * std::cos(s * s_step));
-            dest[k++] = float(r_lat);
-            dest[k++] = float(r_rad * -std::sin(s * s_step));
+                dest[k++] = float(r_rad * std::cos(s * s_step));
+                dest[k++] = float(r_lat);
+                dest[k++] = float(r_rad * -std::sin(s * s_step));
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -89,21 +91,22 @@ void unit_sphere_gen::tangentials(span<float> dest) noexcept {
     EAGINE_ASSERT(has(vertex_attrib_kind::tangential));
     EAGINE_ASSERT(dest.size() >= vertex_count() * 3);
 
-    span_size_t k = 0;
-
     const auto s_step = 2 * math::pi / _sections;
 
-    for(const auto s : integer_range(_sections + 1)) {
-        auto x = -std::sin(s * s_step);
-        auto z = -std::cos(s * s_step);
+    parallel_for(_sections + 1, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * (_rings + 1) * 3;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            auto x = -std::sin(s * s_step);
+            auto z = -std::cos(s * s_step);
 
-        for(const auto r : integer_range(_rings + 1)) {
-            EAGINE_MAYBE_UNUSED(r);
-            dest[k++] = float(x);
-            dest[k++] = float(0);
-            dest[k++] = float(z);
+            for(const auto r : integer_range(_rings + 1)) {
+                EAGINE_MAYBE_UNUSED(r);
+                dest[k++] = float(x);
+                dest[k++] = float(0);
+                dest[k++] = float(z);
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -111,26 +114,27 @@ void unit_sphere_gen::bitangentials(span<float> dest) noexcept {
     EAGINE_ASSERT(has(vertex_attrib_kind::bitangential));
     EAGINE_ASSERT(dest.size() >= vertex_count() * 3);
 
-    span_size_t k = 0;
-
     const auto s_step = 2 * math::pi / _sections;
     const auto r_step = 1 * math::pi / _rings;
     const auto ty = 0;
 
-    for(const auto s : integer_range(_sections + 1)) {
-        for(const auto r : integer_range(_rings + 1)) {
-            const auto r_rad = std::sin(r * r_step);
-            const auto tx = -std::sin(s * s_step);
-            const auto tz = -std::cos(s * s_step);
-            const auto nx = -r_rad * tz;
-            const auto ny = std::cos(r * r_step);
-            const auto nz = r_rad * tx;
+    parallel_for(_sections + 1, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * (_rings + 1) * 3;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings + 1)) {
+                const auto r_rad = std::sin(r * r_step);
+                const auto tx = -std::sin(s * s_step);
+                const auto tz = -std::cos(s * s_step);
+                const auto nx = -r_rad * tz;
+                const auto ny = std::cos(r * r_step);
+                const auto nz = r_rad * tx;
 
-            dest[k++] = float(ny * tz - nz * ty);
-            dest[k++] = float(nz * tx - nx * tz);
-            dest[k++] = float(nx * ty - ny * tx);
+                dest[k++] = float(ny * tz - nz * ty);
+                dest[k++] = float(nz * tx - nx * tz);
+                dest[k++] = float(nx * ty - ny * tx);
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -138,17 +142,18 @@ void unit_sphere_gen::wrap_coords(span<float> dest) noexcept {
     EAGINE_ASSERT(has(vertex_attrib_kind::wrap_coord));
     EAGINE_ASSERT(dest.size() >= vertex_count() * 2);
 
-    span_size_t k = 0;
-
     const auto s_step = 1.F / _sections;
     const auto r_step = 1.F / _rings;
 
-    for(const auto s : integer_range(_sections + 1)) {
-        for(const auto r : integer_range(_rings + 1)) {
-            dest[k++] = s * s_step;
-            dest[k++] = r * r_step;
+    parallel_for(_sections + 1, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * (_rings + 1) * 2;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings + 1)) {
+                dest[k++] = s * s_step;
+                dest[k++] = r * r_step;
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -209,19 +214,23 @@ void unit_sphere_gen::_indices(drawing_variant var, span<T> dest) noexcept {
     EAGINE_MAYBE_UNUSED(var);
 
     const auto pri = limit_cast<T>(vertex_count());
-    span_size_t k = 0;
-    span_size_t step = _rings + 1;
+    const span_size_t step = _rings + 1;
+    const bool restart = primitive_restart();
+    const span_size_t section_size = step * 2 + (restart ? 1 : 0);
 
-    for(const auto s : integer_range(_sections + 1)) {
-        for(const auto r : integer_range(step)) {
-            dest[k++] = limit_cast<T>((s + 0) * step + r);
-            dest[k++] = limit_cast<T>((s + 1) * step + r);
-        }
+    parallel_for(_sections, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * section_size;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(step)) {
+                dest[k++] = limit_cast<T>((s + 0) * step + r);
+                dest[k++] = limit_cast<T>((s + 1) * step + r);
+            }
 
-        if(primitive_restart()) {
-            dest[k++] = pri;
+            if(restart) {
+                dest[k++] = pri;
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
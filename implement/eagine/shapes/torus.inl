@@ -11,6 +11,7 @@
 #include <eagine/math/functions.hpp>
 #include <cmath>
 #include <random>
+#include <vector>
 
 #ifdef __clang__
 EAGINE_DIAG_PUSH()
@@ -50,25 +51,26 @@ void unit_torus_gen::vertex_pivots(span<float> dest) noexcept {
     EAGINE_ASSERT(has(vertex_attrib_kind::position));
     EAGINE_ASSERT(dest.size() >= vertex_count() * 3);
 
-    span_size_t k = 0;
-
     const auto ro = 0.50;
     const auto ri = ro * _radius_ratio;
     const auto rc = (ro + ri) / 2;
 
     const auto s_step = 2 * math::pi / _sections;
 
-    for(const auto s : integer_range(_sections + 1)) {
-        const auto vx = std::cos(s * s_step) * rc;
-        const auto vz = -std::sin(s * s_step) * rc;
-
-        for(const auto r : integer_range(_rings + 1)) {
-            EAGINE_MAYBE_UNUSED(r);
-            dest[k++] = float(vx);
-            dest[k++] = float(0);
-            dest[k++] = float(vz);
+    parallel_for(_sections + 1, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * (_rings + 1) * 3;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            const auto vx = std::cos(s * s_step) * rc;
+            const auto vz = -std::sin(s * s_step) * rc;
+
+            for(const auto r : integer_range(_rings + 1)) {
+                EAGINE_MAYBE_UNUSED(r);
+                dest[k++] = float(vx);
+                dest[k++] = float(0);
+                dest[k++] = float(vz);
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -90,24 +92,26 @@ void unit_torus_gen::positions(
         return 3 * (s * (_rings + 1) + r) + c;
     };
 
-    for(const auto s : integer_range(_sections)) {
-        for(const auto r : integer_range(_rings)) {
-            const auto [rd, sd, td] = get_offs(s, r);
+    parallel_for(_sections, [&](span_size_t s_begin, span_size_t s_end) {
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings)) {
+                const auto [rd, sd, td] = get_offs(s, r);
 
-            const auto vr = -std::cos((r + rd) * r_step);
-            const auto vx = std::cos((s + sd) * s_step);
-            const auto vy = std::sin((r + rd) * r_step);
-            const auto vz = -std::sin((s + sd) * s_step);
-            const auto rt = r2 * (1 + td);
+                const auto vr = -std::cos((r + rd) * r_step);
+                const auto vx = std::cos((s + sd) * s_step);
+                const auto vy = std::sin((r + rd) * r_step);
+                const auto vz = -std::sin((s + sd) * s_step);
+                const auto rt = r2 * (1 + td);
 
-            dest[k(s, r, 0)] = float(vx * (r1 + rt * (1 + vr)));
-            dest[k(s, r, 1)] = float(vy * rt);
-            dest[k(s, r, 2)] = float(vz * (r1 + rt * (1 + vr)));
+                dest[k(s, r, 0)] = float(vx * (r1 + rt * (1 + vr)));
+                dest[k(s, r, 1)] = float(vy * rt);
+                dest[k(s, r, 2)] = float(vz * (r1 + rt * (1 + vr)));
+            }
+            dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
+            dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
+            dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
         }
-        dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
-        dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
-        dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
-    }
+    });
     for(const auto r : integer_range(_rings + 1)) {
         dest[k(_sections, r, 0)] = dest[k(0, r, 0)];
         dest[k(_sections, r, 1)] = dest[k(0, r, 1)];
@@ -129,24 +133,26 @@ void unit_torus_gen::normals(
         return 3 * (s * (_rings + 1) + r) + c;
     };
 
-    for(const auto s : integer_range(_sections)) {
-        for(const auto r : integer_range(_rings)) {
-            const auto [rd, sd, td] = get_offs(s, r);
-            EAGINE_MAYBE_UNUSED(td);
+    parallel_for(_sections, [&](span_size_t s_begin, span_size_t s_end) {
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings)) {
+                const auto [rd, sd, td] = get_offs(s, r);
+                EAGINE_MAYBE_UNUSED(td);
 
-            const auto nr = -std::cos((r + rd) * r_step);
-            const auto nx = std::cos((s + sd) * s_step);
-            const auto ny = std::sin((r + rd) * r_step);
-            const auto nz = -std::sin((s + sd) * s_step);
+                const auto nr = -std::cos((r + rd) * r_step);
+                const auto nx = std::cos((s + sd) * s_step);
+                const auto ny = std::sin((r + rd) * r_step);
+                const auto nz = -std::sin((s + sd) * s_step);
 
-            dest[k(s, r, 0)] = float(nx * nr);
-            dest[k(s, r, 1)] = float(ny);
-            dest[k(s, r, 2)] = float(nz * nr);
+                dest[k(s, r, 0)] = float(nx * nr);
+                dest[k(s, r, 1)] = float(ny);
+                dest[k(s, r, 2)] = float(nz * nr);
+            }
+            dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
+            dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
+            dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
         }
-        dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
-        dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
-        dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
-    }
+    });
     for(const auto r : integer_range(_rings + 1)) {
         dest[k(_sections, r, 0)] = dest[k(0, r, 0)];
         dest[k(_sections, r, 1)] = dest[k(0, r, 1)];
@@ -167,23 +173,25 @@ void unit_torus_gen::tangentials(
 
     const auto s_step = 2 * math::pi / _sections;
 
-    for(const auto s : integer_range(_sections)) {
-        for(const auto r : integer_range(_rings)) {
-            const auto [rd, sd, td] = get_offs(s, r);
-            EAGINE_MAYBE_UNUSED(rd);
-            EAGINE_MAYBE_UNUSED(td);
+    parallel_for(_sections, [&](span_size_t s_begin, span_size_t s_end) {
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings)) {
+                const auto [rd, sd, td] = get_offs(s, r);
+                EAGINE_MAYBE_UNUSED(rd);
+                EAGINE_MAYBE_UNUSED(td);
 
-            const auto tx = -std::sin((s + sd) * s_step);
-            const auto tz = -std::cos((s + sd) * s_step);
+                const auto tx = -std::sin((s + sd) * s_step);
+                const auto tz = -std::cos((s + sd) * s_step);
 
-            dest[k(s, r, 0)] = float(tx);
-            dest[k(s, r, 1)] = float(0);
-            dest[k(s, r, 2)] = float(tz);
+                dest[k(s, r, 0)] = float(tx);
+                dest[k(s, r, 1)] = float(0);
+                dest[k(s, r, 2)] = float(tz);
+            }
+            dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
+            dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
+            dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
         }
-        dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
-        dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
-        dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
-    }
+    });
     for(const auto r : integer_range(_rings + 1)) {
         dest[k(_sections, r, 0)] = dest[k(0, r, 0)];
         dest[k(_sections, r, 1)] = dest[k(0, r, 1)];
@@ -207,26 +215,28 @@ void unit_torus_gen::bitangentials(
 
     const auto ty = 0;
 
-    for(const auto s : integer_range(_sections)) {
-        for(const auto r : integer_range(_rings)) {
-            const auto [rd, sd, td] = get_offs(s, r);
-            EAGINE_MAYBE_UNUSED(td);
-
-            const auto tx = -std::sin((s + sd) * s_step);
-            const auto tz = -std::cos((s + sd) * s_step);
-            const auto nr = -std::cos((r + rd) * r_step);
-            const auto ny = std::sin((r + rd) * r_step);
-            const auto nx = -tz * nr;
-            const auto nz = tx * nr;
-
-            dest[k(s, r, 0)] = float(ny * tz - nz * ty);
-            dest[k(s, r, 1)] = float(nz * tx - nx * tz);
-            dest[k(s, r, 2)] = float(nx * ty - ny * tx);
+    parallel_for(_sections, [&](span_size_t s_begin, span_size_t s_end) {
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings)) {
+                const auto [rd, sd, td] = get_offs(s, r);
+                EAGINE_MAYBE_UNUSED(td);
+
+                const auto tx = -std::sin((s + sd) * s_step);
+                const auto tz = -std::cos((s + sd) * s_step);
+                const auto nr = -std::cos((r + rd) * r_step);
+                const auto ny = std::sin((r + rd) * r_step);
+                const auto nx = -tz * nr;
+                const auto nz = tx * nr;
+
+                dest[k(s, r, 0)] = float(ny * tz - nz * ty);
+                dest[k(s, r, 1)] = float(nz * tx - nx * tz);
+                dest[k(s, r, 2)] = float(nx * ty - ny * tx);
+            }
+            dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
+            dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
+            dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
         }
-        dest[k(s, _rings, 0)] = dest[k(s, 0, 0)];
-        dest[k(s, _rings, 1)] = dest[k(s, 0, 1)];
-        dest[k(s, _rings, 2)] = dest[k(s, 0, 2)];
-    }
+    });
     for(const auto r : integer_range(_rings + 1)) {
         dest[k(_sections, r, 0)] = dest[k(0, r, 0)];
         dest[k(_sections, r, 1)] = dest[k(0, r, 1)];
@@ -239,17 +249,18 @@ void unit_torus_gen::wrap_coords(span<float> dest) noexcept {
     EAGINE_ASSERT(has(vertex_attrib_kind::wrap_coord));
     EAGINE_ASSERT(dest.size() >= vertex_count() * 2);
 
-    span_size_t k = 0;
-
     const auto s_step = 1.F / _sections;
     const auto r_step = 1.F / _rings;
 
-    for(const auto s : integer_range(_sections + 1)) {
-        for(const auto r : integer_range(_rings + 1)) {
-            dest[k++] = s * s_step;
-            dest[k++] = r * r_step;
+    parallel_for(_sections + 1, [&](span_size_t s_begin, span_size_t s_end) {
+        span_size_t k = s_begin * (_rings + 1) * 2;
+        for(const auto s : integer_range(s_begin, s_end)) {
+            for(const auto r : integer_range(_rings + 1)) {
+                dest[k++] = s * s_step;
+                dest[k++] = r * r_step;
+            }
         }
-    }
+    });
 }
 //------------------------------------------------------------------------------
 EAGINE_LIB_FUNC
@@ -266,13 +277,22 @@ void unit_torus_gen::make_special_attrib_values(
   span_size_t variant_index,
   span<float> dest) {
     if(variant_index == 1) {
-        auto get_offs = [rrg{std::mt19937{_r_seed}},
-                         srg{std::mt19937{_s_seed}},
-                         rnd{std::normal_distribution<float>{0.F, 0.15F}},
-                         snd{std::normal_distribution<float>{0.F, 0.15F}}](
-                          span_size_t,
-                          span_size_t) mutable -> std::array<float, 3> {
-            return {{rnd(rrg), snd(srg), 0.F}};
+        // the random offsets are generated up-front in the same order
+        // as before, so that the sections can be processed in parallel
+        std::mt19937 rrg{_r_seed};
+        std::mt19937 srg{_s_seed};
+        std::normal_distribution<float> rnd{0.F, 0.15F};
+        std::normal_distribution<float> snd{0.F, 0.15F};
+        std::vector<std::array<float, 3>> offsets;
+        offsets.reserve(std_size(_sections * _rings));
+        for(const auto i : integer_range(_sections * _rings)) {
+            EAGINE_MAYBE_UNUSED(i);
+            const auto rd = rnd(rrg);
+            offsets.push_back({{rd, snd(srg), 0.F}});
+        }
+        auto get_offs = [this, &offsets](span_size_t s, span_size_t r)
+          -> std::array<float, 3> {
+            return offsets[std_size(s * _rings + r)];
         };
         (this->*function)(dest, {construct_from, get_offs});
     } else if(variant_index == 2) {
@@ -426,17 +446,23 @@ void unit_torus_gen::_indices(drawing_variant var, span<T> dest) noexcept {
     span_size_t k = 0;
 
     if(var == 0) {
-        span_size_t step = _rings + 1;
-        for(const auto s : integer_range(_sections)) {
-            for(const auto r : integer_range(step)) {
-                dest[k++] = limit_cast<T>((s + 0) * step + r);
-                dest[k++] = limit_cast<T>((s + 1) * step + r);
-            }
-
-            if(primitive_restart()) {
-                dest[k++] = pri;
+        const span_size_t step = _rings + 1;
+        const bool restart = primitive_restart();
+        const span_size_t section_size = step * 2 + (restart ? 1 : 0);
+        parallel_for(_sections, [&](span_size_t s_begin, span_size_t s_end) {
+            span_size_t l = s_begin * section_size;
+            for(const auto s : integer_range(s_begin, s_end)) {
+                for(const auto r : integer_range(step)) {
+                    dest[l++] = limit_cast<T>((s + 0) * step + r);
+                    dest[l++] = limit_cast<T>((s + 1) * step + r);
+                }
+
+                if(restart) {
+                    dest[l++] = pri;
+                }
             }
-        }
+        });
+        k = _sections * section_size;
     } else if(var == 1) {
         for(const auto s : integer_range(_sections)) {
             for(const auto r : integer_range(_rings)) {
@@ -6,6 +6,8 @@
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
 
+#include <eagine/shapes/vertex_transform.hpp>
+
 namespace eagine {
 namespace shapes {
 //------------------------------------------------------------------------------
@@ -21,11 +23,8 @@ void translated_gen::attrib_values(vertex_attrib_variant vav, span<float> dest)
     if(is_translated_attrib) {
         const auto m = values_per_vertex(vav);
         const auto n = vertex_count();
-        for(const auto v : integer_range(n)) {
-            for(const auto c : integer_range(m)) {
-                dest[v * m + c] += _d[std_size(c)];
-            }
-        }
+        translate_vertex_values(
+          head(dest, n * m), m, {{_d[0], _d[1], _d[2], 0.F}});
     }
 }
 //------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
 
+#include <eagine/application_config.hpp>
 #include <eagine/main_ctx.hpp>
 #include <eagine/timeout.hpp>
 #include <vector>
@@ -14,9 +15,15 @@
 #include <eagine/file_contents.hpp>
 #include <eagine/from_string.hpp>
 #include <eagine/memory/span_algo.hpp>
-#include <eagine/value_tree/filesystem.hpp>
-#include <eagine/value_tree/wrappers.hpp>
+#include <eagine/string_algo.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <filesystem>
 #include <limits>
+#include <mutex>
+#include <utility>
+#include <fcntl.h>
 #include <sys/sysinfo.h>
 #endif
 
@@ -48,73 +55,69 @@ static inline auto system_info_linux_load_avg(std::size_t which) noexcept
              (std::thread::hardware_concurrency()));
 }
 //------------------------------------------------------------------------------
-class system_info_impl {
+// A sysfs attribute file, which is kept open and re-read with pread
+// each time a new sample of the value is requested. The reads use buffers
+// supplied by the caller, so that a value can be sampled concurrently.
+class system_info_sysfs_value {
 public:
-    system_info_impl(main_ctx_parent parent)
-      : _sysfs{valtree::from_filesystem_path("/sys/devices", parent)} {
-        auto sysfs_scanner = [this](
-                               valtree::compound& c,
-                               const valtree::attribute& a,
-                               const basic_string_path& p) {
-            if(!c.is_link(a)) {
-                bool is_tz{false};
-                bool is_cd{false};
-                bool is_ps{false};
-                for(auto& entry : p) {
-                    if(starts_with(entry, string_view("thermal_zone"))) {
-                        is_tz = true;
-                        break;
-                    }
-                    if(starts_with(entry, string_view("cooling_device"))) {
-                        is_cd = true;
-                        break;
-                    }
-                    if(starts_with(entry, string_view("power_supply"))) {
-                        is_ps = true;
-                        break;
-                    }
-                }
-                if(is_tz) {
-                    if(auto temp_a{c.nested(a, "temp")}) {
-                        if(auto type_a{c.nested(a, "type")}) {
-                            if(!_cpu_temp_i) {
-                                if(c.has_value(type_a, "cpu-thermal")) {
-                                    _cpu_temp_i = tz_count();
-                                } else if(c.has_value(type_a, "acpitz")) {
-                                    _cpu_temp_i = tz_count();
-                                }
-                            }
-                            _tz_temp_a.emplace_back(temp_a);
-                        }
-                    }
-                }
-                if(is_cd) {
-                    if(auto cur_a{c.nested(a, "cur_state")}) {
-                        if(auto max_a{c.nested(a, "max_state")}) {
-                            _cd_cm_a.emplace_back(cur_a, max_a);
-                        }
-                    }
+    system_info_sysfs_value(const std::filesystem::path& path) noexcept
+      : _fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)} {}
+
+    system_info_sysfs_value(system_info_sysfs_value&& temp) noexcept
+      : _fd{std::exchange(temp._fd, -1)} {}
+    system_info_sysfs_value(const system_info_sysfs_value&) = delete;
+    auto operator=(system_info_sysfs_value&&) = delete;
+    auto operator=(const system_info_sysfs_value&) = delete;
+
+    ~system_info_sysfs_value() noexcept {
+        if(_fd >= 0) {
+            ::close(_fd);
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return _fd >= 0;
+    }
+
+    auto read(memory::span<char> buf) noexcept -> string_view {
+        if(_fd >= 0) {
+            while(true) {
+                const auto len =
+                  ::pread(_fd, buf.data(), std_size(buf.size()), 0);
+                if(len >= 0) {
+                    return take_until(
+                      head(view(buf), span_size(len)), [](char c) {
+                          // isspace is undefined for negative char values
+                          return !c ||
+                                 std::isspace(static_cast<unsigned char>(c));
+                      });
                 }
-                if(is_ps) {
-                    if(auto type_a{c.nested(a, "type")}) {
-                        if(c.has_value(type_a, "Battery")) {
-                            if(auto cap_a{c.nested(a, "capacity")}) {
-                                _bat_cap_a.emplace_back(cap_a);
-                            }
-                        } else if(c.has_value(type_a, "Mains")) {
-                            if(auto onl_a{c.nested(a, "online")}) {
-                                _ac_online_a.emplace_back(onl_a);
-                            }
-                        }
-                    }
+                if(errno != EINTR) {
+                    break;
                 }
-                return true;
             }
-            return false;
-        };
-        _sysfs.traverse(
-          valtree::compound::visit_handler{construct_from, sysfs_scanner});
+        }
+        return {};
+    }
+
+    template <typename T>
+    auto fetch(T& dest) noexcept -> bool {
+        std::array<char, 64> buf{};
+        if(auto fetched{from_string<T>(read(cover(buf)))}) {
+            dest = extract(fetched);
+            return true;
+        }
+        return false;
+    }
 
+private:
+    int _fd{-1};
+};
+//------------------------------------------------------------------------------
+class system_info_impl {
+public:
+    system_info_impl(std::filesystem::path sysfs_root)
+      : _sysfs_root{std::move(sysfs_root)} {
         if(file_contents machine_id{"/etc/machine-id"}) {
             memory::for_each_chunk(
               as_chars(machine_id.block()),
@@ -136,18 +139,17 @@ public:
     }
 
     auto tz_count() noexcept -> span_size_t {
-        return span_size(_tz_temp_a.size());
+        _discover_thermal();
+        return span_size(_tz_temp.size());
     }
 
     auto tz_temperature(span_size_t index) noexcept
       -> valid_if_positive<kelvins_t<float>> {
         EAGINE_ASSERT((index >= 0) && (index < tz_count()));
-        auto& temp_a = _tz_temp_a[std_size(index)];
-        if(temp_a) {
-            float millicelsius{0.F};
-            if(_sysfs.fetch_value(temp_a, millicelsius)) {
-                return kelvins_(millicelsius * 0.001F + 273.15F);
-            }
+        _discover_thermal();
+        float millicelsius{0.F};
+        if(_tz_temp[std_size(index)].fetch(millicelsius)) {
+            return kelvins_(millicelsius * 0.001F + 273.15F);
         }
         return {kelvins_(0.F)};
     }
@@ -155,11 +157,12 @@ public:
     auto tz_min_max() noexcept -> std::tuple<
       valid_if_positive<kelvins_t<float>>,
       valid_if_positive<kelvins_t<float>>> {
+        _discover_thermal();
         auto min{std::numeric_limits<float>::max()};
         auto max{std::numeric_limits<float>::min()};
-        for(auto& temp_a : _tz_temp_a) {
+        for(auto& temp : _tz_temp) {
             float millicelsius{0.F};
-            if(_sysfs.fetch_value(temp_a, millicelsius)) {
+            if(temp.fetch(millicelsius)) {
                 min = std::min(min, millicelsius);
                 max = std::max(max, millicelsius);
             }
@@ -173,6 +176,7 @@ public:
     }
 
     auto cpu_temperature() noexcept -> valid_if_positive<kelvins_t<float>> {
+        _discover_thermal();
         if(_cpu_temp_i) {
             return tz_temperature(extract(_cpu_temp_i));
         }
@@ -180,6 +184,7 @@ public:
     }
 
     auto gpu_temperature() noexcept -> valid_if_positive<kelvins_t<float>> {
+        _discover_thermal();
         if(_gpu_temp_i) {
             return tz_temperature(extract(_gpu_temp_i));
         }
@@ -187,70 +192,151 @@ public:
     }
 
     auto cd_count() noexcept -> span_size_t {
-        return span_size(_cd_cm_a.size());
+        _discover_thermal();
+        return span_size(_cd_cur_max.size());
     }
 
     auto cd_state(span_size_t index) noexcept -> valid_if_between_0_1<float> {
         EAGINE_ASSERT((index >= 0) && (index < cd_count()));
-        auto& [cur_a, max_a] = _cd_cm_a[index];
-        if(cur_a && max_a) {
-            float cur_s{-1.F};
-            float max_s{-1.F};
-            if(
-              _sysfs.fetch_value(cur_a, cur_s) &&
-              _sysfs.fetch_value(max_a, max_s)) {
-                if(max_s > 0.F) {
-                    return {cur_s / max_s};
-                }
+        _discover_thermal();
+        auto& [cur_v, max_v] = _cd_cur_max[std_size(index)];
+        float cur_s{-1.F};
+        float max_s{-1.F};
+        if(cur_v.fetch(cur_s) && max_v.fetch(max_s)) {
+            if(max_s > 0.F) {
+                return {cur_s / max_s};
             }
         }
         return {-1.F};
     }
 
     auto bat_count() noexcept -> span_size_t {
-        return span_size(_bat_cap_a.size());
+        _discover_power_supply();
+        return span_size(_bat_cap.size());
     }
 
     auto bat_capacity(span_size_t index) noexcept
       -> valid_if_between_0_1<float> {
         EAGINE_ASSERT((index >= 0) && (index < bat_count()));
-        auto& cap_a = _bat_cap_a[index];
-        if(cap_a) {
-            float capacity{-1.F};
-            if(_sysfs.fetch_value(cap_a, capacity)) {
-                return {capacity * 0.01F};
-            }
+        _discover_power_supply();
+        float capacity{-1.F};
+        if(_bat_cap[std_size(index)].fetch(capacity)) {
+            return {capacity * 0.01F};
         }
         return {-1.F};
     }
 
     auto acps_count() noexcept -> span_size_t {
-        return span_size(_ac_online_a.size());
+        _discover_power_supply();
+        return span_size(_ac_online.size());
     }
 
     auto acps_online(span_size_t index) noexcept -> tribool {
         EAGINE_ASSERT((index >= 0) && (index < acps_count()));
-        auto& onl_a = _ac_online_a[index];
-        if(onl_a) {
-            int online{0};
-            if(_sysfs.fetch_value(onl_a, online)) {
-                return {online != 0};
-            }
+        _discover_power_supply();
+        int online{0};
+        if(_ac_online[std_size(index)].fetch(online)) {
+            return {online != 0};
         }
         return indeterminate;
     }
 
 private:
+    // lists the device directories in a sysfs class directory in the order
+    // of the device numbers (thermal_zone2 goes before thermal_zone10)
+    auto _class_devices(const char* class_name) const noexcept
+      -> std::vector<std::filesystem::path> {
+        std::vector<std::filesystem::path> result;
+        try {
+            std::error_code error;
+            for(auto& ent : std::filesystem::directory_iterator(
+                  _sysfs_root / "class" / class_name, error)) {
+                result.push_back(ent.path());
+            }
+            std::sort(
+              result.begin(), result.end(), [](const auto& l, const auto& r) {
+                  const auto& ls = l.native();
+                  const auto& rs = r.native();
+                  return (ls.size() != rs.size()) ? ls.size() < rs.size()
+                                                  : ls < rs;
+              });
+        } catch(...) {
+        }
+        return result;
+    }
+
+    static auto _has_value(
+      const std::filesystem::path& path,
+      string_view value) noexcept -> bool {
+        system_info_sysfs_value attrib{path};
+        std::array<char, 64> buf{};
+        return are_equal(attrib.read(cover(buf)), value);
+    }
+
+    // the system info is queried from several threads, the devices are
+    // discovered once on the first query of the respective sysfs class
+    void _discover_thermal() noexcept {
+        std::call_once(_thermal_once, [this] { _do_discover_thermal(); });
+    }
+
+    void _do_discover_thermal() noexcept {
+        for(auto& path : _class_devices("thermal")) {
+            const auto name{path.filename().native()};
+            if(starts_with(string_view(name), string_view("thermal_zone"))) {
+                system_info_sysfs_value temp{path / "temp"};
+                if(temp && exists(path / "type")) {
+                    if(!_cpu_temp_i) {
+                        if(
+                          _has_value(path / "type", "cpu-thermal") ||
+                          _has_value(path / "type", "acpitz")) {
+                            _cpu_temp_i = span_size(_tz_temp.size());
+                        }
+                    }
+                    _tz_temp.emplace_back(std::move(temp));
+                }
+            } else if(starts_with(
+                        string_view(name), string_view("cooling_device"))) {
+                system_info_sysfs_value cur{path / "cur_state"};
+                system_info_sysfs_value max{path / "max_state"};
+                if(cur && max) {
+                    _cd_cur_max.emplace_back(std::move(cur), std::move(max));
+                }
+            }
+        }
+    }
+
+    void _discover_power_supply() noexcept {
+        std::call_once(
+          _power_supply_once, [this] { _do_discover_power_supply(); });
+    }
+
+    void _do_discover_power_supply() noexcept {
+        for(auto& path : _class_devices("power_supply")) {
+            if(_has_value(path / "type", "Battery")) {
+                if(system_info_sysfs_value cap{path / "capacity"}) {
+                    _bat_cap.emplace_back(std::move(cap));
+                }
+            } else if(_has_value(path / "type", "Mains")) {
+                if(system_info_sysfs_value onl{path / "online"}) {
+                    _ac_online.emplace_back(std::move(onl));
+                }
+            }
+        }
+    }
+
     host_id_t _host_id{0};
-    valtree::compound _sysfs;
-    std::vector<valtree::attribute> _tz_temp_a;
+    const std::filesystem::path _sysfs_root;
+
+    std::once_flag _thermal_once;
+    std::vector<system_info_sysfs_value> _tz_temp;
     valid_if_nonnegative<span_size_t> _cpu_temp_i{-1};
     valid_if_nonnegative<span_size_t> _gpu_temp_i{-1};
+    std::vector<std::tuple<system_info_sysfs_value, system_info_sysfs_value>>
+      _cd_cur_max;
 
-    std::vector<std::tuple<valtree::attribute, valtree::attribute>> _cd_cm_a;
-
-    std::vector<valtree::attribute> _bat_cap_a;
-    std::vector<valtree::attribute> _ac_online_a;
+    std::once_flag _power_supply_once;
+    std::vector<system_info_sysfs_value> _bat_cap;
+    std::vector<system_info_sysfs_value> _ac_online;
 };
 //------------------------------------------------------------------------------
 #else
@@ -261,7 +347,8 @@ auto system_info::_impl() noexcept -> system_info_impl* {
 #if EAGINE_LINUX
     if(EAGINE_UNLIKELY(!_pimpl)) {
         try {
-            _pimpl = std::make_shared<system_info_impl>(*this);
+            _pimpl = std::make_shared<system_info_impl>(
+              cfg_init("system.sysfs_root", std::string("/sys")));
         } catch(...) {
         }
     }
@@ -5,21 +5,54 @@
 /// See accompanying file LICENSE_1_0.txt or copy at
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
+#include <eagine/config/platform.hpp>
 #include <eagine/from_string.hpp>
 #include <eagine/logging/type/exception.hpp>
 #include <eagine/logging/type/filesystem.hpp>
 #include <eagine/main_ctx_object.hpp>
 #include <eagine/value_tree/implementation.hpp>
+#include <algorithm>
+#include <cerrno>
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#if EAGINE_POSIX
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if EAGINE_LINUX && EAGINE_USE_INOTIFY
+#include <linux/magic.h>
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#endif
+
 namespace eagine::valtree {
 //------------------------------------------------------------------------------
 class filesystem_compound;
 class filesystem_node;
 //------------------------------------------------------------------------------
+// Sorted names of the entries in a directory, shared by all nodes referring
+// to that directory. Listings of watched directories are re-read only after
+// a change is reported, the others whenever the nested count is queried.
+struct filesystem_listing {
+    std::filesystem::path path;
+    std::vector<std::string> names;
+    int watch{-1};
+    bool can_watch{true};
+    bool is_valid{false};
+};
+//------------------------------------------------------------------------------
+static auto filesystem_listing_of(
+  filesystem_compound& owner,
+  const std::filesystem::path& real_path,
+  bool refresh) -> filesystem_listing&;
 static auto filesystem_make_node(
   filesystem_compound& owner,
   const std::filesystem::path& fs_path) -> attribute_interface*;
@@ -38,6 +71,26 @@ public:
     filesystem_node(const std::filesystem::path& fs_path)
       : filesystem_node{fs_path, canonical(fs_path)} {}
 
+    filesystem_node(filesystem_node&& temp) noexcept
+      : _node_path{std::move(temp._node_path)}
+      , _real_path{std::move(temp._real_path)}
+      , _name{std::move(temp._name)}
+      , _listing{std::exchange(temp._listing, nullptr)}
+      , _is_dir{temp._is_dir}
+      , _open_failed{temp._open_failed}
+      , _keep_open{temp._keep_open}
+      , _fd{std::exchange(temp._fd, -1)} {}
+
+    filesystem_node(const filesystem_node&) = delete;
+
+    ~filesystem_node() noexcept override {
+#if EAGINE_POSIX
+        if(_fd >= 0) {
+            ::close(_fd);
+        }
+#endif
+    }
+
     friend auto
     operator==(const filesystem_node& l, const filesystem_node& r) noexcept
       -> bool {
@@ -57,63 +110,35 @@ public:
     }
 
     auto nested_count(filesystem_compound& owner) -> span_size_t {
-        if(is_directory(_real_path)) {
-            try {
-                const auto iter =
-                  std::filesystem::directory_iterator(_node_path);
-                return span_size(std::distance(begin(iter), end(iter)));
-            } catch(const std::filesystem::filesystem_error& err) {
-                filesystem_object_of(owner)
-                  .log_debug("failed to get filesystem node count")
-                  .arg(EAGINE_ID(path), _node_path)
-                  .arg(EAGINE_ID(error), err);
-            }
+        if(auto listing{_listing_of(owner, true)}) {
+            return span_size(listing->names.size());
         }
         return 0;
     }
 
     auto nested(filesystem_compound& owner, span_size_t index)
       -> attribute_interface* {
-        try {
-            if(is_directory(_real_path)) {
-                for(auto& ent :
-                    std::filesystem::directory_iterator(_node_path)) {
-                    if(index > 0) {
-                        --index;
-                    } else {
-                        return filesystem_make_node(owner, ent);
-                    }
-                }
+        if(auto listing{_listing_of(owner, false)}) {
+            if((index >= 0) && (index < span_size(listing->names.size()))) {
+                return filesystem_make_node(
+                  owner, _node_path / listing->names[std_size(index)]);
             }
-        } catch(const std::filesystem::filesystem_error& err) {
-            filesystem_object_of(owner)
-              .log_debug("failed to get nested filesystem node for '${path}'")
-              .arg(EAGINE_ID(index), index)
-              .arg(EAGINE_ID(path), _node_path)
-              .arg(EAGINE_ID(error), err);
         }
         return nullptr;
     }
 
     auto nested(filesystem_compound& owner, string_view name)
       -> attribute_interface* {
-        try {
-            if(is_directory(_real_path)) {
-                for(auto& ent :
-                    std::filesystem::directory_iterator(_node_path)) {
-                    const std::filesystem::path& epath{ent};
-                    const std::string& ename{epath.filename()};
-                    if(are_equal(name, string_view(ename))) {
-                        return filesystem_make_node(owner, epath);
-                    }
-                }
+        if(auto listing{_listing_of(owner, false)}) {
+            const std::string_view key{name};
+            const auto& names = listing->names;
+            const auto pos = std::lower_bound(
+              names.begin(), names.end(), key, [](const auto& l, auto r) {
+                  return std::string_view(l) < r;
+              });
+            if((pos != names.end()) && (std::string_view(*pos) == key)) {
+                return filesystem_make_node(owner, _node_path / *pos);
             }
-        } catch(const std::filesystem::filesystem_error& err) {
-            filesystem_object_of(owner)
-              .log_debug("failed to get nested filesystem node for '${path}'")
-              .arg(EAGINE_ID(name), name)
-              .arg(EAGINE_ID(path), _node_path)
-              .arg(EAGINE_ID(error), err);
         }
         return nullptr;
     }
@@ -162,6 +187,43 @@ public:
         return nullptr;
     }
 
+#if EAGINE_POSIX
+    auto value_count() -> span_size_t {
+        span_size_t result = 0;
+        struct ::stat st {};
+        if((_open() >= 0) && (::fstat(_fd, &st) == 0)) {
+            result = span_size(st.st_size);
+        }
+        _release();
+        return result;
+    }
+
+    auto fetch_values(span_size_t offset, memory::block dest) -> span_size_t {
+        span_size_t done = 0;
+        if(_open() >= 0) {
+            while(done < dest.size()) {
+                const auto len = ::pread(
+                  _fd,
+                  dest.data() + done,
+                  std_size(dest.size() - done),
+                  static_cast<::off_t>(offset + done));
+                if(len > 0) {
+                    done += span_size(len);
+                } else if((len < 0) && (errno == EINTR)) {
+                    continue;
+                } else {
+                    break;
+                }
+            }
+        }
+        _release();
+        return done;
+    }
+
+    auto fetch_values(span_size_t offset, span<char> dest) -> span_size_t {
+        return fetch_values(offset, as_bytes(dest));
+    }
+#else
     auto value_count() -> span_size_t {
         if(is_regular_file(_real_path)) {
             return file_size(_real_path);
@@ -199,6 +261,8 @@ public:
         return 0;
     }
 
+#endif
+
     template <typename T>
     auto fetch_values(span_size_t offset, span<T> dest) -> span_size_t {
         if(dest.size() == 1) {
@@ -219,9 +283,71 @@ public:
     }
 
 private:
-    const std::filesystem::path _node_path;
-    const std::filesystem::path _real_path;
-    const std::string _name;
+    auto _listing_of(filesystem_compound& owner, bool refresh)
+      -> const filesystem_listing* {
+        try {
+            if(_is_dir && !_listing) {
+                _is_dir = is_directory(_real_path);
+            }
+            if(_is_dir) {
+                _listing = &filesystem_listing_of(owner, _real_path, refresh);
+            }
+        } catch(const std::filesystem::filesystem_error& err) {
+            filesystem_object_of(owner)
+              .log_debug("failed to list filesystem node '${path}'")
+              .arg(EAGINE_ID(path), _node_path)
+              .arg(EAGINE_ID(error), err);
+        }
+        return (_listing && _listing->is_valid) ? _listing : nullptr;
+    }
+
+#if EAGINE_POSIX
+    // the procfs/sysfs files are kept open while the node exists and are read
+    // with pread, so that their repeated polling is cheap. Other files are
+    // reopened on each read, because they may be atomically replaced
+    auto _open() -> int {
+        if((_fd < 0) && !_open_failed) {
+            _fd = ::open(_real_path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct ::stat st {};
+            if(_fd >= 0) {
+                if((::fstat(_fd, &st) != 0) || !S_ISREG(st.st_mode)) {
+                    ::close(_fd);
+                    _fd = -1;
+                    _open_failed = true;
+                } else {
+                    _keep_open = _is_pseudo_file(_fd);
+                }
+            }
+        }
+        return _fd;
+    }
+
+    void _release() noexcept {
+        if((_fd >= 0) && !_keep_open) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    static auto _is_pseudo_file([[maybe_unused]] int fd) noexcept -> bool {
+#if EAGINE_LINUX && EAGINE_USE_INOTIFY
+        struct ::statfs st {};
+        return (::fstatfs(fd, &st) == 0) &&
+               ((st.f_type == PROC_SUPER_MAGIC) || (st.f_type == SYSFS_MAGIC));
+#else
+        return false;
+#endif
+    }
+#endif
+
+    std::filesystem::path _node_path;
+    std::filesystem::path _real_path;
+    std::string _name;
+    const filesystem_listing* _listing{nullptr};
+    bool _is_dir{true};
+    bool _open_failed{false};
+    bool _keep_open{false};
+    int _fd{-1};
 };
 //------------------------------------------------------------------------------
 class filesystem_compound
@@ -233,6 +359,79 @@ class filesystem_compound
 
     filesystem_node _root;
     std::shared_ptr<file_compound_factory> _compound_factory;
+    std::map<std::string, filesystem_listing> _listings;
+    std::map<int, filesystem_listing*> _watches;
+    int _inotify{-1};
+
+    void _load(filesystem_listing& listing) {
+        // the watch is added first so that no change gets lost
+        _watch(listing);
+        listing.is_valid = false;
+        listing.names.clear();
+        for(auto& ent : std::filesystem::directory_iterator(listing.path)) {
+            listing.names.emplace_back(ent.path().filename());
+        }
+        std::sort(listing.names.begin(), listing.names.end());
+        listing.is_valid = true;
+    }
+
+    void _watch([[maybe_unused]] filesystem_listing& listing) {
+#if EAGINE_LINUX && EAGINE_USE_INOTIFY
+        if((_inotify < 0) || (listing.watch >= 0) || !listing.can_watch) {
+            return;
+        }
+        // procfs and sysfs do not report changes through inotify
+        struct ::statfs st {};
+        if(
+          (::statfs(listing.path.c_str(), &st) != 0) ||
+          (st.f_type == PROC_SUPER_MAGIC) || (st.f_type == SYSFS_MAGIC)) {
+            listing.can_watch = false;
+            return;
+        }
+        listing.watch = ::inotify_add_watch(
+          _inotify,
+          listing.path.c_str(),
+          IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+            IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+        if(listing.watch >= 0) {
+            _watches[listing.watch] = &listing;
+        } else {
+            listing.can_watch = false;
+        }
+#endif
+    }
+
+    void _poll_changes() {
+#if EAGINE_LINUX && EAGINE_USE_INOTIFY
+        if(_inotify < 0) {
+            return;
+        }
+        alignas(::inotify_event) char buf[4096];
+        while(true) {
+            const auto len = ::read(_inotify, buf, sizeof(buf));
+            if(len <= 0) {
+                break;
+            }
+            for(auto pos = 0L; pos < len;) {
+                const auto& event =
+                  *reinterpret_cast<const ::inotify_event*>(buf + pos);
+                if(event.mask & IN_Q_OVERFLOW) {
+                    for(auto& entry : _listings) {
+                        entry.second.is_valid = false;
+                    }
+                } else if(auto found{_watches.find(event.wd)};
+                          found != _watches.end()) {
+                    found->second->is_valid = false;
+                    if(event.mask & IN_IGNORED) {
+                        found->second->watch = -1;
+                        _watches.erase(found);
+                    }
+                }
+                pos += long(sizeof(::inotify_event) + event.len);
+            }
+        }
+#endif
+    }
 
 public:
     filesystem_compound(
@@ -241,7 +440,27 @@ public:
       std::shared_ptr<file_compound_factory> factory)
       : main_ctx_object{EAGINE_ID(FsVtCmpnd), parent}
       , _root{std::string_view{fs_path}}
-      , _compound_factory{std::move(factory)} {}
+      , _compound_factory{std::move(factory)} {
+#if EAGINE_LINUX && EAGINE_USE_INOTIFY
+        _inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(_inotify < 0) {
+            log_debug("directory listings are not watched for changes");
+        }
+#endif
+    }
+
+    filesystem_compound(filesystem_compound&&) = delete;
+    filesystem_compound(const filesystem_compound&) = delete;
+    auto operator=(filesystem_compound&&) = delete;
+    auto operator=(const filesystem_compound&) = delete;
+
+    ~filesystem_compound() noexcept override {
+#if EAGINE_POSIX
+        if(_inotify >= 0) {
+            ::close(_inotify);
+        }
+#endif
+    }
 
     static auto make_shared(
       main_ctx_parent parent,
@@ -302,6 +521,20 @@ public:
         return _unwrap(attrib).value_count();
     }
 
+    // returns the cached listing of the specified directory, the listing
+    // is re-read if a change was reported or if it is not watched and
+    // a refresh is requested
+    auto listing_of(const std::filesystem::path& real_path, bool refresh)
+      -> filesystem_listing& {
+        _poll_changes();
+        auto& listing = _listings[real_path.native()];
+        if(!listing.is_valid || (refresh && (listing.watch < 0))) {
+            listing.path = real_path;
+            _load(listing);
+        }
+        return listing;
+    }
+
     template <typename T>
     auto do_fetch_values(
       attribute_interface& attrib,
@@ -316,6 +549,13 @@ static inline auto filesystem_object_of(filesystem_compound& owner)
     return owner;
 }
 //------------------------------------------------------------------------------
+static inline auto filesystem_listing_of(
+  filesystem_compound& owner,
+  const std::filesystem::path& real_path,
+  bool refresh) -> filesystem_listing& {
+    return owner.listing_of(real_path, refresh);
+}
+//------------------------------------------------------------------------------
 static inline auto filesystem_make_node(
   filesystem_compound& owner,
   const std::filesystem::path& fs_path) -> attribute_interface* {
@@ -107,6 +107,11 @@ bool base_output::render_parent(const render_params& params) {
 }
 //------------------------------------------------------------------------------
 OGLPLUS_LIB_FUNC
+bool base_output::cpu_evaluate(const cpu_sample_params&, cpu_sample_values&) {
+    return false;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
 std::intptr_t base_output::get_id() const noexcept {
     return reinterpret_cast<std::intptr_t>(this);
 }
@@ -90,5 +90,31 @@ blur2d_output::definitions(std::ostream& out, compile_context& ctxt) {
     return closing_expr(out, ctxt);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool blur2d_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    static const float weights[3][3] = {
+      {0.05f, 0.10f, 0.05f}, {0.10f, 0.20f, 0.10f}, {0.05f, 0.10f, 0.05f}};
+
+    for(auto& c : r.c) {
+        c = cpu_fill(0.f);
+    }
+    cpu_sample_values v;
+    for(int y = -1; y <= 1; ++y) {
+        for(int x = -1; x <= 1; ++x) {
+            const auto q = cpu_offset_voxels(p, float(x), float(y), 0.f);
+            if(!input.output().cpu_evaluate(q, v)) {
+                return false;
+            }
+            const float w = weights[y + 1][x + 1];
+            for(std::size_t i = 0; i < r.c.size(); ++i) {
+                r.c[i] += v.c[i] * w;
+            }
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
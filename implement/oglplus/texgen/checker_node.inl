@@ -57,6 +57,24 @@ checker_output::definitions(std::ostream& out, compile_context& ctxt) {
 }
 //------------------------------------------------------------------------------
 OGLPLUS_LIB_FUNC
+bool checker_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    cpu_sample_values rep;
+    if(!cpu_evaluate_as(repeat.output(), p, slot_data_type::float_3, rep)) {
+        return false;
+    }
+    auto s = cpu_fill(0.f);
+    for(std::size_t i = 0; i < 3; ++i) {
+        const auto c =
+          p.norm_coord[i] * rep.c[i] + p.voxel_offset[i] * p.voxel_size[i];
+        s += cpu_mod(cpu_floor(c), 2.f);
+    }
+    r.c[0] = cpu_mod(s, 2.f);
+    return true;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
 pixel_checker_output::pixel_checker_output(node_intf& parent)
   : base_output(parent) {}
 //------------------------------------------------------------------------------
@@ -87,5 +105,18 @@ pixel_checker_output::definitions(std::ostream& out, compile_context& ctxt) {
     return closing_expr(out, ctxt);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool pixel_checker_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    auto s = cpu_fill(0.f);
+    for(std::size_t i = 0; i < 3; ++i) {
+        const auto c = p.norm_coord[i] / p.voxel_size[i] + p.voxel_offset[i];
+        s += cpu_mod(cpu_floor(c), 2.f);
+    }
+    r.c[0] = cpu_mod(s, 2.f);
+    return true;
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
@@ -48,5 +48,22 @@ coord_output::definitions(std::ostream& out, compile_context& context) {
     return closing_expr(out, context);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool coord_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    for(std::size_t i = 0; i < 3; ++i) {
+        switch(_type) {
+            case coord_type::normalized:
+                r.c[i] = cpu_norm_sample_coord(p, i);
+                break;
+            case coord_type::frag_coord:
+                r.c[i] = p.norm_coord[i] / p.voxel_size[i];
+                break;
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
@@ -0,0 +1,175 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/assert.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace eagine::oglp::texgen {
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+cpu_renderer& cpu_renderer::set_dimensions(
+  const valid_if_positive<int>& width,
+  const valid_if_positive<int>& height,
+  const valid_if_positive<int>& depth) {
+    _width = width.value_or(1);
+    _height = height.value_or(1);
+    _depth = depth.value_or(1);
+    return *this;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+cpu_renderer& cpu_renderer::set_tile_size(const valid_if_positive<int>& size) {
+    _tile_size = size.value_or(64);
+    return *this;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+cpu_renderer&
+cpu_renderer::use_workers(workshop& workers, span_size_t max_threads) {
+    _workers = &workers;
+    _max_threads = max_threads;
+    if(max_threads > 1) {
+        workers.ensure_workers(max_threads - 1);
+    }
+    return *this;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+span_size_t cpu_renderer::tile_count() const noexcept {
+    const auto tx = (_width + _tile_size - 1) / _tile_size;
+    const auto ty = (_height + _tile_size - 1) / _tile_size;
+    return span_size(tx) * ty * _depth;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+cpu_renderer::_tile_rect
+cpu_renderer::_get_tile(span_size_t tile) const noexcept {
+    const auto tx = span_size((_width + _tile_size - 1) / _tile_size);
+    const auto ty = span_size((_height + _tile_size - 1) / _tile_size);
+    _tile_rect r{};
+    r.x = int(tile % tx) * _tile_size;
+    r.y = int((tile / tx) % ty) * _tile_size;
+    r.z = int(tile / (tx * ty));
+    r.width = std::min(_tile_size, _width - r.x);
+    r.height = std::min(_tile_size, _height - r.y);
+    return r;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool cpu_renderer::_render_tile(
+  output_intf& output,
+  const _tile_rect& tile,
+  span<float> values) {
+    EAGINE_ASSERT(values.size() >= span_size(tile.width) * tile.height * 4);
+
+    // same parameters as in the fragment shader of the render node
+    cpu_sample_params params;
+    params.voxel_size[0] = cpu_fill(1.f / float(_width));
+    params.voxel_size[1] = cpu_fill(1.f / float(_height));
+    params.voxel_size[2] = cpu_fill(_depth > 1 ? 1.f / float(_depth) : 1.f);
+    params.norm_coord[2] =
+      cpu_fill(_depth > 1 ? (float(tile.z) + 0.5f) / float(_depth) : 0.f);
+
+    cpu_sample_values result;
+    float* dst = values.data();
+    for(int y = 0; y < tile.height; ++y) {
+        params.norm_coord[1] =
+          cpu_fill((float(tile.y + y) + 0.5f) / float(_height));
+        for(int x = 0; x < tile.width; x += cpu_lane_count) {
+            for(int l = 0; l < cpu_lane_count; ++l) {
+                params.norm_coord[0][l] =
+                  (float(tile.x + x + l) + 0.5f) / float(_width);
+            }
+            if(!cpu_evaluate_as(
+                 output, params, slot_data_type::float_4, result)) {
+                return false;
+            }
+            const int n = std::min(cpu_lane_count, tile.width - x);
+            for(int l = 0; l < n; ++l) {
+                for(std::size_t c = 0; c < 4; ++c) {
+                    *dst++ = result.c[c][l];
+                }
+            }
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+template <typename Store>
+bool cpu_renderer::_render_tiles(output_intf& output, const Store& store) {
+    std::atomic<bool> supported{true};
+    const auto func = [&](span_size_t, span_size_t begin, span_size_t end) {
+        std::vector<float> values(std_size(_tile_size * _tile_size * 4));
+        for(span_size_t t = begin; t < end; ++t) {
+            if(!supported) {
+                break;
+            }
+            const auto tile = _get_tile(t);
+            if(_render_tile(output, tile, cover(values))) {
+                store(tile, view(values));
+            } else {
+                supported = false;
+            }
+        }
+    };
+    if(_workers && (_max_threads > 1)) {
+        _workers->parallel_for(tile_count(), _max_threads, func);
+    } else {
+        func(0, 0, tile_count());
+    }
+    return supported;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool cpu_renderer::render(output_intf& output, span<float> dest) {
+    EAGINE_ASSERT(dest.size() >= texel_count() * 4);
+    return _render_tiles(
+      output, [this, dest](const _tile_rect& tile, span<const float> values) {
+          const auto row_size = std_size(tile.width * 4);
+          for(int y = 0; y < tile.height; ++y) {
+              const auto offs =
+                ((span_size(tile.z) * _height + tile.y + y) * _width + tile.x) *
+                4;
+              std::memcpy(
+                dest.data() + offs,
+                values.data() + row_size * std_size(y),
+                row_size * sizeof(float));
+          }
+      });
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool cpu_renderer::render(
+  output_intf& output,
+  span_size_t channels,
+  span<byte> dest) {
+    EAGINE_ASSERT((channels > 0) && (channels <= 4));
+    EAGINE_ASSERT(dest.size() >= texel_count() * channels);
+    return _render_tiles(
+      output,
+      [this, channels, dest](const _tile_rect& tile, span<const float> values) {
+          const float* src = values.data();
+          for(int y = 0; y < tile.height; ++y) {
+              auto offs =
+                ((span_size(tile.z) * _height + tile.y + y) * _width + tile.x) *
+                channels;
+              for(int x = 0; x < tile.width; ++x) {
+                  for(span_size_t c = 0; c < channels; ++c) {
+                      const auto v = std::min(std::max(src[c], 0.f), 1.f);
+                      dest.data()[offs++] = byte(v * 255.f + 0.5f);
+                  }
+                  src += 4;
+              }
+          }
+      });
+}
+//------------------------------------------------------------------------------
+} // namespace eagine::oglp::texgen
+//------------------------------------------------------------------------------
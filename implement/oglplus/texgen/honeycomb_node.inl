@@ -7,6 +7,7 @@
 ///
 #include <eagine/assert.hpp>
 #include <eagine/maybe_unused.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace eagine::oglp::texgen {
@@ -170,6 +171,75 @@ honeycomb_output::definitions(std::ostream& out, compile_context& ctxt) {
 }
 //------------------------------------------------------------------------------
 OGLPLUS_LIB_FUNC
+bool honeycomb_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    cpu_sample_values cells;
+    if(!cpu_evaluate_as(_cells.output(), p, slot_data_type::float_2, cells)) {
+        return false;
+    }
+    const std::array<cpu_lanes, 2> cell_count{{cells.c[0], cells.c[1]}};
+    const std::array<cpu_lanes, 2> cell_size{
+      {cpu_fill(1.f) / cpu_max(cell_count[0], 1.f),
+       cpu_fill(1.f) / cpu_max(cell_count[1], 1.f)}};
+    const std::array<cpu_lanes, 2> norm_coord{
+      {cpu_norm_sample_coord(p, 0), cpu_norm_sample_coord(p, 1)}};
+    const bool vertical = _direction == honeycomb_direction::vertical;
+
+    auto min_dist = cpu_fill(2.f);
+    std::array<cpu_lanes, 2> min_cell{};
+    for(int i = 0; i < 9; ++i) {
+        const std::array<float, 2> cell_offs{
+          {float(i / 3 - 1), float(i % 3 - 1)}};
+        std::array<cpu_lanes, 2> cell_coord{};
+        for(std::size_t k = 0; k < 2; ++k) {
+            cell_coord[k] =
+              cpu_floor(norm_coord[k] * cell_count[k] + cell_offs[k]);
+        }
+        const auto stripes = cpu_mod(cell_coord[vertical ? 1 : 0], 2.f);
+        const std::array<cpu_lanes, 2> rel_center{
+          {vertical ? cpu_fill(0.5f) - stripes * 0.5f : cpu_fill(0.5f),
+           vertical ? cpu_fill(0.5f) : stripes * 0.5f}};
+
+        std::array<cpu_lanes, 2> abs_center{};
+        for(std::size_t k = 0; k < 2; ++k) {
+            cell_coord[k] *= cell_size[k];
+            abs_center[k] = cell_coord[k] + cell_size[k] * rel_center[k];
+        }
+        const auto dx = norm_coord[0] - abs_center[0];
+        const auto dy = norm_coord[1] - abs_center[1];
+        const auto dist = cpu_sqrt(dx * dx + dy * dy);
+        const auto closer = cpu_apply(min_dist - dist, [](float d) {
+            return d > 0.f ? 1.f : 0.f;
+        });
+
+        min_dist = cpu_select(closer, dist, min_dist);
+        const auto& cell = (_type == honeycomb_output_type::cell_center)
+                             ? abs_center
+                             : cell_coord;
+        for(std::size_t k = 0; k < 2; ++k) {
+            min_cell[k] = cpu_select(closer, cell[k], min_cell[k]);
+        }
+    }
+
+    switch(_type) {
+        case honeycomb_output_type::distance:
+            for(int l = 0; l < cpu_lane_count; ++l) {
+                r.c[0][l] = min_dist[l] *
+                            std::min(cell_count[0][l], cell_count[1][l]) /
+                            std::sqrt(2.f);
+            }
+            break;
+        case honeycomb_output_type::cell_coord:
+        case honeycomb_output_type::cell_center:
+            r.c[0] = min_cell[0];
+            r.c[1] = min_cell[1];
+            break;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
 std::ostream& honeycomb_output::expression(std::ostream& out, compile_context&) {
     append_id(out);
     return out << type_abbr();
@@ -45,5 +45,18 @@ invert_output::definitions(std::ostream& out, compile_context& ctxt) {
     return closing_expr(out, ctxt);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool invert_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    if(!input.output().cpu_evaluate(p, r)) {
+        return false;
+    }
+    for(auto& c : r.c) {
+        c = cpu_fill(1.f) - c;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
@@ -71,5 +71,38 @@ mandelbrot_output::definitions(std::ostream& result, compile_context& context) {
     return closing_expr(result, context);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool mandelbrot_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    const int max = 128;
+    const auto cx = cpu_norm_sample_coord(p, 0);
+    const auto cy = cpu_norm_sample_coord(p, 1);
+    auto zx = cpu_fill(0.f);
+    auto zy = cpu_fill(0.f);
+    auto i = cpu_fill(0.f);
+
+    for(int n = 0; n < max; ++n) {
+        const auto dx = cx - zx;
+        const auto dy = cy - zy;
+        const auto active = cpu_apply(
+          dx * dx + dy * dy, [](float d) { return d < 4.f ? 1.f : 0.f; });
+        if(!cpu_any(active)) {
+            break;
+        }
+        const auto nx = zx * zx - zy * zy + cx;
+        const auto ny = zx * zy * 2.f + cy;
+        zx = cpu_select(active, nx, zx);
+        zy = cpu_select(active, ny, zy);
+        i += active;
+    }
+
+    const auto dx = zx - cx;
+    const auto dy = zy - cy;
+    r.c[0] = i / float(max);
+    r.c[1] = cpu_sqrt(dx * dx + dy * dy) * 0.5f;
+    return true;
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
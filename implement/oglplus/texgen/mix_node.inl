@@ -66,6 +66,27 @@ std::ostream& mix_output::definitions(std::ostream& out, compile_context& ctxt)
 }
 //------------------------------------------------------------------------------
 OGLPLUS_LIB_FUNC
+bool mix_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    const slot_data_type res_type = value_type();
+    cpu_sample_values a, t;
+    if(!cpu_evaluate_as(zero.output(), p, res_type, a)) {
+        return false;
+    }
+    if(!cpu_evaluate_as(one.output(), p, res_type, r)) {
+        return false;
+    }
+    if(!cpu_evaluate_as(value.output(), p, slot_data_type::float_, t)) {
+        return false;
+    }
+    for(std::size_t i = 0; i < r.c.size(); ++i) {
+        r.c[i] = a.c[i] + (r.c[i] - a.c[i]) * t.c[0];
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
 span_size_t mix_node::input_count() {
     return 3;
 }
@@ -182,5 +182,58 @@ newton_output::definitions(std::ostream& result, compile_context& context) {
     return closing_expr(result, context);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool newton_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    const int max = 64;
+    auto zx = cpu_norm_sample_coord(p, 0);
+    auto zy = cpu_norm_sample_coord(p, 1);
+    auto active = cpu_fill(1.f);
+    auto i = cpu_fill(0.f);
+
+    for(int n = 0; n < max; ++n) {
+        cpu_lanes fx, fy, dx, dy;
+        if(_function == newton_function::xe3minus1) {
+            fx = zx * zx * zx - zx * zy * zy * 3.f - 1.f;
+            fy = zx * zx * zy * 3.f - zy * zy * zy;
+            dx = (zx * zx - zy * zy) * 3.f;
+            dy = zx * zy * 6.f;
+        } else if(_function == newton_function::xe4minus1) {
+            fx = zx * zx * zx * zx + zy * zy * zy * zy -
+                 zx * zx * zy * zy * 6.f - 1.f;
+            fy = zx * zx * zx * zy * 4.f - zx * zy * zy * zy * 4.f;
+            dx = (zx * zx * zx - zx * zy * zy * 3.f) * 4.f;
+            dy = (zx * zx * zy * 3.f - zy * zy * zy) * 4.f;
+        } else {
+            return false;
+        }
+        // complex division, the lanes with zero divisor keep the dividend
+        const auto d = dx * dx + dy * dy;
+        const auto nonzero =
+          cpu_apply(d, [](float v) { return v != 0.f ? 1.f : 0.f; });
+        const auto sd = cpu_select(nonzero, d, cpu_fill(1.f));
+        const auto qx = cpu_select(nonzero, (fx * dx + fy * dy) / sd, fx);
+        const auto qy = cpu_select(nonzero, (fy * dx - fx * dy) / sd, fy);
+
+        const auto nx = zx - qx;
+        const auto ny = zy - qy;
+        const auto ex = nx - zx;
+        const auto ey = ny - zy;
+        const auto converged = cpu_apply(
+          ex * ex + ey * ey, [](float e) { return e < 1e-10f ? 1.f : 0.f; });
+        active = cpu_select(converged, cpu_fill(0.f), active);
+        if(!cpu_any(active)) {
+            break;
+        }
+        zx = cpu_select(active, nx, zx);
+        zy = cpu_select(active, ny, zy);
+        i += active;
+    }
+
+    r.c[0] = i / float(max);
+    return true;
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
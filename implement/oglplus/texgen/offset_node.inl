@@ -55,5 +55,20 @@ offset_output::definitions(std::ostream& out, compile_context& ctxt) {
     return closing_expr(out, ctxt);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool offset_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    cpu_sample_values o;
+    if(!cpu_evaluate_as(offset.output(), p, slot_data_type::float_3, o)) {
+        return false;
+    }
+    auto q = p;
+    for(std::size_t i = 0; i < 3; ++i) {
+        q.norm_coord[i] += o.c[i];
+    }
+    return input.output().cpu_evaluate(q, r);
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
@@ -59,5 +59,21 @@ scale_output::definitions(std::ostream& out, compile_context& ctxt) {
     return closing_expr(out, ctxt);
 }
 //------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+bool scale_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    cpu_sample_values s;
+    if(!cpu_evaluate_as(scale.output(), p, slot_data_type::float_3, s, 1.f)) {
+        return false;
+    }
+    auto q = p;
+    for(std::size_t i = 0; i < 3; ++i) {
+        q.norm_coord[i] /= s.c[i];
+        q.voxel_size[i] /= s.c[i];
+    }
+    return input.output().cpu_evaluate(q, r);
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::oglp::texgen
 //------------------------------------------------------------------------------
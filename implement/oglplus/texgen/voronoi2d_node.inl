@@ -5,6 +5,7 @@
 /// See accompanying file LICENSE_1_0.txt or copy at
 ///  http://www.boost.org/LICENSE_1_0.txt
 ///
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -223,6 +224,106 @@ voronoi2d_output::definitions(std::ostream& out, compile_context& ctxt) {
 }
 //------------------------------------------------------------------------------
 OGLPLUS_LIB_FUNC
+bool voronoi2d_output::cpu_evaluate(
+  const cpu_sample_params& p,
+  cpu_sample_values& r) {
+    const slot_data_type v2 = slot_data_type::float_2;
+
+    cpu_sample_values cells;
+    if(!cpu_evaluate_as(_cells.output(), p, v2, cells)) {
+        return false;
+    }
+    const std::array<cpu_lanes, 2> cell_count{{cells.c[0], cells.c[1]}};
+    const std::array<cpu_lanes, 2> cell_size{
+      {cpu_fill(1.f) / cpu_max(cell_count[0], 1.f),
+       cpu_fill(1.f) / cpu_max(cell_count[1], 1.f)}};
+    const std::array<cpu_lanes, 2> norm_coord{
+      {cpu_norm_sample_coord(p, 0), cpu_norm_sample_coord(p, 1)}};
+
+    // the input is sampled with (vec3(cell_coord,0), vec3(cell_size,1), 0)
+    cpu_sample_params cell_params;
+    cell_params.voxel_size = {{cell_size[0], cell_size[1], cpu_fill(1.f)}};
+
+    if(_type == voronoi_output_type::input_cell_center) {
+        for(std::size_t k = 0; k < 2; ++k) {
+            cell_params.norm_coord[k] =
+              cpu_floor(norm_coord[k] * cell_count[k]) * cell_size[k];
+        }
+        return cpu_evaluate_as(_input.output(), cell_params, value_type(), r);
+    }
+
+    const auto ord = std_size(order());
+    std::array<std::array<float, 3>, cpu_lane_count> min_dist{};
+    std::array<std::array<std::array<float, 2>, 3>, cpu_lane_count> min_cell{};
+    for(auto& lane : min_dist) {
+        lane.fill(2.f);
+    }
+
+    cpu_sample_values rel_center;
+    for(int i = 0; i < 9; ++i) {
+        const std::array<float, 2> cell_offs{
+          {float(i / 3 - 1), float(i % 3 - 1)}};
+        std::array<cpu_lanes, 2> cell_coord{};
+        for(std::size_t k = 0; k < 2; ++k) {
+            cell_coord[k] =
+              cpu_floor(norm_coord[k] * cell_count[k] + cell_offs[k]) *
+              cell_size[k];
+            cell_params.norm_coord[k] = cell_coord[k];
+        }
+        if(!cpu_evaluate_as(_input.output(), cell_params, v2, rel_center)) {
+            return false;
+        }
+        const std::array<cpu_lanes, 2> abs_center{
+          {cell_coord[0] + rel_center.c[0] * cell_size[0],
+           cell_coord[1] + rel_center.c[1] * cell_size[1]}};
+        const auto dx = norm_coord[0] - abs_center[0];
+        const auto dy = norm_coord[1] - abs_center[1];
+        const auto dist = cpu_sqrt(dx * dx + dy * dy);
+
+        const auto& cell = (_type == voronoi_output_type::cell_center)
+                             ? abs_center
+                             : cell_coord;
+        for(int l = 0; l < cpu_lane_count; ++l) {
+            auto& ld = min_dist[std_size(l)];
+            auto& lc = min_cell[std_size(l)];
+            for(std::size_t o = 0; o < ord; ++o) {
+                if(ld[o] > dist[l]) {
+                    for(std::size_t k = ord - 1; k > o; --k) {
+                        ld[k] = ld[k - 1];
+                        lc[k] = lc[k - 1];
+                    }
+                    ld[o] = dist[l];
+                    lc[o] = {{cell[0][l], cell[1][l]}};
+                    break;
+                }
+            }
+        }
+    }
+
+    for(int l = 0; l < cpu_lane_count; ++l) {
+        const auto& ld = min_dist[std_size(l)];
+        const auto& lc = min_cell[std_size(l)];
+        switch(_type) {
+            case voronoi_output_type::distance1:
+            case voronoi_output_type::distance2:
+            case voronoi_output_type::distance3:
+                r.c[0][l] = ld[ord - 1] *
+                            std::min(cell_count[0][l], cell_count[1][l]) /
+                            std::sqrt(2.f);
+                break;
+            case voronoi_output_type::cell_coord:
+            case voronoi_output_type::cell_center:
+                r.c[0][l] = lc[ord - 1][0];
+                r.c[1][l] = lc[ord - 1][1];
+                break;
+            case voronoi_output_type::input_cell_center:
+                break;
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
 std::ostream& voronoi2d_output::expression(std::ostream& out, compile_context&) {
     append_id(out);
     return out << type_abbr();
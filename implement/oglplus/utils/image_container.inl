@@ -0,0 +1,272 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/memory/align.hpp>
+#include <eagine/memory/span_algo.hpp>
+#include <algorithm>
+#include <new>
+#include <ostream>
+
+namespace eagine::oglp {
+//------------------------------------------------------------------------------
+// the container header, the level table and the level data are aligned
+static constexpr const span_size_t image_container_align = 64;
+//------------------------------------------------------------------------------
+static inline auto image_container_aligned(span_size_t size) noexcept
+  -> span_size_t {
+    return ((size + image_container_align - 1) / image_container_align) *
+           image_container_align;
+}
+//------------------------------------------------------------------------------
+static inline auto image_container_contains(
+  memory::const_block data,
+  memory::const_block part) noexcept -> bool {
+    return (part.begin() >= data.begin()) && (part.end() <= data.end()) &&
+           (part.begin() <= part.end());
+}
+//------------------------------------------------------------------------------
+// checks that the (unpacked) level data is a valid image block
+static inline auto image_container_valid_image(
+  memory::const_block level) noexcept -> bool {
+    if(
+      (level.size() < span_size(sizeof(image_data_header))) ||
+      !memory::is_aligned_as<image_data_header>(level.addr())) {
+        return false;
+    }
+    const auto* image = static_cast<const image_data_header*>(level.addr());
+    return image->magic.is_valid() &&
+           image_container_contains(level, as_bytes(image->pixels));
+}
+//------------------------------------------------------------------------------
+// texture_image_container
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+texture_image_container::texture_image_container(
+  file_contents contents) noexcept
+  : _contents{std::move(contents)}
+  , _header{_validate(_contents.block())} {}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container::_validate(memory::const_block data) noexcept
+  -> const image_container_header* {
+    if(
+      (data.size() < span_size(sizeof(image_container_header))) ||
+      !memory::is_aligned_as<image_container_header>(data.addr())) {
+        return nullptr;
+    }
+    const auto* header =
+      static_cast<const image_container_header*>(data.addr());
+    if(!header->magic.is_valid() || header->levels.empty()) {
+        return nullptr;
+    }
+    if(!image_container_contains(data, as_bytes(header->levels))) {
+        return nullptr;
+    }
+    for(span_size_t i = 0; i < header->levels.size(); ++i) {
+        const auto& level = header->levels[i];
+        if(!image_container_contains(data, level.data)) {
+            return nullptr;
+        }
+        if((level.packed == 0) && !image_container_valid_image(level.data)) {
+            return nullptr;
+        }
+    }
+    return header;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container::dimensions(span_size_t index) const noexcept
+  -> image_dimensions {
+    const auto& entry = _level(index);
+    return {entry.width, entry.height, entry.depth, _header->channels};
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container::level(span_size_t index) const noexcept
+  -> texture_image_block {
+    const auto& entry = _level(index);
+    EAGINE_ASSERT(entry.packed == 0);
+    return {_level_data(entry)};
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container::unpack_level(
+  span_size_t index,
+  chunked_data_compressor& compressor,
+  memory::buffer& buf) const -> memory::const_block {
+    const auto& entry = _level(index);
+    if(entry.packed == 0) {
+        return _level_data(entry);
+    }
+    const auto unpacked = compressor.decompress(_level_data(entry), buf);
+    if(
+      (unpacked.size() != entry.unpacked_size) ||
+      !image_container_valid_image(unpacked)) {
+        return {};
+    }
+    return unpacked;
+}
+//------------------------------------------------------------------------------
+// texture_image_container_builder
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+texture_image_container_builder::texture_image_container_builder(
+  const image_data_header& base)
+  : _base{base} {
+    _add_level(_base.width, _base.height);
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container_builder::_add_level(
+  gl_types::sizei_type w,
+  gl_types::sizei_type h) -> span<byte> {
+    const auto pixels_size = span_size(w) * h * _base.depth * _base.channels;
+    const auto header_size = image_container_aligned(sizeof(image_data_header));
+
+    memory::buffer buf;
+    buf.resize(header_size + pixels_size);
+    zero(cover(buf));
+
+    auto* image = new(buf.data()) image_data_header(
+      w, h, _base.depth, _base.channels);
+    image->format = _base.format;
+    image->internal_format = _base.internal_format;
+    image->data_type = _base.data_type;
+    image->pixels.reset(buf.addr() + header_size, pixels_size);
+
+    _levels.emplace_back(std::move(buf));
+    return _pixels(level_count() - 1);
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container_builder::_pixels(span_size_t index) noexcept
+  -> span<byte> {
+    const auto header_size = image_container_aligned(sizeof(image_data_header));
+    return skip(cover(_levels[std_size(index)]), header_size);
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container_builder::level(span_size_t index) const noexcept
+  -> texture_image_block {
+    return {view(_levels[std_size(index)])};
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto texture_image_container_builder::add_mipmaps(
+  image_mipmap_generator& gen,
+  span_size_t max_levels) -> bool {
+    if(_base.data_type != GL_UNSIGNED_BYTE) {
+        return false;
+    }
+    const auto count = std::min(
+      max_levels,
+      image_mipmap_generator::level_count(_base.width, _base.height));
+    while(level_count() < count) {
+        const auto src_level = level_count() - 1;
+        const auto src_width =
+          image_mipmap_generator::level_size(_base.width, src_level);
+        const auto src_height =
+          image_mipmap_generator::level_size(_base.height, src_level);
+        auto dst = _add_level(
+          image_mipmap_generator::level_size(src_width, 1),
+          image_mipmap_generator::level_size(src_height, 1));
+        gen.downsample(
+          _pixels(src_level),
+          src_width,
+          src_height,
+          _base.depth,
+          _base.channels,
+          dst);
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+void texture_image_container_builder::_write(
+  std::ostream& output,
+  const std::vector<memory::const_block>& packed) const {
+    const auto header_size =
+      image_container_aligned(sizeof(image_container_header));
+    const auto table_size = image_container_aligned(
+      span_size(sizeof(image_container_level)) * level_count());
+
+    // the header and the level table are built in memory with the same
+    // layout as in the file, so that the offset spans are set properly
+    memory::buffer directory;
+    directory.resize(header_size + table_size);
+    zero(cover(directory));
+    const auto base_addr = directory.addr();
+
+    auto* header = new(directory.data()) image_container_header();
+    header->width = _base.width;
+    header->height = _base.height;
+    header->layers = _base.depth;
+    header->channels = _base.channels;
+    header->format = _base.format;
+    header->internal_format = _base.internal_format;
+    header->data_type = _base.data_type;
+    auto* levels = reinterpret_cast<image_container_level*>(
+      directory.data() + header_size);
+    for(span_size_t i = 0; i < level_count(); ++i) {
+        new(levels + i) image_container_level();
+    }
+    header->levels.reset(levels, level_count());
+
+    span_size_t offset = header_size + table_size;
+    for(span_size_t i = 0; i < level_count(); ++i) {
+        const auto& src = packed[std_size(i)];
+        const auto& unpacked = _levels[std_size(i)];
+        const texture_image_block image{view(unpacked)};
+        const auto dims = image.dimensions();
+        auto& level = levels[i];
+        level.width = dims.width();
+        level.height = dims.height();
+        level.depth = dims.depth();
+        level.packed = src.empty() ? 0U : 1U;
+        level.unpacked_size = unpacked.size();
+        level.data.reset(
+          base_addr + offset, src.empty() ? unpacked.size() : src.size());
+        offset = image_container_aligned(offset + level.data.size());
+    }
+    write_to_stream(output, view(directory));
+
+    const char zeros[image_container_align] = {};
+    offset = header_size + table_size;
+    for(span_size_t i = 0; i < level_count(); ++i) {
+        const auto& src = packed[std_size(i)];
+        const auto data = src.empty() ? view(_levels[std_size(i)]) : src;
+        write_to_stream(output, data);
+        const auto next = image_container_aligned(offset + data.size());
+        output.write(zeros, std::streamsize(next - offset - data.size()));
+        offset = next;
+    }
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+void texture_image_container_builder::write(std::ostream& output) const {
+    _write(output, std::vector<memory::const_block>(_levels.size()));
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+void texture_image_container_builder::write(
+  std::ostream& output,
+  chunked_data_compressor& compressor,
+  data_compression_level level) const {
+    std::vector<memory::buffer> buffers(_levels.size());
+    std::vector<memory::const_block> packed(_levels.size());
+    for(std::size_t i = 0; i < _levels.size(); ++i) {
+        const auto unpacked = view(_levels[i]);
+        const auto blk = compressor.compress(unpacked, buffers[i], level);
+        if(!blk.empty() && (blk.size() < unpacked.size())) {
+            packed[i] = blk;
+        }
+    }
+    _write(output, packed);
+}
+//------------------------------------------------------------------------------
+} // namespace eagine::oglp
+//------------------------------------------------------------------------------
@@ -0,0 +1,176 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <eagine/assert.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace eagine::oglp {
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto image_mipmap_generator::use_workers(
+  workshop& workers,
+  span_size_t max_threads) -> image_mipmap_generator& {
+    _workers = &workers;
+    _max_threads = max_threads;
+    if(max_threads > 1) {
+        workers.ensure_workers(max_threads - 1);
+    }
+    return *this;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto image_mipmap_generator::level_count(
+  gl_types::sizei_type width,
+  gl_types::sizei_type height) noexcept -> span_size_t {
+    span_size_t result = 1;
+    for(auto size = std::max(width, height); size > 1; size /= 2) {
+        ++result;
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+static inline auto image_mipmap_bessel_i0(float x) noexcept -> float {
+    float sum = 1.f;
+    float term = 1.f;
+    for(int k = 1; k < 32; ++k) {
+        const float h = x / (2.f * float(k));
+        term *= h * h;
+        sum += term;
+        if(term < sum * 1e-7f) {
+            break;
+        }
+    }
+    return sum;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+auto image_mipmap_generator::_make_taps(int factor) const -> _taps {
+    _taps result;
+    if(factor < 2) {
+        result.weights.push_back(1.f);
+    } else if(_filter == image_mipmap_filter::kaiser) {
+        // windowed sinc with three source pixels on each side of the center
+        const float alpha = 4.f;
+        const float radius = 1.5f;
+        const float pi = 3.14159265358979f;
+        result.first = -2;
+        float sum = 0.f;
+        for(int k = 0; k < 6; ++k) {
+            const float t = (float(result.first + k) - 0.5f) / 2.f;
+            const float r = t / radius;
+            const float sinc = std::sin(pi * t) / (pi * t);
+            const float window =
+              image_mipmap_bessel_i0(alpha * std::sqrt(1.f - r * r)) /
+              image_mipmap_bessel_i0(alpha);
+            result.weights.push_back(sinc * window);
+            sum += result.weights.back();
+        }
+        for(auto& weight : result.weights) {
+            weight /= sum;
+        }
+    } else {
+        result.weights.assign(2U, 0.5f);
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+void image_mipmap_generator::_downsample_row(
+  const byte* src,
+  gl_types::sizei_type src_width,
+  gl_types::sizei_type src_height,
+  gl_types::sizei_type channels,
+  int dst_y,
+  gl_types::sizei_type dst_width,
+  const _taps& htaps,
+  const _taps& vtaps,
+  byte* dst,
+  std::vector<_pixel_t>& temp) const noexcept {
+    const int hfactor = htaps.weights.size() > 1 ? 2 : 1;
+    const int vfactor = vtaps.weights.size() > 1 ? 2 : 1;
+    const auto row_size = std_size(src_width * channels);
+
+    // vertical pass into a row of SIMD pixels
+    std::fill(temp.begin(), temp.end(), _pixel_t{});
+    const int first_row = vfactor * dst_y + vtaps.first;
+    for(std::size_t k = 0; k < vtaps.weights.size(); ++k) {
+        const auto y =
+          std::min(std::max(first_row + int(k), 0), int(src_height) - 1);
+        const byte* row = src + row_size * std_size(y);
+        const float weight = vtaps.weights[k];
+        for(std::size_t x = 0; x < temp.size(); ++x) {
+            _pixel_t pixel{};
+            for(int c = 0; c < channels; ++c) {
+                pixel[c] = float(*row++);
+            }
+            temp[x] += pixel * weight;
+        }
+    }
+
+    // horizontal pass into the destination row
+    for(int x = 0; x < dst_width; ++x) {
+        _pixel_t pixel{};
+        const int first_col = hfactor * x + htaps.first;
+        for(std::size_t k = 0; k < htaps.weights.size(); ++k) {
+            const auto s =
+              std::min(std::max(first_col + int(k), 0), int(src_width) - 1);
+            pixel += temp[std_size(s)] * htaps.weights[k];
+        }
+        for(int c = 0; c < channels; ++c) {
+            *dst++ = byte(std::min(std::max(pixel[c], 0.f), 255.f) + 0.5f);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+OGLPLUS_LIB_FUNC
+void image_mipmap_generator::downsample(
+  span<const byte> src,
+  gl_types::sizei_type width,
+  gl_types::sizei_type height,
+  gl_types::sizei_type layers,
+  gl_types::sizei_type channels,
+  span<byte> dst) {
+    EAGINE_ASSERT((channels > 0) && (channels <= 4));
+    const auto dst_width = level_size(width, 1);
+    const auto dst_height = level_size(height, 1);
+    EAGINE_ASSERT(src.size() >= span_size(width) * height * layers * channels);
+    EAGINE_ASSERT(
+      dst.size() >= span_size(dst_width) * dst_height * layers * channels);
+
+    const auto htaps = _make_taps(width > dst_width ? 2 : 1);
+    const auto vtaps = _make_taps(height > dst_height ? 2 : 1);
+    const auto src_layer = span_size(width) * height * channels;
+    const auto dst_row = span_size(dst_width) * channels;
+
+    const auto func = [&](span_size_t, span_size_t begin, span_size_t end) {
+        std::vector<_pixel_t> temp(std_size(width));
+        for(span_size_t r = begin; r < end; ++r) {
+            const auto layer = r / dst_height;
+            _downsample_row(
+              src.data() + layer * src_layer,
+              width,
+              height,
+              channels,
+              int(r % dst_height),
+              dst_width,
+              htaps,
+              vtaps,
+              dst.data() + r * dst_row,
+              temp);
+        }
+    };
+    const auto row_count = span_size(dst_height) * layers;
+    if(_workers && (_max_threads > 1)) {
+        _workers->parallel_for(row_count, _max_threads, func);
+    } else {
+        func(0, 0, row_count);
+    }
+}
+//------------------------------------------------------------------------------
+} // namespace eagine::oglp
+//------------------------------------------------------------------------------
@@ -13,7 +13,10 @@
 #include "program_args.hpp"
 #include "valid_if/decl.hpp"
 #include "value_tree/wrappers.hpp"
+#include <any>
+#include <cstdint>
 #include <memory>
+#include <typeinfo>
 #include <vector>
 
 namespace eagine {
@@ -26,6 +29,8 @@ class application_config_impl;
 ///
 /// This class allow to read application configuration values from from
 /// environment variables, command line arguments and/or configuration files.
+/// The resolved values are memoized per key, tag and value type, so repeated
+/// reads of the same value do not search through all the sources again.
 class application_config : public main_ctx_object {
 public:
     application_config(main_ctx_parent parent) noexcept
@@ -37,8 +42,133 @@ public:
         return *this;
     }
 
+    /// @brief Discards the memoized values and the loaded configuration files.
+    /// @see refresh
+    void reload() noexcept;
+
+    /// @brief Does reload if any of the looked-up configuration files changed.
+    /// @see reload
+    ///
+    /// The modification times of the configuration files that were looked up
+    /// (including those that did not exist) are compared to the ones at the
+    /// time of the lookup. This is intended to be called periodically or when
+    /// notified about a file change.
+    auto refresh() noexcept -> bool;
+
     /// @brief Checks is the boolean option identified by @p key is set to true.
     auto is_set(string_view key, string_view tag = {}) noexcept -> bool {
+        const auto generation{_memo_generation()};
+        if(const auto memo{_find_memo(key, tag, typeid(_is_set_tag))}) {
+            return std::any_cast<bool>(*memo);
+        }
+        const bool result{_is_set(key, tag)};
+        _memoize(key, tag, typeid(_is_set_tag), result, generation);
+        return result;
+    }
+
+    /// @brief Fetches the configuration value identified by @p key, into @p dest.
+    template <typename T>
+    auto fetch(string_view key, T& dest, string_view tag = {}) noexcept
+      -> bool {
+        const auto generation{_memo_generation()};
+        if(const auto memo{_find_memo(key, tag, typeid(T))}) {
+            if(const auto* value{std::any_cast<T>(memo.get())}) {
+                dest = *value;
+                return true;
+            }
+            return false;
+        }
+        if(_fetch(key, dest, tag)) {
+            _memoize(key, tag, typeid(T), dest, generation);
+            return true;
+        }
+        _memoize(key, tag, typeid(T), {}, generation);
+        return false;
+    }
+
+    /// @brief Fetches the configuration values identified by @p key, into @p dest.
+    template <typename T, typename A>
+    auto fetch(
+      string_view key,
+      std::vector<T, A>& dest,
+      string_view tag = {}) noexcept {
+        using V = std::vector<T, A>;
+        const auto generation{_memo_generation()};
+        if(const auto memo{_find_memo(key, tag, typeid(V))}) {
+            if(const auto* values{std::any_cast<V>(memo.get())}) {
+                dest.insert(dest.end(), values->begin(), values->end());
+                return true;
+            }
+            return false;
+        }
+        V values;
+        const bool fetched{_fetch(key, values, tag)};
+        dest.insert(dest.end(), values.begin(), values.end());
+        if(fetched) {
+            _memoize(key, tag, typeid(V), std::move(values), generation);
+        } else {
+            _memoize(key, tag, typeid(V), {}, generation);
+        }
+        return fetched;
+    }
+
+    /// @brief Fetches the configuration value identified by @p key, into @p dest.
+    template <typename T, typename P>
+    auto fetch(string_view key, valid_if<T, P>& dest, string_view tag) noexcept
+      -> bool {
+        T temp{};
+        if(fetch(key, temp, tag)) {
+            if(dest.is_valid(temp)) {
+                dest = std::move(temp);
+                return true;
+            } else {
+                log_error("value '${value}' is not valid for '${key}'")
+                  .arg(EAGINE_ID(value), temp)
+                  .arg(EAGINE_ID(key), key);
+            }
+        }
+        return false;
+    }
+
+    /// @brief Returns the configuration value or type @p T, identified by @p key.
+    template <typename T>
+    auto get(string_view key, type_identity<T> = {}) -> optionally_valid<T> {
+        T temp{};
+        const auto fetched = fetch(key, temp);
+        return {std::move(temp), fetched};
+    }
+
+    /// @brief Fetches the configuration value identified by @p key, into @p init.
+    template <typename T>
+    auto init(string_view key, T& initial, string_view tag = {}) -> T {
+        fetch(key, initial, tag);
+        return initial;
+    }
+
+private:
+    std::shared_ptr<application_config_impl> _pimpl;
+    auto _impl() noexcept -> application_config_impl*;
+
+    struct _is_set_tag {};
+
+    // the generation is read before the lookup and passed to _memoize,
+    // which drops the value if the memo was reloaded in the meantime
+    auto _memo_generation() noexcept -> std::uint64_t;
+    // returns the memoized value, which is empty if the value was not found,
+    // or nullptr if the value was not memoized yet. The value stays valid
+    // while the returned pointer is held, even if the memo is reloaded
+    auto _find_memo(
+      string_view key,
+      string_view tag,
+      const std::type_info& type) noexcept -> std::shared_ptr<const std::any>;
+    void _memoize(
+      string_view key,
+      string_view tag,
+      const std::type_info& type,
+      std::any value,
+      std::uint64_t generation) noexcept;
+
+    auto _is_set(string_view key, string_view tag) noexcept -> bool {
         if(const auto attr{_find_comp_attr(key, tag)}) {
             bool flag{false};
             if(attr.select_value(flag, application_config_tag())) {
@@ -59,10 +189,8 @@ public:
         return false;
     }
 
-    /// @brief Fetches the configuration value identified by @p key, into @p dest.
     template <typename T>
-    auto fetch(string_view key, T& dest, string_view tag = {}) noexcept
-      -> bool {
+    auto _fetch(string_view key, T& dest, string_view tag) noexcept -> bool {
         if(const auto arg{_find_prog_arg(key)}) {
             if(arg.parse_next(
                  dest, application_config_tag(), log_error_stream())) {
@@ -94,12 +222,10 @@ public:
         return false;
     }
 
-    /// @brief Fetches the configuration values identified by @p key, into @p dest.
     template <typename T, typename A>
-    auto fetch(
-      string_view key,
-      std::vector<T, A>& dest,
-      string_view tag = {}) noexcept {
+    auto
+    _fetch(string_view key, std::vector<T, A>& dest, string_view tag) noexcept
+      -> bool {
         const auto arg_name{_prog_arg_name(key)};
         for(auto arg : _prog_args()) {
             if(arg.is_tag(arg_name)) {
@@ -140,43 +266,6 @@ public:
         return true;
     }
 
-    /// @brief Fetches the configuration value identified by @p key, into @p dest.
-    template <typename T, typename P>
-    auto fetch(string_view key, valid_if<T, P>& dest, string_view tag) noexcept
-      -> bool {
-        T temp{};
-        if(fetch(key, temp, tag)) {
-            if(dest.is_valid(temp)) {
-                dest = std::move(temp);
-                return true;
-            } else {
-                log_error("value '${value}' is not valid for '${key}'")
-                  .arg(EAGINE_ID(value), temp)
-                  .arg(EAGINE_ID(key), key);
-            }
-        }
-        return false;
-    }
-
-    /// @brief Returns the configuration value or type @p T, identified by @p key.
-    template <typename T>
-    auto get(string_view key, type_identity<T> = {}) -> optionally_valid<T> {
-        T temp{};
-        const auto fetched = fetch(key, temp);
-        return {std::move(temp), fetched};
-    }
-
-    /// @brief Fetches the configuration value identified by @p key, into @p init.
-    template <typename T>
-    auto init(string_view key, T& initial, string_view tag = {}) -> T {
-        fetch(key, initial, tag);
-        return initial;
-    }
-
-private:
-    std::shared_ptr<application_config_impl> _pimpl;
-    auto _impl() noexcept -> application_config_impl*;
-
     auto _find_comp_attr(string_view key, string_view tag) noexcept
       -> valtree::compound_attribute;
 
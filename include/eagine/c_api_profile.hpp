@@ -0,0 +1,281 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#ifndef EAGINE_C_API_PROFILE_HPP
+#define EAGINE_C_API_PROFILE_HPP
+
+#include "branch_predict.hpp"
+#include "c_api_wrap.hpp"
+#include "config/basic.hpp"
+#include "string_span.hpp"
+#include "types.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+/// @brief Call statistics of a single profiled C-API function.
+/// @ingroup c_api_wrap
+/// @see c_api_call_profile
+struct c_api_function_stats {
+    /// @brief The name of the function, empty if it was not linked by name.
+    std::string name;
+
+    /// @brief The address of the function.
+    const void* address{nullptr};
+
+    /// @brief The number of calls of the function.
+    std::uint64_t call_count{0U};
+
+    /// @brief The total time spent in the function (if timing is enabled).
+    std::chrono::nanoseconds total_time{0};
+};
+//------------------------------------------------------------------------------
+/// @brief Compact record of a single call in the C-API call trace.
+/// @ingroup c_api_wrap
+/// @see c_api_call_profile
+struct c_api_trace_record {
+    /// @brief The start of the call in nanoseconds since the profile epoch.
+    std::uint64_t start_ns{0U};
+
+    /// @brief The index of the called function in the profile.
+    /// @see c_api_call_profile::function_stats
+    std::uint32_t function_index{0U};
+
+    /// @brief The duration of the call in nanoseconds (saturated).
+    std::uint32_t duration_ns{0U};
+};
+//------------------------------------------------------------------------------
+/// @brief Class collecting call counts, times and traces of C-API functions.
+/// @ingroup c_api_wrap
+/// @see profiling_c_api_traits
+///
+/// The functions are identified by their addresses, which are kept in a fixed
+/// size open-addressing table, so that recording a call does not allocate or
+/// lock. Counting of the calls is always enabled, measuring of the call times
+/// and tracing of the calls into a ring buffer can be enabled separately.
+/// The trace records are published with a sequence stamp, so calls can be
+/// traced from multiple threads and the trace read concurrently.
+class c_api_call_profile {
+public:
+    c_api_call_profile() noexcept;
+
+    /// @brief Returns the number of functions that can be profiled separately.
+    /// @note The calls to functions beyond this limit are counted together.
+    static constexpr auto max_functions() noexcept -> span_size_t {
+        return span_size_t(_slot_count) - 1;
+    }
+
+    /// @brief Associates the specified function address with a name.
+    void register_function(const void* address, string_view name);
+
+    /// @brief Enables or disables the measuring of the call times.
+    void enable_timing(bool enable = true) noexcept {
+        _timing.store(enable, std::memory_order_relaxed);
+    }
+
+    /// @brief Indicates if the call times are measured.
+    auto is_timing() const noexcept -> bool {
+        return _timing.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Enables the tracing of up to capacity most recent calls.
+    /// @see disable_trace
+    /// @note This must not be called concurrently with the profiled calls.
+    ///
+    /// Tracing implies measuring of the call times.
+    void enable_trace(span_size_t capacity);
+
+    /// @brief Disables the tracing of calls and clears the trace.
+    /// @note This must not be called concurrently with the profiled calls.
+    void disable_trace() {
+        enable_trace(0);
+    }
+
+    /// @brief Indicates if the calls are traced.
+    auto is_tracing() const noexcept -> bool {
+        return !_trace.empty();
+    }
+
+    /// @brief Resets the call counts, times and the trace.
+    void reset() noexcept;
+
+    /// @brief Returns the statistics of the called functions.
+    ///
+    /// The index of a function in the returned vector is the function index
+    /// in the trace records.
+    auto function_stats() const -> std::vector<c_api_function_stats>;
+
+    /// @brief Returns the trace of the most recent calls, the oldest first.
+    /// @note Records being written or overwritten concurrently are skipped.
+    auto trace() const -> std::vector<c_api_trace_record>;
+
+    /// @brief Writes a report of the top count functions by calls and time.
+    auto write_report(std::ostream&, span_size_t count = 20) const
+      -> std::ostream&;
+
+    /// @brief Records a call of a function in the profile.
+    class call_scope {
+    public:
+        call_scope(c_api_call_profile& profile, const void* address) noexcept
+          : _profile{profile}
+          , _index{profile._slot_of(address)}
+          , _timed{profile.is_timing()} {
+            _profile._slots[_index].call_count.fetch_add(
+              1U, std::memory_order_relaxed);
+            if(EAGINE_UNLIKELY(_timed)) {
+                _start = _clock::now();
+            }
+        }
+
+        call_scope(call_scope&&) = delete;
+        call_scope(const call_scope&) = delete;
+        auto operator=(call_scope&&) = delete;
+        auto operator=(const call_scope&) = delete;
+
+        ~call_scope() noexcept {
+            if(EAGINE_UNLIKELY(_timed)) {
+                _profile._record(_index, _start, _clock::now());
+            }
+        }
+
+    private:
+        c_api_call_profile& _profile;
+        std_size_t _index;
+        bool _timed;
+        std::chrono::steady_clock::time_point _start{};
+    };
+
+private:
+    using _clock = std::chrono::steady_clock;
+
+    // the last slot counts the calls of all functions that did not fit
+    // into the rest of the table
+    static constexpr const std_size_t _slot_count{1024U};
+
+    struct _slot {
+        std::atomic<const void*> address{nullptr};
+        std::atomic<std::uint64_t> call_count{0U};
+        std::atomic<std::uint64_t> total_ns{0U};
+    };
+
+    auto _slot_of(const void* address) noexcept -> std_size_t {
+        const auto key{reinterpret_cast<std::uintptr_t>(address)};
+        auto index{((key >> 4U) * 0x9E3779B97F4A7C15U) % (_slot_count - 1U)};
+        if(EAGINE_LIKELY(
+             _slots[index].address.load(std::memory_order_acquire) ==
+             address)) {
+            return index;
+        }
+        return _find_slot(address, index);
+    }
+
+    auto _find_slot(const void* address, std_size_t index) noexcept
+      -> std_size_t;
+    void _record(
+      std_size_t index,
+      _clock::time_point start,
+      _clock::time_point finish) noexcept;
+
+    _clock::time_point _epoch;
+    std::atomic<bool> _timing{false};
+    std::array<_slot, _slot_count> _slots{};
+
+    struct _trace_entry {
+        // 2 * pos + 1 while the record at position pos is being written,
+        // 2 * pos + 2 once it is complete, zero if the entry was not used
+        std::atomic<std::uint64_t> stamp{0U};
+        std::atomic<std::uint64_t> start_ns{0U};
+        std::atomic<std::uint32_t> function_index{0U};
+        std::atomic<std::uint32_t> duration_ns{0U};
+    };
+
+    std::vector<_trace_entry> _trace{};
+    std::atomic<std::uint64_t> _trace_pos{0U};
+
+    mutable std::mutex _names_mutex{};
+    std::vector<std::tuple<const void*, std::string>> _names{};
+};
+//------------------------------------------------------------------------------
+/// @brief Policy adaptor profiling the calls of the functions of a C-API.
+/// @tparam Traits the adapted C-API traits, like default_c_api_traits.
+/// @ingroup c_api_wrap
+/// @see c_api_call_profile
+/// @see default_c_api_traits
+///
+/// This can be used in place of the adapted traits in the instantiation
+/// of the C-API wrappers. The dynamically linked functions are registered
+/// in the profile by name, the statically linked ones only by address.
+template <typename Traits>
+class profiling_c_api_traits : public Traits {
+public:
+    using Traits::Traits;
+
+    /// @brief Returns the call profile of the C-API functions.
+    static auto profile() noexcept -> c_api_call_profile& {
+        static c_api_call_profile the_profile;
+        return the_profile;
+    }
+
+    /// @brief Links the function using the adapted traits, registers it.
+    template <typename Api, typename Tag, typename Signature>
+    auto link_function(
+      Api& api,
+      Tag tag,
+      string_view name,
+      type_identity<Signature> sig) -> std::add_pointer_t<Signature> {
+        auto function{Traits::link_function(api, tag, name, sig)};
+        if(function) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            profile().register_function(
+              reinterpret_cast<const void*>(function), name);
+        }
+        return function;
+    }
+
+    template <typename RV, typename Tag, typename... Params, typename... Args>
+    static auto
+    call_static(Tag tag, RV (*function)(Params...), Args&&... args) -> RV {
+        if(function) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const c_api_call_profile::call_scope scope{
+              profile(), reinterpret_cast<const void*>(function)};
+            return Traits::call_static(
+              tag, function, std::forward<Args>(args)...);
+        }
+        return Traits::call_static(tag, function, std::forward<Args>(args)...);
+    }
+
+    template <typename RV, typename Tag, typename... Params, typename... Args>
+    static auto
+    call_dynamic(Tag tag, RV (*function)(Params...), Args&&... args) -> RV {
+        if(function) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const c_api_call_profile::call_scope scope{
+              profile(), reinterpret_cast<const void*>(function)};
+            return Traits::call_dynamic(
+              tag, function, std::forward<Args>(args)...);
+        }
+        return Traits::call_dynamic(
+          tag, function, std::forward<Args>(args)...);
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+#if !EAGINE_LINK_LIBRARY || defined(EAGINE_IMPLEMENTING_LIBRARY)
+#include <eagine/c_api_profile.inl>
+#endif
+
+#endif // EAGINE_C_API_PROFILE_HPP
@@ -0,0 +1,163 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_CHUNKED_COMPRESSION_HPP
+#define EAGINE_CHUNKED_COMPRESSION_HPP
+
+#include "compression.hpp"
+#include "main_ctx_fwd.hpp"
+#include "memory/block.hpp"
+#include "memory/buffer.hpp"
+#include "types.hpp"
+#include <vector>
+
+namespace eagine {
+class workshop;
+//------------------------------------------------------------------------------
+/// @brief Read-only view of a chunked compressed data container.
+/// @ingroup main_context
+/// @see chunked_data_compressor
+///
+/// The container consists of a fixed-size header, an index with the end
+/// offsets of the individual chunks and the chunks themselves, each of them
+/// compressed independently by data_compressor. This allows to unpack
+/// only the chunks containing the required part of the original data.
+class chunked_compressed_view {
+public:
+    /// @brief Default constructor. Constructs an invalid view.
+    chunked_compressed_view() noexcept = default;
+
+    /// @brief Construction from a block with the container data.
+    chunked_compressed_view(memory::const_block data) noexcept;
+
+    /// @brief Indicates if the specified block starts with a container header.
+    static auto is_chunked(memory::const_block data) noexcept -> bool;
+
+    /// @brief Indicates if the viewed data is a valid container.
+    auto is_valid() const noexcept -> bool {
+        return _chunk_size > 0;
+    }
+
+    /// @brief Indicates if the viewed data is a valid container.
+    /// @see is_valid
+    explicit operator bool() const noexcept {
+        return is_valid();
+    }
+
+    /// @brief Returns the size of the original uncompressed data.
+    auto total_size() const noexcept -> span_size_t {
+        return _total_size;
+    }
+
+    /// @brief Returns the uncompressed size of the chunks (except the last).
+    auto chunk_size() const noexcept -> span_size_t {
+        return _chunk_size;
+    }
+
+    /// @brief Returns the number of compressed chunks.
+    auto chunk_count() const noexcept -> span_size_t {
+        return _chunk_count;
+    }
+
+    /// @brief Returns the index of chunk containing the specified data offset.
+    auto chunk_index(span_size_t offset) const noexcept -> span_size_t {
+        return offset / _chunk_size;
+    }
+
+    /// @brief Returns the offset of the chunk with the specified index.
+    auto chunk_offset(span_size_t index) const noexcept -> span_size_t {
+        return index * _chunk_size;
+    }
+
+    /// @brief Returns the unpacked size of the chunk at the specified index.
+    auto unpacked_size(span_size_t index) const noexcept -> span_size_t;
+
+    /// @brief Returns the compressed data of the chunk at the specified index.
+    auto packed_chunk(span_size_t index) const noexcept -> memory::const_block;
+
+    /// @brief Unpacks the chunk at the specified index into the output buffer.
+    auto unpack_chunk(
+      data_compressor& compressor,
+      span_size_t index,
+      memory::buffer& output) const -> memory::const_block;
+
+private:
+    memory::const_block _index{};
+    memory::const_block _chunks{};
+    span_size_t _total_size{0};
+    span_size_t _chunk_size{0};
+    span_size_t _chunk_count{0};
+};
+//------------------------------------------------------------------------------
+/// @brief Class compressing and decompressing large blocks in parallel.
+/// @ingroup main_context
+/// @see chunked_compressed_view
+///
+/// The input is split into chunks, that are compressed independently
+/// by a set of data_compressors on the threads of a workshop and stored
+/// in a container with a chunk index.
+/// A single instance should be used only from one thread at a time.
+class chunked_data_compressor {
+public:
+    /// @brief Returns the default chunk size.
+    static constexpr auto default_chunk_size() noexcept -> span_size_t {
+        return 1024 * 1024;
+    }
+
+    /// @brief Construction with a reference to workshop and the chunk size.
+    /// @param workers the thread pool doing the work.
+    /// @param thread_count the maximum number of chunks processed in parallel.
+    /// @param chunk_size the size of the chunks the input is split into.
+    chunked_data_compressor(
+      workshop& workers,
+      span_size_t thread_count,
+      span_size_t chunk_size = default_chunk_size());
+
+    /// @brief Construction using the workshop from the main context.
+    chunked_data_compressor(main_ctx_getters& ctx);
+
+    /// @brief Returns the maximum number of chunks processed in parallel.
+    auto thread_count() const noexcept -> span_size_t {
+        return span_size(_compressors.size());
+    }
+
+    /// @brief Returns the size of the chunks the input is split into.
+    auto chunk_size() const noexcept -> span_size_t {
+        return _chunk_size;
+    }
+
+    /// @brief Compress the input block, writing the container to output.
+    auto compress(
+      memory::const_block input,
+      memory::buffer& output,
+      data_compression_level level) -> memory::const_block;
+
+    /// @brief Compress the input block, writing the container to output.
+    auto compress(memory::const_block input, memory::buffer& output)
+      -> memory::const_block {
+        return compress(input, output, data_compression_level::normal);
+    }
+
+    /// @brief Decompress the input container, writing the data to output.
+    auto decompress(memory::const_block input, memory::buffer& output)
+      -> memory::const_block;
+
+private:
+    workshop& _workers;
+    span_size_t _chunk_size{default_chunk_size()};
+    std::vector<data_compressor> _compressors;
+    std::vector<memory::buffer> _packed_chunks;
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+#if !EAGINE_LINK_LIBRARY || defined(EAGINE_IMPLEMENTING_LIBRARY)
+#include <eagine/chunked_compression.inl>
+#endif
+
+#endif // EAGINE_CHUNKED_COMPRESSION_HPP
@@ -12,6 +12,8 @@
 #include "callable_ref.hpp"
 #include "memory/block.hpp"
 #include "memory/buffer.hpp"
+#include "span.hpp"
+#include <cstdint>
 #include <memory>
 
 namespace eagine {
@@ -30,10 +32,39 @@ enum class data_compression_level {
     highest
 };
 //------------------------------------------------------------------------------
+/// @brief Alias for preset compression dictionary identifier type.
+/// @ingroup main_context
+/// @see data_compressor::add_dictionary
+///
+/// The dictionary id is stored in the header byte of the compressed data,
+/// values 0 and 1 are reserved for uncompressed data and data compressed
+/// without a dictionary, value 255 for data stored in chunks.
+using data_compression_dictionary_id = std::uint8_t;
+
+/// @brief Returns the dictionary id value meaning "no dictionary".
+/// @ingroup main_context
+static constexpr auto no_compression_dictionary() noexcept
+  -> data_compression_dictionary_id {
+    return 0U;
+}
+
+/// @brief Returns the header byte of data stored in chunks without compression.
+/// @ingroup main_context
+/// @see data_compress_stream
+///
+/// Each chunk is prefixed by its 32-bit little-endian size, an empty chunk
+/// marks the end of the data.
+static constexpr auto stored_chunks_compression_header() noexcept -> byte {
+    return 0xFFU;
+}
+//------------------------------------------------------------------------------
 class data_compressor_impl;
 
 /// @brief Class implementing data compression and decompresson.
 /// @ingroup main_context
+///
+/// Copies of data_compressor share the compression contexts, which are reused
+/// between calls, and the registered preset dictionaries.
 class data_compressor {
 public:
     /// @brief Default constructor.
@@ -42,17 +73,53 @@ public:
     /// @brief Alias for data handler callable type.
     using data_handler = callable_ref<bool(memory::const_block)>;
 
+    /// @brief Builds a preset dictionary from the specified sample payloads.
+    /// @see add_dictionary
+    ///
+    /// The dictionary consists of the byte sequences that occur most often
+    /// in the samples, the most frequent ones are put at the end.
+    static auto make_dictionary(
+      span<const memory::const_block> samples,
+      span_size_t max_size) -> memory::buffer;
+
+    /// @brief Registers a preset dictionary with the specified id (2 - 254).
+    /// @see make_dictionary
+    ///
+    /// Data compressed with a dictionary can be decompressed only by
+    /// compressors that have the same dictionary registered with the same id.
+    auto add_dictionary(
+      data_compression_dictionary_id dictionary_id,
+      memory::const_block dictionary) -> bool;
+
     /// @brief Compress the input block, passing the packed data to handler.
     auto compress(
       memory::const_block input,
       const data_handler& handler,
-      data_compression_level level) -> bool;
+      data_compression_level level) -> bool {
+        return compress(input, handler, level, no_compression_dictionary());
+    }
+
+    /// @brief Compress the input block using a dictionary, passing data to handler.
+    auto compress(
+      memory::const_block input,
+      const data_handler& handler,
+      data_compression_level level,
+      data_compression_dictionary_id dictionary_id) -> bool;
 
     /// @brief Compress the input block, writing the compressed data to output.
     auto compress(
       memory::const_block input,
       memory::buffer& output,
-      data_compression_level level) -> memory::const_block;
+      data_compression_level level) -> memory::const_block {
+        return compress(input, output, level, no_compression_dictionary());
+    }
+
+    /// @brief Compress the input block using a dictionary, writing to output.
+    auto compress(
+      memory::const_block input,
+      memory::buffer& output,
+      data_compression_level level,
+      data_compression_dictionary_id dictionary_id) -> memory::const_block;
 
     /// @brief Compress the input block, writing the compressed data to output.
     auto compress(memory::const_block input, memory::buffer& output)
@@ -62,7 +129,15 @@ public:
 
     /// @brief Compress the input block into internal buffer, returns const view.
     auto compress(memory::const_block input, data_compression_level level)
-      -> memory::const_block;
+      -> memory::const_block {
+        return compress(input, level, no_compression_dictionary());
+    }
+
+    /// @brief Compress the input block using a dictionary into internal buffer.
+    auto compress(
+      memory::const_block input,
+      data_compression_level level,
+      data_compression_dictionary_id dictionary_id) -> memory::const_block;
 
     /// @brief Decompress the input block, passing the unpacked data to handler.
     auto decompress(memory::const_block input, const data_handler& handler)
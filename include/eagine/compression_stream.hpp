@@ -0,0 +1,247 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_COMPRESSION_STREAM_HPP
+#define EAGINE_COMPRESSION_STREAM_HPP
+
+#include "callable_ref.hpp"
+#include "compression.hpp"
+#include "memory/block.hpp"
+#include "memory/buffer.hpp"
+#include "types.hpp"
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+class data_compress_stream_impl;
+
+/// @brief Class implementing incremental data compression.
+/// @ingroup main_context
+/// @see data_decompress_stream
+/// @see data_compressor
+///
+/// The input can be pushed in arbitrarily sized pieces, the compressed
+/// data is passed to the specified handler as it is produced. The output
+/// can be unpacked by data_compressor::decompress. Without zlib the data is
+/// stored in size-prefixed chunks, so that the receiver can detect its end.
+class data_compress_stream {
+public:
+    /// @brief Alias for data handler callable type.
+    using data_handler = callable_ref<bool(memory::const_block)>;
+
+    /// @brief Construction with the specified compression level.
+    data_compress_stream(
+      data_compression_level level = data_compression_level::normal);
+
+    /// @brief Move constructible.
+    data_compress_stream(data_compress_stream&&) noexcept;
+    /// @brief Not copy constructible.
+    data_compress_stream(const data_compress_stream&) = delete;
+    /// @brief Move assignable.
+    auto operator=(data_compress_stream&&) noexcept -> data_compress_stream&;
+    /// @brief Not copy assignable.
+    auto operator=(const data_compress_stream&) = delete;
+
+    ~data_compress_stream() noexcept;
+
+    /// @brief Compresses the input block, passing the packed data to handler.
+    /// @see flush
+    /// @see finish
+    ///
+    /// Some of the input may be kept in the internal state of the stream
+    /// until more input is pushed or the stream is flushed or finished.
+    auto push(memory::const_block input, const data_handler& handler) -> bool;
+
+    /// @brief Passes all the pending compressed data to handler.
+    ///
+    /// After flush all the data pushed so far can be unpacked by the receiver.
+    /// Flushing too often degrades the compression ratio.
+    auto flush(const data_handler& handler) -> bool;
+
+    /// @brief Passes the rest of the compressed data to handler and finishes.
+    /// @see reset
+    auto finish(const data_handler& handler) -> bool;
+
+    /// @brief Indicates if the stream was finished.
+    auto is_finished() const noexcept -> bool;
+
+    /// @brief Resets the stream so that it can compress new data.
+    auto reset() -> data_compress_stream&;
+
+    /// @brief Returns the number of bytes pushed since the last reset.
+    auto input_size() const noexcept -> span_size_t;
+
+    /// @brief Returns the number of bytes produced since the last reset.
+    auto output_size() const noexcept -> span_size_t;
+
+private:
+    std::unique_ptr<data_compress_stream_impl> _pimpl;
+};
+//------------------------------------------------------------------------------
+class data_decompress_stream_impl;
+
+/// @brief Class implementing incremental data decompression.
+/// @ingroup main_context
+/// @see data_compress_stream
+/// @see data_compressor
+///
+/// Can unpack the output of both data_compress_stream and data_compressor
+/// (without preset dictionaries).
+class data_decompress_stream {
+public:
+    /// @brief Alias for data handler callable type.
+    using data_handler = callable_ref<bool(memory::const_block)>;
+
+    /// @brief Default constructor.
+    data_decompress_stream();
+
+    /// @brief Move constructible.
+    data_decompress_stream(data_decompress_stream&&) noexcept;
+    /// @brief Not copy constructible.
+    data_decompress_stream(const data_decompress_stream&) = delete;
+    /// @brief Move assignable.
+    auto operator=(data_decompress_stream&&) noexcept
+      -> data_decompress_stream&;
+    /// @brief Not copy assignable.
+    auto operator=(const data_decompress_stream&) = delete;
+
+    ~data_decompress_stream() noexcept;
+
+    /// @brief Unpacks the input block, passing the unpacked data to handler.
+    ///
+    /// Returns false on invalid input or if the handler returned false.
+    auto push(memory::const_block input, const data_handler& handler) -> bool;
+
+    /// @brief Indicates if the end of the compressed data was reached.
+    ///
+    /// The end of the data stored by data_compress_stream is always detected,
+    /// the end of data stored by data_compressor without compression is not.
+    auto is_finished() const noexcept -> bool;
+
+    /// @brief Resets the stream so that it can decompress new data.
+    auto reset() -> data_decompress_stream&;
+
+    /// @brief Returns the number of bytes pushed since the last reset.
+    auto input_size() const noexcept -> span_size_t;
+
+    /// @brief Returns the number of bytes produced since the last reset.
+    auto output_size() const noexcept -> span_size_t;
+
+private:
+    std::unique_ptr<data_decompress_stream_impl> _pimpl;
+};
+//------------------------------------------------------------------------------
+/// @brief Stream buffer compressing the written data into another ostream.
+/// @ingroup main_context
+/// @see data_compress_ostream
+class data_compress_streambuf : public std::streambuf {
+public:
+    /// @brief Construction with the output stream and the compression level.
+    data_compress_streambuf(
+      std::ostream& output,
+      data_compression_level level = data_compression_level::normal,
+      span_size_t buffer_size = 64 * 1024);
+
+    data_compress_streambuf(data_compress_streambuf&&) = delete;
+    data_compress_streambuf(const data_compress_streambuf&) = delete;
+    auto operator=(data_compress_streambuf&&) = delete;
+    auto operator=(const data_compress_streambuf&) = delete;
+
+    /// @brief Finishes the compressed stream if not finished explicitly.
+    ~data_compress_streambuf() noexcept override;
+
+    /// @brief Compresses the rest of the buffered data and finishes the stream.
+    auto finish() -> bool;
+
+protected:
+    auto overflow(int_type c) -> int_type override;
+    auto sync() -> int override;
+
+private:
+    auto _pack_buffered() -> bool;
+
+    std::ostream& _output;
+    data_compress_stream _stream;
+    std::vector<char> _buffer;
+};
+//------------------------------------------------------------------------------
+/// @brief Stream buffer reading compressed data from another istream.
+/// @ingroup main_context
+/// @see data_decompress_istream
+class data_decompress_streambuf : public std::streambuf {
+public:
+    /// @brief Construction with the input stream with the compressed data.
+    data_decompress_streambuf(
+      std::istream& input,
+      span_size_t buffer_size = 16 * 1024);
+
+protected:
+    auto underflow() -> int_type override;
+
+private:
+    std::istream& _input;
+    data_decompress_stream _stream;
+    std::vector<char> _packed;
+    std::vector<char> _unpacked;
+    bool _failed{false};
+};
+//------------------------------------------------------------------------------
+/// @brief Output stream compressing the written data into another ostream.
+/// @ingroup main_context
+/// @see data_decompress_istream
+class data_compress_ostream : public std::ostream {
+public:
+    /// @brief Construction with the output stream and the compression level.
+    data_compress_ostream(
+      std::ostream& output,
+      data_compression_level level = data_compression_level::normal)
+      : std::ostream{nullptr}
+      , _buf{output, level} {
+        rdbuf(&_buf);
+    }
+
+    /// @brief Compresses the rest of the written data and finishes the stream.
+    auto finish() -> bool {
+        if(!_buf.finish()) {
+            setstate(std::ios::badbit);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    data_compress_streambuf _buf;
+};
+//------------------------------------------------------------------------------
+/// @brief Input stream reading compressed data from another istream.
+/// @ingroup main_context
+/// @see data_compress_ostream
+class data_decompress_istream : public std::istream {
+public:
+    /// @brief Construction with the input stream with the compressed data.
+    data_decompress_istream(std::istream& input)
+      : std::istream{nullptr}
+      , _buf{input} {
+        rdbuf(&_buf);
+    }
+
+private:
+    data_decompress_streambuf _buf;
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+#if !EAGINE_LINK_LIBRARY || defined(EAGINE_IMPLEMENTING_LIBRARY)
+#include <eagine/compression_stream.inl>
+#endif
+
+#endif // EAGINE_COMPRESSION_STREAM_HPP
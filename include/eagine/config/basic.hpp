@@ -57,6 +57,10 @@
 #define EAGINE_USE_SYSTEMD 0
 #endif
 
+#ifndef EAGINE_USE_INOTIFY
+#define EAGINE_USE_INOTIFY 1
+#endif
+
 #ifndef EAGINE_LINK_LIBRARY
 #define EAGINE_LINK_LIBRARY 0
 #endif
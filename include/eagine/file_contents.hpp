@@ -25,6 +25,10 @@ struct file_contents_intf : interface<file_contents_intf> {
     virtual auto block() noexcept -> memory::const_block = 0;
 };
 
+/// @brief Tag type selecting memory-mapped access to the contents of a file.
+/// @see file_contents
+struct map_file_tag {};
+
 /// @brief Class providing access to the contents of a file.
 /// @see structured_file_content
 class file_contents {
@@ -35,6 +39,12 @@ public:
     /// @brief Constructor that opens and loads contents of file at the given path.
     file_contents(string_view path);
 
+    /// @brief Constructor that memory-maps the file at the given path.
+    ///
+    /// If the file cannot be mapped (it is not a regular file or the platform
+    /// does not support it) then the contents are loaded into a buffer.
+    file_contents(string_view path, map_file_tag);
+
     /// @brief Checks if the contents were loaded.
     /// @see block
     auto is_loaded() const noexcept -> bool {
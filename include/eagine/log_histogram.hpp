@@ -0,0 +1,180 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_LOG_HISTOGRAM_HPP
+#define EAGINE_LOG_HISTOGRAM_HPP
+
+#include "types.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace eagine {
+
+/// @brief Lock-free histogram with logarithmically sized buckets.
+/// @ingroup type_utils
+///
+/// Values below 2^SubBucketBits each get their own bucket, larger values are
+/// grouped by their most significant bit and each such power-of-two range is
+/// split into 2^SubBucketBits linear sub-buckets (like in HDR histograms).
+/// This bounds the relative error of reported quantiles to 2^-SubBucketBits.
+/// Values not less than 2^MaxValueBits are counted in the last bucket.
+/// The add function can be called concurrently from multiple threads.
+template <unsigned SubBucketBits = 3U, unsigned MaxValueBits = 40U>
+class log_histogram {
+    static_assert(SubBucketBits > 0U);
+    static_assert(SubBucketBits < MaxValueBits);
+    static_assert(MaxValueBits < 64U);
+
+public:
+    /// @brief The value type.
+    using value_type = std::uint64_t;
+
+    /// @brief Returns the number of buckets in this histogram.
+    static constexpr auto bucket_count() noexcept -> span_size_t {
+        return span_size_t(
+          (MaxValueBits - SubBucketBits + 1U) << SubBucketBits);
+    }
+
+    /// @brief Returns the index of the bucket where the specified value goes.
+    static constexpr auto bucket_index(value_type value) noexcept
+      -> span_size_t {
+        if(value < _sub_count) {
+            return span_size_t(value);
+        }
+        if(value >= (value_type(1U) << MaxValueBits)) {
+            return bucket_count() - 1;
+        }
+        const auto shift = _msb(value) - SubBucketBits;
+        return span_size_t(
+          ((value_type(shift) + 1U) << SubBucketBits) + (value >> shift) -
+          _sub_count);
+    }
+
+    /// @brief Returns the smallest value that goes to the specified bucket.
+    static constexpr auto bucket_min(span_size_t index) noexcept
+      -> value_type {
+        const auto idx = value_type(index);
+        if(idx < _sub_count) {
+            return idx;
+        }
+        const auto shift = (idx >> SubBucketBits) - 1U;
+        return ((idx & (_sub_count - 1U)) + _sub_count) << shift;
+    }
+
+    /// @brief Returns the largest value that goes to the specified bucket.
+    static constexpr auto bucket_max(span_size_t index) noexcept
+      -> value_type {
+        const auto idx = value_type(index);
+        if(idx < _sub_count) {
+            return idx;
+        }
+        const auto shift = (idx >> SubBucketBits) - 1U;
+        return bucket_min(index) + (value_type(1U) << shift) - 1U;
+    }
+
+    /// @brief Records the specified value.
+    void add(value_type value) noexcept {
+        _buckets[std_size(bucket_index(value))].fetch_add(
+          1U, std::memory_order_relaxed);
+        _count.fetch_add(1U, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+        auto prev_max = _max.load(std::memory_order_relaxed);
+        while((prev_max < value) &&
+              !_max.compare_exchange_weak(
+                prev_max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// @brief Returns the number of recorded values.
+    auto count() const noexcept -> value_type {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the number of values recorded in the specified bucket.
+    auto bucket_value_count(span_size_t index) const noexcept -> value_type {
+        return _buckets[std_size(index)].load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the sum of recorded values.
+    auto sum() const noexcept -> value_type {
+        return _sum.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the largest recorded value.
+    auto max() const noexcept -> value_type {
+        return _max.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the mean of the recorded values.
+    auto mean() const noexcept -> double {
+        const auto cnt = count();
+        return cnt ? double(sum()) / double(cnt) : 0.0;
+    }
+
+    /// @brief Returns the value at the specified quantile (0.0 - 1.0).
+    ///
+    /// The result is the upper bound of the bucket containing the quantile,
+    /// clamped to the largest recorded value.
+    auto quantile(double q) const noexcept -> value_type {
+        const auto cnt = count();
+        if(!cnt) {
+            return 0U;
+        }
+        value_type rank{cnt};
+        if(q <= 0.0) {
+            rank = 1U;
+        } else if(q < 1.0) {
+            rank = value_type(q * double(cnt) + 0.5);
+        }
+        value_type seen{0U};
+        const auto max_value = max();
+        for(span_size_t i = 0; i < bucket_count(); ++i) {
+            seen += bucket_value_count(i);
+            if(seen >= rank) {
+                const auto result = bucket_max(i);
+                return result < max_value ? result : max_value;
+            }
+        }
+        return max_value;
+    }
+
+    /// @brief Resets all the counters. Not atomic with respect to add.
+    void reset() noexcept {
+        for(auto& bucket : _buckets) {
+            bucket.store(0U, std::memory_order_relaxed);
+        }
+        _count.store(0U, std::memory_order_relaxed);
+        _sum.store(0U, std::memory_order_relaxed);
+        _max.store(0U, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr const value_type _sub_count = value_type(1U)
+                                                   << SubBucketBits;
+
+    static constexpr auto _msb(value_type value) noexcept -> unsigned {
+        unsigned result{0U};
+        for(unsigned step = 32U; step > 0U; step /= 2U) {
+            if(value >= (value_type(1U) << step)) {
+                value >>= step;
+                result += step;
+            }
+        }
+        return result;
+    }
+
+    std::array<std::atomic<value_type>, std_size(bucket_count())> _buckets{};
+    std::atomic<value_type> _count{0U};
+    std::atomic<value_type> _sum{0U};
+    std::atomic<value_type> _max{0U};
+};
+
+} // namespace eagine
+
+#endif // EAGINE_LOG_HISTOGRAM_HPP
@@ -10,6 +10,7 @@
 #define EAGINE_LOGGING_BACKEND_HPP
 
 #include "../interface.hpp"
+#include "../maybe_unused.hpp"
 #include "../memory/block.hpp"
 #include "../memory/shared_alloc.hpp"
 #include "../message_id.hpp"
@@ -20,6 +21,7 @@
 
 namespace eagine {
 class application_config;
+class log_filter;
 //------------------------------------------------------------------------------
 /// @brief Helper class used in implementation of has_log_entry_adapter_t.
 /// @ingroup logging
@@ -75,6 +77,25 @@ struct logger_backend : interface<logger_backend> {
     entry_backend(identifier source, log_event_severity severity) noexcept
       -> logger_backend* = 0;
 
+    /// @brief Returns a pointer to the backend to be used by an log_entry.
+    /// @param source the identifier of the source logger object.
+    /// @param severity the log level or severity of the log event.
+    /// @param format the format string, identifying the logging call site.
+    /// @see entry_backend
+    virtual auto site_entry_backend(
+      identifier source,
+      log_event_severity severity,
+      string_view format) noexcept -> logger_backend* {
+        EAGINE_MAYBE_UNUSED(format);
+        return entry_backend(source, severity);
+    }
+
+    /// @brief Returns a pointer to the run-time log entry filter if any.
+    /// @see log_filter
+    virtual auto filter() noexcept -> log_filter* {
+        return nullptr;
+    }
+
     /// @brief Enters logging scope.
     virtual void enter_scope(identifier scope) noexcept = 0;
 
@@ -15,6 +15,9 @@
 #include "../message_id.hpp"
 #include "../valid_if/decl.hpp"
 #include "backend.hpp"
+#include "entry_arg.hpp"
+#include <array>
+#include <optional>
 #include <sstream>
 
 namespace eagine {
@@ -77,12 +80,7 @@ public:
       , _instance_id{instance_id}
       , _backend{backend}
       , _format{format}
-      , _args{_be_alloc(_backend)}
-      , _severity{severity} {
-        if(_backend) {
-            _args.reserve(16);
-        }
-    }
+      , _severity{severity} {}
 
     /// @brief Not moveable.
     log_entry(log_entry&&) = delete;
@@ -98,7 +96,7 @@ public:
         if(_backend) {
             if(EAGINE_LIKELY(_backend->begin_message(
                  _source_id, _entry_tag, _instance_id, _severity, _format))) {
-                _args(*_backend);
+                _write_args(*_backend);
                 _backend->finish_message();
                 _backend = nullptr;
             }
@@ -120,12 +118,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, identifier value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_identifier(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, value);
     }
 
     /// @brief Adds a new message argument with identifier value.
@@ -141,12 +134,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, message_id value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_message_id(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, value);
     }
 
     /// @brief Adds a new message argument with identifier value.
@@ -162,12 +150,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, std::int64_t value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_integer(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, std::intmax_t(value));
     }
 
     /// @brief Adds a new message argument with 64-bit signed integer value.
@@ -196,12 +179,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, std::int32_t value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_integer(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, std::intmax_t(value));
     }
 
     /// @brief Adds a new message argument with 32-bit signed integer value.
@@ -231,12 +209,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, std::int16_t value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_integer(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, std::intmax_t(value));
     }
 
     /// @brief Adds a new message argument with 16-bit signed integer value.
@@ -265,12 +238,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, std::uint64_t value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_unsigned(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, std::uintmax_t(value));
     }
 
     /// @brief Adds a new message argument with 64-bit unsigned integer value.
@@ -299,12 +267,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, std::uint32_t value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_unsigned(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, std::uintmax_t(value));
     }
 
     /// @brief Adds a new message argument with 32-bit unsigned integer value.
@@ -333,12 +296,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, std::uint16_t value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_unsigned(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, std::uintmax_t(value));
     }
 
     /// @brief Adds a new message argument with 16-bit unsigned integer value.
@@ -366,12 +324,7 @@ public:
     /// @param tag the argument type identifier. Used in value formatting.
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, float value) noexcept -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_float(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, value);
     }
 
     /// @brief Adds a new message argument with floating-point value.
@@ -409,12 +362,7 @@ public:
       float min,
       float value,
       float max) noexcept -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_float(name, tag, min, value, max);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, min, value, max);
     }
 
     /// @brief Adds a new message argument with floating-point value.
@@ -434,16 +382,10 @@ public:
       identifier name,
       identifier tag,
       std::chrono::duration<R, P> value) noexcept -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_duration(
-                  name,
-                  tag,
-                  std::chrono::duration_cast<std::chrono::duration<float>>(
-                    value));
-            });
-        }
-        return *this;
+        return _add_arg(
+          name,
+          tag,
+          std::chrono::duration_cast<std::chrono::duration<float>>(value));
     }
 
     /// @brief Adds a new message argument with time duration value.
@@ -461,12 +403,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, string_view value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_string(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, value);
     }
 
     /// @brief Adds a new message argument with string value.
@@ -480,15 +417,9 @@ public:
     /// @param name the argument name identifier. Used in message substitution.
     /// @param tag the argument type identifier. Used in value formatting.
     /// @param value the value of the argument.
+    /// @note Short strings are copied into a buffer inside the log entry.
     auto arg(identifier name, identifier tag, const std::string& value) noexcept
-      -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_string(name, tag, value);
-            });
-        }
-        return *this;
-    }
+      -> log_entry&;
 
     /// @brief Adds a new message argument with string value.
     /// @param name the argument name identifier. Used in message substitution.
@@ -503,12 +434,7 @@ public:
     /// @param value the value of the argument.
     auto arg(identifier name, identifier tag, memory::const_block value) noexcept
       -> auto& {
-        if(_backend) {
-            _args.add([=](logger_backend& backend) {
-                backend.add_blob(name, tag, value);
-            });
-        }
-        return *this;
+        return _add_arg(name, tag, value);
     }
 
     /// @brief Adds a new message argument with BLOB value.
@@ -522,7 +448,7 @@ public:
     template <typename Func>
     auto arg_func(Func function) -> auto& {
         if(_backend) {
-            _args.add(std::move(function));
+            _add_deferred(std::move(function));
         }
         return *this;
     }
@@ -535,7 +461,7 @@ public:
     auto arg(identifier name, T&& value) noexcept
       -> std::enable_if_t<has_log_entry_adapter_v<std::decay_t<T>>, log_entry&> {
         if(_backend) {
-            _args.add(adapt_log_entry_arg(name, std::forward<T>(value)));
+            _add_deferred(adapt_log_entry_arg(name, std::forward<T>(value)));
         }
         return *this;
     }
@@ -588,16 +514,47 @@ private:
     logger_instance_id _instance_id{};
     logger_backend* _backend{nullptr};
     string_view _format{};
-    memory::callable_storage<void(logger_backend&)> _args;
     const log_event_severity _severity{log_event_severity::info};
 
-    static auto _be_alloc(logger_backend* backend) noexcept
-      -> memory::shared_byte_allocator {
-        if(backend) {
-            return backend->allocator();
+    // the common arguments are stored inline as typed records and the short
+    // copied strings in a small character buffer, so that the entries do not
+    // allocate any memory; only the adapted arguments and the arguments that
+    // do not fit are stored as callables in the out-of-line storage
+    static constexpr const span_size_t _max_args{16};
+    static constexpr const span_size_t _max_chars{256};
+    span_size_t _arg_count{0};
+    span_size_t _char_count{0};
+    std::array<log_entry_arg, std_size(_max_args)> _args;
+    std::array<char, std_size(_max_chars)> _chars;
+    std::optional<memory::callable_storage<void(logger_backend&)>> _deferred{};
+
+    template <typename... Args>
+    auto _add_arg(identifier name, identifier tag, Args... args) noexcept
+      -> log_entry& {
+        if(_backend) {
+            if(EAGINE_LIKELY(_arg_count < _max_args)) {
+                _args[std_size(_arg_count++)] = {name, tag, args...};
+            } else {
+                _add_deferred(
+                  [arg{log_entry_arg{name, tag, args...}}](
+                    logger_backend& backend) { arg.write_to(backend); });
+            }
+        }
+        return *this;
+    }
+
+    template <typename Func>
+    void _add_deferred(Func function) {
+        if(!_deferred) {
+            _deferred.emplace(_backend->allocator());
+        }
+        _deferred->add(std::move(function));
+        if(_arg_count < _max_args) {
+            _args[std_size(_arg_count++)] = log_entry_arg::deferred();
         }
-        return {};
     }
+
+    void _write_args(logger_backend&) noexcept;
 };
 //------------------------------------------------------------------------------
 /// @brief Do-nothing variant of log_entry with compatible API.
@@ -0,0 +1,304 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_LOGGING_ENTRY_ARG_HPP
+#define EAGINE_LOGGING_ENTRY_ARG_HPP
+
+#include "../assert.hpp"
+#include "../memory/block.hpp"
+#include "../message_id.hpp"
+#include "../string_span.hpp"
+#include "backend.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+/// @brief Typed record of a single log entry argument.
+/// @ingroup logging
+/// @see log_entry
+///
+/// The values of the scalar argument types are stored directly in the record,
+/// strings, BLOBs and spans are stored as views. The record is trivial,
+/// so that a fixed array of them can be kept inline in a log entry without
+/// any initialization and dynamic memory allocation.
+class log_entry_arg {
+public:
+    /// @brief Enumeration of the kinds of values stored in the record.
+    enum class value_kind : std::uint8_t {
+        deferred,
+        identifier_value,
+        message_id_value,
+        integer,
+        unsigned_integer,
+        real,
+        real_range,
+        duration,
+        string,
+        blob,
+        integer64_span,
+        integer32_span,
+        integer16_span,
+        unsigned64_span,
+        unsigned32_span,
+        unsigned16_span,
+        real_span
+    };
+
+    /// @brief Default constructor. Leaves the record uninitialized.
+    log_entry_arg() noexcept = default;
+
+    /// @brief Construction from an identifier value.
+    log_entry_arg(identifier name, identifier tag, identifier value) noexcept
+      : log_entry_arg{name, tag, value_kind::identifier_value} {
+        _ids[0] = value.value();
+    }
+
+    /// @brief Construction from a message id value.
+    log_entry_arg(identifier name, identifier tag, message_id value) noexcept
+      : log_entry_arg{name, tag, value_kind::message_id_value} {
+        _ids[0] = value.class_id();
+        _ids[1] = value.method_id();
+    }
+
+    /// @brief Construction from a signed integer value.
+    log_entry_arg(identifier name, identifier tag, std::intmax_t value) noexcept
+      : log_entry_arg{name, tag, value_kind::integer} {
+        _integer = value;
+    }
+
+    /// @brief Construction from an unsigned integer value.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      std::uintmax_t value) noexcept
+      : log_entry_arg{name, tag, value_kind::unsigned_integer} {
+        _unsigned = value;
+    }
+
+    /// @brief Construction from a floating-point value.
+    log_entry_arg(identifier name, identifier tag, float value) noexcept
+      : log_entry_arg{name, tag, value_kind::real} {
+        _reals[0] = value;
+    }
+
+    /// @brief Construction from a floating-point value with a range.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      float min,
+      float value,
+      float max) noexcept
+      : log_entry_arg{name, tag, value_kind::real_range} {
+        _reals = {min, value, max};
+    }
+
+    /// @brief Construction from a time duration value.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      std::chrono::duration<float> value) noexcept
+      : log_entry_arg{name, tag, value_kind::duration} {
+        _reals[0] = value.count();
+    }
+
+    /// @brief Construction from a string view.
+    log_entry_arg(identifier name, identifier tag, string_view value) noexcept
+      : log_entry_arg{name, tag, value_kind::string, value} {}
+
+    /// @brief Construction from a BLOB view.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      memory::const_block value) noexcept
+      : log_entry_arg{name, tag, value_kind::blob, value} {}
+
+    /// @brief Construction from a span of 64-bit signed integers.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      span<const std::int64_t> values) noexcept
+      : log_entry_arg{name, tag, value_kind::integer64_span, values} {}
+
+    /// @brief Construction from a span of 32-bit signed integers.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      span<const std::int32_t> values) noexcept
+      : log_entry_arg{name, tag, value_kind::integer32_span, values} {}
+
+    /// @brief Construction from a span of 16-bit signed integers.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      span<const std::int16_t> values) noexcept
+      : log_entry_arg{name, tag, value_kind::integer16_span, values} {}
+
+    /// @brief Construction from a span of 64-bit unsigned integers.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      span<const std::uint64_t> values) noexcept
+      : log_entry_arg{name, tag, value_kind::unsigned64_span, values} {}
+
+    /// @brief Construction from a span of 32-bit unsigned integers.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      span<const std::uint32_t> values) noexcept
+      : log_entry_arg{name, tag, value_kind::unsigned32_span, values} {}
+
+    /// @brief Construction from a span of 16-bit unsigned integers.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      span<const std::uint16_t> values) noexcept
+      : log_entry_arg{name, tag, value_kind::unsigned16_span, values} {}
+
+    /// @brief Construction from a span of floating-point values.
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      span<const float> values) noexcept
+      : log_entry_arg{name, tag, value_kind::real_span, values} {}
+
+    /// @brief Returns a record marking an argument stored out of line.
+    static auto deferred() noexcept -> log_entry_arg {
+        return {{}, {}, value_kind::deferred};
+    }
+
+    /// @brief Returns the kind of the stored value.
+    auto kind() const noexcept -> value_kind {
+        return _kind;
+    }
+
+    /// @brief Indicates if the argument value is stored out of line.
+    auto is_deferred() const noexcept -> bool {
+        return _kind == value_kind::deferred;
+    }
+
+    /// @brief Passes the stored argument to the specified logger backend.
+    /// @pre !is_deferred()
+    void write_to(logger_backend& backend) const noexcept {
+        const identifier name{_name};
+        const identifier tag{_tag};
+        switch(_kind) {
+            case value_kind::identifier_value:
+                backend.add_identifier(name, tag, identifier{_ids[0]});
+                break;
+            case value_kind::message_id_value:
+                backend.add_message_id(name, tag, message_id{_ids[0], _ids[1]});
+                break;
+            case value_kind::integer:
+                backend.add_integer(name, tag, _integer);
+                break;
+            case value_kind::unsigned_integer:
+                backend.add_unsigned(name, tag, _unsigned);
+                break;
+            case value_kind::real:
+                backend.add_float(name, tag, _reals[0]);
+                break;
+            case value_kind::real_range:
+                backend.add_float(name, tag, _reals[0], _reals[1], _reals[2]);
+                break;
+            case value_kind::duration:
+                backend.add_duration(
+                  name, tag, std::chrono::duration<float>{_reals[0]});
+                break;
+            case value_kind::string:
+                backend.add_string(name, tag, _view_of<const char>());
+                break;
+            case value_kind::blob:
+                backend.add_blob(name, tag, _view_of<const byte>());
+                break;
+            case value_kind::integer64_span:
+                _add_integers(backend, _view_of<const std::int64_t>());
+                break;
+            case value_kind::integer32_span:
+                _add_integers(backend, _view_of<const std::int32_t>());
+                break;
+            case value_kind::integer16_span:
+                _add_integers(backend, _view_of<const std::int16_t>());
+                break;
+            case value_kind::unsigned64_span:
+                _add_unsigneds(backend, _view_of<const std::uint64_t>());
+                break;
+            case value_kind::unsigned32_span:
+                _add_unsigneds(backend, _view_of<const std::uint32_t>());
+                break;
+            case value_kind::unsigned16_span:
+                _add_unsigneds(backend, _view_of<const std::uint16_t>());
+                break;
+            case value_kind::real_span:
+                for(auto value : _view_of<const float>()) {
+                    backend.add_float(name, tag, value);
+                }
+                break;
+            case value_kind::deferred:
+                EAGINE_UNREACHABLE("deferred log entry argument");
+                break;
+        }
+    }
+
+private:
+    log_entry_arg(identifier name, identifier tag, value_kind kind) noexcept
+      : _name{name.value()}
+      , _tag{tag.value()}
+      , _kind{kind} {}
+
+    template <typename T>
+    log_entry_arg(
+      identifier name,
+      identifier tag,
+      value_kind kind,
+      span<T> values) noexcept
+      : log_entry_arg{name, tag, kind} {
+        _view = {values.data(), values.size()};
+    }
+
+    template <typename T>
+    auto _view_of() const noexcept -> span<T> {
+        return {static_cast<T*>(_view.addr), _view.size};
+    }
+
+    template <typename T>
+    void _add_integers(logger_backend& backend, span<T> values) const noexcept {
+        for(auto value : values) {
+            backend.add_integer(identifier{_name}, identifier{_tag}, value);
+        }
+    }
+
+    template <typename T>
+    void
+    _add_unsigneds(logger_backend& backend, span<T> values) const noexcept {
+        for(auto value : values) {
+            backend.add_unsigned(identifier{_name}, identifier{_tag}, value);
+        }
+    }
+
+    struct _view_t {
+        const void* addr;
+        span_size_t size;
+    };
+
+    identifier_t _name;
+    identifier_t _tag;
+    union {
+        std::array<identifier_t, 2> _ids;
+        std::intmax_t _integer;
+        std::uintmax_t _unsigned;
+        std::array<float, 3> _reals;
+        _view_t _view;
+    };
+    value_kind _kind;
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+#endif // EAGINE_LOGGING_ENTRY_ARG_HPP
@@ -0,0 +1,174 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_LOGGING_FILTER_HPP
+#define EAGINE_LOGGING_FILTER_HPP
+
+#include "../branch_predict.hpp"
+#include "../identifier.hpp"
+#include "../types.hpp"
+#include "severity.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <tuple>
+
+namespace eagine {
+class application_config;
+//------------------------------------------------------------------------------
+/// @brief Run-time filter of log entries, applied before the entry arguments
+///        are captured.
+/// @ingroup logging
+/// @see filtering_log_backend
+///
+/// The filter keeps a table of minimum severities for individual log sources,
+/// falling back to a default minimum severity for the sources not listed
+/// in the table. Optionally the entries with severity below error are rate
+/// limited by a token bucket per logging call site.
+class log_filter {
+public:
+    /// @brief Construction with the specified default minimum severity.
+    log_filter(log_event_severity min_severity) noexcept
+      : _min_severity{min_severity} {}
+
+    /// @brief Returns the default minimum severity.
+    auto min_severity() const noexcept -> log_event_severity {
+        return _min_severity.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Sets the default minimum severity.
+    auto set_min_severity(log_event_severity severity) noexcept -> log_filter& {
+        _min_severity.store(severity, std::memory_order_relaxed);
+        return *this;
+    }
+
+    /// @brief Sets the minimum severity of entries from the specified source.
+    /// @see reset_min_severity
+    /// @see max_source_rules
+    ///
+    /// If the rules for max_source_rules distinct sources were already set,
+    /// then the rules of new sources are ignored.
+    auto set_min_severity(identifier source, log_event_severity severity)
+      -> log_filter&;
+
+    /// @brief Makes the specified source use the default minimum severity.
+    /// @see set_min_severity
+    auto reset_min_severity(identifier source) -> log_filter&;
+
+    /// @brief Makes all sources use the default minimum severity.
+    auto reset_min_severities() -> log_filter&;
+
+    /// @brief Returns the maximum number of sources with individual severity.
+    static constexpr auto max_source_rules() noexcept -> span_size_t {
+        return _max_rules;
+    }
+
+    /// @brief Indicates if entries from source with severity pass the filter.
+    auto is_enabled(identifier source, log_event_severity severity) noexcept
+      -> bool {
+        if(EAGINE_LIKELY(!_has_source_rules.load(std::memory_order_acquire))) {
+            return severity >= min_severity();
+        }
+        return _is_enabled(source, severity);
+    }
+
+    /// @brief Sets the rate limit for entries from a single call site.
+    /// @param per_second the average number of entries allowed per second.
+    /// @param burst the number of entries allowed in a short burst.
+    ///
+    /// Rate limiting is disabled if per_second is not positive.
+    auto set_rate_limit(float per_second, float burst) noexcept -> log_filter&;
+
+    /// @brief Indicates if the entries are rate limited.
+    auto is_rate_limited() const noexcept -> bool {
+        return _is_rate_limited.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Applies the rate limit to an entry from the specified call site.
+    ///
+    /// Returns a boolean indicating if the entry passes and the number of
+    /// entries from the same call site suppressed since the previous one
+    /// that passed.
+    auto throttle(
+      identifier source,
+      log_event_severity severity,
+      const void* call_site) noexcept -> std::tuple<bool, span_size_t> {
+        if(
+          EAGINE_LIKELY(!is_rate_limited()) ||
+          (severity >= log_event_severity::error)) {
+            return {true, 0};
+        }
+        return _throttle(source, call_site);
+    }
+
+    /// @brief Returns the total number of entries suppressed by rate limiting.
+    auto suppressed_count() const noexcept -> span_size_t {
+        return _suppressed_count.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Reads the filter settings from the application configuration.
+    ///
+    /// The log.source_severity list with SourceId:severity entries sets
+    /// the per-source severities, log.rate_limit.per_second and
+    /// log.rate_limit.burst set the call site rate limit.
+    void configure(application_config&);
+
+private:
+    using _clock = std::chrono::steady_clock;
+
+    struct _bucket {
+        const void* call_site{nullptr};
+        identifier source{};
+        _clock::time_point refilled{};
+        float tokens{0.F};
+        span_size_t suppressed{0};
+    };
+
+    // the rules of individual sources are kept in a fixed-size open
+    // addressing table that the readers probe without any locking,
+    // a slot once taken by a source is never reused for another one
+    // so the readers cannot see a rule of a different source
+    struct _source_rule {
+        std::atomic<identifier_t> source{0U};
+        std::atomic<log_event_severity> severity{};
+        std::atomic<bool> active{false};
+    };
+
+    static auto _rule_index(identifier source) noexcept -> std::size_t;
+    auto _find_rule(identifier source, bool insert) noexcept -> _source_rule*;
+    auto _is_enabled(identifier source, log_event_severity) noexcept -> bool;
+    auto _throttle(identifier source, const void* call_site) noexcept
+      -> std::tuple<bool, span_size_t>;
+
+    std::atomic<log_event_severity> _min_severity;
+    std::atomic<bool> _has_source_rules{false};
+    std::atomic<bool> _is_rate_limited{false};
+    std::atomic<span_size_t> _suppressed_count{0};
+
+    // the mutex serializes the writers of the source rules
+    static constexpr const span_size_t _max_rules{128};
+    std::mutex _rules_mutex{};
+    span_size_t _active_rules{0};
+    std::array<_source_rule, std_size(_max_rules)> _source_rules{};
+
+    // the buckets are indexed by a hash of the call site, sites colliding
+    // in the same slot take it over, so the memory use is bounded
+    std::mutex _buckets_mutex{};
+    std::array<_bucket, 256> _buckets{};
+    float _rate{0.F};
+    float _burst{1.F};
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+#if !EAGINE_LINK_LIBRARY || defined(EAGINE_IMPLEMENTING_LIBRARY)
+#include <eagine/logging/filter.inl>
+#endif
+
+#endif // EAGINE_LOGGING_FILTER_HPP
@@ -0,0 +1,214 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_LOGGING_FILTERING_BACKEND_HPP
+#define EAGINE_LOGGING_FILTERING_BACKEND_HPP
+
+#include "backend.hpp"
+#include "filter.hpp"
+#include <memory>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+/// @brief Logger backend applying a log_filter before delegating the entries.
+/// @ingroup logging
+/// @see log_filter
+///
+/// The filter is consulted when an entry is created, so the arguments of
+/// the entries that are filtered out or rate-limited are never captured.
+/// The arguments of the entries that pass go directly to the delegate.
+class filtering_log_backend final : public logger_backend {
+public:
+    filtering_log_backend(
+      std::unique_ptr<logger_backend> delegate,
+      log_event_severity min_severity) noexcept
+      : _delegate{std::move(delegate)}
+      , _filter{min_severity} {
+        EAGINE_ASSERT(_delegate);
+    }
+
+    auto configure(application_config& config) -> bool final {
+        _filter.configure(config);
+        return _delegate->configure(config);
+    }
+
+    auto filter() noexcept -> log_filter* final {
+        return &_filter;
+    }
+
+    auto entry_backend(identifier source, log_event_severity severity) noexcept
+      -> logger_backend* final {
+        if(_filter.is_enabled(source, severity)) {
+            return _delegate->entry_backend(source, severity);
+        }
+        return nullptr;
+    }
+
+    auto site_entry_backend(
+      identifier source,
+      log_event_severity severity,
+      string_view format) noexcept -> logger_backend* final {
+        if(_filter.is_enabled(source, severity)) {
+            const auto [passes, suppressed] =
+              _filter.throttle(source, severity, format.data());
+            if(passes) {
+                if(EAGINE_UNLIKELY(suppressed > 0)) {
+                    _report_suppressed(source, severity, suppressed);
+                }
+                return _delegate->site_entry_backend(source, severity, format);
+            }
+        }
+        return nullptr;
+    }
+
+    auto allocator() noexcept -> memory::shared_byte_allocator final {
+        return _delegate->allocator();
+    }
+
+    auto type_id() noexcept -> identifier final {
+        return _delegate->type_id();
+    }
+
+    void enter_scope(identifier scope) noexcept final {
+        _delegate->enter_scope(scope);
+    }
+
+    void leave_scope(identifier scope) noexcept final {
+        _delegate->leave_scope(scope);
+    }
+
+    void set_description(
+      identifier source,
+      logger_instance_id instance,
+      string_view display_name,
+      string_view description) noexcept final {
+        _delegate->set_description(
+          source, instance, display_name, description);
+    }
+
+    auto begin_message(
+      identifier source,
+      identifier tag,
+      logger_instance_id instance,
+      log_event_severity severity,
+      string_view format) noexcept -> bool final {
+        return _delegate->begin_message(
+          source, tag, instance, severity, format);
+    }
+
+    void add_nothing(identifier arg, identifier tag) noexcept final {
+        _delegate->add_nothing(arg, tag);
+    }
+
+    void add_identifier(
+      identifier arg,
+      identifier tag,
+      identifier value) noexcept final {
+        _delegate->add_identifier(arg, tag, value);
+    }
+
+    void add_message_id(
+      identifier arg,
+      identifier tag,
+      message_id value) noexcept final {
+        _delegate->add_message_id(arg, tag, value);
+    }
+
+    void add_bool(identifier arg, identifier tag, bool value) noexcept final {
+        _delegate->add_bool(arg, tag, value);
+    }
+
+    void add_integer(
+      identifier arg,
+      identifier tag,
+      std::intmax_t value) noexcept final {
+        _delegate->add_integer(arg, tag, value);
+    }
+
+    void add_unsigned(
+      identifier arg,
+      identifier tag,
+      std::uintmax_t value) noexcept final {
+        _delegate->add_unsigned(arg, tag, value);
+    }
+
+    void add_float(identifier arg, identifier tag, float value) noexcept final {
+        _delegate->add_float(arg, tag, value);
+    }
+
+    void add_float(
+      identifier arg,
+      identifier tag,
+      float min,
+      float value,
+      float max) noexcept final {
+        _delegate->add_float(arg, tag, min, value, max);
+    }
+
+    void add_duration(
+      identifier arg,
+      identifier tag,
+      std::chrono::duration<float> value) noexcept final {
+        _delegate->add_duration(arg, tag, value);
+    }
+
+    void add_string(identifier arg, identifier tag, string_view value) noexcept
+      final {
+        _delegate->add_string(arg, tag, value);
+    }
+
+    void add_blob(
+      identifier arg,
+      identifier tag,
+      memory::const_block value) noexcept final {
+        _delegate->add_blob(arg, tag, value);
+    }
+
+    void finish_message() noexcept final {
+        _delegate->finish_message();
+    }
+
+    void finish_log() noexcept final {
+        _delegate->finish_log();
+    }
+
+    void log_chart_sample(
+      identifier source,
+      logger_instance_id instance,
+      identifier series,
+      float value) noexcept final {
+        if(_filter.is_enabled(source, log_event_severity::stat)) {
+            _delegate->log_chart_sample(source, instance, series, value);
+        }
+    }
+
+private:
+    std::unique_ptr<logger_backend> _delegate;
+    log_filter _filter;
+
+    void _report_suppressed(
+      identifier source,
+      log_event_severity severity,
+      span_size_t count) noexcept {
+        if(auto lbe{_delegate->entry_backend(source, severity)}) {
+            if(lbe->begin_message(
+                 source,
+                 EAGINE_ID(Suppressed),
+                 0U,
+                 severity,
+                 "suppressed ${count} entries from the following call site")) {
+                lbe->add_integer(EAGINE_ID(count), EAGINE_ID(int64), count);
+                lbe->finish_message();
+            }
+        }
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+#endif // EAGINE_LOGGING_FILTERING_BACKEND_HPP
@@ -95,7 +95,7 @@ protected:
           instance_id(),
           severity,
           format,
-          _entry_backend(source, severity)};
+          _entry_backend(source, severity, format)};
     }
 
     constexpr auto make_log_entry(
@@ -124,7 +124,7 @@ protected:
           instance_id(),
           severity,
           format,
-          _entry_backend(source, severity)};
+          _entry_backend(source, severity, format)};
     }
 
     constexpr auto log_fatal(identifier source, string_view format) noexcept {
@@ -219,6 +219,18 @@ protected:
         return nullptr;
     }
 
+    auto _entry_backend(
+      identifier source,
+      log_event_severity severity,
+      string_view format) noexcept -> logger_backend* {
+        if(is_log_level_enabled(severity)) {
+            if(auto lbe{backend()}) {
+                return lbe->site_entry_backend(source, severity, format);
+            }
+        }
+        return nullptr;
+    }
+
 private:
     auto _backend_getter() noexcept -> BackendGetter& {
         return *this;
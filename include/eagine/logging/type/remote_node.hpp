@@ -45,6 +45,25 @@ adapt_log_entry_arg(identifier name, const msgbus::remote_node& value) {
         if(const auto opt_bld{value.instance().build()}) {
             backend.add_adapted(EAGINE_ID(buildInfo), extract(opt_bld));
         }
+        if(const auto opt_usage{value.resource_usage()}) {
+            const auto& usage = extract(opt_usage);
+            if(usage.cpu_usage >= 0.F) {
+                backend.add_float(
+                  EAGINE_ID(cpuUsage), EAGINE_ID(Ratio), usage.cpu_usage);
+            }
+            if(usage.resident_size >= 0) {
+                backend.add_integer(
+                  EAGINE_ID(residentSz),
+                  EAGINE_ID(ByteSize),
+                  usage.resident_size);
+            }
+            if(usage.open_file_count >= 0) {
+                backend.add_integer(
+                  EAGINE_ID(openFiles),
+                  EAGINE_ID(int32),
+                  usage.open_file_count);
+            }
+        }
 
         if(const auto opt_name{value.display_name()}) {
             backend.add_string(
@@ -113,6 +113,10 @@ public:
         return _compressor;
     }
 
+    auto workers() noexcept -> workshop& final {
+        return _workers;
+    }
+
     auto scratch_space() noexcept -> memory::buffer& final {
         return _scratch_space;
     }
@@ -131,6 +135,7 @@ private:
     message_bus& _msg_bus;
     memory::buffer& _scratch_space;
     data_compressor& _compressor;
+    workshop& _workers;
     string_view _exe_path;
     string_view _app_name;
 
@@ -22,6 +22,7 @@ class compiler_info;
 class system_info;
 class user_info;
 class data_compressor;
+class workshop;
 class program_args;
 class process_watchdog;
 class message_bus;
@@ -86,6 +87,9 @@ struct main_ctx_getters : interface<main_ctx_getters> {
     /// @brief Returns a reference to shared data compressor object.
     virtual auto compressor() noexcept -> data_compressor& = 0;
 
+    /// @brief Returns a reference to shared thread pool object.
+    virtual auto workers() noexcept -> workshop& = 0;
+
     /// @brief Returns a reference to shared temporary buffer.
     virtual auto scratch_space() noexcept -> memory::buffer& = 0;
 };
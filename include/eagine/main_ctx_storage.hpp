@@ -19,6 +19,7 @@
 #include "system_info.hpp"
 #include "user_info.hpp"
 #include "watchdog.hpp"
+#include "workshop.hpp"
 
 namespace eagine {
 //------------------------------------------------------------------------------
@@ -98,6 +99,10 @@ public:
         return _compressor;
     }
 
+    auto workers() noexcept -> workshop& final {
+        return _workers;
+    }
+
     auto scratch_space() noexcept -> memory::buffer& final {
         return _scratch_space;
     }
@@ -123,6 +128,7 @@ private:
     message_bus _msg_bus;
     memory::buffer _scratch_space{};
     data_compressor _compressor{};
+    workshop _workers{};
     std::string _exe_path{};
     std::string _app_name{};
 };
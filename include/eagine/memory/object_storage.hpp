@@ -165,11 +165,21 @@ public:
         return base::is_empty();
     }
 
+    auto size() const noexcept -> span_size_t {
+        return span_size(_clrs.size());
+    }
+
     void clear() noexcept {
         base::clear();
         _clrs.clear();
     }
 
+    void call(span_size_t index, Params... params) noexcept {
+        EAGINE_ASSERT((index >= 0) && (index < size()));
+        const auto i{std_size(index)};
+        _clrs[i](block(_blks[i]), params...);
+    }
+
     void operator()(Params... params) noexcept {
         auto fn = [&](auto i, block blk) {
             this->_clrs[i](blk, params...);
@@ -27,6 +27,10 @@ struct acceptor : connection_info {
         return {};
     }
 
+    /// @brief Sets up the specified event to be woken up on new connections.
+    /// @see wakeup_event
+    virtual void prepare_wait(const shared_wakeup_event&) {}
+
     /// @brief Lets the handler process the pending accepted connections.
     virtual auto process_accepted(const accept_handler& handler)
       -> work_done = 0;
@@ -455,6 +455,26 @@ struct asio_connection_state
         return something_done;
     }
 
+    void prepare_wait(wakeup_event& event) {
+#if EAGINE_POSIX
+        if(socket.is_open()) {
+            event.watch(int(socket.native_handle()));
+        }
+#endif
+        if(is_sending) {
+            // the pending send is continued by polling the asio context,
+            // which is needed again once the socket accepts more data
+            bool watched{false};
+#if EAGINE_POSIX
+            watched = socket.is_open() &&
+                      event.watch_writable(int(socket.native_handle()));
+#endif
+            if(!watched) {
+                event.notify();
+            }
+        }
+    }
+
     void cleanup(asio_connection_group<Kind, Proto>& group) {
         log_usage_stats();
         while(is_usable() && start_send(group)) {
@@ -579,6 +599,13 @@ public:
         return true;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        conn_state().prepare_wait(*event);
+        if(!_outgoing.empty() || !_incoming.empty()) {
+            event->notify();
+        }
+    }
+
     void cleanup() final {
         timeout too_long{std::chrono::seconds{5}};
         while(!_outgoing.empty() && !too_long) {
@@ -673,6 +700,14 @@ public:
         return something_done;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        EAGINE_ASSERT(_incoming);
+        conn_state().prepare_wait(*event);
+        if(!_incoming->empty()) {
+            event->notify();
+        }
+    }
+
 private:
     std::shared_ptr<connection_outgoing_messages> _outgoing;
     std::shared_ptr<connection_incoming_messages> _incoming;
@@ -784,6 +819,10 @@ public:
         return something_done;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        conn_state().prepare_wait(*event);
+    }
+
     void cleanup() final {
         conn_state().cleanup(*this);
     }
@@ -1000,6 +1039,17 @@ public:
         return something_done;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+#if EAGINE_POSIX
+        if(_acceptor.is_open()) {
+            event->watch(int(_acceptor.native_handle()));
+        }
+#endif
+        if(!_accepted.empty()) {
+            event->notify();
+        }
+    }
+
     auto process_accepted(const accept_handler& handler) -> work_done final {
         some_true something_done{};
         for(auto& socket : _accepted) {
@@ -1180,6 +1230,10 @@ public:
         return _conn.update();
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        _conn.prepare_wait(event);
+    }
+
     auto process_accepted(const accept_handler& handler) -> work_done final {
         return _conn.process_accepted(handler);
     }
@@ -1340,6 +1394,15 @@ public:
         return something_done;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        if(_acceptor.is_open()) {
+            event->watch(int(_acceptor.native_handle()));
+        }
+        if(!_accepted.empty()) {
+            event->notify();
+        }
+    }
+
     auto process_accepted(const accept_handler& handler) -> work_done final {
         some_true something_done{};
         for(auto& socket : _accepted) {
@@ -48,6 +48,10 @@ public:
     }
 
     auto update() -> work_done;
+    void prepare_wait(const shared_wakeup_event& event);
+    auto next_deadline() const noexcept
+      -> std::chrono::steady_clock::time_point;
+    auto wait_for(std::chrono::milliseconds max_time) -> bool;
     auto is_done() const noexcept -> bool;
     void say_bye();
     void cleanup();
@@ -112,6 +116,7 @@ private:
     bridge_statistics _stats{};
 
     std::shared_ptr<bridge_state> _state{};
+    shared_wakeup_event _wakeup{};
     timeout _no_connection_timeout{adjusted_duration(std::chrono::seconds{30})};
     std::unique_ptr<connection> _connection{};
 };
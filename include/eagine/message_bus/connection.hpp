@@ -17,6 +17,7 @@
 #include "../valid_if/positive.hpp"
 #include "connection_kind.hpp"
 #include "message.hpp"
+#include "wakeup.hpp"
 #include <type_traits>
 
 namespace eagine::msgbus {
@@ -128,6 +129,13 @@ struct connection : connection_info {
     /// @brief Cleans up the connection before destroying it.
     virtual void cleanup() {}
 
+    /// @brief Sets up the specified event to be woken up when there is work.
+    /// @see wakeup_event
+    /// @see update
+    ///
+    /// Called from the thread that is about to wait, before each wait.
+    virtual void prepare_wait(const shared_wakeup_event&) {}
+
     /// @brief Checks if the connection is in usable state.
     virtual auto is_usable() -> bool {
         return true;
@@ -45,6 +45,9 @@ public:
     void send_to_server(message_id msg_id, const message_view& message) {
         std::unique_lock lock{_mutex};
         _client_to_server.back().push(msg_id, message);
+        if(_server_wakeup) {
+            _server_wakeup->notify();
+        }
     }
 
     /// @brief Sends a message to the client counterpart.
@@ -53,11 +56,32 @@ public:
         if(_client_connected) {
             std::unique_lock lock{_mutex};
             _server_to_client.back().push(msg_id, message);
+            if(_client_wakeup) {
+                _client_wakeup->notify();
+            }
             return true;
         }
         return false;
     }
 
+    /// @brief Sets the event notified when a message is sent to the server.
+    void set_server_wakeup(const shared_wakeup_event& event) {
+        std::unique_lock lock{_mutex};
+        _server_wakeup = event;
+        if(event && !_client_to_server.back().empty()) {
+            event->notify();
+        }
+    }
+
+    /// @brief Sets the event notified when a message is sent to the client.
+    void set_client_wakeup(const shared_wakeup_event& event) {
+        std::unique_lock lock{_mutex};
+        _client_wakeup = event;
+        if(event && !_server_to_client.back().empty()) {
+            event->notify();
+        }
+    }
+
     /// @brief Fetches received messages from the client counterpart.
     auto fetch_from_client(connection::fetch_handler handler) noexcept
       -> std::tuple<bool, bool> {
@@ -83,6 +107,8 @@ private:
     std::mutex _mutex;
     double_buffer<message_storage> _server_to_client;
     double_buffer<message_storage> _client_to_server;
+    shared_wakeup_event _server_wakeup;
+    shared_wakeup_event _client_wakeup;
     std::atomic<bool> _client_connected{false};
 };
 //------------------------------------------------------------------------------
@@ -110,24 +136,44 @@ public:
     /// @see process_all
     auto connect() -> shared_state {
         auto state{std::make_shared<direct_connection_state>(*this)};
+        std::unique_lock lock{_mutex};
         _pending.push_back(state);
+        if(_wakeup) {
+            _wakeup->notify();
+        }
         return state;
     }
 
+    /// @brief Sets the event notified when a new client connects.
+    /// @see connect
+    void set_wakeup(const shared_wakeup_event& event) {
+        std::unique_lock lock{_mutex};
+        _wakeup = event;
+        if(event && !_pending.empty()) {
+            event->notify();
+        }
+    }
+
     /// @brief Handles the pending server counterparts for created client connections.
     /// @see connect
     auto process_all(process_handler handler) -> work_done {
         some_true something_done{};
-        for(auto& state : _pending) {
+        std::vector<shared_state> pending;
+        {
+            std::unique_lock lock{_mutex};
+            pending.swap(_pending);
+        }
+        for(auto& state : pending) {
             handler(state);
             something_done();
         }
-        _pending.clear();
         return something_done;
     }
 
 private:
+    std::mutex _mutex;
     std::vector<shared_state> _pending;
+    shared_wakeup_event _wakeup;
 };
 //------------------------------------------------------------------------------
 /// @brief Implementation of the connection_info interface for direct connections.
@@ -175,6 +221,7 @@ public:
 
     ~direct_client_connection() noexcept final {
         if(EAGINE_LIKELY(_state)) {
+            _state->set_client_wakeup({});
             _state->client_disconnect();
         }
     }
@@ -206,6 +253,12 @@ public:
         return true;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        if(EAGINE_LIKELY(_state)) {
+            _state->set_client_wakeup(event);
+        }
+    }
+
     void cleanup() final {}
 
 private:
@@ -234,11 +287,23 @@ public:
     direct_server_connection(std::shared_ptr<direct_connection_state>& state)
       : _state{state} {}
 
+    direct_server_connection(direct_server_connection&&) = delete;
+    direct_server_connection(const direct_server_connection&) = delete;
+    auto operator=(direct_server_connection&&) = delete;
+    auto operator=(const direct_server_connection&) = delete;
+
+    ~direct_server_connection() noexcept final {
+        if(_state) {
+            _state->set_server_wakeup({});
+        }
+    }
+
     auto is_usable() -> bool final {
         if(EAGINE_LIKELY(_state)) {
             if(EAGINE_LIKELY(_is_usable)) {
                 return true;
             }
+            _state->set_server_wakeup({});
             _state.reset();
         }
         return false;
@@ -263,6 +328,12 @@ public:
         return false;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        if(EAGINE_LIKELY(_state)) {
+            _state->set_server_wakeup(event);
+        }
+    }
+
 private:
     std::shared_ptr<direct_connection_state> _state;
     bool _is_usable{true};
@@ -302,6 +373,12 @@ public:
         return something_done;
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        if(_address) {
+            _address->set_wakeup(event);
+        }
+    }
+
     /// @brief Makes a new client-side direct connection.
     auto make_connection() -> std::unique_ptr<connection> {
         if(_address) {
@@ -151,6 +151,22 @@ public:
     /// @brief Updates the internal state, sends and receives pending messages.
     auto update() -> work_done;
 
+    /// @brief Sets up the specified event to be woken up when there is work.
+    /// @see wait_for
+    void prepare_wait(const shared_wakeup_event& event);
+
+    /// @brief Returns the time when update has to be called at the latest.
+    /// @see wait_for
+    auto next_deadline() const noexcept
+      -> std::chrono::steady_clock::time_point;
+
+    /// @brief Blocks until there are incoming messages or the timeout expires.
+    /// @see update
+    /// @see prepare_wait
+    ///
+    /// Should be called instead of sleeping when update did no work.
+    auto wait_for(std::chrono::milliseconds max_time) -> bool;
+
     /// @brief Says to the message bus that this endpoint is disconnecting.
     void finish() {
         say_bye();
@@ -444,6 +460,7 @@ private:
       cfg_init("msg_bus.endpoint.alive_notify_period", std::chrono::seconds{30}),
       nothing};
 
+    shared_wakeup_event _wakeup{};
     std::unique_ptr<connection> _connection{};
     bool _had_working_connection{false};
 
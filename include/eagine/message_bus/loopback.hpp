@@ -41,6 +41,13 @@ public:
         return _messages.fetch_all(handler);
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        std::unique_lock lock{_mutex};
+        if(!_messages.empty()) {
+            event->notify();
+        }
+    }
+
     auto query_statistics(connection_statistics& stats) -> bool final {
         stats.block_usage_ratio = 1.F;
         return true;
@@ -170,6 +170,12 @@ struct message_info {
     /// @brief The message cryptography flags.
     message_crypto_flags crypto_flags{};
 
+    /// @brief Indicates that newer messages with the same id supersede this one.
+    /// @see set_latest_wins
+    /// This is not transferred over the connections, it affects only the
+    /// outgoing queues of the bus node where it was set.
+    bool latest_wins{false};
+
     auto assign(const message_info& that) noexcept -> auto& {
         return *this = that;
     }
@@ -236,6 +242,17 @@ struct message_info {
         return *this;
     }
 
+    /// @brief Sets the "latest wins" queuing policy for this message.
+    /// @see latest_wins
+    ///
+    /// Messages with this policy replace still-enqueued messages with the same
+    /// id, source and target instead of being appended to the outgoing queues.
+    /// Should be used only with messages carrying idempotent status updates.
+    auto set_latest_wins(bool value = true) noexcept -> auto& {
+        latest_wins = value;
+        return *this;
+    }
+
     /// @brief Sets the source endpoint identifier.
     auto set_source_id(identifier_t id) noexcept -> auto& {
         source_id = id;
@@ -663,13 +680,26 @@ public:
         _messages.erase(_messages.begin());
     }
 
+    /// @brief Alias for the key of messages that can replace each other.
+    /// @see push_or_replace
+    using replace_key = std::tuple<message_id, identifier_t, identifier_t>;
+
     void push(memory::const_block message) {
         EAGINE_ASSERT(!message.empty());
         auto buf = _buffers.get(message.size());
         memory::copy_into(message, buf);
-        _messages.emplace_back(std::move(buf), _clock_t::now());
+        _messages.emplace_back(
+          std::move(buf), _clock_t::now(), replace_key{}, false);
     }
 
+    /// @brief Replaces an enqueued message with the same key or pushes a new one.
+    /// @see push
+    ///
+    /// Messages that were packed and are possibly being sent are not replaced.
+    /// Returns true if an enqueued message was replaced.
+    auto push_or_replace(memory::const_block message, const replace_key& key)
+      -> bool;
+
     auto fetch_all(fetch_handler handler) -> bool;
 
     auto pack_into(memory::block dest) -> message_pack_info;
@@ -679,7 +709,10 @@ public:
 private:
     using _clock_t = std::chrono::steady_clock;
     memory::buffer_pool _buffers;
-    std::vector<std::tuple<memory::buffer, message_timestamp>> _messages;
+    // message data, enqueue time, replace key, is packed
+    std::vector<
+      std::tuple<memory::buffer, message_timestamp, replace_key, bool>>
+      _messages;
 };
 //------------------------------------------------------------------------------
 class endpoint;
@@ -778,12 +811,22 @@ public:
         return _serialized.empty();
     }
 
+    /// @brief Serializes and enqueues the message to be sent.
+    /// @see message_info::set_latest_wins
+    ///
+    /// Messages with the "latest wins" policy replace enqueued messages
+    /// with the same id, source and target that have not been sent yet.
     auto enqueue(
       main_ctx_object& user,
       message_id,
       const message_view&,
       memory::block) -> bool;
 
+    /// @brief Returns the number of messages replaced by newer ones.
+    auto replaced_count() const noexcept -> span_size_t {
+        return _replaced_count;
+    }
+
     auto pack_into(memory::block dest) -> message_pack_info {
         return _serialized.pack_into(dest);
     }
@@ -794,6 +837,7 @@ public:
 
 private:
     serialized_message_storage _serialized{};
+    span_size_t _replaced_count{0};
 };
 //------------------------------------------------------------------------------
 class connection_incoming_messages {
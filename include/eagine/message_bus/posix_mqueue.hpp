@@ -11,7 +11,9 @@
 
 #include "../bool_aggregate.hpp"
 #include "../branch_predict.hpp"
+#include "../config/platform.hpp"
 #include "../main_ctx_object.hpp"
+#include "../maybe_unused.hpp"
 #include "../random_identifier.hpp"
 #include "../serialize/block_sink.hpp"
 #include "../serialize/block_source.hpp"
@@ -150,28 +152,17 @@ public:
     /// @see open
     /// @see close
     auto create() -> auto& {
-        errno = 0;
-        // NOLINTNEXTLINE(hicpp-vararg)
-        _ihandle = ::mq_open(
-          (_name + "1").c_str(),
-          // NOLINTNEXTLINE(hicpp-signed-bitwise)
-          O_RDONLY | O_CREAT | O_EXCL | O_NONBLOCK,
-          // NOLINTNEXTLINE(hicpp-signed-bitwise)
-          S_IRUSR | S_IWUSR,
-          nullptr);
-        _last_errno = errno;
-        if(errno == 0) {
-            // NOLINTNEXTLINE(hicpp-vararg)
-            _ohandle = ::mq_open(
-              (_name + "0").c_str(),
-              // NOLINTNEXTLINE(hicpp-signed-bitwise)
-              O_WRONLY | O_CREAT | O_EXCL | O_NONBLOCK,
-              // NOLINTNEXTLINE(hicpp-signed-bitwise)
-              S_IRUSR | S_IWUSR,
-              nullptr);
-            _last_errno = errno;
-        }
-        return *this;
+        return _create(nullptr);
+    }
+
+    /// @brief Creates new OS queue objects with the specified limits.
+    /// @see create
+    auto create(span_size_t max_messages, span_size_t max_message_size)
+      -> auto& {
+        struct ::mq_attr attr {};
+        attr.mq_maxmsg = static_cast<long>(max_messages);
+        attr.mq_msgsize = static_cast<long>(max_message_size);
+        return _create(&attr);
     }
 
     /// @brief Opens existing OS queue objects.
@@ -218,6 +209,18 @@ public:
         return *this;
     }
 
+    /// @brief Indicates that the input queue should wake up the specified event.
+    /// @note Message queue descriptors can be waited on only on Linux.
+    void watch_input(wakeup_event& event) const noexcept {
+#if EAGINE_LINUX
+        if(is_open()) {
+            event.watch(int(_ihandle));
+        }
+#else
+        EAGINE_MAYBE_UNUSED(event);
+#endif
+    }
+
     constexpr static auto default_data_size() noexcept -> span_size_t {
         return 8 * 1024;
     }
@@ -270,6 +273,31 @@ public:
     }
 
 private:
+    auto _create(struct ::mq_attr* attr) -> posix_mqueue& {
+        errno = 0;
+        // NOLINTNEXTLINE(hicpp-vararg)
+        _ihandle = ::mq_open(
+          (_name + "1").c_str(),
+          // NOLINTNEXTLINE(hicpp-signed-bitwise)
+          O_RDONLY | O_CREAT | O_EXCL | O_NONBLOCK,
+          // NOLINTNEXTLINE(hicpp-signed-bitwise)
+          S_IRUSR | S_IWUSR,
+          attr);
+        _last_errno = errno;
+        if(errno == 0) {
+            // NOLINTNEXTLINE(hicpp-vararg)
+            _ohandle = ::mq_open(
+              (_name + "0").c_str(),
+              // NOLINTNEXTLINE(hicpp-signed-bitwise)
+              O_WRONLY | O_CREAT | O_EXCL | O_NONBLOCK,
+              // NOLINTNEXTLINE(hicpp-signed-bitwise)
+              S_IRUSR | S_IWUSR,
+              attr);
+            _last_errno = errno;
+        }
+        return *this;
+    }
+
     std::string _name{};
 
     static constexpr auto _invalid_handle() noexcept -> ::mqd_t {
@@ -344,19 +372,20 @@ public:
 
     auto send(message_id msg_id, const message_view& message) -> bool final {
         std::unique_lock lock{_mutex};
-        block_data_sink sink(cover(_buffer));
-        string_serializer_backend backend(sink);
-        auto errors = serialize_message(msg_id, message, backend);
-        if(!errors) {
-            _outgoing.push(sink.done());
-            return true;
-        }
-        return false;
+        return _outgoing.enqueue(*this, msg_id, message, cover(_buffer));
     }
 
     auto fetch_messages(fetch_handler handler) -> work_done final {
         std::unique_lock lock{_mutex};
-        return _incoming.fetch_all(handler);
+        return _incoming.fetch_messages(*this, handler);
+    }
+
+    void prepare_wait(const shared_wakeup_event& event) override {
+        std::unique_lock lock{_mutex};
+        _data_queue.watch_input(*event);
+        if(!_incoming.empty() || !_outgoing.empty()) {
+            event->notify();
+        }
     }
 
     auto query_statistics(connection_statistics&) -> bool final {
@@ -409,33 +438,36 @@ protected:
         return something_done;
     }
 
-    auto _send() -> bool {
+    auto _send() -> work_done {
+        some_true something_done{};
         if(_data_queue.is_usable()) {
-            return _outgoing.fetch_all(EAGINE_THIS_MEM_FUNC_REF(_handle_send));
+            // pack as many pending messages as fit into each queue message
+            while(!_outgoing.empty()) {
+                const auto packed = _outgoing.pack_into(cover(_buffer));
+                if(packed.is_empty()) {
+                    break;
+                }
+                const auto blk = head(view(_buffer), packed.used());
+                if(_data_queue.send(1, as_chars(blk)).had_error()) {
+                    // the queue is full, retry on the next update
+                    break;
+                }
+                _outgoing.cleanup(packed);
+                something_done();
+            }
         }
-        return false;
+        return something_done;
     }
 
 protected:
-    auto _handle_send(message_timestamp, memory::const_block data) -> bool {
-        return !_data_queue.send(1, as_chars(data)).had_error();
-    }
-
     void _handle_receive(unsigned, memory::span<const char> data) {
-        _incoming.push_if(
-          [data](
-            message_id& msg_id, message_timestamp&, stored_message& message) {
-              block_data_source source(as_bytes(data));
-              string_deserializer_backend backend(source);
-              const auto errors = deserialize_message(msg_id, message, backend);
-              return !errors;
-          });
+        _incoming.push(as_bytes(data));
     }
 
     std::mutex _mutex;
     memory::buffer _buffer;
-    message_storage _incoming;
-    serialized_message_storage _outgoing;
+    connection_incoming_messages _incoming;
+    connection_outgoing_messages _outgoing;
     posix_mqueue _data_queue{};
     std::default_random_engine _rand_eng{std::random_device{}()};
 };
@@ -537,6 +569,13 @@ public:
         return _process(handler);
     }
 
+    void prepare_wait(const shared_wakeup_event& event) final {
+        _accept_queue.watch_input(*event);
+        if(!_requests.empty()) {
+            event->notify();
+        }
+    }
+
 private:
     auto _checkup() -> work_done {
         some_true something_done{};
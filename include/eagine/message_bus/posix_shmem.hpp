@@ -0,0 +1,879 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_MESSAGE_BUS_POSIX_SHMEM_HPP
+#define EAGINE_MESSAGE_BUS_POSIX_SHMEM_HPP
+
+#include "../bool_aggregate.hpp"
+#include "../branch_predict.hpp"
+#include "../main_ctx_object.hpp"
+#include "../maybe_unused.hpp"
+#include "../memory/copy.hpp"
+#include "../random_identifier.hpp"
+#include "../serialize/block_sink.hpp"
+#include "../serialize/block_source.hpp"
+#include "../serialize/string_backend.hpp"
+#include "conn_factory.hpp"
+#include "posix_mqueue.hpp"
+#include "serialize.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <new>
+#include <random>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace eagine::msgbus {
+//------------------------------------------------------------------------------
+/// @brief Class wrapping a named POSIX shared memory segment.
+/// @ingroup msgbus
+class posix_shmem_segment {
+public:
+    /// @brief Default constructor.
+    constexpr posix_shmem_segment() noexcept = default;
+
+    /// @brief Move constructible.
+    posix_shmem_segment(posix_shmem_segment&& temp) noexcept {
+        using std::swap;
+        swap(_name, temp._name);
+        swap(_addr, temp._addr);
+        swap(_size, temp._size);
+    }
+
+    /// @brief Not copy constructible.
+    posix_shmem_segment(const posix_shmem_segment&) = delete;
+
+    /// @brief Not move assignable.
+    auto operator=(posix_shmem_segment&& temp) = delete;
+
+    /// @brief Not copy assignable.
+    auto operator=(const posix_shmem_segment&) = delete;
+
+    ~posix_shmem_segment() noexcept {
+        this->close();
+    }
+
+    /// @brief Returns the unique name of this segment.
+    /// @see set_name
+    auto get_name() const noexcept -> string_view {
+        return {_name};
+    }
+
+    /// @brief Sets the unique name of the segment.
+    /// @see get_name
+    auto set_name(std::string name) -> auto& {
+        _name = std::move(name);
+        if(!_name.empty()) {
+            if(_name.front() != '/') {
+                _name.insert(_name.begin(), '/');
+            }
+        }
+        return *this;
+    }
+
+    /// @brief Returns the error message of the last failed operation.
+    /// @see had_error
+    auto error_message() const -> std::string {
+        if(_last_errno) {
+            char buf[128] = {'\0'};
+            ::strerror_r(_last_errno, static_cast<char*>(buf), sizeof(buf));
+            return {static_cast<const char*>(buf)};
+        }
+        return {};
+    }
+
+    /// @brief Indicates if there a previous operation finished with an error.
+    /// @see error_message
+    auto had_error() const -> bool {
+        return _last_errno != 0;
+    }
+
+    /// @brief Indicates if this segment is open and mapped into memory.
+    constexpr auto is_open() const noexcept -> bool {
+        return _addr != nullptr;
+    }
+
+    /// @brief Unlinks the OS shared memory object.
+    /// @see create
+    /// @see open
+    auto unlink() -> auto& {
+        errno = 0;
+        ::shm_unlink(_name.c_str());
+        _last_errno = errno;
+        return *this;
+    }
+
+    /// @brief Creates a new OS shared memory object with the specified size.
+    /// @see unlink
+    /// @see open
+    /// @see close
+    auto create(span_size_t size) -> auto& {
+        errno = 0;
+        const int fd = ::shm_open(
+          _name.c_str(),
+          // NOLINTNEXTLINE(hicpp-signed-bitwise)
+          O_RDWR | O_CREAT | O_EXCL,
+          // NOLINTNEXTLINE(hicpp-signed-bitwise)
+          S_IRUSR | S_IWUSR);
+        _last_errno = errno;
+        if(fd >= 0) {
+            if(::ftruncate(fd, ::off_t(size)) == 0) {
+                _map(fd, size);
+            } else {
+                _last_errno = errno;
+            }
+            ::close(fd);
+        }
+        return *this;
+    }
+
+    /// @brief Opens an existing OS shared memory object.
+    /// @see create
+    /// @see unlink
+    /// @see close
+    auto open() -> auto& {
+        errno = 0;
+        // NOLINTNEXTLINE(hicpp-signed-bitwise)
+        const int fd = ::shm_open(_name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+        _last_errno = errno;
+        if(fd >= 0) {
+            struct ::stat st {};
+            if(::fstat(fd, &st) == 0) {
+                _map(fd, span_size(st.st_size));
+            } else {
+                _last_errno = errno;
+            }
+            ::close(fd);
+        }
+        return *this;
+    }
+
+    /// @brief Unmaps the shared memory segment.
+    /// @see create
+    /// @see open
+    auto close() noexcept -> posix_shmem_segment& {
+        if(is_open()) {
+            ::munmap(_addr, std_size(_size));
+            _addr = nullptr;
+            _size = 0;
+        }
+        return *this;
+    }
+
+    /// @brief Returns the mapped memory block.
+    auto block() const noexcept -> memory::block {
+        return {static_cast<byte*>(_addr), _size};
+    }
+
+private:
+    void _map(int fd, span_size_t size) noexcept {
+        void* addr = ::mmap(
+          nullptr,
+          std_size(size),
+          // NOLINTNEXTLINE(hicpp-signed-bitwise)
+          PROT_READ | PROT_WRITE,
+          MAP_SHARED,
+          fd,
+          0);
+        if(addr != MAP_FAILED) {
+            _addr = addr;
+            _size = size;
+        } else {
+            _last_errno = errno;
+        }
+    }
+
+    std::string _name{};
+    void* _addr{nullptr};
+    span_size_t _size{0};
+    int _last_errno{0};
+};
+//------------------------------------------------------------------------------
+/// @brief Shared state of a single-producer single-consumer ring buffer.
+/// @ingroup msgbus
+/// @see posix_shmem_ring
+///
+/// Lives in the shared memory segment; a zero-filled instance is valid.
+struct posix_shmem_ring_state {
+    alignas(64) std::atomic<std::uint64_t> write_pos;
+    alignas(64) std::atomic<std::uint64_t> read_pos;
+    alignas(64) std::atomic<std::uint32_t> reader_waiting;
+    std::atomic<std::uint32_t> writer_closed;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+};
+//------------------------------------------------------------------------------
+/// @brief View of a single-producer single-consumer byte ring in shared memory.
+/// @ingroup msgbus
+/// @see posix_shmem_ring_state
+///
+/// Each record consists of a 32-bit size followed by the data and may wrap
+/// around the end of the ring buffer. Neither writing nor reading needs any
+/// system calls, the peer is explicitly woken up only if it indicated that
+/// it is waiting for new data.
+class posix_shmem_ring {
+public:
+    constexpr posix_shmem_ring() noexcept = default;
+
+    posix_shmem_ring(posix_shmem_ring_state& state, memory::block data) noexcept
+      : _state{&state}
+      , _data{data} {}
+
+    /// @brief Indicates if this ring is bound to a shared state.
+    constexpr auto is_valid() const noexcept -> bool {
+        return _state != nullptr;
+    }
+
+    /// @brief Returns the number of bytes that the ring can hold.
+    auto capacity() const noexcept -> span_size_t {
+        return _data.size();
+    }
+
+    /// @brief Writes a record with the specified data into the ring.
+    /// Returns false if there is not enough free space in the ring.
+    auto write(memory::const_block blk) noexcept -> bool {
+        EAGINE_ASSERT(is_valid());
+        const auto wpos = _state->write_pos.load(std::memory_order_relaxed);
+        const auto rpos = _state->read_pos.load(std::memory_order_acquire);
+        const auto used = span_size(wpos - rpos);
+        const auto size = limit_cast<std::uint32_t>(blk.size());
+        if(used + _size_len() + blk.size() > capacity()) {
+            return false;
+        }
+        _copy_in(wpos, as_bytes(view_one(size)));
+        _copy_in(wpos + _size_len(), blk);
+        _state->write_pos.store(
+          wpos + std_size(_size_len() + blk.size()), std::memory_order_seq_cst);
+        return true;
+    }
+
+    /// @brief Returns the size of the next record or zero if the ring is empty.
+    auto next_size() const noexcept -> span_size_t {
+        EAGINE_ASSERT(is_valid());
+        const auto rpos = _state->read_pos.load(std::memory_order_relaxed);
+        const auto wpos = _state->write_pos.load(std::memory_order_acquire);
+        if(rpos == wpos) {
+            return 0;
+        }
+        std::uint32_t size{0U};
+        _copy_out(rpos, as_bytes(cover_one(size)));
+        return span_size(size);
+    }
+
+    /// @brief Reads the next record into the destination block.
+    /// Returns the filled part of dest or an empty block if the ring is empty
+    /// or if the next record does not fit into dest.
+    /// @see next_size
+    auto read(memory::block dest) noexcept -> memory::block {
+        EAGINE_ASSERT(is_valid());
+        const auto rpos = _state->read_pos.load(std::memory_order_relaxed);
+        const auto wpos = _state->write_pos.load(std::memory_order_acquire);
+        if(rpos == wpos) {
+            return {};
+        }
+        std::uint32_t size{0U};
+        _copy_out(rpos, as_bytes(cover_one(size)));
+        if(EAGINE_UNLIKELY(span_size(size) > dest.size())) {
+            return {};
+        }
+        auto result = head(dest, span_size(size));
+        _copy_out(rpos + _size_len(), result);
+        _state->read_pos.store(
+          rpos + std_size(_size_len() + result.size()),
+          std::memory_order_release);
+        return result;
+    }
+
+    /// @brief Indicates if there are records to be read (with full ordering).
+    auto has_data() const noexcept -> bool {
+        EAGINE_ASSERT(is_valid());
+        return _state->read_pos.load(std::memory_order_seq_cst) !=
+               _state->write_pos.load(std::memory_order_seq_cst);
+    }
+
+    /// @brief Called by the reader before it starts to wait for new records.
+    /// @see has_data
+    /// @see take_reader_waiting
+    ///
+    /// The reader must check has_data after calling this function.
+    void set_reader_waiting() noexcept {
+        EAGINE_ASSERT(is_valid());
+        _state->reader_waiting.store(1U, std::memory_order_seq_cst);
+    }
+
+    /// @brief Called by the reader after it woke up.
+    /// @see set_reader_waiting
+    void clear_reader_waiting() noexcept {
+        EAGINE_ASSERT(is_valid());
+        _state->reader_waiting.store(0U, std::memory_order_relaxed);
+    }
+
+    /// @brief Called by the writer after writing, indicates if the reader should be woken up.
+    auto take_reader_waiting() noexcept -> bool {
+        EAGINE_ASSERT(is_valid());
+        if(_state->reader_waiting.load(std::memory_order_seq_cst) != 0U) {
+            return _state->reader_waiting.exchange(0U) != 0U;
+        }
+        return false;
+    }
+
+    /// @brief Marks this ring as closed by the writer.
+    void close_writer() noexcept {
+        if(is_valid()) {
+            _state->writer_closed.store(1U, std::memory_order_release);
+        }
+    }
+
+    /// @brief Indicates if the writer closed this ring.
+    auto is_writer_closed() const noexcept -> bool {
+        return _state->writer_closed.load(std::memory_order_acquire) != 0U;
+    }
+
+private:
+    static constexpr auto _size_len() noexcept -> span_size_t {
+        return span_size(sizeof(std::uint32_t));
+    }
+
+    auto _offset(std::uint64_t pos) const noexcept -> span_size_t {
+        return span_size(pos % std::uint64_t(capacity()));
+    }
+
+    void _copy_in(std::uint64_t pos, memory::const_block src) noexcept {
+        const auto offs = _offset(pos);
+        const auto first = std::min(src.size(), capacity() - offs);
+        std::memcpy(_data.data() + offs, src.data(), std_size(first));
+        std::memcpy(
+          _data.data(), src.data() + first, std_size(src.size() - first));
+    }
+
+    void _copy_out(std::uint64_t pos, memory::block dst) const noexcept {
+        const auto offs = _offset(pos);
+        const auto first = std::min(dst.size(), capacity() - offs);
+        std::memcpy(dst.data(), _data.data() + offs, std_size(first));
+        std::memcpy(
+          dst.data() + first, _data.data(), std_size(dst.size() - first));
+    }
+
+    posix_shmem_ring_state* _state{nullptr};
+    memory::block _data{};
+};
+//------------------------------------------------------------------------------
+/// @brief Implementation of the connection_info interface for shared memory connection.
+/// @ingroup msgbus
+/// @see connection_info
+template <typename Base>
+class posix_shmem_connection_info : public Base {
+public:
+    using Base::Base;
+
+    auto kind() -> connection_kind final {
+        return connection_kind::local_interprocess;
+    }
+
+    auto addr_kind() -> connection_addr_kind final {
+        return connection_addr_kind::filepath;
+    }
+
+    auto type_id() -> identifier final {
+        return EAGINE_ID(PosixShMem);
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Implementation of connection on top of POSIX shared memory.
+/// @ingroup msgbus
+/// @see posix_shmem_connector
+/// @see posix_shmem_acceptor
+///
+/// Messages are exchanged through a pair of ring buffers in a shared memory
+/// segment. A pair of POSIX message queues is used only to wake up a peer
+/// that is waiting for new messages.
+class posix_shmem_connection
+  : public posix_shmem_connection_info<connection>
+  , public main_ctx_object {
+
+public:
+    /// @brief Alias for received message fetch handler callable.
+    using fetch_handler = connection::fetch_handler;
+
+    /// @brief Construction from parent main context object.
+    posix_shmem_connection(main_ctx_parent parent)
+      : main_ctx_object{EAGINE_ID(ShMemConn), parent} {
+        _buffer.resize(default_block_size());
+    }
+
+    posix_shmem_connection(posix_shmem_connection&&) = delete;
+    posix_shmem_connection(const posix_shmem_connection&) = delete;
+    auto operator=(posix_shmem_connection&&) = delete;
+    auto operator=(const posix_shmem_connection&) = delete;
+
+    ~posix_shmem_connection() noexcept override {
+        _output.close_writer();
+    }
+
+    static constexpr auto default_block_size() noexcept -> span_size_t {
+        return 16 * 1024;
+    }
+
+    static constexpr auto default_ring_size() noexcept -> span_size_t {
+        return 1024 * 1024;
+    }
+
+    /// @brief Returns the smallest ring size that can hold a full-size block.
+    static constexpr auto min_ring_size() noexcept -> span_size_t {
+        return default_block_size() + span_size(sizeof(std::uint32_t));
+    }
+
+    /// @brief Returns the name of the connection request queue for an address.
+    static auto accept_queue_name(std::string name) -> std::string {
+        name.append("-shm");
+        return name;
+    }
+
+    /// @brief Opens the connection to a segment created by the peer.
+    auto open(std::string name) -> bool {
+        _segment.set_name(name).open();
+        if(!_segment.had_error() && _bind(false)) {
+            if(!_doorbell.set_name(std::move(name)).open().had_error()) {
+                _doorbell_buffer.resize(_doorbell.data_size());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto is_usable() -> bool final {
+        return _segment.is_open() && _input.is_valid() &&
+               _doorbell.is_usable() && !_input.is_writer_closed();
+    }
+
+    auto max_data_size() -> valid_if_positive<span_size_t> final {
+        return {_buffer.size()};
+    }
+
+    auto update() -> work_done override {
+        std::unique_lock lock{_mutex};
+        some_true something_done{};
+        something_done(_receive());
+        something_done(_send());
+        return something_done;
+    }
+
+    auto send(message_id msg_id, const message_view& message) -> bool final {
+        std::unique_lock lock{_mutex};
+        return _outgoing.enqueue(*this, msg_id, message, cover(_buffer));
+    }
+
+    auto fetch_messages(fetch_handler handler) -> work_done final {
+        std::unique_lock lock{_mutex};
+        return _incoming.fetch_messages(*this, handler);
+    }
+
+    void prepare_wait(const shared_wakeup_event& event) override {
+        std::unique_lock lock{_mutex};
+        if(_input.is_valid()) {
+            _input.set_reader_waiting();
+            _doorbell_armed = true;
+            if(_input.has_data()) {
+                event->notify();
+            }
+        }
+        _doorbell.watch_input(*event);
+        if(!_incoming.empty() || !_outgoing.empty()) {
+            event->notify();
+        }
+    }
+
+    auto query_statistics(connection_statistics&) -> bool final {
+        return false;
+    }
+
+protected:
+    auto _checkup(posix_mqueue& connect_queue) -> work_done {
+        some_true something_done{};
+        if(connect_queue.is_usable()) {
+            if(!_segment.is_open()) {
+                const auto name = posix_mqueue::name_from(
+                  random_identifier(any_random_engine(_rand_eng)));
+                _doorbell.close();
+                _doorbell.unlink();
+                _segment.unlink();
+                _segment.set_name(name).create(
+                  _header_size() + 2 * _ring_size);
+                // the wakeup queues need to hold just a single small message
+                if(
+                  !_segment.had_error() && _bind(true) &&
+                  !_doorbell.set_name(name).create(1, 1).had_error()) {
+                    _doorbell_buffer.resize(_doorbell.data_size());
+
+                    block_data_sink sink(cover(_buffer));
+                    string_serializer_backend backend(sink);
+                    auto errors = serialize_message(
+                      EAGINE_MSGBUS_ID(shmConnect),
+                      message_view(_segment.get_name()),
+                      backend);
+                    if(!errors) {
+                        connect_queue.send(1, as_chars(sink.done()));
+                    }
+                }
+                something_done();
+            }
+        }
+        return something_done;
+    }
+
+    auto _receive() -> work_done {
+        some_true something_done{};
+        if(_doorbell_armed) {
+            // only touch the wakeup queue if we announced that we wait
+            _doorbell_armed = false;
+            while(!_doorbell
+                     .receive(
+                       as_chars(cover(_doorbell_buffer)),
+                       posix_mqueue::receive_handler(
+                         EAGINE_THIS_MEM_FUNC_REF(_handle_doorbell)))
+                     .had_error()) {
+            }
+            _input.clear_reader_waiting();
+        }
+        if(_input.is_valid()) {
+            // records written before the peer closed its writer are still read
+            const bool peer_closed = _input.is_writer_closed();
+            while(true) {
+                const auto blk = _input.read(cover(_buffer));
+                if(blk.empty()) {
+                    const auto size = _input.next_size();
+                    if(EAGINE_UNLIKELY(size > _buffer.size())) {
+                        log_error("received too large shared memory record")
+                          .arg(EAGINE_ID(size), size)
+                          .arg(EAGINE_ID(maxSize), _buffer.size());
+                        _close();
+                        something_done();
+                        return something_done;
+                    }
+                    break;
+                }
+                _incoming.push(blk);
+                something_done();
+            }
+            if(peer_closed) {
+                _close();
+                something_done();
+            }
+        }
+        return something_done;
+    }
+
+    auto _send() -> work_done {
+        some_true something_done{};
+        if(_output.is_valid()) {
+            while(!_outgoing.empty()) {
+                const auto packed = _outgoing.pack_into(cover(_buffer));
+                if(packed.is_empty()) {
+                    break;
+                }
+                if(!_output.write(head(view(_buffer), packed.used()))) {
+                    // the ring is full, retry on the next update
+                    break;
+                }
+                _outgoing.cleanup(packed);
+                something_done();
+            }
+            if(something_done && _output.take_reader_waiting()) {
+                const char ring{'\0'};
+                _doorbell.send(1, view_one(ring));
+            }
+        }
+        return something_done;
+    }
+
+    std::mutex _mutex;
+    memory::buffer _buffer;
+    connection_incoming_messages _incoming;
+    connection_outgoing_messages _outgoing;
+    posix_shmem_segment _segment{};
+    posix_mqueue _doorbell{};
+    std::default_random_engine _rand_eng{std::random_device{}()};
+
+private:
+    struct _header {
+        std::uint64_t ring_size;
+        posix_shmem_ring_state rings[2];
+    };
+
+    static constexpr auto _header_size() noexcept -> span_size_t {
+        return span_size(sizeof(_header));
+    }
+
+    auto _bind(bool creator) noexcept -> bool {
+        auto blk = _segment.block();
+        if(blk.size() < _header_size()) {
+            return false;
+        }
+        auto& hdr = creator ? *new(blk.data()) _header{}
+                            : *reinterpret_cast<_header*>(blk.data());
+        if(creator) {
+            hdr.ring_size = std::uint64_t(_ring_size);
+        } else if(
+          (span_size(hdr.ring_size) < min_ring_size()) ||
+          (blk.size() < _header_size() + 2 * span_size(hdr.ring_size))) {
+            return false;
+        }
+        const auto ring_size = span_size(hdr.ring_size);
+        auto ring0 = head(skip(blk, _header_size()), ring_size);
+        auto ring1 = head(skip(blk, _header_size() + ring_size), ring_size);
+        // the creator writes into the first ring and reads the second one
+        _output = creator ? posix_shmem_ring{hdr.rings[0], ring0}
+                          : posix_shmem_ring{hdr.rings[1], ring1};
+        _input = creator ? posix_shmem_ring{hdr.rings[1], ring1}
+                         : posix_shmem_ring{hdr.rings[0], ring0};
+        return true;
+    }
+
+    void _close() noexcept {
+        // tell the peer that we are gone and unmap the segment, the connector
+        // creates a new one on the next checkup
+        _output.close_writer();
+        _input = {};
+        _output = {};
+        _segment.close();
+    }
+
+    void _handle_doorbell(unsigned, memory::span<const char>) {}
+
+    auto _init_ring_size() -> span_size_t {
+        const auto ring_size =
+          cfg_init("msg_bus.posix_shmem.ring_size", default_ring_size());
+        if(ring_size < min_ring_size()) {
+            log_error("shared memory ring size is too small")
+              .arg(EAGINE_ID(ringSize), ring_size)
+              .arg(EAGINE_ID(minSize), min_ring_size());
+            return min_ring_size();
+        }
+        return ring_size;
+    }
+
+    const span_size_t _ring_size{_init_ring_size()};
+    memory::buffer _doorbell_buffer;
+    posix_shmem_ring _input{};
+    posix_shmem_ring _output{};
+    bool _doorbell_armed{false};
+};
+//------------------------------------------------------------------------------
+/// @brief Implementation of connection on top of POSIX shared memory.
+/// @ingroup msgbus
+/// @see posix_shmem_acceptor
+class posix_shmem_connector : public posix_shmem_connection {
+    using base = posix_shmem_connection;
+
+public:
+    /// @brief Alias for received message fetch handler callable.
+    using fetch_handler = connection::fetch_handler;
+
+    /// @brief Construction from parent main context object and address.
+    posix_shmem_connector(main_ctx_parent parent, std::string name)
+      : base{parent}
+      , _connect_queue{accept_queue_name(std::move(name))} {}
+
+    /// @brief Construction from parent main context object and identifier.
+    posix_shmem_connector(main_ctx_parent parent, identifier id)
+      : posix_shmem_connector{parent, posix_mqueue::name_from(id)} {}
+
+    posix_shmem_connector(posix_shmem_connector&&) = delete;
+    posix_shmem_connector(const posix_shmem_connector&) = delete;
+    auto operator=(posix_shmem_connector&&) = delete;
+    auto operator=(const posix_shmem_connector&) = delete;
+
+    ~posix_shmem_connector() noexcept final {
+        _doorbell.unlink();
+        _segment.unlink();
+    }
+
+    auto update() -> work_done final {
+        std::unique_lock lock{_mutex};
+        some_true something_done{};
+        something_done(_checkup());
+        something_done(_receive());
+        something_done(_send());
+        return something_done;
+    }
+
+private:
+    auto _checkup() -> work_done {
+        some_true something_done{};
+        if(!_connect_queue.is_usable()) {
+            _connect_queue.close();
+            _connect_queue.open();
+            something_done();
+        }
+        something_done(posix_shmem_connection::_checkup(_connect_queue));
+        return something_done;
+    }
+
+    posix_mqueue _connect_queue{};
+};
+//------------------------------------------------------------------------------
+/// @brief Implementation of acceptor on top of POSIX shared memory.
+/// @ingroup msgbus
+/// @see posix_shmem_connector
+///
+/// Connection requests are received through a POSIX message queue.
+class posix_shmem_acceptor
+  : public posix_shmem_connection_info<acceptor>
+  , public main_ctx_object {
+
+public:
+    /// @brief Alias for accepted connection handler callable.
+    using accept_handler = acceptor::accept_handler;
+
+    /// @brief Construction from parent main context object and address.
+    posix_shmem_acceptor(main_ctx_parent parent, std::string name)
+      : main_ctx_object{EAGINE_ID(ShMemConnA), parent}
+      , _accept_queue{posix_shmem_connection::accept_queue_name(
+          std::move(name))} {
+        _buffer.resize(_accept_queue.data_size());
+    }
+
+    /// @brief Construction from parent main context object and identifier.
+    posix_shmem_acceptor(main_ctx_parent parent, identifier id)
+      : posix_shmem_acceptor{parent, posix_mqueue::name_from(id)} {}
+
+    posix_shmem_acceptor(posix_shmem_acceptor&&) noexcept = default;
+    posix_shmem_acceptor(const posix_shmem_acceptor&) = delete;
+    auto operator=(posix_shmem_acceptor&&) = delete;
+    auto operator=(const posix_shmem_acceptor&) = delete;
+
+    ~posix_shmem_acceptor() noexcept final {
+        _accept_queue.unlink();
+    }
+
+    auto update() -> work_done final {
+        some_true something_done{};
+        something_done(_checkup());
+        something_done(_receive());
+        return something_done;
+    }
+
+    auto process_accepted(const accept_handler& handler) -> work_done final {
+        return _process(handler);
+    }
+
+    void prepare_wait(const shared_wakeup_event& event) final {
+        _accept_queue.watch_input(*event);
+        if(!_requests.empty()) {
+            event->notify();
+        }
+    }
+
+private:
+    auto _checkup() -> work_done {
+        some_true something_done{};
+        if(!_accept_queue.is_usable()) {
+            _accept_queue.close();
+            _accept_queue.unlink();
+            if(!_accept_queue.create().had_error()) {
+                _buffer.resize(_accept_queue.data_size());
+            }
+            something_done();
+        }
+        return something_done;
+    }
+
+    auto _receive() -> work_done {
+        some_true something_done{};
+        if(_accept_queue.is_usable()) {
+            while(!_accept_queue
+                     .receive(
+                       as_chars(cover(_buffer)),
+                       EAGINE_THIS_MEM_FUNC_REF(_handle_receive))
+                     .had_error()) {
+                something_done();
+            }
+        }
+        return something_done;
+    }
+
+    void _handle_receive(unsigned, memory::span<const char> data) {
+        _requests.push_if(
+          [data](
+            message_id& msg_id, message_timestamp&, stored_message& message) {
+              block_data_source source(as_bytes(data));
+              string_deserializer_backend backend(source);
+              const auto errors = deserialize_message(msg_id, message, backend);
+              if(EAGINE_LIKELY(is_special_message(msg_id))) {
+                  if(EAGINE_LIKELY(msg_id.has_method(EAGINE_ID(shmConnect)))) {
+                      return !errors;
+                  }
+              }
+              return false;
+          });
+    }
+
+    auto _process(const accept_handler& handler) -> work_done {
+        auto fetch_handler = [this, &handler](
+                               message_id msg_id,
+                               message_age,
+                               const message_view& message) -> bool {
+            EAGINE_ASSERT((msg_id == EAGINE_MSGBUS_ID(shmConnect)));
+            EAGINE_MAYBE_UNUSED(msg_id);
+
+            if(auto conn = std::make_unique<posix_shmem_connection>(*this)) {
+                if(conn->open(to_string(as_chars(message.data())))) {
+                    handler(std::move(conn));
+                } else {
+                    log_warning("failed to open shared memory connection")
+                      .arg(EAGINE_ID(name), as_chars(message.data()));
+                }
+            }
+            return true;
+        };
+        return _requests.fetch_all({construct_from, fetch_handler});
+    }
+
+    memory::buffer _buffer{};
+    message_storage _requests{};
+    posix_mqueue _accept_queue{};
+};
+//------------------------------------------------------------------------------
+/// @brief Implementation of connection_factory for POSIX shared memory connections.
+/// @ingroup msgbus
+/// @see posix_shmem_connector
+/// @see posix_shmem_acceptor
+class posix_shmem_connection_factory
+  : public posix_shmem_connection_info<connection_factory>
+  , public main_ctx_object {
+public:
+    /// @brief Construction from parent main context object.
+    posix_shmem_connection_factory(main_ctx_parent parent)
+      : main_ctx_object{EAGINE_ID(ShMemConnF), parent} {}
+
+    using connection_factory::make_acceptor;
+    using connection_factory::make_connector;
+
+    /// @brief Makes an connection acceptor listening at the specified address.
+    auto make_acceptor(string_view address) -> std::unique_ptr<acceptor> final {
+        return std::make_unique<posix_shmem_acceptor>(
+          *this, to_string(address));
+    }
+
+    /// @brief Makes a connector connecting to the specified address.
+    auto make_connector(string_view address)
+      -> std::unique_ptr<connection> final {
+        return std::make_unique<posix_shmem_connector>(
+          *this, to_string(address));
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::msgbus
+
+#endif // EAGINE_MESSAGE_BUS_POSIX_SHMEM_HPP
@@ -806,6 +806,11 @@ public:
     /// @brief Returns node uptime in seconds.
     auto uptime() const noexcept -> valid_if_not_zero<std::chrono::seconds>;
 
+    /// @brief Returns the latest process resource usage of the node.
+    /// @see resource_usage_consumer
+    auto resource_usage() const noexcept
+      -> optional_reference_wrapper<const process_resource_usage>;
+
     /// @brief Return information about the connections of this node.
     /// @see host
     /// @see instance
@@ -848,6 +853,7 @@ public:
     auto assign(const router_statistics&) -> remote_node_state&;
     auto assign(const bridge_statistics&) -> remote_node_state&;
     auto assign(const endpoint_statistics&) -> remote_node_state&;
+    auto assign(const process_resource_usage&) -> remote_node_state&;
 
     auto add_subscription(message_id) -> remote_node_state&;
     auto remove_subscription(message_id) -> remote_node_state&;
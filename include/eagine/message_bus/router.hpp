@@ -11,12 +11,15 @@
 
 #include "../bool_aggregate.hpp"
 #include "../flat_map.hpp"
+#include "../flat_set.hpp"
+#include "../log_histogram.hpp"
 #include "../main_ctx_object.hpp"
 #include "../timeout.hpp"
 #include "../valid_if/positive.hpp"
 #include "acceptor.hpp"
 #include "blobs.hpp"
 #include "context_fwd.hpp"
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -53,6 +56,38 @@ struct router_endpoint_info {
     }
 };
 //------------------------------------------------------------------------------
+struct router_flow_histograms {
+    log_histogram<> age_us{};
+    log_histogram<> size{};
+    log_histogram<> latency_ns{};
+
+    void add(
+      message_age age,
+      span_size_t msg_size,
+      std::chrono::steady_clock::duration latency) noexcept {
+        age_us.add(std::uint64_t(age.count() * 1000000.F));
+        size.add(std::uint64_t(msg_size));
+        latency_ns.add(std::uint64_t(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(latency)
+            .count()));
+    }
+
+    void summarize(message_flow_statistics& stats) const noexcept {
+        const auto clamp = [](std::uint64_t v) {
+            return std::int32_t(std::min<std::uint64_t>(v, 0x7FFFFFFFU));
+        };
+        stats.message_count = std::int64_t(age_us.count());
+        stats.age_p50_us = clamp(age_us.quantile(0.50));
+        stats.age_p99_us = clamp(age_us.quantile(0.99));
+        stats.age_max_us = clamp(age_us.max());
+        stats.size_p50 = clamp(size.quantile(0.50));
+        stats.size_max = clamp(size.max());
+        stats.latency_p50_ns = clamp(latency_ns.quantile(0.50));
+        stats.latency_p99_ns = clamp(latency_ns.quantile(0.99));
+        stats.latency_max_ns = clamp(latency_ns.max());
+    }
+};
+//------------------------------------------------------------------------------
 struct routed_node {
     std::unique_ptr<connection> the_connection{};
     std::vector<message_id> message_block_list{};
@@ -122,6 +157,10 @@ public:
         return update(2);
     }
 
+    void prepare_wait(const shared_wakeup_event& event);
+    auto next_deadline() -> std::chrono::steady_clock::time_point;
+    auto wait_for(std::chrono::milliseconds max_time) -> bool;
+
     void say_bye();
     void cleanup();
     void finish();
@@ -156,6 +195,7 @@ private:
     auto _uptime_seconds() -> std::int64_t;
 
     void _setup_from_config();
+    void _setup_latest_wins_from_config();
 
     auto _handle_accept() -> work_done;
     auto _handle_pending() -> work_done;
@@ -201,6 +241,18 @@ private:
     auto _update_stats() -> work_done;
     auto _handle_stats_query(const message_view&) -> message_handling_result;
 
+    using flow_histogram_map =
+      flat_map<identifier_t, std::unique_ptr<router_flow_histograms>>;
+    static auto _flow_histograms(flow_histogram_map&, identifier_t)
+      -> router_flow_histograms&;
+    void _record_flow(
+      router_flow_histograms& conn_hist,
+      message_id msg_id,
+      const message_view& message,
+      std::chrono::steady_clock::time_point start);
+    void _send_flow_stats(const message_view& request);
+    void _log_flow_stats();
+
     auto _handle_blob_fragment(const message_view&) -> message_handling_result;
     auto _handle_blob_resend(const message_view&) -> message_handling_result;
 
@@ -248,10 +300,17 @@ private:
     float _message_age_sum{0.F};
     router_statistics _stats{};
     message_flow_info _flow_info{};
+    bool _flow_histograms_enabled{false};
+    identifier_t _last_flow_class{0};
+    router_flow_histograms* _last_flow_class_hist{nullptr};
+    flow_histogram_map _connection_flow_hists;
+    flow_histogram_map _class_flow_hists;
 
+    shared_wakeup_event _wakeup{};
     parent_router _parent_router;
     std::vector<std::shared_ptr<acceptor>> _acceptors;
     std::vector<router_pending> _pending;
+    flat_set<message_id> _latest_wins_msg_ids;
     flat_map<identifier_t, routed_node> _nodes;
     flat_map<identifier_t, identifier_t> _endpoint_idx;
     flat_map<identifier_t, router_endpoint_info> _endpoint_infos;
@@ -0,0 +1,209 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_MESSAGE_BUS_SERVICE_LOG_CONTROL_HPP
+#define EAGINE_MESSAGE_BUS_SERVICE_LOG_CONTROL_HPP
+
+#include "../../logging/filter.hpp"
+#include "../../main_ctx.hpp"
+#include "../../maybe_unused.hpp"
+#include "../serialize.hpp"
+#include "../signal.hpp"
+#include "../subscriber.hpp"
+#include <array>
+#include <tuple>
+
+namespace eagine::msgbus {
+//------------------------------------------------------------------------------
+/// @brief Service allowing to adjust the endpoint's log filter over the bus.
+/// @ingroup msgbus
+/// @see service_composition
+/// @see log_control_invoker
+/// @see log_filter
+///
+/// The requests are applied to the filter of the application's root logger,
+/// if the root logger has one and if allow_log_control approves the sender.
+template <typename Base = subscriber>
+class log_control_target : public Base {
+    using This = log_control_target;
+
+public:
+    /// @brief Triggered when the log filter was changed by a remote node.
+    signal<void(identifier_t source_id, verification_bits verified)>
+      log_filter_changed;
+
+    /// @brief Decides if a log filter change request should be applied.
+    ///
+    /// By default only requests signed by a node with verified certificate
+    /// are applied.
+    virtual auto allow_log_control(
+      identifier_t source_id,
+      verification_bits verified) -> bool {
+        EAGINE_MAYBE_UNUSED(source_id);
+        return verified.has_all(
+          verification_bit::source_certificate,
+          verification_bit::message_content);
+    }
+
+protected:
+    using Base::Base;
+
+    void add_methods() {
+        Base::add_methods();
+        Base::add_method(
+          this, EAGINE_MSG_MAP(eagiLogCtl, setSevrty, This, _handle_severity));
+        Base::add_method(
+          this, EAGINE_MSG_MAP(eagiLogCtl, rstSevrty, This, _handle_reset));
+        Base::add_method(
+          this, EAGINE_MSG_MAP(eagiLogCtl, rateLimit, This, _handle_rate));
+    }
+
+private:
+    static auto _filter() noexcept -> log_filter* {
+        if(auto lbe{main_ctx::get().log().backend()}) {
+            return lbe->filter();
+        }
+        return nullptr;
+    }
+
+    auto _allowed(stored_message& message, verification_bits& verified)
+      -> bool {
+        verified = this->verify_bits(message);
+        if(allow_log_control(message.source_id, verified)) {
+            return true;
+        }
+        this->bus_node()
+          .log_warning("rejected log filter change from ${source}")
+          .arg(EAGINE_ID(source), message.source_id);
+        return false;
+    }
+
+    void _changed(stored_message& message, verification_bits verified) {
+        this->bus_node()
+          .log_info("log filter changed by ${source}")
+          .arg(EAGINE_ID(source), message.source_id);
+        log_filter_changed(message.source_id, verified);
+    }
+
+    auto _handle_severity(const message_context&, stored_message& message)
+      -> bool {
+        verification_bits verified{};
+        std::tuple<identifier_t, log_event_severity> request{};
+        if(
+          _allowed(message, verified) &&
+          default_deserialize(request, message.content())) {
+            if(auto filter{_filter()}) {
+                const auto [source, severity] = request;
+                if(source) {
+                    filter->set_min_severity(identifier{source}, severity);
+                } else {
+                    filter->set_min_severity(severity);
+                }
+                _changed(message, verified);
+            }
+        }
+        return true;
+    }
+
+    auto _handle_reset(const message_context&, stored_message& message)
+      -> bool {
+        verification_bits verified{};
+        identifier_t source{0U};
+        if(
+          _allowed(message, verified) &&
+          default_deserialize(source, message.content())) {
+            if(auto filter{_filter()}) {
+                if(source) {
+                    filter->reset_min_severity(identifier{source});
+                } else {
+                    filter->reset_min_severities();
+                }
+                _changed(message, verified);
+            }
+        }
+        return true;
+    }
+
+    auto _handle_rate(const message_context&, stored_message& message)
+      -> bool {
+        verification_bits verified{};
+        std::tuple<float, float> request{};
+        if(
+          _allowed(message, verified) &&
+          default_deserialize(request, message.content())) {
+            if(auto filter{_filter()}) {
+                const auto [per_second, burst] = request;
+                filter->set_rate_limit(per_second, burst);
+                _changed(message, verified);
+            }
+        }
+        return true;
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Service allowing to adjust the log filters of other endpoints.
+/// @ingroup msgbus
+/// @see service_composition
+/// @see log_control_target
+template <typename Base = subscriber>
+class log_control_invoker : public Base {
+public:
+    /// @brief Sets the minimum severity of a log source on the target endpoint.
+    /// @see reset_log_severity
+    ///
+    /// If the source is empty the default minimum severity is set.
+    void set_log_severity(
+      identifier_t target_id,
+      identifier source,
+      log_event_severity severity) {
+        _post(
+          target_id,
+          EAGINE_MSG_ID(eagiLogCtl, setSevrty),
+          std::make_tuple(source.value(), severity));
+    }
+
+    /// @brief Makes a log source on the target use the default severity.
+    /// @see set_log_severity
+    ///
+    /// If the source is empty all sources use the default severity.
+    void reset_log_severity(identifier_t target_id, identifier source) {
+        _post(target_id, EAGINE_MSG_ID(eagiLogCtl, rstSevrty), source.value());
+    }
+
+    /// @brief Sets the per call site log rate limit on the target endpoint.
+    ///
+    /// Zero or negative rate disables the rate limiting.
+    void set_log_rate_limit(
+      identifier_t target_id,
+      float per_second,
+      float burst) {
+        _post(
+          target_id,
+          EAGINE_MSG_ID(eagiLogCtl, rateLimit),
+          std::make_tuple(per_second, burst));
+    }
+
+protected:
+    using Base::Base;
+
+private:
+    template <typename T>
+    void _post(identifier_t target_id, message_id msg_id, const T& value) {
+        std::array<byte, 64> temp{};
+        auto serialized{default_serialize(value, cover(temp))};
+        EAGINE_ASSERT(serialized);
+
+        message_view message{extract(serialized)};
+        message.set_target_id(target_id);
+        this->bus_node().post_signed(msg_id, message);
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::msgbus
+
+#endif // EAGINE_MESSAGE_BUS_SERVICE_LOG_CONTROL_HPP
@@ -9,6 +9,7 @@
 #ifndef EAGINE_MESSAGE_BUS_SERVICE_RESOURCE_TRANSFER_HPP
 #define EAGINE_MESSAGE_BUS_SERVICE_RESOURCE_TRANSFER_HPP
 
+#include "../../chunked_compression.hpp"
 #include "../../flat_map.hpp"
 #include "../../flat_set.hpp"
 #include "../../from_string.hpp"
@@ -26,6 +27,7 @@
 #include "../signal.hpp"
 #include "discovery.hpp"
 #include "host_info.hpp"
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <random>
@@ -131,6 +133,112 @@ private:
     span_size_t _size{0};
 };
 //------------------------------------------------------------------------------
+/// @brief Implementation of blob_io serving the unpacked content of a chunked
+///        compressed container.
+/// @ingroup msgbus
+/// @see chunked_compressed_view
+/// @see make_file_blob_io
+///
+/// Only the chunks overlapping the fetched fragments are unpacked, so the
+/// container does not have to be decompressed as a whole before sending.
+/// The offset and size apply to the unpacked data, like in file_blob_io.
+class chunked_compressed_blob_io : public blob_io {
+public:
+    chunked_compressed_blob_io(
+      memory::buffer packed,
+      data_compressor compressor,
+      optionally_valid<span_size_t> offs,
+      optionally_valid<span_size_t> size) noexcept
+      : _packed{std::move(packed)}
+      , _view{view(_packed)}
+      , _compressor{std::move(compressor)}
+      , _size{_view.total_size()} {
+        if(size) {
+            _size = math::minimum(_size, extract(size));
+        }
+        if(offs) {
+            _offs = math::minimum(_size, extract(offs));
+        }
+    }
+
+    auto total_size() -> span_size_t final {
+        return _size - _offs;
+    }
+
+    auto fetch_fragment(span_size_t offs, memory::block dst)
+      -> span_size_t final {
+        span_size_t done{0};
+        offs += _offs;
+        dst = head(dst, _size - offs);
+        while(!dst.empty()) {
+            // only the chunk(s) overlapping the fragment are unpacked
+            const auto index = _view.chunk_index(offs);
+            if(index != _unpacked_index) {
+                _unpacked = _view.unpack_chunk(_compressor, index, _buffer);
+                _unpacked_index = _unpacked ? index : -1;
+                if(!_unpacked) {
+                    break;
+                }
+            }
+            const auto src = head(
+              skip(_unpacked, offs - _view.chunk_offset(index)), dst.size());
+            if(src.empty()) {
+                break;
+            }
+            copy(src, dst);
+            dst = skip(dst, src.size());
+            offs += src.size();
+            done += src.size();
+        }
+        return done;
+    }
+
+private:
+    memory::buffer _packed;
+    chunked_compressed_view _view;
+    data_compressor _compressor;
+    memory::buffer _buffer;
+    memory::const_block _unpacked;
+    span_size_t _unpacked_index{-1};
+    span_size_t _offs{0};
+    span_size_t _size{0};
+};
+//------------------------------------------------------------------------------
+/// @brief Makes a blob_io reading the specified file.
+/// @ingroup msgbus
+/// @see file_blob_io
+/// @see chunked_compressed_blob_io
+///
+/// Files containing a chunked compressed container are loaded into memory
+/// and served unpacked by chunked_compressed_blob_io, other files are read
+/// as they are by file_blob_io.
+static inline auto make_file_blob_io(
+  std::fstream file,
+  optionally_valid<span_size_t> offs,
+  optionally_valid<span_size_t> size) -> std::unique_ptr<blob_io> {
+    // enough for the container header
+    std::array<byte, 64> header{};
+    const auto header_size =
+      limit_cast<span_size_t>(read_from_stream(file, cover(header)).gcount());
+    if(chunked_compressed_view::is_chunked(head(view(header), header_size))) {
+        file.clear();
+        file.seekg(0, std::ios::end);
+        memory::buffer packed;
+        packed.resize(limit_cast<span_size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        if(
+          read_from_stream(file, cover(packed)).gcount() ==
+            std::streamsize(packed.size()) &&
+          chunked_compressed_view{view(packed)}) {
+            return std::make_unique<chunked_compressed_blob_io>(
+              std::move(packed), data_compressor{}, offs, size);
+        }
+    }
+    file.clear();
+    file.seekg(0, std::ios::beg);
+    return std::make_unique<file_blob_io>(std::move(file), offs, size);
+}
+//------------------------------------------------------------------------------
 /// @brief Service providing access to files and/or blobs over the message bus.
 /// @ingroup msgbus
 /// @see service_composition
@@ -271,7 +379,7 @@ private:
                           .arg(EAGINE_ID(target), endpoint_id)
                           .arg(
                             EAGINE_ID(filePath), EAGINE_ID(FsPath), file_path);
-                        read_io = std::make_unique<file_blob_io>(
+                        read_io = make_file_blob_io(
                           std::move(file),
                           from_string<span_size_t>(extract_or(
                             locator.argument("offs"), string_view{})),
@@ -0,0 +1,165 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_MESSAGE_BUS_SERVICE_RESOURCE_USAGE_HPP
+#define EAGINE_MESSAGE_BUS_SERVICE_RESOURCE_USAGE_HPP
+
+#include "../../bool_aggregate.hpp"
+#include "../../process_resources.hpp"
+#include "../../timeout.hpp"
+#include "../serialize.hpp"
+#include "../signal.hpp"
+#include "../subscriber.hpp"
+#include "../types.hpp"
+#include <array>
+#include <chrono>
+
+namespace eagine::msgbus {
+//------------------------------------------------------------------------------
+/// @brief Service publishing the resource usage of the endpoint's process.
+/// @ingroup msgbus
+/// @see service_composition
+/// @see resource_usage_consumer
+/// @see process_resource_sampler
+///
+/// The usage is sampled and broadcast periodically, with the period set by
+/// the msg_bus.resource_usage.interval configuration value (zero disables
+/// the broadcasts) and is also sent on request.
+template <typename Base = subscriber>
+class resource_usage_provider : public Base {
+    using This = resource_usage_provider;
+
+public:
+    auto update() -> work_done {
+        some_true something_done{};
+        something_done(Base::update());
+
+        if(_should_publish.period() >= _min_interval) {
+            if(_should_publish) {
+                _sample();
+                _post(broadcast_endpoint_id());
+                something_done();
+            }
+        }
+        return something_done;
+    }
+
+protected:
+    using Base::Base;
+
+    void init() {
+        Base::init();
+        if(const auto interval{this->app_config().get(
+             "msg_bus.resource_usage.interval",
+             type_identity<std::chrono::seconds>{})}) {
+            _should_publish.reset(extract(interval));
+        }
+    }
+
+    void add_methods() {
+        Base::add_methods();
+        Base::add_method(
+          this, EAGINE_MSG_MAP(eagiPrcUsg, qryUsage, This, _handle_query));
+    }
+
+private:
+    // the shortest sampling interval, queries received sooner than this
+    // after the previous sample are answered with the previous sample
+    static constexpr const std::chrono::seconds _min_interval{1};
+
+    process_resource_sampler _sampler{};
+    process_resource_usage _usage{};
+    resetting_timeout _should_publish{std::chrono::seconds{5}, nothing};
+
+    void _sample() noexcept {
+        const auto& s = _sampler.update().current();
+        _usage.cpu_time_us = (s.user_cpu_time + s.system_cpu_time).count();
+        _usage.resident_size = s.resident_size;
+        _usage.context_switches =
+          s.voluntary_context_switches + s.involuntary_context_switches;
+        _usage.read_bytes = s.read_bytes;
+        _usage.written_bytes = s.written_bytes;
+        _usage.open_file_count = limit_cast<std::int32_t>(s.open_file_count);
+        _usage.cpu_usage = extract_or(_sampler.cpu_usage(), -1.F);
+        _usage.context_switches_per_second =
+          extract_or(_sampler.context_switches_per_second(), -1.F);
+        _usage.read_bytes_per_second =
+          extract_or(_sampler.read_bytes_per_second(), -1.F);
+        _usage.written_bytes_per_second =
+          extract_or(_sampler.written_bytes_per_second(), -1.F);
+    }
+
+    void _post(identifier_t target_id) {
+        std::array<byte, 256> temp{};
+        auto serialized{default_serialize(_usage, cover(temp))};
+        EAGINE_ASSERT(serialized);
+
+        message_view message{extract(serialized)};
+        message.set_target_id(target_id);
+        message.set_priority(message_priority::low);
+        this->bus_node().post(EAGINE_MSG_ID(eagiPrcUsg, usage), message);
+    }
+
+    auto _handle_query(const message_context&, stored_message& message)
+      -> bool {
+        if(
+          std::chrono::steady_clock::now() - _sampler.current().time >=
+          _min_interval) {
+            _sample();
+        }
+        _post(message.source_id);
+        return true;
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Service consuming the process resource usage of bus endpoints.
+/// @ingroup msgbus
+/// @see service_composition
+/// @see resource_usage_provider
+template <typename Base = subscriber>
+class resource_usage_consumer : public Base {
+    using This = resource_usage_consumer;
+
+public:
+    /// @brief Queries the process resource usage of the specified endpoint.
+    /// @see resource_usage_received
+    void query_resource_usage(identifier_t endpoint_id) {
+        message_view message{};
+        message.set_target_id(endpoint_id);
+        message.set_priority(message_priority::low);
+        this->bus_node().post(EAGINE_MSG_ID(eagiPrcUsg, qryUsage), message);
+    }
+
+    /// @brief Triggered on receipt of endpoint's process resource usage.
+    /// @see query_resource_usage
+    signal<void(identifier_t, const process_resource_usage&)>
+      resource_usage_received;
+
+protected:
+    using Base::Base;
+
+    void add_methods() {
+        Base::add_methods();
+        Base::add_method(
+          this, EAGINE_MSG_MAP(eagiPrcUsg, usage, This, _handle_usage));
+    }
+
+private:
+    auto _handle_usage(const message_context&, stored_message& message)
+      -> bool {
+        process_resource_usage usage{};
+        if(default_deserialize(usage, message.content())) {
+            resource_usage_received(message.source_id, usage);
+        }
+        return true;
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::msgbus
+
+#endif // EAGINE_MESSAGE_BUS_SERVICE_RESOURCE_USAGE_HPP
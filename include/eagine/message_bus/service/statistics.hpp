@@ -67,6 +67,13 @@ public:
     /// @see endpoint_stats_received
     signal<void(const connection_statistics&)> connection_stats_received;
 
+    /// @brief Triggered on receipt of router message flow statistics.
+    /// @see router_stats_received
+    /// @see connection_stats_received
+    ///
+    /// Routers send these only if the message flow histograms are enabled.
+    signal<void(const message_flow_statistics&)> message_flow_stats_received;
+
 protected:
     using Base::Base;
 
@@ -78,6 +85,8 @@ protected:
           this, EAGINE_MSG_MAP(eagiMsgBus, statsBrdg, This, _handle_bridge));
         Base::add_method(
           this, EAGINE_MSG_MAP(eagiMsgBus, statsEndpt, This, _handle_endpoint));
+        Base::add_method(
+          this, EAGINE_MSG_MAP(eagiMsgBus, statsFlow, This, _handle_flow));
     }
 
 private:
@@ -116,6 +125,15 @@ private:
         }
         return true;
     }
+
+    auto _handle_flow(const message_context&, stored_message& message)
+      -> bool {
+        message_flow_statistics stats{};
+        if(default_deserialize(stats, message.content())) {
+            message_flow_stats_received(stats);
+        }
+        return true;
+    }
 };
 //------------------------------------------------------------------------------
 } // namespace eagine::msgbus
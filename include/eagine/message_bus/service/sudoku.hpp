@@ -17,13 +17,18 @@
 #include "../../maybe_unused.hpp"
 #include "../../serialize/type/sudoku.hpp"
 #include "../../sudoku.hpp"
+#include "../../workshop.hpp"
 #include "../serialize.hpp"
 #include "../signal.hpp"
 #include "../subscriber.hpp"
+#include "../wakeup.hpp"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <memory>
 #include <random>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -178,6 +183,11 @@ sudoku_response_msg(unsigned_constant<S> rank, bool is_solved) noexcept
 /// @see service_composition
 /// @see sudoku_solver
 /// @see sudoku_tiling
+///
+/// By default the boards are searched one at a time on the thread calling
+/// update. If use_workers is called, the searches are done on the threads
+/// of a workshop (which can be shared by all helpers in the process) and the
+/// found candidates are posted on the thread calling update as they appear.
 template <typename Base = subscriber>
 class sudoku_helper : public Base {
     using This = sudoku_helper;
@@ -189,7 +199,7 @@ public:
 
         for_each_sudoku_rank_unit(
           [&](auto& info) {
-              if(info.update(this->bus_node(), _compressor)) {
+              if(info.update(this->bus_node(), _workers, _capacity, _wakeup)) {
                   something_done();
               }
           },
@@ -198,6 +208,37 @@ public:
         return something_done;
     }
 
+    /// @brief Makes this helper search the boards on the threads of workers.
+    /// @param max_threads is the number of boards of each rank searched
+    ///        at the same time. It is advertised to the solvers as the
+    ///        capacity of this helper.
+    /// @note This should be called before the helper starts receiving boards.
+    auto use_workers(workshop& workers, span_size_t max_threads) -> auto& {
+        _workers = &workers;
+        _capacity = math::maximum(max_threads, span_size(1));
+        workers.ensure_workers(_capacity);
+        return *this;
+    }
+
+    /// @brief Returns the number of boards of each rank searched at once.
+    auto capacity() const noexcept -> span_size_t {
+        return _capacity;
+    }
+
+    /// @brief Sets up the event to be woken up when new candidates are found.
+    /// @see endpoint::prepare_wait
+    void prepare_wait(const shared_wakeup_event& event) {
+        EAGINE_ASSERT(event);
+        _wakeup = event;
+        bool has_results = false;
+        for_each_sudoku_rank_unit(
+          [&](const auto& info) { has_results |= info.has_results(); },
+          _infos);
+        if(has_results) {
+            event->notify();
+        }
+    }
+
     void mark_activity() {
         _activity_time = std::chrono::steady_clock::now();
     }
@@ -256,6 +297,7 @@ private:
         if(EAGINE_LIKELY(deserialized)) {
             info.add_board(
               this->bus_node(),
+              _capacity,
               message.source_id,
               message.sequence_no,
               std::move(board));
@@ -272,6 +314,140 @@ private:
           &This::_handle_board<S>>>{sudoku_query_msg(rank)};
     }
 
+    // Searches the alternatives of one board on a worker thread.
+    // The candidates are serialized on the worker and published one by one
+    // through the _produced counter, the slots below it are not modified
+    // until the searching thread takes them and starts the next search.
+    template <unsigned S>
+    class search_work : public work_unit {
+    public:
+        search_work(const default_sudoku_board_traits<S>& traits)
+          : _board{traits} {}
+
+        search_work(search_work&&) = delete;
+        search_work(const search_work&) = delete;
+        auto operator=(search_work&&) = delete;
+        auto operator=(const search_work&) = delete;
+
+        ~search_work() noexcept override {
+            // a busy unit is either being searched by a worker or queued,
+            // the workshop cancels the queued units when it shuts down
+            if(_busy) {
+                while(!_finished.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        auto is_busy() const noexcept -> bool {
+            return _busy;
+        }
+
+        auto has_results() const noexcept -> bool {
+            return _busy &&
+                   ((_consumed < _produced.load(std::memory_order_acquire)) ||
+                    _finished.load(std::memory_order_acquire));
+        }
+
+        void start(
+          identifier_t target_id,
+          message_sequence_t sequence_no,
+          basic_sudoku_board<S> board,
+          shared_wakeup_event wakeup) {
+            EAGINE_ASSERT(!_busy);
+            _target_id = target_id;
+            _sequence_no = sequence_no;
+            _board = std::move(board);
+            _wakeup = std::move(wakeup);
+            _produced.store(0, std::memory_order_relaxed);
+            _finished.store(false, std::memory_order_relaxed);
+            _consumed = 0;
+            _busy = true;
+        }
+
+        auto do_it() -> bool final {
+            _board.for_each_alternative(
+              _board.find_unsolved(), [&](auto& candidate) {
+                  const auto index{_produced.load(std::memory_order_relaxed)};
+                  auto& result = _results[std_size(index)];
+                  result.is_solved = candidate.is_solved();
+
+                  auto temp{default_serialize_buffer_for(candidate)};
+                  const auto serialized{
+                    (S >= 4) ? default_serialize_packed(
+                                 candidate, cover(temp), _compressor)
+                             : default_serialize(candidate, cover(temp))};
+                  EAGINE_ASSERT(serialized);
+                  memory::copy_into(extract(serialized), result.data);
+
+                  _produced.store(index + 1, std::memory_order_release);
+                  if(_wakeup) {
+                      _wakeup->notify();
+                  }
+              });
+            return true;
+        }
+
+        void deliver() final {
+            // this must not be accessed after _finished is set
+            const auto wakeup{_wakeup};
+            _finished.store(true, std::memory_order_release);
+            if(wakeup) {
+                wakeup->notify();
+            }
+        }
+
+        void cancel() final {
+            // the search is reported as done without further candidates
+            deliver();
+        }
+
+        auto post_results(endpoint& bus, std::size_t& counter) -> work_done {
+            const unsigned_constant<S> rank{};
+            some_true something_done;
+            if(_busy) {
+                const bool finished{_finished.load(std::memory_order_acquire)};
+                const auto produced{_produced.load(std::memory_order_acquire)};
+                for(; _consumed < produced; ++_consumed) {
+                    const auto& result = _results[std_size(_consumed)];
+                    message_view response{view(result.data)};
+                    response.set_target_id(_target_id);
+                    response.set_sequence_no(_sequence_no);
+                    bus.post(
+                      sudoku_response_msg(rank, result.is_solved), response);
+                    ++counter;
+                    something_done();
+                }
+                if(finished) {
+                    message_view response{};
+                    response.set_target_id(_target_id);
+                    response.set_sequence_no(_sequence_no);
+                    bus.post(sudoku_done_msg(rank), response);
+                    _busy = false;
+                    something_done();
+                }
+            }
+            return something_done;
+        }
+
+    private:
+        struct result_info {
+            memory::buffer data;
+            bool is_solved{false};
+        };
+
+        basic_sudoku_board<S> _board;
+        identifier_t _target_id{0U};
+        message_sequence_t _sequence_no{0U};
+        data_compressor _compressor{};
+        shared_wakeup_event _wakeup{};
+        std::array<result_info, S * S> _results{};
+        std::atomic<span_size_t> _produced{0};
+        std::atomic<bool> _finished{false};
+        span_size_t _consumed{0};
+        bool _busy{false};
+    };
+
     template <unsigned S>
     struct rank_info {
         default_sudoku_board_traits<S> traits;
@@ -283,16 +459,19 @@ private:
 
         flat_set<identifier_t> searches;
 
+        std::vector<std::unique_ptr<search_work<S>>> works;
+
         void on_search(identifier_t source_id) {
             searches.insert(source_id);
         }
 
         void add_board(
           endpoint& bus,
+          span_size_t capacity,
           identifier_t source_id,
           message_sequence_t sequence_no,
           basic_sudoku_board<S> board) {
-            if(EAGINE_LIKELY(boards.size() <= 8)) {
+            if(EAGINE_LIKELY(span_size(boards.size()) <= 8 * capacity)) {
                 searches.insert(source_id);
                 boards.emplace_back(source_id, sequence_no, std::move(board));
             } else {
@@ -302,14 +481,27 @@ private:
             }
         }
 
-        auto update(endpoint& bus, const data_compressor& compressor)
-          -> work_done {
+        auto has_results() const noexcept -> bool {
+            return std::any_of(
+              works.begin(), works.end(), [](const auto& work) {
+                  return work->has_results();
+              });
+        }
+
+        auto update(
+          endpoint& bus,
+          workshop* workers,
+          span_size_t capacity,
+          const shared_wakeup_event& wakeup) -> work_done {
             const unsigned_constant<S> rank{};
             some_true something_done;
 
-            if(boards.size() < 6) {
+            if(span_size(boards.size()) < 6 * capacity) {
+                auto temp{default_serialize_buffer_for(capacity)};
+                const auto serialized{default_serialize(capacity, cover(temp))};
+                EAGINE_ASSERT(serialized);
                 for(auto target_id : searches) {
-                    message_view response{};
+                    message_view response{extract(serialized)};
                     response.set_target_id(target_id);
                     bus.post(sudoku_alive_msg(rank), response);
                     something_done();
@@ -317,37 +509,26 @@ private:
             }
             searches.clear();
 
-            if(!boards.empty()) {
-                const auto target_id = std::get<0>(boards.back());
-                const auto sequence_no = std::get<1>(boards.back());
-                auto board = std::get<2>(boards.back());
-                boards.pop_back();
-
-                auto process_candidate = [&](auto& candidate) {
-                    ++counter;
-                    const bool is_solved = candidate.is_solved();
-
-                    auto temp{default_serialize_buffer_for(candidate)};
-                    const auto serialized{
-                      (S >= 4) ? default_serialize_packed(
-                                   candidate, cover(temp), compressor)
-                               : default_serialize(candidate, cover(temp))};
-                    EAGINE_ASSERT(serialized);
-
-                    message_view response{extract(serialized)};
-                    response.set_target_id(target_id);
-                    response.set_sequence_no(sequence_no);
-                    bus.post(sudoku_response_msg(rank, is_solved), response);
-                };
-
-                board.for_each_alternative(
-                  board.find_unsolved(), process_candidate);
+            while(span_size(works.size()) < capacity) {
+                works.emplace_back(std::make_unique<search_work<S>>(traits));
+            }
 
-                message_view response{};
-                response.set_target_id(target_id);
-                response.set_sequence_no(sequence_no);
-                bus.post(sudoku_done_msg(rank), response);
-                something_done();
+            for(auto& work : works) {
+                something_done(work->post_results(bus, counter));
+                if(!work->is_busy() && !boards.empty()) {
+                    auto& [target_id, sequence_no, board] = boards.back();
+                    work->start(
+                      target_id, sequence_no, std::move(board), wakeup);
+                    boards.pop_back();
+                    if(workers) {
+                        workers->enqueue(*work);
+                    } else {
+                        work->do_it();
+                        work->deliver();
+                        work->post_results(bus, counter);
+                    }
+                    something_done();
+                }
             }
             return something_done;
         }
@@ -355,6 +536,10 @@ private:
 
     data_compressor _compressor{};
 
+    workshop* _workers{nullptr};
+    span_size_t _capacity{1};
+    shared_wakeup_event _wakeup{};
+
     sudoku_rank_tuple<rank_info> _infos;
 
     std::chrono::steady_clock::time_point _activity_time{
@@ -576,6 +761,7 @@ private:
         flat_set<identifier_t> known_helpers;
         flat_set<identifier_t> ready_helpers;
         flat_map<identifier_t, timeout> used_helpers;
+        flat_map<identifier_t, span_size_t> helper_capacities;
         std::vector<identifier_t> found_helpers;
 
         std::default_random_engine randeng{std::random_device{}()};
@@ -635,6 +821,7 @@ private:
                         }
                         known_helpers.erase(entry.used_helper);
                         used_helpers.erase(entry.used_helper);
+                        helper_capacities.erase(entry.used_helper);
                         return true;
                     }
                     return false;
@@ -732,15 +919,23 @@ private:
                 if(boards.empty()) {
                     key_boards.erase(kbpos);
                 }
-
-                ready_helpers.erase(helper_id);
-                used_helpers[helper_id].reset(
-                  adjusted_duration(std::chrono::seconds{S}));
                 return true;
             }
             return false;
         }
 
+        auto free_slots(identifier_t helper_id) const noexcept -> span_size_t {
+            const auto cpos = helper_capacities.find(helper_id);
+            const auto capacity =
+              cpos != helper_capacities.end() ? cpos->second : 1;
+            return capacity - span_size(std::count_if(
+                                pending.begin(),
+                                pending.end(),
+                                [helper_id](const auto& entry) {
+                                    return entry.used_helper == helper_id;
+                                }));
+        }
+
         auto find_helpers(span<identifier_t> dst) const -> span<identifier_t> {
             span_size_t done = 0;
             for(const auto helper_id : ready_helpers) {
@@ -767,12 +962,25 @@ private:
                 found_helpers.resize(ready_helpers.size());
             }
 
+            // bigger helpers get as many boards as they can search at once
             for(const auto helper_id :
                 head(shuffle(find_helpers(cover(found_helpers)), randeng), 8)) {
-                if(!send_board_to(bus, compressor, helper_id)) {
+                bool sent = false;
+                for(auto slots = free_slots(helper_id); slots > 0; --slots) {
+                    if(!send_board_to(bus, compressor, helper_id)) {
+                        break;
+                    }
+                    sent = true;
+                    something_done();
+                }
+                if(!sent) {
                     break;
                 }
-                something_done();
+                if(free_slots(helper_id) <= 0) {
+                    ready_helpers.erase(helper_id);
+                }
+                used_helpers[helper_id].reset(
+                  adjusted_duration(std::chrono::seconds{S}));
             }
 
             return something_done;
@@ -790,10 +998,11 @@ private:
             }
         }
 
-        void helper_alive(This& parent, identifier_t id) {
+        void helper_alive(This& parent, identifier_t id, span_size_t capacity) {
             if(std::get<1>(known_helpers.insert(id))) {
                 parent.helper_appeared(id);
             }
+            helper_capacities[id] = capacity;
             ready_helpers.insert(id);
         }
 
@@ -814,6 +1023,7 @@ private:
             key_boards.clear();
             pending.clear();
             used_helpers.clear();
+            helper_capacities.clear();
             solution_timeout.reset();
 
             parent.bus_node()
@@ -830,8 +1040,13 @@ private:
     template <unsigned S>
     auto _handle_alive(const message_context&, stored_message& message)
       -> bool {
+        // older helpers do not advertise their capacity
+        span_size_t capacity{1};
+        if(!default_deserialize(capacity, message.content()) || capacity < 1) {
+            capacity = 1;
+        }
         _infos.get(unsigned_constant<S>{})
-          .helper_alive(*this, message.source_id);
+          .helper_alive(*this, message.source_id, capacity);
         return true;
     }
 
@@ -17,6 +17,7 @@
 #include "discovery.hpp"
 #include "host_info.hpp"
 #include "ping_pong.hpp"
+#include "resource_usage.hpp"
 #include "statistics.hpp"
 #include "system_info.hpp"
 #include "topology.hpp"
@@ -34,6 +35,7 @@ using node_tracker_base = require_services<
   system_info_consumer,
   common_info_consumers,
   statistics_consumer,
+  resource_usage_consumer,
   network_topology,
   subscriber_discovery>;
 //------------------------------------------------------------------------------
@@ -135,6 +137,11 @@ public:
         return EAGINE_THIS_MEM_FUNC_REF(_handle_endpoint_stats_received);
     }
 
+    /// @brief Returns handler for the process resource usage message.
+    auto on_resource_usage_received() noexcept {
+        return EAGINE_THIS_MEM_FUNC_REF(_handle_resource_usage_received);
+    }
+
     /// @brief Returns handler for the connection statistics message.
     auto on_connection_stats_received() noexcept {
         return EAGINE_THIS_MEM_FUNC_REF(_handle_connection_stats_received);
@@ -284,6 +291,13 @@ public:
                             }
                         }
                     }
+                    // further updates are broadcast by the node itself
+                    if(!node.resource_usage()) {
+                        if(node.subscribes_to(
+                             EAGINE_MSG_ID(eagiPrcUsg, qryUsage))) {
+                            this->query_resource_usage(node_id);
+                        }
+                    }
                 }
             }
 
@@ -343,6 +357,7 @@ protected:
         this->router_stats_received.connect(on_router_stats_received());
         this->bridge_stats_received.connect(on_bridge_stats_received());
         this->endpoint_stats_received.connect(on_endpoint_stats_received());
+        this->resource_usage_received.connect(on_resource_usage_received());
         this->application_name_received.connect(on_application_name_received());
         this->endpoint_info_received.connect(on_endpoint_info_received());
         this->compiler_info_received.connect(on_compiler_info_received());
@@ -490,6 +505,12 @@ private:
         _get_node(endpoint_id).assign(stats).notice_alive();
     }
 
+    void _handle_resource_usage_received(
+      identifier_t endpoint_id,
+      const process_resource_usage& usage) {
+        _get_node(endpoint_id).assign(usage).notice_alive();
+    }
+
     void _handle_connection_stats_received(const connection_statistics& stats) {
         _get_connection(stats.local_id, stats.remote_id);
     }
@@ -394,6 +394,10 @@ private:
         void deliver() final {
             finished = true;
         }
+
+        void cancel() final {
+            finished = true;
+        }
     };
 
     std::map<id_t, async_call> _pending{};
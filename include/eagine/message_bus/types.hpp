@@ -90,6 +90,72 @@ data_member_mapping(type_identity<router_statistics>, Selector) noexcept {
       {"uptime_seconds", &S::uptime_seconds});
 }
 //------------------------------------------------------------------------------
+/// @brief Message bus node process resource usage.
+/// @ingroup msgbus
+/// @see process_resource_sampler
+///
+/// The counters are cumulative, the rates are computed over the sampling
+/// interval. Values that are not available are negative.
+struct process_resource_usage {
+    /// @brief User and system CPU time in microseconds.
+    std::int64_t cpu_time_us{-1};
+
+    /// @brief The resident set size in bytes.
+    std::int64_t resident_size{-1};
+
+    /// @brief Number of voluntary and involuntary context switches.
+    std::int64_t context_switches{-1};
+
+    /// @brief Number of bytes read from storage.
+    std::int64_t read_bytes{-1};
+
+    /// @brief Number of bytes written to storage.
+    std::int64_t written_bytes{-1};
+
+    /// @brief Number of open file descriptors.
+    std::int32_t open_file_count{-1};
+
+    /// @brief Used CPU time per second (1.0 is one busy core).
+    float cpu_usage{-1.F};
+
+    /// @brief Context switches per second.
+    float context_switches_per_second{-1.F};
+
+    /// @brief Bytes read from storage per second.
+    float read_bytes_per_second{-1.F};
+
+    /// @brief Bytes written to storage per second.
+    float written_bytes_per_second{-1.F};
+};
+
+template <typename Selector>
+constexpr auto
+data_member_mapping(type_identity<process_resource_usage>, Selector) noexcept {
+    using S = process_resource_usage;
+    return make_data_member_mapping<
+      S,
+      std::int64_t,
+      std::int64_t,
+      std::int64_t,
+      std::int64_t,
+      std::int64_t,
+      std::int32_t,
+      float,
+      float,
+      float,
+      float>(
+      {"cpu_time_us", &S::cpu_time_us},
+      {"resident_size", &S::resident_size},
+      {"context_switches", &S::context_switches},
+      {"read_bytes", &S::read_bytes},
+      {"written_bytes", &S::written_bytes},
+      {"open_file_count", &S::open_file_count},
+      {"cpu_usage", &S::cpu_usage},
+      {"context_switches_per_second", &S::context_switches_per_second},
+      {"read_bytes_per_second", &S::read_bytes_per_second},
+      {"written_bytes_per_second", &S::written_bytes_per_second});
+}
+//------------------------------------------------------------------------------
 /// @brief Structure holding part of bridge connection topology information.
 /// @ingroup msgbus
 struct bridge_topology_info {
@@ -284,6 +350,81 @@ data_member_mapping(type_identity<message_flow_info>, selector) noexcept {
       {"avg_msg_age_ms", &s::avg_msg_age_ms});
 }
 //------------------------------------------------------------------------------
+/// @brief Structure holding summary of router message flow histograms.
+/// @ingroup msgbus
+///
+/// Either the remote_id or the message_class is set, depending on whether
+/// the statistics are tracked for a connection or for a message class.
+struct message_flow_statistics {
+    /// @brief The router message bus id.
+    identifier_t router_id{0};
+
+    /// @brief The id of the node on the incoming connection (or zero).
+    identifier_t remote_id{0};
+
+    /// @brief The message class identifier (or zero).
+    identifier_t message_class{0};
+
+    /// @brief Number of routed messages.
+    std::int64_t message_count{0};
+
+    /// @brief Median of the message queue age in microseconds.
+    std::int32_t age_p50_us{0};
+
+    /// @brief 99th percentile of the message queue age in microseconds.
+    std::int32_t age_p99_us{0};
+
+    /// @brief Maximum message queue age in microseconds.
+    std::int32_t age_max_us{0};
+
+    /// @brief Median of the message size in bytes.
+    std::int32_t size_p50{0};
+
+    /// @brief Maximum message size in bytes.
+    std::int32_t size_max{0};
+
+    /// @brief Median of the forwarding latency in nanoseconds.
+    std::int32_t latency_p50_ns{0};
+
+    /// @brief 99th percentile of the forwarding latency in nanoseconds.
+    std::int32_t latency_p99_ns{0};
+
+    /// @brief Maximum forwarding latency in nanoseconds.
+    std::int32_t latency_max_ns{0};
+};
+
+template <typename Selector>
+constexpr auto
+data_member_mapping(type_identity<message_flow_statistics>, Selector) noexcept {
+    using S = message_flow_statistics;
+    return make_data_member_mapping<
+      S,
+      identifier_t,
+      identifier_t,
+      identifier_t,
+      std::int64_t,
+      std::int32_t,
+      std::int32_t,
+      std::int32_t,
+      std::int32_t,
+      std::int32_t,
+      std::int32_t,
+      std::int32_t,
+      std::int32_t>(
+      {"router_id", &S::router_id},
+      {"remote_id", &S::remote_id},
+      {"message_class", &S::message_class},
+      {"message_count", &S::message_count},
+      {"age_p50_us", &S::age_p50_us},
+      {"age_p99_us", &S::age_p99_us},
+      {"age_max_us", &S::age_max_us},
+      {"size_p50", &S::size_p50},
+      {"size_max", &S::size_max},
+      {"latency_p50_ns", &S::latency_p50_ns},
+      {"latency_p99_ns", &S::latency_p99_ns},
+      {"latency_max_ns", &S::latency_max_ns});
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::msgbus
 
 #endif // EAGINE_MESSAGE_BUS_TYPES_HPP
@@ -0,0 +1,248 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_MESSAGE_BUS_WAKEUP_HPP
+#define EAGINE_MESSAGE_BUS_WAKEUP_HPP
+
+#include "../config/platform.hpp"
+#include "../flat_map.hpp"
+#include "../maybe_unused.hpp"
+#include "../types.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#if EAGINE_LINUX
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace eagine::msgbus {
+//------------------------------------------------------------------------------
+/// @brief Event used to block a message bus node until there is work to do.
+/// @ingroup msgbus
+/// @see connection::prepare_wait
+/// @see acceptor::prepare_wait
+///
+/// Connections and acceptors either notify the event directly (possibly from
+/// other threads) when new messages arrive, or register file descriptors
+/// that should wake up the waiting thread when they become readable.
+/// On Linux this is implemented with an eventfd and an epoll set, on other
+/// platforms only the explicit notifications are supported and the file
+/// descriptors are ignored, so the wait is bound only by the timeout.
+class wakeup_event {
+public:
+    /// @brief Default constructor.
+    wakeup_event() noexcept {
+#if EAGINE_LINUX
+        // NOLINTNEXTLINE(hicpp-signed-bitwise)
+        _event_fd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+        _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        if((_event_fd >= 0) && (_epoll_fd >= 0)) {
+            struct ::epoll_event ev {};
+            ev.events = EPOLLIN;
+            ev.data.fd = _event_fd;
+            if(::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _event_fd, &ev) == 0) {
+                return;
+            }
+        }
+        // fall back to the condition variable
+        _close();
+#endif
+    }
+
+    /// @brief Not move constructible.
+    wakeup_event(wakeup_event&&) = delete;
+    /// @brief Not copy constructible.
+    wakeup_event(const wakeup_event&) = delete;
+    /// @brief Not move assignable.
+    auto operator=(wakeup_event&&) = delete;
+    /// @brief Not copy assignable.
+    auto operator=(const wakeup_event&) = delete;
+
+    ~wakeup_event() noexcept {
+#if EAGINE_LINUX
+        _close();
+#endif
+    }
+
+    /// @brief Wakes up the thread waiting on this event (can be called from any thread).
+    /// @see wait_for
+    void notify() noexcept {
+#if EAGINE_LINUX
+        if(_event_fd >= 0) {
+            const std::uint64_t one{1U};
+            while((::write(_event_fd, &one, sizeof(one)) < 0) &&
+                  (errno == EINTR)) {
+            }
+            return;
+        }
+#endif
+        {
+            std::unique_lock lock{_mutex};
+            _notified = true;
+        }
+        _cond.notify_one();
+    }
+
+    /// @brief Indicates that the specified file descriptor should wake up the waiter.
+    /// @see wait_for
+    ///
+    /// Must be called before each wait from the waiting thread; descriptors
+    /// that are not re-watched before the next wait_for are removed.
+    void watch(int fd) noexcept {
+        _watch(fd, false);
+    }
+
+    /// @brief Indicates that the descriptor becoming writable should wake up.
+    /// @see watch
+    ///
+    /// Returns false if the descriptors cannot be watched on this platform.
+    auto watch_writable(int fd) noexcept -> bool {
+        return _watch(fd, true);
+    }
+
+    /// @brief Blocks until notified, a watched descriptor is ready or timeout.
+    /// @see notify
+    /// @see watch
+    ///
+    /// Returns true if the wait was ended by a notification or a ready descriptor.
+    template <typename R, typename P>
+    auto wait_for(std::chrono::duration<R, P> max_time) -> bool {
+        const auto timeout_ms = int(
+          std::chrono::duration_cast<std::chrono::milliseconds>(max_time)
+            .count());
+#if EAGINE_LINUX
+        if(_epoll_fd >= 0) {
+            _update_watched();
+            std::array<struct ::epoll_event, 16> events{};
+            const auto count = ::epoll_wait(
+              _epoll_fd, events.data(), int(events.size()), timeout_ms);
+            if(count > 0) {
+                for(int i = 0; i < count; ++i) {
+                    if(events[std_size(i)].data.fd == _event_fd) {
+                        std::uint64_t value{0U};
+                        const auto rd = ::read(_event_fd, &value, sizeof(value));
+                        EAGINE_MAYBE_UNUSED(rd);
+                    }
+                }
+                return true;
+            }
+            return false;
+        }
+#endif
+        std::unique_lock lock{_mutex};
+        const bool result = _cond.wait_for(
+          lock, std::chrono::milliseconds(timeout_ms), [this] {
+              return _notified;
+          });
+        _notified = false;
+        return result;
+    }
+
+    /// @brief Blocks until notified, a descriptor is ready, deadline or timeout.
+    /// @see notify
+    /// @see watch
+    ///
+    /// The wait ends at the earlier of the deadline and max_time from now.
+    template <typename R, typename P>
+    auto wait_for(
+      std::chrono::duration<R, P> max_time,
+      std::chrono::steady_clock::time_point deadline) -> bool {
+        using std::chrono::milliseconds;
+        // rounded up so that the deadline has passed after the wait
+        const auto until_deadline{std::chrono::ceil<milliseconds>(
+          deadline - std::chrono::steady_clock::now())};
+        return wait_for(std::max(
+          std::min(
+            std::chrono::duration_cast<milliseconds>(max_time), until_deadline),
+          milliseconds::zero()));
+    }
+
+private:
+    auto _watch(int fd, bool writable) noexcept -> bool {
+#if EAGINE_LINUX
+        if((fd >= 0) && (_epoll_fd >= 0)) {
+            _watched[fd].requested |= writable ? EPOLLOUT : EPOLLIN;
+            return true;
+        }
+#else
+        EAGINE_MAYBE_UNUSED(fd);
+        EAGINE_MAYBE_UNUSED(writable);
+#endif
+        return false;
+    }
+
+#if EAGINE_LINUX
+    void _close() noexcept {
+        if(_epoll_fd >= 0) {
+            ::close(_epoll_fd);
+            _epoll_fd = -1;
+        }
+        if(_event_fd >= 0) {
+            ::close(_event_fd);
+            _event_fd = -1;
+        }
+    }
+
+    // applies the events requested since the previous wait, the descriptors
+    // that were not watched again are removed and the writability is watched
+    // only while requested, since it is reported for as long as it lasts
+    void _update_watched() noexcept {
+        for(auto pos = _watched.begin(); pos != _watched.end();) {
+            const auto fd = pos->first;
+            auto& state = pos->second;
+            if(state.requested) {
+                // closed descriptors are dropped from the set by the kernel
+                // and the number may be reused, so always try to (re-)add it
+                struct ::epoll_event ev {};
+                ev.events = state.requested;
+                ev.data.fd = fd;
+                if(
+                  (::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0) ||
+                  ((errno == EEXIST) &&
+                   ((state.registered == state.requested) ||
+                    (::epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &ev) == 0)))) {
+                    state.registered = state.requested;
+                    state.requested = 0U;
+                    ++pos;
+                    continue;
+                }
+            }
+            ::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            pos = _watched.erase(pos);
+        }
+    }
+
+    struct _watch_state {
+        std::uint32_t registered{0U};
+        std::uint32_t requested{0U};
+    };
+
+    int _event_fd{-1};
+    int _epoll_fd{-1};
+    flat_map<int, _watch_state> _watched;
+#endif
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _notified{false};
+};
+//------------------------------------------------------------------------------
+/// @brief Alias for shared pointer to wakeup_event.
+/// @ingroup msgbus
+using shared_wakeup_event = std::shared_ptr<wakeup_event>;
+//------------------------------------------------------------------------------
+} // namespace eagine::msgbus
+
+#endif // EAGINE_MESSAGE_BUS_WAKEUP_HPP
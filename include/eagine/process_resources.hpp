@@ -0,0 +1,150 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#ifndef EAGINE_PROCESS_RESOURCES_HPP
+#define EAGINE_PROCESS_RESOURCES_HPP
+
+#include "config/basic.hpp"
+#include "config/platform.hpp"
+#include "types.hpp"
+#include "valid_if/nonnegative.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+/// @brief Cumulative resource usage counters of the current process.
+/// @ingroup main_context
+/// @see process_resource_sampler
+///
+/// The values that cannot be determined on the current platform are negative.
+struct process_resource_sample {
+    /// @brief The time when the sample was taken.
+    std::chrono::steady_clock::time_point time{};
+
+    /// @brief CPU time spent in user mode.
+    std::chrono::microseconds user_cpu_time{-1};
+
+    /// @brief CPU time spent in the kernel on behalf of the process.
+    std::chrono::microseconds system_cpu_time{-1};
+
+    /// @brief The resident set size in bytes.
+    std::int64_t resident_size{-1};
+
+    /// @brief Number of voluntary context switches.
+    std::int64_t voluntary_context_switches{-1};
+
+    /// @brief Number of involuntary context switches.
+    std::int64_t involuntary_context_switches{-1};
+
+    /// @brief Number of open file descriptors.
+    std::int64_t open_file_count{-1};
+
+    /// @brief Number of bytes read from storage.
+    std::int64_t read_bytes{-1};
+
+    /// @brief Number of bytes written to storage.
+    std::int64_t written_bytes{-1};
+};
+//------------------------------------------------------------------------------
+/// @brief Class sampling the resource usage of the current process.
+/// @ingroup main_context
+/// @see process_resource_sample
+///
+/// The sampler keeps the procfs files open and re-reads them on each update.
+/// The last two samples are kept, so that the rates can be computed.
+class process_resource_sampler {
+public:
+    process_resource_sampler() noexcept;
+    process_resource_sampler(process_resource_sampler&&) = delete;
+    process_resource_sampler(const process_resource_sampler&) = delete;
+    auto operator=(process_resource_sampler&&) = delete;
+    auto operator=(const process_resource_sampler&) = delete;
+    ~process_resource_sampler() noexcept;
+
+    /// @brief Takes a new sample, keeping the previous one.
+    auto update() noexcept -> process_resource_sampler&;
+
+    /// @brief Returns the latest sample.
+    auto current() const noexcept -> const process_resource_sample& {
+        return _samples[_current];
+    }
+
+    /// @brief Returns the sample preceding the latest one.
+    auto previous() const noexcept -> const process_resource_sample& {
+        return _samples[1U - _current];
+    }
+
+    /// @brief Returns the time between the two latest samples.
+    auto interval() const noexcept -> std::chrono::duration<float> {
+        return current().time - previous().time;
+    }
+
+    /// @brief Returns the used CPU time per second (1.0 is one busy core).
+    auto cpu_usage() const noexcept -> valid_if_nonnegative<float> {
+        const auto& c = current();
+        const auto& p = previous();
+        if((p.user_cpu_time.count() < 0) || (c.user_cpu_time.count() < 0)) {
+            return {-1.F};
+        }
+        const std::chrono::duration<float> used{
+          (c.user_cpu_time + c.system_cpu_time) -
+          (p.user_cpu_time + p.system_cpu_time)};
+        return {_per_second(used.count())};
+    }
+
+    /// @brief Returns the number of context switches per second.
+    auto context_switches_per_second() const noexcept
+      -> valid_if_nonnegative<float> {
+        const auto& c = current();
+        const auto& p = previous();
+        return {_rate(
+          c.voluntary_context_switches + c.involuntary_context_switches,
+          p.voluntary_context_switches + p.involuntary_context_switches)};
+    }
+
+    /// @brief Returns the number of bytes read from storage per second.
+    auto read_bytes_per_second() const noexcept
+      -> valid_if_nonnegative<float> {
+        return {_rate(current().read_bytes, previous().read_bytes)};
+    }
+
+    /// @brief Returns the number of bytes written to storage per second.
+    auto written_bytes_per_second() const noexcept
+      -> valid_if_nonnegative<float> {
+        return {_rate(current().written_bytes, previous().written_bytes)};
+    }
+
+private:
+    auto _per_second(float value) const noexcept -> float {
+        const auto secs = interval().count();
+        return secs > 0.F ? value / secs : -1.F;
+    }
+
+    auto _rate(std::int64_t cur, std::int64_t prev) const noexcept -> float {
+        if((cur < 0) || (prev < 0) || (cur < prev)) {
+            return -1.F;
+        }
+        return _per_second(float(cur - prev));
+    }
+
+    void _sample(process_resource_sample&) noexcept;
+
+    std::array<process_resource_sample, 2> _samples{};
+    std::size_t _current{0U};
+    int _statm_fd{-1};
+    int _io_fd{-1};
+};
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+#if !EAGINE_LINK_LIBRARY || defined(EAGINE_IMPLEMENTING_LIBRARY)
+#include <eagine/process_resources.inl>
+#endif
+
+#endif // EAGINE_PROCESS_RESOURCES_HPP
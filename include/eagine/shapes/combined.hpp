@@ -38,6 +38,8 @@ public:
 
     auto is_enabled(generator_capability cap) noexcept -> bool final;
 
+    void use_workers(workshop& workers, span_size_t max_threads) final;
+
     auto vertex_count() -> span_size_t override;
 
     auto attribute_variants(vertex_attrib_kind attrib) -> span_size_t override;
@@ -35,6 +35,10 @@ public:
         return _gen->is_enabled(cap);
     }
 
+    void use_workers(workshop& workers, span_size_t max_threads) override {
+        _gen->use_workers(workers, max_threads);
+    }
+
     auto vertex_count() -> span_size_t override {
         return _gen->vertex_count();
     }
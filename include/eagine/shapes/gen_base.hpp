@@ -16,6 +16,7 @@
 #include "../math/primitives.hpp"
 #include "../span.hpp"
 #include "../types.hpp"
+#include "../workshop.hpp"
 #include "drawing.hpp"
 #include "gen_capabilities.hpp"
 #include "vertex_attrib.hpp"
@@ -39,7 +40,7 @@ struct generator : interface<generator> {
 
     /// @brief Tests if the specified attribute is supported by this generator.
     auto has(vertex_attrib_kind attrib) noexcept {
-        return bool(attrib_bits() | attrib);
+        return bool(attrib_bits() & attrib);
     }
 
     /// @brief Enables or disables the specified generator capability.
@@ -54,6 +55,13 @@ struct generator : interface<generator> {
     /// @brief Indicates if the specified generator capability is enabled.
     virtual auto is_enabled(generator_capability cap) noexcept -> bool = 0;
 
+    /// @brief Lets the generator use the workshop threads to bake the data.
+    /// @param workers the thread pool doing the work.
+    /// @param max_threads the maximum number of ranges processed in parallel.
+    ///
+    /// Generators that do not support parallel baking ignore this.
+    virtual void use_workers(workshop& workers, span_size_t max_threads) = 0;
+
     /// @brief Indicates if element strips are enabled.
     auto strips_allowed() noexcept -> bool {
         return is_enabled(generator_capability::element_strips);
@@ -243,6 +251,14 @@ public:
         return _caps.has(cap);
     }
 
+    void use_workers(workshop& workers, span_size_t max_threads) final {
+        _workers = &workers;
+        _max_threads = max_threads;
+        if(max_threads > 1) {
+            workers.ensure_workers(max_threads - 1);
+        }
+    }
+
     auto attribute_variants(vertex_attrib_kind attrib) -> span_size_t override {
         return has(attrib) ? 1U : 0U;
     }
@@ -310,9 +326,30 @@ protected:
     generator_base(vertex_attrib_bits attr_bits) noexcept
       : _attr_bits(attr_bits) {}
 
+    /// @brief Calls func(begin, end) on contiguous sub-ranges of [0, count).
+    /// @see use_workers
+    ///
+    /// The sub-ranges are processed in parallel if use_workers was called,
+    /// func must not write outside of the part of the output for its range.
+    template <typename Function>
+    void parallel_for(span_size_t count, const Function& func) {
+        if(_workers && (_max_threads > 1)) {
+            _workers->parallel_for(
+              count,
+              _max_threads,
+              [&func](span_size_t, span_size_t begin, span_size_t end) {
+                  func(begin, end);
+              });
+        } else {
+            func(span_size(0), count);
+        }
+    }
+
 private:
     vertex_attrib_bits _attr_bits;
     generator_capabilities _caps;
+    workshop* _workers{nullptr};
+    span_size_t _max_threads{1};
 };
 //------------------------------------------------------------------------------
 /// @brief Base class for shape generators re-calculating the center.
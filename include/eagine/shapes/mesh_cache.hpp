@@ -0,0 +1,151 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_SHAPES_MESH_CACHE_HPP
+#define EAGINE_SHAPES_MESH_CACHE_HPP
+
+#include "../file_contents.hpp"
+#include "../memory/buffer.hpp"
+#include "gen_base.hpp"
+#include <eagine/config/basic.hpp>
+
+namespace eagine {
+namespace shapes {
+//------------------------------------------------------------------------------
+/// @brief Stores all data of a shape generator into a binary mesh cache.
+/// @ingroup shapes
+/// @see save_mesh_cache
+/// @see mesh_cache_loader
+///
+/// The cache contains all vertex attribute variants, the indices and drawing
+/// instructions of all drawing variants and the bounding sphere of the shape.
+/// The data is stored in the native byte order and is not portable between
+/// platforms with different endianness.
+auto store_mesh_cache(generator& gen, memory::buffer& dest) -> bool;
+//------------------------------------------------------------------------------
+/// @brief Stores all data of a shape generator into a binary mesh cache file.
+/// @ingroup shapes
+/// @see store_mesh_cache
+/// @see from_mesh_cache
+auto save_mesh_cache(generator& gen, string_view path) -> bool;
+//------------------------------------------------------------------------------
+/// @brief Loader reading shape data from a binary mesh cache.
+/// @ingroup shapes
+/// @see from_mesh_cache
+/// @see store_mesh_cache
+///
+/// The attribute values and indices are copied directly from the cache
+/// (typically a memory-mapped file), nothing is tessellated or parsed.
+class mesh_cache_loader : public generator_base {
+public:
+    /// @brief Construction from the contents of a mesh cache file.
+    mesh_cache_loader(file_contents contents) noexcept
+      : mesh_cache_loader{contents.block(), std::move(contents)} {}
+
+    /// @brief Construction from a memory block, which must outlive the loader.
+    mesh_cache_loader(memory::const_block data) noexcept
+      : mesh_cache_loader{data, file_contents{}} {}
+
+    /// @brief Indicates if the mesh cache data is valid.
+    auto is_valid() const noexcept -> bool {
+        return !_data.empty();
+    }
+
+    /// @brief Indicates if the mesh cache data is valid.
+    /// @see is_valid
+    explicit operator bool() const noexcept {
+        return is_valid();
+    }
+
+    /// @brief Returns a view of the stored values of an attribute variant.
+    /// @see attrib_type
+    auto attrib_data(vertex_attrib_variant) const noexcept
+      -> memory::const_block;
+
+    /// @brief Returns a view of the stored indices of a drawing variant.
+    /// @see index_type
+    auto index_data(drawing_variant) const noexcept -> memory::const_block;
+
+    auto vertex_count() -> span_size_t override;
+
+    auto attribute_variants(vertex_attrib_kind) -> span_size_t override;
+
+    auto variant_name(vertex_attrib_variant) -> string_view override;
+
+    auto values_per_vertex(vertex_attrib_variant) -> span_size_t override;
+
+    auto attrib_type(vertex_attrib_variant vav) -> attrib_data_type override;
+
+    auto is_attrib_normalized(vertex_attrib_variant) -> bool override;
+
+    void attrib_values(vertex_attrib_variant, span<byte>) override;
+    void attrib_values(vertex_attrib_variant, span<std::int16_t>) override;
+    void attrib_values(vertex_attrib_variant, span<std::int32_t>) override;
+    void attrib_values(vertex_attrib_variant, span<std::uint16_t>) override;
+    void attrib_values(vertex_attrib_variant, span<std::uint32_t>) override;
+    void attrib_values(vertex_attrib_variant, span<float>) override;
+
+    auto draw_variant_count() -> span_size_t override;
+
+    auto index_type(drawing_variant) -> index_data_type override;
+
+    auto index_count(drawing_variant) -> span_size_t override;
+
+    void indices(drawing_variant, span<std::uint8_t> dest) override;
+
+    void indices(drawing_variant, span<std::uint16_t> dest) override;
+
+    void indices(drawing_variant, span<std::uint32_t> dest) override;
+
+    auto operation_count(drawing_variant) -> span_size_t override;
+
+    void instructions(drawing_variant, span<draw_operation> ops) override;
+
+    auto bounding_sphere() -> math::sphere<float, true> override;
+
+private:
+    mesh_cache_loader(
+      memory::const_block data,
+      file_contents&& contents) noexcept;
+
+    static auto _validate(memory::const_block data) noexcept
+      -> memory::const_block;
+
+    static auto _attr_bits(memory::const_block data) noexcept
+      -> vertex_attrib_bits;
+
+    auto _attrib_entry(vertex_attrib_variant) const noexcept -> span_size_t;
+
+    template <typename T>
+    void _attrib_values(vertex_attrib_variant, span<T>);
+
+    template <typename T>
+    void _indices(drawing_variant, span<T>);
+
+    file_contents _contents;
+    memory::const_block _data;
+};
+//------------------------------------------------------------------------------
+/// @brief Constructs instances of mesh_cache_loader from a mesh cache file.
+/// @ingroup shapes
+/// @see save_mesh_cache
+///
+/// The file is memory-mapped if the platform supports it.
+static inline auto from_mesh_cache(string_view path) {
+    return std::make_unique<mesh_cache_loader>(
+      file_contents{path, map_file_tag{}});
+}
+//------------------------------------------------------------------------------
+} // namespace shapes
+} // namespace eagine
+
+#if !EAGINE_LINK_LIBRARY || defined(EAGINE_IMPLEMENTING_LIBRARY)
+#include <eagine/shapes/mesh_cache.inl>
+#endif
+
+#endif // EAGINE_SHAPES_MESH_CACHE_HPP
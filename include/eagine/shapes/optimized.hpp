@@ -0,0 +1,161 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_SHAPES_OPTIMIZED_HPP
+#define EAGINE_SHAPES_OPTIMIZED_HPP
+
+#include "../flat_map.hpp"
+#include "delegated.hpp"
+#include <eagine/config/basic.hpp>
+#include <vector>
+
+namespace eagine {
+namespace shapes {
+//------------------------------------------------------------------------------
+/// @brief Options for the optimized_gen mesh optimization modifier.
+/// @ingroup shapes
+/// @see optimized_gen
+struct mesh_optimization_options {
+    /// @brief The size of the simulated post-transform vertex cache.
+    span_size_t cache_size{16};
+
+    /// @brief Reorder the triangles for vertex cache locality.
+    bool reorder_triangles{true};
+
+    /// @brief Reorder the clusters of triangles to reduce overdraw.
+    bool reduce_overdraw{false};
+
+    /// @brief Reorder the vertices in the order of their first use.
+    bool reorder_vertices{true};
+
+    /// @brief Merge the vertices having identical values of all attributes.
+    bool deduplicate_vertices{false};
+};
+//------------------------------------------------------------------------------
+/// @brief Statistics of the optimization of a single drawing variant.
+/// @ingroup shapes
+/// @see optimized_gen
+struct mesh_optimization_statistics {
+    /// @brief The number of the triangles drawn.
+    span_size_t triangle_count{0};
+
+    /// @brief The number of vertices of the original shape.
+    span_size_t original_vertex_count{0};
+
+    /// @brief The number of vertices after the optimization.
+    span_size_t vertex_count{0};
+
+    /// @brief The average cache miss ratio (misses per triangle) before.
+    float acmr_before{0.F};
+
+    /// @brief The average cache miss ratio (misses per triangle) after.
+    float acmr_after{0.F};
+};
+//------------------------------------------------------------------------------
+/// @brief Returns the average cache miss ratio of triangle list indices.
+/// @ingroup shapes
+/// @param indices triples of vertex indices of a triangle list.
+/// @param cache_size the size of the simulated FIFO vertex cache.
+auto vertex_cache_miss_ratio(
+  span<const unsigned> indices,
+  span_size_t cache_size) -> float;
+//------------------------------------------------------------------------------
+/// @brief Generator modifier optimizing the generated mesh for rendering.
+/// @ingroup shapes
+/// @see optimize
+/// @see mesh_optimization_options
+///
+/// Drawing variants consisting only of triangles, triangle strips or fans
+/// are converted to a single triangle list, optionally reordered for
+/// post-transform vertex cache locality with the Tipsify algorithm.
+/// The vertices can be renumbered in the order of their first use in
+/// the first drawing variant and identical vertices can be merged.
+/// The other drawing variants are only re-indexed.
+class optimized_gen : public delegated_gen {
+public:
+    optimized_gen(
+      std::shared_ptr<generator> gen,
+      const mesh_optimization_options& options) noexcept
+      : delegated_gen{std::move(gen)}
+      , _options{options} {}
+
+    /// @brief Returns the optimization statistics of a drawing variant.
+    auto statistics(drawing_variant) -> const mesh_optimization_statistics&;
+
+    auto vertex_count() -> span_size_t override;
+
+    void attrib_values(vertex_attrib_variant, span<byte>) override;
+    void attrib_values(vertex_attrib_variant, span<std::int16_t>) override;
+    void attrib_values(vertex_attrib_variant, span<std::int32_t>) override;
+    void attrib_values(vertex_attrib_variant, span<std::uint16_t>) override;
+    void attrib_values(vertex_attrib_variant, span<std::uint32_t>) override;
+    void attrib_values(vertex_attrib_variant, span<float>) override;
+
+    auto index_type(drawing_variant) -> index_data_type override;
+
+    auto index_count(drawing_variant) -> span_size_t override;
+
+    void indices(drawing_variant, span<std::uint8_t> dest) override;
+
+    void indices(drawing_variant, span<std::uint16_t> dest) override;
+
+    void indices(drawing_variant, span<std::uint32_t> dest) override;
+
+    auto operation_count(drawing_variant) -> span_size_t override;
+
+    void instructions(drawing_variant, span<draw_operation> ops) override;
+
+private:
+    struct variant_data {
+        std::vector<unsigned> indices;
+        std::vector<draw_operation> operations;
+        mesh_optimization_statistics stats;
+        index_data_type index_type{index_data_type::none};
+    };
+
+    auto _triangles(drawing_variant, std::vector<unsigned>&) -> bool;
+    auto _canonical_vertices() -> std::vector<unsigned>;
+    void _reduce_overdraw(
+      std::vector<unsigned>& indices,
+      const std::vector<span_size_t>& clusters);
+    void _reindex(drawing_variant, variant_data&);
+    auto _variant(drawing_variant) -> variant_data&;
+    void _prepare();
+
+    template <typename T>
+    void _attrib_values(vertex_attrib_variant, span<T>);
+
+    template <typename T>
+    void _indices(drawing_variant, span<T> dest);
+
+    mesh_optimization_options _options;
+    bool _prepared{false};
+    span_size_t _original_vertex_count{0};
+    // original vertex index -> optimized vertex index
+    std::vector<unsigned> _vertex_map;
+    // optimized vertex index -> original vertex index
+    std::vector<unsigned> _vertex_source;
+    flat_map<drawing_variant, variant_data> _variants;
+};
+//------------------------------------------------------------------------------
+/// @brief Constructs instances of optimized_gen modifier.
+/// @ingroup shapes
+static inline auto optimize(
+  std::shared_ptr<generator> gen,
+  const mesh_optimization_options& options = {}) noexcept {
+    return std::make_unique<optimized_gen>(std::move(gen), options);
+}
+//------------------------------------------------------------------------------
+} // namespace shapes
+} // namespace eagine
+
+#if !EAGINE_LINK_LIBRARY || defined(EAGINE_IMPLEMENTING_LIBRARY)
+#include <eagine/shapes/optimized.inl>
+#endif
+
+#endif // EAGINE_SHAPES_OPTIMIZED_HPP
@@ -0,0 +1,158 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef EAGINE_SHAPES_VERTEX_TRANSFORM_HPP
+#define EAGINE_SHAPES_VERTEX_TRANSFORM_HPP
+
+#include "../assert.hpp"
+#include "../span.hpp"
+#include "../types.hpp"
+#include "../vect/data.hpp"
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace eagine {
+namespace shapes {
+//------------------------------------------------------------------------------
+// The interleaved vertex values with m components per vertex are processed
+// in blocks of lcm(m, 4) floats, as a couple of 4-wide vectors, with
+// the per-component parameters repeated in matching lane patterns.
+//------------------------------------------------------------------------------
+using vertex_lanes_t = vect::data_t<float, 4, true>;
+//------------------------------------------------------------------------------
+static constexpr inline auto vertex_lanes_block_size(span_size_t m) noexcept
+  -> span_size_t {
+    return (m == 3) ? 12 : 4;
+}
+//------------------------------------------------------------------------------
+static inline auto
+vertex_lanes_load(const float* src) noexcept -> vertex_lanes_t {
+    vertex_lanes_t result;
+    std::memcpy(&result, src, sizeof(float) * 4);
+    return result;
+}
+//------------------------------------------------------------------------------
+static inline void vertex_lanes_store(float* dst, vertex_lanes_t v) noexcept {
+    std::memcpy(dst, &v, sizeof(float) * 4);
+}
+//------------------------------------------------------------------------------
+static inline auto vertex_lanes_pattern(
+  const std::array<float, 4>& params,
+  span_size_t m) noexcept -> std::array<vertex_lanes_t, 3> {
+    std::array<vertex_lanes_t, 3> result{};
+    for(span_size_t i = 0; i < 12; ++i) {
+        result[std_size(i / 4)][int(i % 4)] = params[std_size(i % m)];
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+template <typename Op>
+static inline void vertex_values_apply(
+  span<float> values,
+  span_size_t m,
+  const std::array<float, 4>& params,
+  Op op) noexcept {
+    EAGINE_ASSERT((m > 0) && (m <= 4));
+    const auto block = vertex_lanes_block_size(m);
+    const auto lanes = vertex_lanes_pattern(params, m);
+    const auto n = values.size();
+    float* data = values.data();
+
+    span_size_t i = 0;
+    for(; i + block <= n; i += block) {
+        for(span_size_t j = 0; j < block; j += 4) {
+            auto v = vertex_lanes_load(data + i + j);
+            op(v, lanes[std_size(j / 4)]);
+            vertex_lanes_store(data + i + j, v);
+        }
+    }
+    for(; i < n; ++i) {
+        op(data[i], params[std_size(i % m)]);
+    }
+}
+//------------------------------------------------------------------------------
+/// @brief Multiplies the m-component interleaved values by the factors.
+/// @ingroup shapes
+/// @see translate_vertex_values
+static inline void scale_vertex_values(
+  span<float> values,
+  span_size_t m,
+  const std::array<float, 4>& factors) noexcept {
+    vertex_values_apply(values, m, factors, [](auto& v, const auto& f) {
+        v *= f;
+    });
+}
+//------------------------------------------------------------------------------
+/// @brief Adds the offsets to the m-component interleaved values.
+/// @ingroup shapes
+/// @see scale_vertex_values
+static inline void translate_vertex_values(
+  span<float> values,
+  span_size_t m,
+  const std::array<float, 4>& offsets) noexcept {
+    vertex_values_apply(values, m, offsets, [](auto& v, const auto& o) {
+        v += o;
+    });
+}
+//------------------------------------------------------------------------------
+/// @brief Finds the per-component bounds of m-component interleaved values.
+/// @ingroup shapes
+static inline void vertex_value_bounds(
+  span<const float> values,
+  span_size_t m,
+  std::array<float, 4>& min,
+  std::array<float, 4>& max) noexcept {
+    EAGINE_ASSERT((m > 0) && (m <= 4));
+    min.fill(std::numeric_limits<float>::max());
+    max.fill(std::numeric_limits<float>::lowest());
+
+    const auto block = vertex_lanes_block_size(m);
+    const auto n = values.size();
+    const float* data = values.data();
+
+    std::array<vertex_lanes_t, 3> lane_min{};
+    std::array<vertex_lanes_t, 3> lane_max{};
+    for(std::size_t j = 0; j < 3; ++j) {
+        for(int l = 0; l < 4; ++l) {
+            lane_min[j][l] = min[0];
+            lane_max[j][l] = max[0];
+        }
+    }
+
+    span_size_t i = 0;
+    for(; i + block <= n; i += block) {
+        for(span_size_t j = 0; j < block; j += 4) {
+            const auto v = vertex_lanes_load(data + i + j);
+            auto& mn = lane_min[std_size(j / 4)];
+            auto& mx = lane_max[std_size(j / 4)];
+            for(int l = 0; l < 4; ++l) {
+                mn[l] = v[l] < mn[l] ? v[l] : mn[l];
+                mx[l] = v[l] > mx[l] ? v[l] : mx[l];
+            }
+        }
+    }
+
+    for(span_size_t k = 0; k < block; ++k) {
+        const auto c = std_size(k % m);
+        const auto& mn = lane_min[std_size(k / 4)];
+        const auto& mx = lane_max[std_size(k / 4)];
+        min[c] = mn[int(k % 4)] < min[c] ? mn[int(k % 4)] : min[c];
+        max[c] = mx[int(k % 4)] > max[c] ? mx[int(k % 4)] : max[c];
+    }
+    for(; i < n; ++i) {
+        const auto c = std_size(i % m);
+        min[c] = data[i] < min[c] ? data[i] : min[c];
+        max[c] = data[i] > max[c] ? data[i] : max[c];
+    }
+}
+//------------------------------------------------------------------------------
+} // namespace shapes
+} // namespace eagine
+
+#endif // EAGINE_SHAPES_VERTEX_TRANSFORM_HPP
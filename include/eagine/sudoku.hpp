@@ -13,8 +13,10 @@
 #include "integer_range.hpp"
 #include "optional_ref.hpp"
 #include "serialize/fwd.hpp"
+#include "vect/config.hpp"
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iomanip>
 #include <ostream>
@@ -202,8 +204,7 @@ public:
     static constexpr const unsigned glyph_count = board_traits::glyph_count;
 
     static constexpr auto to_cell_type(unsigned index) noexcept {
-        // NOLINTNEXTLINE(bugprone-misplaced-widening-cast)
-        return cell_type(1U << index);
+        return cell_type(cell_type(1U) << index);
     }
 
     constexpr basic_sudoku_glyph() noexcept = default;
@@ -227,15 +228,8 @@ public:
     }
 
     auto get_index() const noexcept -> unsigned {
-        unsigned result = 0U;
-        while(result < glyph_count) {
-            if(_cel_val == to_cell_type(result)) {
-                break;
-            }
-            ++result;
-        }
-        EAGINE_ASSERT(result < glyph_count);
-        return result;
+        EAGINE_ASSERT(is_single());
+        return _bit_index(_cel_val);
     }
 
     constexpr auto set(unsigned index) noexcept -> auto& {
@@ -252,23 +246,13 @@ public:
 
     template <typename Function>
     void for_each_alternative(Function func) const noexcept {
-
-        for(const auto index : integer_range(glyph_count)) {
-            const auto mask = to_cell_type(index);
-            if((_cel_val & mask) == mask) {
-                func(index);
-            }
+        for(cell_type bits = _cel_val; bits; bits &= cell_type(bits - 1U)) {
+            func(_bit_index(bits));
         }
     }
 
     auto alternative_count() const noexcept -> unsigned {
-        unsigned count = 0U;
-        cell_type bits = _cel_val;
-        while(bits) {
-            bits &= (bits - 1U);
-            ++count;
-        }
-        return count;
+        return _bit_count(_cel_val);
     }
 
 private:
@@ -283,6 +267,33 @@ private:
         return (v != 0U) && ((v & (v - 1U)) == 0U);
     }
 
+    static constexpr auto _bit_count(cell_type v) noexcept -> unsigned {
+#if defined(__GNUC__)
+        return unsigned(__builtin_popcountll(v));
+#else
+        unsigned count = 0U;
+        while(v) {
+            v &= cell_type(v - 1U);
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // index of the lowest set bit, v must not be zero
+    static constexpr auto _bit_index(cell_type v) noexcept -> unsigned {
+#if defined(__GNUC__)
+        return unsigned(__builtin_ctzll(v));
+#else
+        unsigned index = 0U;
+        while(!(v & 1U)) {
+            v >>= 1U;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
     cell_type _cel_val{0U};
 };
 //------------------------------------------------------------------------------
@@ -372,29 +383,26 @@ public:
         return true;
     }
 
-    auto is_solved() noexcept {
-        bool result = true;
-        for_each_coord([&](const auto& coord) {
-            const auto value = get(coord);
-            if(!value.is_single()) {
-                result = false;
-                return false;
+    auto is_solved() const noexcept {
+        for(const auto& block : _blocks) {
+            for(const auto cel_val : block) {
+                if(!glyph_type::_is_pot(cel_val)) {
+                    return false;
+                }
             }
-            return true;
-        });
-        return result;
+        }
+        return true;
     }
 
-    auto has_empty() noexcept {
-        bool result = false;
-        for_each_coord([&](const auto& coord) {
-            if(get(coord).is_empty()) {
-                result = true;
-                return false;
+    auto has_empty() const noexcept {
+        for(const auto& block : _blocks) {
+            for(const auto cel_val : block) {
+                if(cel_val == 0U) {
+                    return true;
+                }
             }
-            return true;
-        });
-        return result;
+        }
+        return false;
     }
 
     auto get(const coord_type& coord) const noexcept -> glyph_type {
@@ -416,13 +424,26 @@ public:
         return set(coord, alternatives);
     }
 
+    // Sets the alternatives of all non-single cells from the single cells
+    // in their row, column and block and then repeatedly assigns the naked
+    // singles (cells with one alternative) and the hidden singles (glyphs
+    // with one possible cell in a row, column or block). If a contradiction
+    // is found the propagation stops and the board is left with an empty cell.
     auto calculate_alternatives() noexcept -> auto& {
-        for_each_coord([&](const auto& coord) {
-            if(!get(coord).is_single()) {
-                set_available_alternatives(coord);
+        _occupancy occ{};
+        _init_occupancy(occ);
+        bool changed = true;
+        while(changed) {
+            changed = false;
+            if(!_assign_naked_singles(occ, changed)) {
+                break;
             }
-            return true;
-        });
+            if(!changed) {
+                if(!_assign_hidden_singles(occ, changed)) {
+                    break;
+                }
+            }
+        }
         return *this;
     }
 
@@ -430,13 +451,13 @@ public:
         auto result = invalid_coord();
         auto min_alt = glyph_count + 1;
         for_each_coord([&](const auto& coord) {
-            if(const auto num_alt{get(coord).alternative_count()}) {
-                if((num_alt > 1) && (min_alt > num_alt)) {
-                    min_alt = num_alt;
-                    result = coord;
-                }
+            const auto num_alt{get(coord).alternative_count()};
+            if((num_alt > 1) && (min_alt > num_alt)) {
+                min_alt = num_alt;
+                result = coord;
             }
-            return true;
+            // there cannot be a cell with fewer alternatives
+            return min_alt > 2;
         });
         return result;
     }
@@ -486,6 +507,204 @@ public:
     }
 
 private:
+    static constexpr const cell_type _all_glyphs =
+      cell_type(~cell_type(0U)) >> (sizeof(cell_type) * 8U - glyph_count);
+
+    // the glyphs of the single cells in each row, column and block
+    struct _occupancy {
+        std::array<cell_type, glyph_count> rows{};
+        std::array<cell_type, glyph_count> columns{};
+        std::array<cell_type, glyph_count> blocks{};
+
+        auto row(const coord_type& coord) noexcept -> cell_type& {
+            return rows[coord[1] * S + coord[3]];
+        }
+
+        auto column(const coord_type& coord) noexcept -> cell_type& {
+            return columns[coord[0] * S + coord[2]];
+        }
+
+        auto block(const coord_type& coord) noexcept -> cell_type& {
+            return blocks[coord[1] * S + coord[0]];
+        }
+
+        auto excluded(const coord_type& coord) noexcept -> cell_type {
+            return row(coord) | column(coord) | block(coord);
+        }
+
+        void add(const coord_type& coord, cell_type cel_val) noexcept {
+            row(coord) |= cel_val;
+            column(coord) |= cel_val;
+            block(coord) |= cel_val;
+        }
+    };
+
+    void _init_occupancy(_occupancy& occ) const noexcept {
+        for_each_coord([&](const auto& coord) {
+            const auto cel_val = _cell_val(coord);
+            if(glyph_type::_is_pot(cel_val)) {
+                occ.add(coord, cel_val);
+            }
+            return true;
+        });
+    }
+
+    // Updates the alternatives of the non-single cells in a block from
+    // the excluded glyphs and stores the cells that became single into fresh.
+    static void _update_alternatives(
+      block_type& block,
+      const block_type& excluded,
+      block_type& fresh) noexcept {
+        unsigned i = 0U;
+#if EAGINE_USE_SIMD && defined(__GNUC__)
+        using vec_type __attribute__((vector_size(16))) = cell_type;
+        constexpr const unsigned lanes = 16U / sizeof(cell_type);
+        for(; i + lanes <= glyph_count; i += lanes) {
+            vec_type cel_val{};
+            vec_type excl{};
+            std::memcpy(&cel_val, &block[i], sizeof(vec_type));
+            std::memcpy(&excl, &excluded[i], sizeof(vec_type));
+            // all bits set in the lanes with single cells
+            const auto single = vec_type(
+              (cel_val != 0U) & ((cel_val & (cel_val - 1U)) == 0U));
+            const vec_type alt = ~excl & _all_glyphs;
+            const auto alt_single =
+              vec_type((alt != 0U) & ((alt & (alt - 1U)) == 0U));
+            const vec_type updated = (cel_val & single) | (alt & ~single);
+            const vec_type new_single = alt & alt_single & ~single;
+            std::memcpy(&block[i], &updated, sizeof(vec_type));
+            std::memcpy(&fresh[i], &new_single, sizeof(vec_type));
+        }
+#endif
+        for(; i < glyph_count; ++i) {
+            const auto cel_val = block[i];
+            const auto alt = cell_type(~excluded[i] & _all_glyphs);
+            const bool single = glyph_type::_is_pot(cel_val);
+            block[i] = single ? cel_val : alt;
+            fresh[i] = (!single && glyph_type::_is_pot(alt)) ? alt : 0U;
+        }
+    }
+
+    auto _assign_naked_singles(_occupancy& occ, bool& changed) noexcept
+      -> bool {
+        block_type excluded{};
+        block_type fresh{};
+        for(const auto by : integer_range(S)) {
+            for(const auto bx : integer_range(S)) {
+                auto& block = _block(_blocks, bx, by);
+                for(const auto cy : integer_range(S)) {
+                    for(const auto cx : integer_range(S)) {
+                        excluded[cy * S + cx] =
+                          occ.excluded(coord_type{{bx, by, cx, cy}});
+                    }
+                }
+                _update_alternatives(block, excluded, fresh);
+                for(const auto cy : integer_range(S)) {
+                    for(const auto cx : integer_range(S)) {
+                        const coord_type coord{{bx, by, cx, cy}};
+                        auto& cel_val = _cell(block, cx, cy);
+                        if(cel_val == 0U) {
+                            return false;
+                        }
+                        if(const auto single{_cell(fresh, cx, cy)}) {
+                            // another cell became the same single before
+                            if(occ.excluded(coord) & single) {
+                                cel_val = 0U;
+                                return false;
+                            }
+                            occ.add(coord, single);
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename CoordAt>
+    auto _assign_hidden_singles(
+      _occupancy& occ,
+      cell_type placed,
+      CoordAt coord_at,
+      bool& changed) noexcept -> bool {
+        cell_type once{0U};
+        cell_type twice{0U};
+        auto open = invalid_coord();
+        for(const auto k : integer_range(glyph_count)) {
+            const auto coord{coord_at(k)};
+            const auto cel_val = _cell_val(coord);
+            if(!glyph_type::_is_pot(cel_val)) {
+                twice |= cel_val & once;
+                once |= cel_val;
+                open = coord;
+            }
+        }
+        if(open == invalid_coord()) {
+            return true;
+        }
+        if(_all_glyphs & ~(once | placed)) {
+            // some glyph does not fit anywhere in the unit
+            _cell_ref(open) = 0U;
+            return false;
+        }
+        if(const auto hidden = cell_type(once & ~twice & ~placed)) {
+            for(const auto k : integer_range(glyph_count)) {
+                const auto coord{coord_at(k)};
+                auto& cel_val = _cell_ref(coord);
+                const auto single = cell_type(cel_val & hidden);
+                if(single && !glyph_type::_is_pot(cel_val)) {
+                    if(
+                      !glyph_type::_is_pot(single) ||
+                      (occ.excluded(coord) & single)) {
+                        cel_val = 0U;
+                        return false;
+                    }
+                    cel_val = single;
+                    occ.add(coord, single);
+                    changed = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    auto _assign_hidden_singles(_occupancy& occ, bool& changed) noexcept
+      -> bool {
+        for(const auto u : integer_range(S)) {
+            for(const auto v : integer_range(S)) {
+                if(!_assign_hidden_singles(
+                     occ,
+                     occ.rows[u * S + v],
+                     [u, v](unsigned k) {
+                         return coord_type{{k / S, u, k % S, v}};
+                     },
+                     changed)) {
+                    return false;
+                }
+                if(!_assign_hidden_singles(
+                     occ,
+                     occ.columns[u * S + v],
+                     [u, v](unsigned k) {
+                         return coord_type{{u, k / S, v, k % S}};
+                     },
+                     changed)) {
+                    return false;
+                }
+                if(!_assign_hidden_singles(
+                     occ,
+                     occ.blocks[u * S + v],
+                     [u, v](unsigned k) {
+                         return coord_type{{v, u, k % S, k / S}};
+                     },
+                     changed)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     auto _cell_val(const coord_type& coord) const noexcept {
         const auto [bx, by, cx, cy] = coord;
         return _cell(_block(_blocks, bx, by), cx, cy);
@@ -527,17 +746,22 @@ public:
         board_type result{_traits};
         result.calculate_alternatives();
 
-        while(count) {
+        // the alternatives are propagated, so the board can be solved
+        // or contradictory before all of the requested glyphs are set
+        while(count && !result.is_solved() && !result.has_empty()) {
             const typename board_type::coord_type coord{
               _coord_dist(_rd),
               _coord_dist(_rd),
               _coord_dist(_rd),
               _coord_dist(_rd)};
 
-            if(!result.get(coord).is_single()) {
+            const auto cell{result.get(coord)};
+            if(cell.is_multiple()) {
                 while(true) {
                     const auto value{_glyph_dist(_rd)};
-                    if(result.is_possible(coord, value)) {
+                    if(
+                      (cell.cell_value() & cell.to_cell_type(value)) &&
+                      result.is_possible(coord, value)) {
                         result.set(coord, value).calculate_alternatives();
                         --count;
                         break;
@@ -140,6 +140,13 @@ public:
         return _duration;
     }
 
+    /// @brief Returns the point in time when the timeout expires.
+    /// @see reset
+    /// @see is_expired
+    auto deadline() const noexcept -> _clock::time_point {
+        return _timeout;
+    }
+
 private:
     _clock::duration _duration{};
     _clock::time_point _timeout{};
@@ -13,7 +13,9 @@
 #include "extract.hpp"
 #include "integer_range.hpp"
 #include "interface.hpp"
+#include "scope_exit.hpp"
 #include "types.hpp"
+#include <algorithm>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -27,6 +29,53 @@ namespace eagine {
 struct work_unit : interface<work_unit> {
     virtual auto do_it() -> bool = 0;
     virtual void deliver() = 0;
+    // called instead of do_it and deliver if the workshop shuts down
+    // before the unit was started
+    virtual void cancel() = 0;
+};
+//------------------------------------------------------------------------------
+template <typename Function>
+class workshop_range_work : public work_unit {
+public:
+    workshop_range_work(
+      const Function& func,
+      span_size_t task,
+      span_size_t begin,
+      span_size_t end,
+      std::mutex& mutex,
+      std::condition_variable& cond,
+      span_size_t& pending) noexcept
+      : _func{func}
+      , _task{task}
+      , _begin{begin}
+      , _end{end}
+      , _mutex{mutex}
+      , _cond{cond}
+      , _pending{pending} {}
+
+    auto do_it() -> bool final {
+        _func(_task, _begin, _end);
+        return true;
+    }
+
+    void deliver() final {
+        std::unique_lock lock{_mutex};
+        --_pending;
+        _cond.notify_all();
+    }
+
+    void cancel() final {
+        deliver();
+    }
+
+private:
+    const Function& _func;
+    const span_size_t _task;
+    const span_size_t _begin;
+    const span_size_t _end;
+    std::mutex& _mutex;
+    std::condition_variable& _cond;
+    span_size_t& _pending;
 };
 //------------------------------------------------------------------------------
 class workshop {
@@ -70,6 +119,19 @@ private:
         }
     }
 
+    // must be called with _mutex locked
+    void _add_worker() {
+        _workers.emplace_back([this]() { this->_employ(); });
+    }
+
+    void _add_workers(span_size_t n) {
+        _workers.reserve(_workers.size() + std_size(n));
+        for(const auto i : integer_range(n)) {
+            EAGINE_MAYBE_UNUSED(i);
+            _add_worker();
+        }
+    }
+
 public:
     workshop() = default;
     workshop(workshop&&) = delete;
@@ -87,6 +149,12 @@ public:
     auto shutdown() -> workshop& {
         std::unique_lock lock{_mutex};
         _shutdown = true;
+        // the workers do not fetch any more units, so the owners of the
+        // queued ones must not wait for them
+        while(!_work_queue.empty()) {
+            _work_queue.front()->cancel();
+            _work_queue.pop();
+        }
         _cond.notify_all();
         return *this;
     }
@@ -105,23 +173,22 @@ public:
     }
 
     auto add_worker() -> workshop& {
-        _workers.emplace_back([this]() { this->_employ(); });
+        std::unique_lock lock{_mutex};
+        _add_worker();
         return *this;
     }
 
     auto add_workers(span_size_t n) -> workshop& {
-        _workers.reserve(_workers.size() + std_size(n));
-        for(const auto i : integer_range(n)) {
-            EAGINE_MAYBE_UNUSED(i);
-            add_worker();
-        }
+        std::unique_lock lock{_mutex};
+        _add_workers(n);
         return *this;
     }
 
     auto ensure_workers(span_size_t n) -> workshop& {
+        std::unique_lock lock{_mutex};
         const auto c = span_size(_workers.size());
         if(n > c) {
-            add_workers(n - c);
+            _add_workers(n - c);
         }
         return *this;
     }
@@ -137,13 +204,66 @@ public:
 
     auto enqueue(work_unit& work) -> workshop& {
         std::unique_lock lock{_mutex};
+        if(EAGINE_UNLIKELY(_shutdown)) {
+            work.cancel();
+            return *this;
+        }
         if(EAGINE_UNLIKELY(_workers.empty())) {
-            add_worker();
+            _add_worker();
         }
         _work_queue.push(&work);
         _cond.notify_one();
         return *this;
     }
+
+    /// @brief Splits the range [0, count) into task_count contiguous ranges.
+    ///
+    /// Calls func(task, begin, end) for each of the ranges, the first one
+    /// on the calling thread and the others on the workers, and waits until
+    /// all of them are done. Must not be called from the worker threads.
+    template <typename Function>
+    auto parallel_for(
+      span_size_t count,
+      span_size_t task_count,
+      const Function& func) -> workshop& {
+        task_count = std::min(task_count, count);
+        if(task_count < 2) {
+            if(count > 0) {
+                func(span_size(0), span_size(0), count);
+            }
+            return *this;
+        }
+
+        const auto range_end = [count, task_count](span_size_t task) {
+            return (count * task) / task_count;
+        };
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        span_size_t pending{0};
+        std::vector<workshop_range_work<Function>> tasks;
+        tasks.reserve(std_size(task_count - 1));
+        for(span_size_t t = 1; t < task_count; ++t) {
+            tasks.emplace_back(
+              func, t, range_end(t), range_end(t + 1), mutex, cond, pending);
+        }
+
+        // the workers reference the tasks, which must not be destroyed
+        // before all the enqueued ones are done, even if something throws
+        const auto wait_for_tasks = finally([&]() {
+            std::unique_lock lock{mutex};
+            cond.wait(lock, [&pending]() { return pending == 0; });
+        });
+        ensure_workers(task_count - 1);
+        for(auto& task : tasks) {
+            enqueue(task);
+            // the task may be delivered before this
+            std::unique_lock lock{mutex};
+            ++pending;
+        }
+        func(span_size(0), span_size(0), range_end(1));
+        return *this;
+    }
 };
 //------------------------------------------------------------------------------
 } // namespace eagine
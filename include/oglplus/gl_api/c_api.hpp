@@ -14,12 +14,8 @@
 #include <eagine/preprocessor.hpp>
 
 #ifndef OGLPLUS_GL_STATIC_FUNC
-#if OGLPLUS_HAS_GL
-#if defined(__GLEW_H__)
-#define OGLPLUS_GL_STATIC_FUNC(NAME) nullptr
-#else
+#if OGLPLUS_HAS_STATIC_GL
 #define OGLPLUS_GL_STATIC_FUNC(NAME) &EAGINE_JOIN(gl, NAME)
-#endif
 #else
 #define OGLPLUS_GL_STATIC_FUNC(NAME) nullptr
 #endif
@@ -19,6 +19,14 @@
 #endif
 #endif // OGLPLUS_HAS_GL
 
+#ifndef OGLPLUS_HAS_STATIC_GL
+#if OGLPLUS_HAS_GL && !defined(__GLEW_H__)
+#define OGLPLUS_HAS_STATIC_GL 1
+#else
+#define OGLPLUS_HAS_STATIC_GL 0
+#endif
+#endif // OGLPLUS_HAS_STATIC_GL
+
 #if !OGLPLUS_HAS_GL
 #include <eagine/nothing.hpp>
 #include <cstdint>
@@ -31,11 +39,7 @@ namespace eagine::oglp {
 struct gl_types {
 #if OGLPLUS_HAS_GL
     static constexpr bool has_api = true;
-#if defined(__GLEW_H__)
-    static constexpr bool has_static_api = false;
-#else
-    static constexpr bool has_static_api = true;
-#endif
+    static constexpr bool has_static_api = OGLPLUS_HAS_STATIC_GL;
     /// @brief Untyped pointer type.
     using void_ptr_type = GLvoid*;
 
@@ -0,0 +1,250 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#ifndef OGLPLUS_GL_API_STATE_CACHE_HPP
+#define OGLPLUS_GL_API_STATE_CACHE_HPP
+
+#include "api.hpp"
+#include <eagine/flat_map.hpp>
+#include <eagine/type_identity.hpp>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace eagine::oglp {
+//------------------------------------------------------------------------------
+/// @brief Shadow of the GL binding and capability state eliding some calls.
+/// @ingroup gl_api_wrap
+/// @see basic_gl_operations
+///
+/// Wraps a subset of the binding and capability functions from
+/// basic_gl_operations and remembers the values set by them. Calls that would
+/// not change the remembered state are not forwarded to the GL and are only
+/// counted. One instance should be used per GL context and all changes of the
+/// shadowed state in that context should be done through it. If the state
+/// is changed in some other way (by other code, by deleting a bound object,
+/// etc.) then invalidate must be called before the next shadowed call.
+template <typename ApiTraits>
+class basic_gl_state_cache {
+public:
+    /// @brief Alias for the wrapped GL operations.
+    using operations = basic_gl_operations<ApiTraits>;
+
+    using enum_type = typename gl_types::enum_type;
+    using name_type = typename gl_types::name_type;
+
+    /// @brief Construction with a reference to the wrapped operations.
+    basic_gl_state_cache(const operations& api) noexcept
+      : _api{api} {}
+
+    /// @brief Returns a reference to the wrapped operations.
+    auto api() const noexcept -> const operations& {
+        return _api;
+    }
+
+    /// @brief Forgets all remembered state.
+    /// @post The next call of each shadowed function is forwarded to the GL.
+    void invalidate() noexcept {
+        _capabilities.clear();
+        _buffers.clear();
+        _textures.clear();
+        _renderbuffers.clear();
+        _framebuffers.clear();
+        _draw_framebuffer.reset();
+        _read_framebuffer.reset();
+        _active_unit.reset();
+        _program.reset();
+        _vertex_array.reset();
+    }
+
+    /// @brief Returns the number of calls forwarded to the GL.
+    auto issued_count() const noexcept -> std::uint64_t {
+        return _issued_count;
+    }
+
+    /// @brief Returns the number of calls elided as redundant.
+    auto elided_count() const noexcept -> std::uint64_t {
+        return _elided_count;
+    }
+
+    /// @brief Resets the issued and elided call counters.
+    void reset_counters() noexcept {
+        _issued_count = 0U;
+        _elided_count = 0U;
+    }
+
+    /// @brief Enables the specified capability, unless it is already enabled.
+    /// @see disable
+    auto enable(capability cap) {
+        return _shadowed(_capabilities[enum_type(cap)], true, [&] {
+            return _api.enable(cap);
+        });
+    }
+
+    /// @brief Disables the specified capability, unless it is already disabled.
+    /// @see enable
+    auto disable(capability cap) {
+        return _shadowed(_capabilities[enum_type(cap)], false, [&] {
+            return _api.disable(cap);
+        });
+    }
+
+    /// @brief Makes the specified program current, unless it already is.
+    auto use_program(program_name prog) {
+        return _shadowed(_program, name_type(prog), [&] {
+            return _api.use_program(prog);
+        });
+    }
+
+    /// @brief Binds the buffer to the target, unless it is already bound.
+    auto bind_buffer(buffer_target tgt, buffer_name buf) {
+        return _shadowed(_buffers[enum_type(tgt)], name_type(buf), [&] {
+            return _api.bind_buffer(tgt, buf);
+        });
+    }
+
+    /// @brief Binds the vertex array, unless it is already bound.
+    ///
+    /// The element array buffer binding is a part of the vertex array state,
+    /// so it is forgotten whenever a different vertex array gets bound.
+    auto bind_vertex_array(vertex_array_name vao) {
+        if(_vertex_array != name_type(vao)) {
+#ifdef GL_ELEMENT_ARRAY_BUFFER
+            _buffers.erase(enum_type(GL_ELEMENT_ARRAY_BUFFER));
+#endif
+        }
+        return _shadowed(_vertex_array, name_type(vao), [&] {
+            return _api.bind_vertex_array(vao);
+        });
+    }
+
+    /// @brief Makes the specified texture unit active, unless it already is.
+    auto active_texture(texture_unit unit) {
+        return _shadowed(_active_unit, enum_type(unit), [&] {
+            return _api.active_texture(unit);
+        });
+    }
+
+    /// @brief Binds the texture to the target of the active texture unit.
+    ///
+    /// The binding is remembered (and the call elided) only if the active
+    /// texture unit is known, i.e. it was set through this cache.
+    auto bind_texture(texture_target tgt, texture_name tex) {
+        if(_active_unit) {
+            const std::pair<enum_type, enum_type> key{
+              *_active_unit, enum_type(tgt)};
+            return _shadowed(_textures[key], name_type(tex), [&] {
+                return _api.bind_texture(tgt, tex);
+            });
+        }
+        ++_issued_count;
+        return _api.bind_texture(tgt, tex);
+    }
+
+    /// @brief Binds the renderbuffer to the target, unless it is already bound.
+    auto bind_renderbuffer(renderbuffer_target tgt, renderbuffer_name rbo) {
+        return _shadowed(_renderbuffers[enum_type(tgt)], name_type(rbo), [&] {
+            return _api.bind_renderbuffer(tgt, rbo);
+        });
+    }
+
+    /// @brief Binds the framebuffer to the target, unless it is already bound.
+    ///
+    /// Binding to the framebuffer target binds both the draw and the read
+    /// framebuffer, so it is elided only if both of them are already bound.
+    auto bind_framebuffer(framebuffer_target tgt, framebuffer_name fbo) {
+        const auto call = [&] {
+            return _api.bind_framebuffer(tgt, fbo);
+        };
+#if defined(GL_FRAMEBUFFER) && defined(GL_DRAW_FRAMEBUFFER) && \
+  defined(GL_READ_FRAMEBUFFER)
+        switch(enum_type(tgt)) {
+            case GL_DRAW_FRAMEBUFFER:
+                return _shadowed(_draw_framebuffer, name_type(fbo), call);
+            case GL_READ_FRAMEBUFFER:
+                return _shadowed(_read_framebuffer, name_type(fbo), call);
+            case GL_FRAMEBUFFER:
+                if(_read_framebuffer == name_type(fbo)) {
+                    return _shadowed(_draw_framebuffer, name_type(fbo), [&] {
+                        auto result{call()};
+                        if(!result) {
+                            _read_framebuffer.reset();
+                        }
+                        return result;
+                    });
+                }
+                _draw_framebuffer.reset();
+                return _shadowed(_read_framebuffer, name_type(fbo), [&] {
+                    auto result{call()};
+                    if(result) {
+                        _draw_framebuffer = name_type(fbo);
+                    }
+                    return result;
+                });
+            default:
+                break;
+        }
+#endif
+        return _shadowed(_framebuffers[enum_type(tgt)], name_type(fbo), call);
+    }
+
+private:
+    template <typename Result>
+    static constexpr auto _elided_result(type_identity<Result>) noexcept
+      -> Result {
+        // the optionally-valid results are invalid when default constructed
+        if constexpr(std::is_constructible_v<Result, bool>) {
+            return Result{true};
+        } else {
+            return Result{};
+        }
+    }
+
+    template <typename Value, typename Call>
+    auto _shadowed(std::optional<Value>& current, Value value, Call call) {
+        using result_type = std::decay_t<decltype(call())>;
+        if(current == value) {
+            ++_elided_count;
+            return _elided_result(type_identity<result_type>{});
+        }
+        ++_issued_count;
+        result_type result{call()};
+        if(result) {
+            current = value;
+        } else {
+            // the state after a failed call is not known
+            current.reset();
+        }
+        return result;
+    }
+
+    const operations& _api;
+
+    std::uint64_t _issued_count{0U};
+    std::uint64_t _elided_count{0U};
+
+    flat_map<enum_type, std::optional<bool>> _capabilities;
+    flat_map<enum_type, std::optional<name_type>> _buffers;
+    flat_map<std::pair<enum_type, enum_type>, std::optional<name_type>>
+      _textures;
+    flat_map<enum_type, std::optional<name_type>> _renderbuffers;
+    flat_map<enum_type, std::optional<name_type>> _framebuffers;
+    std::optional<name_type> _draw_framebuffer;
+    std::optional<name_type> _read_framebuffer;
+    std::optional<enum_type> _active_unit;
+    std::optional<name_type> _program;
+    std::optional<name_type> _vertex_array;
+};
+//------------------------------------------------------------------------------
+/// @brief Alias for the default GL state cache instantiation.
+/// @ingroup gl_api_wrap
+using gl_state_cache = basic_gl_state_cache<gl_api_traits>;
+//------------------------------------------------------------------------------
+} // namespace eagine::oglp
+
+#endif // OGLPLUS_GL_API_STATE_CACHE_HPP
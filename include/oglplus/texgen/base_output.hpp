@@ -8,6 +8,7 @@
 #ifndef OGLPLUS_TEXGEN_BASE_OUTPUT_HPP
 #define OGLPLUS_TEXGEN_BASE_OUTPUT_HPP
 
+#include "cpu_eval.hpp"
 #include "interface.hpp"
 #include "param_format.hpp"
 #include <set>
@@ -62,6 +63,8 @@ public:
 
     bool render_parent(const render_params&) override;
 
+    bool cpu_evaluate(const cpu_sample_params&, cpu_sample_values&) override;
+
     std::intptr_t get_id() const noexcept;
 
     void append_id(std::ostream&, string_view);
@@ -24,6 +24,8 @@ public:
     slot_data_type value_type() override;
 
     std::ostream& definitions(std::ostream& out, compile_context& ctxt) override;
+
+    bool cpu_evaluate(const cpu_sample_params&, cpu_sample_values&) override;
 };
 
 class checker_node
@@ -47,6 +49,8 @@ public:
     slot_data_type value_type() override;
 
     std::ostream& definitions(std::ostream& out, compile_context& ctxt) override;
+
+    bool cpu_evaluate(const cpu_sample_params&, cpu_sample_values&) override;
 };
 
 using pixel_checker_node = single_output_node<pixel_checker_output>;
@@ -74,6 +74,14 @@ public:
         }
         return out << ")";
     }
+
+    bool
+    cpu_evaluate(const cpu_sample_params&, cpu_sample_values& r) override {
+        for(const auto i : integer_range(N)) {
+            r.c[std_size(i)] = cpu_fill(float(_coords[std_size(i)]));
+        }
+        return true;
+    }
 };
 
 } // namespace eagine::oglp::texgen
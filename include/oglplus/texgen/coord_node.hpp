@@ -33,6 +33,8 @@ public:
     slot_data_type value_type() override;
 
     std::ostream& definitions(std::ostream& out, compile_context& ctxt) override;
+
+    bool cpu_evaluate(const cpu_sample_params&, cpu_sample_values&) override;
 };
 
 class coord_node : public single_output_node<coord_output> {
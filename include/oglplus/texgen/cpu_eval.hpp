@@ -0,0 +1,150 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#ifndef OGLPLUS_TEXGEN_CPU_EVAL_HPP
+#define OGLPLUS_TEXGEN_CPU_EVAL_HPP
+
+#include "interface.hpp"
+#include <eagine/vect/data.hpp>
+#include <array>
+#include <cmath>
+
+namespace eagine::oglp::texgen {
+//------------------------------------------------------------------------------
+// The outputs are evaluated on the CPU for groups of cpu_lane_count samples
+// at once. Each component of the parameters and of the values is stored
+// in a separate (SIMD) vector, with one lane per sample.
+//------------------------------------------------------------------------------
+static constexpr const int cpu_lane_count = 4;
+
+using cpu_lanes = vect::data_t<float, cpu_lane_count, true>;
+//------------------------------------------------------------------------------
+// CPU counterpart of the (oglptg_nc, oglptg_vs, oglptg_vo) GLSL parameters.
+struct cpu_sample_params {
+    std::array<cpu_lanes, 3> norm_coord{};
+    std::array<cpu_lanes, 3> voxel_size{};
+    std::array<cpu_lanes, 3> voxel_offset{};
+};
+//------------------------------------------------------------------------------
+// Up to four value components for each of the evaluated samples.
+struct cpu_sample_values {
+    std::array<cpu_lanes, 4> c{};
+};
+//------------------------------------------------------------------------------
+static inline cpu_lanes cpu_fill(float v) noexcept {
+    cpu_lanes r{};
+    for(int l = 0; l < cpu_lane_count; ++l) {
+        r[l] = v;
+    }
+    return r;
+}
+//------------------------------------------------------------------------------
+template <typename Function>
+static inline cpu_lanes cpu_apply(cpu_lanes v, Function func) noexcept {
+    for(int l = 0; l < cpu_lane_count; ++l) {
+        v[l] = func(v[l]);
+    }
+    return v;
+}
+//------------------------------------------------------------------------------
+// Avoids the library call, the values with a magnitude of at least 2^23
+// have no fractional part and are returned as they are.
+static inline cpu_lanes cpu_floor(cpu_lanes v) noexcept {
+    return cpu_apply(v, [](float x) {
+        if(!(std::abs(x) < 8388608.f)) {
+            return x;
+        }
+        const auto t = float(static_cast<int>(x));
+        return t > x ? t - 1.f : t;
+    });
+}
+//------------------------------------------------------------------------------
+static inline cpu_lanes cpu_sqrt(cpu_lanes v) noexcept {
+    return cpu_apply(v, [](float x) { return std::sqrt(x); });
+}
+//------------------------------------------------------------------------------
+static inline cpu_lanes cpu_max(cpu_lanes v, float m) noexcept {
+    return cpu_apply(v, [m](float x) { return x < m ? m : x; });
+}
+//------------------------------------------------------------------------------
+// GLSL mod(x, y), which unlike std::fmod uses floor.
+static inline cpu_lanes cpu_mod(cpu_lanes x, float y) noexcept {
+    return x - cpu_floor(x / y) * y;
+}
+//------------------------------------------------------------------------------
+// Picks the lanes of a where the mask lanes are non-zero and of b elsewhere.
+static inline cpu_lanes
+cpu_select(cpu_lanes mask, cpu_lanes a, cpu_lanes b) noexcept {
+    for(int l = 0; l < cpu_lane_count; ++l) {
+        if(mask[l] == 0.f) {
+            a[l] = b[l];
+        }
+    }
+    return a;
+}
+//------------------------------------------------------------------------------
+static inline bool cpu_any(cpu_lanes mask) noexcept {
+    for(int l = 0; l < cpu_lane_count; ++l) {
+        if(mask[l] != 0.f) {
+            return true;
+        }
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+// The normalized sample coordinate (norm_sample_coord in the GLSL code).
+static inline cpu_lanes
+cpu_norm_sample_coord(const cpu_sample_params& p, std::size_t i) noexcept {
+    return p.norm_coord[i] + p.voxel_offset[i] * p.voxel_size[i];
+}
+//------------------------------------------------------------------------------
+// The parameters shifted by the specified number of voxels.
+static inline cpu_sample_params cpu_offset_voxels(
+  cpu_sample_params p,
+  float x,
+  float y,
+  float z) noexcept {
+    p.voxel_offset[0] += x;
+    p.voxel_offset[1] += y;
+    p.voxel_offset[2] += z;
+    return p;
+}
+//------------------------------------------------------------------------------
+// Mirrors the conversion_prefix and conversion_suffix in the GLSL code,
+// the components missing in the source value are set to pad.
+static inline void cpu_convert(
+  cpu_sample_values& v,
+  slot_data_type from,
+  slot_data_type to,
+  float pad = 0.f) noexcept {
+    if(from != to) {
+        const auto df = std_size(data_type_dims(from));
+        const auto dt = std_size(data_type_dims(to));
+        for(std::size_t i = df; i < dt; ++i) {
+            v.c[i] = cpu_fill(pad);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Evaluates an output connected to an input, converting its value the same
+// way the GLSL code does. Returns false if the output is not supported.
+static inline bool cpu_evaluate_as(
+  output_intf& output,
+  const cpu_sample_params& params,
+  slot_data_type to,
+  cpu_sample_values& result,
+  float pad = 0.f) {
+    if(output.cpu_evaluate(params, result)) {
+        cpu_convert(result, output.value_type(), to, pad);
+        return true;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine::oglp::texgen
+
+#endif // OGLPLUS_TEXGEN_CPU_EVAL_HPP
@@ -0,0 +1,92 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#ifndef OGLPLUS_TEXGEN_CPU_RENDERER_HPP
+#define OGLPLUS_TEXGEN_CPU_RENDERER_HPP
+
+#include "cpu_eval.hpp"
+#include "interface.hpp"
+#include <eagine/span.hpp>
+#include <eagine/valid_if/positive.hpp>
+#include <eagine/workshop.hpp>
+
+namespace eagine::oglp::texgen {
+
+// Evaluates the outputs of a node graph on the CPU, without a GL context.
+// The image is split into tiles, which are processed in parallel if a
+// workshop is used, the samples in a tile are evaluated in SIMD lane groups.
+// The values are the same as those written by the render_node, i.e. the
+// output converted to vec4, with rows going from the bottom to the top.
+class cpu_renderer {
+private:
+    int _width{1};
+    int _height{1};
+    int _depth{1};
+    int _tile_size{64};
+    workshop* _workers{nullptr};
+    span_size_t _max_threads{1};
+
+    struct _tile_rect {
+        int x, y, z, width, height;
+    };
+
+    _tile_rect _get_tile(span_size_t tile) const noexcept;
+
+    bool _render_tile(output_intf&, const _tile_rect&, span<float> values);
+
+    template <typename Store>
+    bool _render_tiles(output_intf&, const Store&);
+
+public:
+    cpu_renderer& set_dimensions(
+      const valid_if_positive<int>& width,
+      const valid_if_positive<int>& height,
+      const valid_if_positive<int>& depth);
+
+    cpu_renderer& set_dimensions(
+      const valid_if_positive<int>& width,
+      const valid_if_positive<int>& height) {
+        return set_dimensions(width, height, 1);
+    }
+
+    cpu_renderer& set_tile_size(const valid_if_positive<int>& size);
+
+    cpu_renderer& use_workers(workshop& workers, span_size_t max_threads);
+
+    int width() const noexcept {
+        return _width;
+    }
+
+    int height() const noexcept {
+        return _height;
+    }
+
+    int depth() const noexcept {
+        return _depth;
+    }
+
+    span_size_t tile_count() const noexcept;
+
+    span_size_t texel_count() const noexcept {
+        return span_size(_width) * _height * _depth;
+    }
+
+    // renders RGBA float values, dest must have 4 * texel_count elements
+    // returns false if some of the nodes cannot be evaluated on the CPU
+    bool render(output_intf& output, span<float> dest);
+
+    // renders the first channels components as normalized unsigned bytes
+    bool render(output_intf& output, span_size_t channels, span<byte> dest);
+};
+
+} // namespace eagine::oglp::texgen
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/texgen/cpu_renderer.inl>
+#endif
+
+#endif // OGLPLUS_TEXGEN_CPU_RENDERER_HPP
@@ -38,6 +38,8 @@ public:
 
     std::ostream& definitions(std::ostream& out, compile_context& ctxt) override;
 
+    bool cpu_evaluate(const cpu_sample_params&, cpu_sample_values&) override;
+
     std::ostream& expression(std::ostream& out, compile_context& ctxt) override;
 };
 
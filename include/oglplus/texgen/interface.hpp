@@ -26,6 +26,9 @@ struct input_intf;
 struct output_intf;
 struct node_intf;
 
+struct cpu_sample_params;
+struct cpu_sample_values;
+
 class compile_context_impl;
 
 class compile_context {
@@ -148,6 +151,9 @@ struct output_intf : interface<output_intf> {
     virtual void prepare_parent() = 0;
 
     virtual bool render_parent(const render_params&) = 0;
+
+    // evaluates the output on the CPU, returns false if not supported
+    virtual bool cpu_evaluate(const cpu_sample_params&, cpu_sample_values&) = 0;
 };
 
 bool connect_output_to_input(output_intf& output, input_intf& input);
@@ -0,0 +1,152 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef OGLPLUS_UTILS_IMAGE_CONTAINER_HPP
+#define OGLPLUS_UTILS_IMAGE_CONTAINER_HPP
+
+#include "image_container_hdr.hpp"
+#include "image_file.hpp"
+#include "image_mipmap.hpp"
+#include <eagine/chunked_compression.hpp>
+#include <eagine/file_contents.hpp>
+#include <eagine/memory/buffer.hpp>
+#include <eagine/string_span.hpp>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace eagine::oglp {
+//------------------------------------------------------------------------------
+// Read-only view of a texture image container, with multiple mip-map levels
+// and array layers. The container file is memory-mapped and the levels
+// stored without compression are used in-place, without copying.
+class texture_image_container {
+public:
+    texture_image_container(file_contents contents) noexcept;
+
+    // the data block must outlive the container
+    texture_image_container(memory::const_block data) noexcept
+      : _header{_validate(data)} {}
+
+    texture_image_container(string_view path)
+      : texture_image_container(file_contents(path, map_file_tag{})) {}
+
+    texture_image_container(const std::string& path)
+      : texture_image_container(string_view(path)) {}
+
+    auto is_valid() const noexcept -> bool {
+        return _header != nullptr;
+    }
+
+    explicit operator bool() const noexcept {
+        return is_valid();
+    }
+
+    auto level_count() const noexcept -> span_size_t {
+        return is_valid() ? _header->levels.size() : 0;
+    }
+
+    auto layer_count() const noexcept -> span_size_t {
+        return is_valid() ? _header->layers : 0;
+    }
+
+    auto dimensions(span_size_t index) const noexcept -> image_dimensions;
+
+    // indicates if the specified level is stored compressed
+    auto is_packed(span_size_t index) const noexcept -> bool {
+        return _level(index).packed != 0;
+    }
+
+    // the size of the stored (possibly compressed) level data
+    auto stored_size(span_size_t index) const noexcept -> span_size_t {
+        return _level(index).data.size();
+    }
+
+    // returns the image block of a level stored without compression,
+    // pointing directly into the container data
+    auto level(span_size_t index) const noexcept -> texture_image_block;
+
+    // returns the image block data of any level, the compressed levels are
+    // unpacked into the specified buffer, which must outlive the result,
+    // returns an empty block if the level cannot be unpacked
+    auto unpack_level(
+      span_size_t index,
+      chunked_data_compressor& compressor,
+      memory::buffer& buf) const -> memory::const_block;
+
+private:
+    static auto _validate(memory::const_block data) noexcept
+      -> const image_container_header*;
+
+    static auto _level_data(const image_container_level& entry) noexcept
+      -> memory::const_block {
+        return {entry.data.data().get(), entry.data.size()};
+    }
+
+    auto _level(span_size_t index) const noexcept
+      -> const image_container_level& {
+        EAGINE_ASSERT(is_valid() && (index >= 0) && (index < level_count()));
+        return _header->levels[index];
+    }
+
+    file_contents _contents;
+    const image_container_header* _header{nullptr};
+};
+//------------------------------------------------------------------------------
+// Builds the levels of a texture image container in memory and writes them
+// into an output stream, optionally compressing the individual levels.
+class texture_image_container_builder {
+public:
+    // the width, height, depth (number of layers), channels and the format
+    // are taken from the specified header
+    texture_image_container_builder(const image_data_header& base);
+
+    // the pixels of the base level, to be filled by the caller
+    auto base_pixels() noexcept -> span<byte> {
+        return _pixels(0);
+    }
+
+    auto level_count() const noexcept -> span_size_t {
+        return span_size(_levels.size());
+    }
+
+    auto level(span_size_t index) const noexcept -> texture_image_block;
+
+    // generates the mip-map levels following the base level, up to the
+    // specified total number of levels, images with other than unsigned
+    // byte components are not supported
+    auto add_mipmaps(image_mipmap_generator& gen, span_size_t max_levels)
+      -> bool;
+
+    void write(std::ostream& output) const;
+
+    // the levels which do not get smaller are stored uncompressed
+    void write(
+      std::ostream& output,
+      chunked_data_compressor& compressor,
+      data_compression_level level) const;
+
+private:
+    auto _add_level(gl_types::sizei_type w, gl_types::sizei_type h)
+      -> span<byte>;
+
+    auto _pixels(span_size_t index) noexcept -> span<byte>;
+
+    void _write(std::ostream&, const std::vector<memory::const_block>&) const;
+
+    image_data_header _base;
+    std::vector<memory::buffer> _levels;
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::oglp
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/utils/image_container.inl>
+#endif
+
+#endif // OGLPLUS_UTILS_IMAGE_CONTAINER_HPP
@@ -0,0 +1,44 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef OGLPLUS_UTILS_IMAGE_CONTAINER_HDR_HPP
+#define OGLPLUS_UTILS_IMAGE_CONTAINER_HDR_HPP
+
+#include "image_file_hdr.hpp"
+#include <eagine/types.hpp>
+#include <cstdint>
+
+namespace eagine::oglp {
+
+// The data of each level is a complete texture image block, i.e. a padded
+// image_data_header followed by the pixels. If the level is packed then the
+// data is a chunked compressed container, which unpacks into such block.
+struct image_container_level {
+    gl_types::sizei_type width{0}, height{0}, depth{0};
+    std::uint32_t packed{0};
+    std::int64_t unpacked_size{0};
+
+    memory::offset_span<const byte> data{};
+};
+
+// The levels are mip-map levels with decreasing width and height, the depth
+// of all levels is the number of layers of an array texture.
+struct image_container_header {
+    file_magic_number<'o', 'g', 'l', '+', 't', 'e', 'x', 'c'> magic;
+    gl_types::sizei_type width{0}, height{0}, layers{0}, channels{0};
+    gl_types::enum_type format{0}, internal_format{0};
+    gl_types::enum_type data_type{0};
+
+    memory::offset_span<const image_container_level> levels{};
+
+    constexpr image_container_header() noexcept = default;
+};
+
+} // namespace eagine::oglp
+
+#endif // OGLPLUS_UTILS_IMAGE_CONTAINER_HDR_HPP
@@ -0,0 +1,104 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef OGLPLUS_UTILS_IMAGE_MIPMAP_HPP
+#define OGLPLUS_UTILS_IMAGE_MIPMAP_HPP
+
+#include "../config/basic.hpp"
+#include "../gl_api/config.hpp"
+#include <eagine/span.hpp>
+#include <eagine/types.hpp>
+#include <eagine/vect/data.hpp>
+#include <eagine/workshop.hpp>
+#include <vector>
+
+namespace eagine::oglp {
+//------------------------------------------------------------------------------
+enum class image_mipmap_filter { box, kaiser };
+//------------------------------------------------------------------------------
+// Generates the mip-map levels of images with unsigned byte components
+// on the CPU. The filters are separable, the components of a pixel are
+// processed together in a SIMD vector and the rows of the generated level
+// are processed in parallel if a workshop is used.
+// Images with depth greater than one are treated as arrays of layers,
+// which are filtered independently.
+class image_mipmap_generator {
+public:
+    auto set_filter(image_mipmap_filter filter) noexcept
+      -> image_mipmap_generator& {
+        _filter = filter;
+        return *this;
+    }
+
+    auto filter() const noexcept -> image_mipmap_filter {
+        return _filter;
+    }
+
+    auto use_workers(workshop& workers, span_size_t max_threads)
+      -> image_mipmap_generator&;
+
+    // the size of a level in one of the filtered dimensions
+    static auto
+    level_size(gl_types::sizei_type size, span_size_t level) noexcept
+      -> gl_types::sizei_type {
+        for(; (level > 0) && (size > 1); --level) {
+            size /= 2;
+        }
+        return size;
+    }
+
+    // the number of levels of the full mip-map chain, including the base
+    static auto level_count(
+      gl_types::sizei_type width,
+      gl_types::sizei_type height) noexcept -> span_size_t;
+
+    // downsamples the source level into the next one, the destination
+    // must have the size of the level following the source level
+    void downsample(
+      span<const byte> src,
+      gl_types::sizei_type width,
+      gl_types::sizei_type height,
+      gl_types::sizei_type layers,
+      gl_types::sizei_type channels,
+      span<byte> dst);
+
+private:
+    using _pixel_t = vect::data_t<float, 4, true>;
+
+    // filter weights for the source pixels around a destination pixel
+    struct _taps {
+        int first{0};
+        std::vector<float> weights;
+    };
+
+    auto _make_taps(int factor) const -> _taps;
+
+    void _downsample_row(
+      const byte* src,
+      gl_types::sizei_type src_width,
+      gl_types::sizei_type src_height,
+      gl_types::sizei_type channels,
+      int dst_y,
+      gl_types::sizei_type dst_width,
+      const _taps& htaps,
+      const _taps& vtaps,
+      byte* dst,
+      std::vector<_pixel_t>& temp) const noexcept;
+
+    image_mipmap_filter _filter{image_mipmap_filter::box};
+    workshop* _workers{nullptr};
+    span_size_t _max_threads{1};
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::oglp
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/utils/image_mipmap.inl>
+#endif
+
+#endif // OGLPLUS_UTILS_IMAGE_MIPMAP_HPP
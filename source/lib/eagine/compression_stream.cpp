@@ -0,0 +1,15 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+// clang-format off
+#include "prologue.inl"
+
+#include "implement.inl"
+#include <eagine/compression_stream.hpp>
+#include "epilogue.inl"
+// clang-format on
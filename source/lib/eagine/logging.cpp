@@ -17,6 +17,9 @@
 
 #include "implement.inl"
 #include <eagine/logging/entry.hpp>
+// entry.hpp was already included above, without the implementation
+#include <eagine/logging/entry.inl>
+#include <eagine/logging/filter.hpp>
 #include <eagine/logging/root_logger.hpp>
 #include "epilogue.inl"
 // clang-format on
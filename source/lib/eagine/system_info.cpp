@@ -8,6 +8,7 @@
 
 // clang-format off
 #include "prologue.inl"
+#include <eagine/application_config.hpp>
 #include <eagine/main_ctx.hpp>
 #include <eagine/value_tree/filesystem.hpp>
 
@@ -19,6 +19,7 @@
 #include <eagine/message_bus/service/shutdown.hpp>
 #include <eagine/signal_switch.hpp>
 #include <eagine/watchdog.hpp>
+#include <algorithm>
 
 namespace eagine {
 //------------------------------------------------------------------------------
@@ -129,6 +130,10 @@ auto main(main_ctx& ctx) -> int {
     int idle_streak{0};
     int max_idle_streak{0};
 
+    auto max_idle_wait = std::chrono::milliseconds(50);
+    ctx.config().fetch("msg_bus.bridge.max_idle_wait", max_idle_wait);
+    auto wakeup{std::make_shared<msgbus::wakeup_event>()};
+
     msgbus::endpoint node_endpoint{EAGINE_ID(BrdgNodeEp), ctx};
     node_endpoint.add_ca_certificate_pem(ca_certificate_pem(ctx));
     ctx.bus().setup_connectors(node_endpoint);
@@ -150,8 +155,12 @@ auto main(main_ctx& ctx) -> int {
             } else {
                 ++cycles_idle;
                 max_idle_streak = math::maximum(max_idle_streak, ++idle_streak);
-                std::this_thread::sleep_for(
-                  std::chrono::milliseconds(math::minimum(idle_streak / 8, 8)));
+                bridge.prepare_wait(wakeup);
+                node_endpoint.prepare_wait(wakeup);
+                wakeup->wait_for(
+                  max_idle_wait,
+                  std::min(
+                    bridge.next_deadline(), node_endpoint.next_deadline()));
             }
             wd.notify_alive();
         }
@@ -16,7 +16,6 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
-#include <thread>
 
 namespace eagine {
 namespace msgbus {
@@ -101,9 +100,12 @@ auto main(main_ctx& ctx) -> int {
         }
     }
 
+    auto max_idle_wait = std::chrono::milliseconds(50);
+    ctx.config().fetch("msg_bus.pingable.max_idle_wait", max_idle_wait);
+
     while(!the_pingable.is_done()) {
         if(!the_pingable.update_and_process_all()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            the_pingable.bus_node().wait_for(max_idle_wait);
         }
     }
 
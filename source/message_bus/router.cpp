@@ -15,11 +15,14 @@
 #include <eagine/message_bus/endpoint.hpp>
 #include <eagine/message_bus/router.hpp>
 #include <eagine/message_bus/service/common_info.hpp>
+#include <eagine/message_bus/service/log_control.hpp>
 #include <eagine/message_bus/service/ping_pong.hpp>
+#include <eagine/message_bus/service/resource_usage.hpp>
 #include <eagine/message_bus/service/shutdown.hpp>
 #include <eagine/message_bus/service/system_info.hpp>
 #include <eagine/signal_switch.hpp>
 #include <eagine/watchdog.hpp>
+#include <algorithm>
 #include <cstdint>
 
 namespace eagine {
@@ -28,8 +31,10 @@ namespace msgbus {
 using router_node_base = service_composition<require_services<
   subscriber,
   shutdown_target,
+  log_control_target,
   pingable,
   system_info_provider,
+  resource_usage_provider,
   common_info_providers>>;
 //------------------------------------------------------------------------------
 class router_node
@@ -138,6 +143,10 @@ auto main(main_ctx& ctx) -> int {
     int idle_streak{0};
     int max_idle_streak{0};
 
+    auto max_idle_wait = std::chrono::milliseconds(50);
+    ctx.config().fetch("msg_bus.router.max_idle_wait", max_idle_wait);
+    auto wakeup{std::make_shared<msgbus::wakeup_event>()};
+
     msgbus::endpoint node_endpoint{EAGINE_ID(RutrNodeEp), ctx};
     node_endpoint.add_certificate_pem(msgbus_router_certificate_pem(ctx));
     node_endpoint.add_connection(std::move(node_connection));
@@ -158,8 +167,12 @@ auto main(main_ctx& ctx) -> int {
             } else {
                 ++cycles_idle;
                 max_idle_streak = math::maximum(max_idle_streak, ++idle_streak);
-                std::this_thread::sleep_for(
-                  std::chrono::milliseconds(math::minimum(idle_streak / 8, 8)));
+                router.prepare_wait(wakeup);
+                node_endpoint.prepare_wait(wakeup);
+                wakeup->wait_for(
+                  max_idle_wait,
+                  std::min(
+                    router.next_deadline(), node_endpoint.next_deadline()));
             }
             wd.notify_alive();
         }
@@ -14,9 +14,11 @@
 #include <eagine/message_bus/service/ping_pong.hpp>
 #include <eagine/message_bus/service/shutdown.hpp>
 #include <eagine/message_bus/service/sudoku.hpp>
+#include <eagine/message_bus/wakeup.hpp>
 #include <eagine/signal_switch.hpp>
 #include <eagine/watchdog.hpp>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -79,9 +81,17 @@ auto main(main_ctx& ctx) -> int {
     auto max_idle_time = std::chrono::seconds(30);
     ctx.config().fetch("msg_bus.sudoku.helper.max_idle_time", max_idle_time);
 
+    // the helper endpoints share the worker threads searching the boards
     auto helper_count = extract_or(
-      ctx.config().get<span_size_t>("msg_bus.sudoku.helper.count"),
+      ctx.config().get<span_size_t>("msg_bus.sudoku.helper.count"), 1);
+    const auto thread_count = extract_or(
+      ctx.config().get<span_size_t>("msg_bus.sudoku.helper.threads"),
       extract_or(ctx.system().cpu_concurrent_threads(), 4));
+    const auto threads_per_helper = math::maximum(
+      thread_count / math::maximum(helper_count, span_size(1)), span_size(1));
+
+    auto max_idle_wait = std::chrono::milliseconds(100);
+    ctx.config().fetch("msg_bus.sudoku.helper.max_idle_wait", max_idle_wait);
 
     std::mutex helper_mutex;
     std::condition_variable helper_cond;
@@ -94,6 +104,7 @@ auto main(main_ctx& ctx) -> int {
         std::unique_lock init_lock{helper_mutex};
         auto& helper_node =
           the_reg.emplace<msgbus::sudoku_helper_node>(EAGINE_ID(SdkHlpEndp));
+        helper_node.use_workers(ctx.workers(), threads_per_helper);
         remaining--;
         helper_cond.notify_all();
         init_lock.unlock();
@@ -105,6 +116,7 @@ auto main(main_ctx& ctx) -> int {
         }
 
         int idle_streak = 0;
+        auto wakeup{std::make_shared<msgbus::wakeup_event>()};
         auto keep_running = [&]() {
             if(idle_streak > 5) {
                 std::unique_lock check_lock{helper_mutex};
@@ -122,8 +134,10 @@ auto main(main_ctx& ctx) -> int {
             if(helper_node.update_and_process_all()) {
                 idle_streak = 0;
             } else {
-                std::this_thread::sleep_for(
-                  std::chrono::milliseconds(math::minimum(++idle_streak, 100)));
+                ++idle_streak;
+                helper_node.bus_node().prepare_wait(wakeup);
+                helper_node.prepare_wait(wakeup);
+                wakeup->wait_for(max_idle_wait);
             }
         }
     };
@@ -10,9 +10,14 @@
 #include <eagine/main_fwd.hpp>
 #include <eagine/program_args.hpp>
 #include <eagine/valid_if/positive.hpp>
+#include <eagine/workshop.hpp>
 #include <oglplus/gl.hpp>
 #include <oglplus/utils/image_file_io.hpp>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
+#include <thread>
+#include <vector>
 
 namespace eagine {
 //------------------------------------------------------------------------------
@@ -33,6 +38,8 @@ struct options {
     _int_param_t rep_x;
     _int_param_t rep_y;
     _int_param_t rep_z;
+    _int_param_t threads;
+    program_option verbosity;
 
     program_parameters all;
 
@@ -44,7 +51,21 @@ struct options {
       , rep_x("-x", "--x-repeat", 8)
       , rep_y("-y", "--y-repeat", 8)
       , rep_z("-z", "--z-repeat", 8)
-      , all(output_path, width, height, depth, rep_x, rep_y, rep_z) {
+      , threads(
+          "-t",
+          "--threads",
+          GLsizei(std::max(std::thread::hardware_concurrency(), 1U)))
+      , verbosity("-v", "--verbose")
+      , all(
+          output_path,
+          width,
+          height,
+          depth,
+          rep_x,
+          rep_y,
+          rep_z,
+          threads,
+          verbosity) {
         output_path.description(
           "Output file path, or '-' for standard output.");
         width.description("Output image width in pixels.");
@@ -53,6 +74,8 @@ struct options {
         rep_x.description("Pattern repeat along the X axis.");
         rep_y.description("Pattern repeat along the Y axis.");
         rep_z.description("Pattern repeat along the Z axis.");
+        threads.description("Number of generating threads.");
+        verbosity.description("Print the output size and throughput.");
     }
 
     void print_usage(std::ostream& log) {
@@ -83,29 +106,48 @@ void write_output(std::ostream& output, const options& opts) {
     }
     const GLsizei channels = has_r3g3b2 ? 1 : 3;
 
-    const auto size = span_size(
-      opts.width.value() * opts.height.value() * opts.depth.value() * channels);
-
-    oglp::write_and_pad_texture_image_data_header(output, hdr, size);
+    const auto start = std::chrono::steady_clock::now();
+    const auto row_size = span_size(hdr.width) * channels;
+    const auto row_count = span_size(hdr.height) * hdr.depth;
+    std::vector<byte> texels(std_size(row_size * row_count));
 
     const GLsizei fd = opts.depth.value() / opts.rep_z.value();
     const GLsizei fh = opts.height.value() / opts.rep_y.value();
     const GLsizei fw = opts.width.value() / opts.rep_x.value();
 
-    for(GLsizei z = 0; z < hdr.depth; ++z) {
-        const GLsizei fz = (fd == 0 ? 0 : z / fd);
-        for(GLsizei y = 0; y < hdr.height; ++y) {
-            const GLsizei fy = (fh == 0 ? 0 : y / fh);
-            for(GLsizei x = 0; x < hdr.width; ++x) {
-                const GLsizei fx = (fw == 0 ? 0 : x / fw);
-                const bool black = ((fx % 2) + (fy % 2) + (fz % 2)) % 2 == 0;
-                const char outb = char(black ? 0x00 : 0xFF);
-
-                for(GLsizei c = 0; c < channels; ++c) {
-                    output.put(outb);
-                }
-            }
-        }
+    workshop workers;
+    workers.parallel_for(
+      row_count,
+      opts.threads.value(),
+      [&](span_size_t, span_size_t begin, span_size_t end) {
+          for(span_size_t r = begin; r < end; ++r) {
+              const auto y = GLsizei(r % hdr.height);
+              const auto z = GLsizei(r / hdr.height);
+              const GLsizei fz = (fd == 0 ? 0 : z / fd);
+              const GLsizei fy = (fh == 0 ? 0 : y / fh);
+              auto* dst = texels.data() + r * row_size;
+              for(GLsizei x = 0; x < hdr.width; ++x) {
+                  const GLsizei fx = (fw == 0 ? 0 : x / fw);
+                  const bool black =
+                    ((fx % 2) + (fy % 2) + (fz % 2)) % 2 == 0;
+                  const byte outb = black ? 0x00 : 0xFF;
+
+                  for(GLsizei c = 0; c < channels; ++c) {
+                      *dst++ = outb;
+                  }
+              }
+          }
+      });
+    oglp::write_texture_image_data(output, hdr, view(texels));
+
+    if(opts.verbosity.value() > 0) {
+        const std::chrono::duration<float> seconds{
+          std::chrono::steady_clock::now() - start};
+        const auto mbytes = float(texels.size()) / (1024.f * 1024.f);
+        std::cerr << std::fixed << std::setprecision(2) << mbytes << " MB in "
+                  << seconds.count() * 1000.f << " ms, "
+                  << mbytes / seconds.count() << " MB/s, "
+                  << opts.threads.value() << " thread(s)" << std::endl;
     }
 }
 //------------------------------------------------------------------------------
@@ -122,7 +164,8 @@ auto main(main_ctx& ctx) -> int {
         if(are_equal(opts.output_path.value(), string_view("-"))) {
             write_output(std::cout, opts);
         } else {
-            std::ofstream output_file(c_str(opts.output_path.value()));
+            std::ofstream output_file(
+              c_str(opts.output_path.value()), std::ios::binary);
             write_output(output_file, opts);
         }
     } catch(const std::exception& err) {
@@ -0,0 +1,348 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#include <eagine/chunked_compression.hpp>
+#include <eagine/main_ctx.hpp>
+#include <eagine/main_fwd.hpp>
+#include <eagine/program_args.hpp>
+#include <eagine/valid_if/positive.hpp>
+#include <eagine/workshop.hpp>
+#include <oglplus/gl.hpp>
+#include <oglplus/utils/image_container.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+struct options {
+    using _str_param_t = program_parameter<string_view>;
+    using _int_param_t = program_parameter<valid_if_positive<GLsizei>>;
+    using _opt_param_t = program_option;
+
+    _str_param_t input_path;
+    _str_param_t output_path;
+    _str_param_t filter;
+    _int_param_t levels;
+    _int_param_t threads;
+    _opt_param_t compress;
+    _opt_param_t benchmark;
+    _int_param_t max_size;
+
+    program_parameters all;
+
+    options()
+      : input_path("-i", "--input", "a.oglptex")
+      , output_path("-o", "--output", "a.oglptexc")
+      , filter("-f", "--filter", "box")
+      , levels("-l", "--levels", 32)
+      , threads(
+          "-t",
+          "--threads",
+          GLsizei(std::max(std::thread::hardware_concurrency(), 1U)))
+      , compress("-z", "--compress")
+      , benchmark("-b", "--benchmark")
+      , max_size("-s", "--max-size", 8192)
+      , all(
+          input_path,
+          output_path,
+          filter,
+          levels,
+          threads,
+          compress,
+          benchmark,
+          max_size) {
+        input_path.description(
+          "Input texture image file, written by one of the bake tools.");
+        output_path.description(
+          "Output file path, or '-' for standard output.");
+        filter.description("Mip-map filter, either 'box' or 'kaiser'.");
+        levels.description("Maximum number of mip-map levels.");
+        threads.description("Number of mip-map and compression threads.");
+        compress.description("Compress the individual levels.");
+        benchmark.description(
+          "Measure the bake time and load latency of generated images "
+          "of increasing size, without writing the output.");
+        max_size.description("Size of the largest benchmarked image.");
+    }
+
+    void print_usage(std::ostream& log) {
+        all.print_usage(log, "bake_image_container");
+    }
+
+    auto check(std::ostream& log) -> bool {
+        if(!all.validate(log)) {
+            return false;
+        }
+        if(
+          !are_equal(filter.value(), string_view("box")) &&
+          !are_equal(filter.value(), string_view("kaiser"))) {
+            log << "Invalid filter '" << filter.value() << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    auto parse(program_arg& arg, std::ostream& log) -> bool {
+        return all.parse(arg, log);
+    }
+
+    auto mipmap_filter() const -> oglp::image_mipmap_filter {
+        return are_equal(filter.value(), string_view("kaiser"))
+                 ? oglp::image_mipmap_filter::kaiser
+                 : oglp::image_mipmap_filter::box;
+    }
+};
+//------------------------------------------------------------------------------
+auto make_builder(const oglp::texture_image_block& image)
+  -> oglp::texture_image_container_builder {
+    const auto spec = image.spec();
+    oglp::image_data_header hdr(
+      spec.width(), spec.height(), spec.depth(), spec.channels());
+    hdr.format = GLenum(spec.format());
+    hdr.internal_format = GLenum(spec.internal_format());
+    hdr.data_type = GLenum(spec.type());
+
+    oglp::texture_image_container_builder builder(hdr);
+    copy(spec.data(), builder.base_pixels());
+    return builder;
+}
+//------------------------------------------------------------------------------
+void write_builder(
+  std::ostream& output,
+  const oglp::texture_image_container_builder& builder,
+  const options& opts,
+  workshop& workers) {
+    if(opts.compress.value() > 0) {
+        chunked_data_compressor compressor{workers, opts.threads.value()};
+        builder.write(output, compressor, data_compression_level::normal);
+    } else {
+        builder.write(output);
+    }
+}
+//------------------------------------------------------------------------------
+void write_output(std::ostream& output, const options& opts) {
+    const oglp::texture_image_file input(opts.input_path.value().to_string());
+    if(!input.is_valid()) {
+        std::cerr << "Invalid input texture image file '"
+                  << opts.input_path.value() << "'" << std::endl;
+        return;
+    }
+
+    workshop workers;
+    oglp::image_mipmap_generator gen;
+    gen.set_filter(opts.mipmap_filter())
+      .use_workers(workers, opts.threads.value());
+
+    auto builder = make_builder(input);
+    if(!builder.add_mipmaps(gen, opts.levels.value())) {
+        std::cerr << "Mip-maps are generated only for images "
+                     "with unsigned byte components"
+                  << std::endl;
+    }
+    write_builder(output, builder, opts, workers);
+}
+//------------------------------------------------------------------------------
+// The benchmark images have smooth gradients with some noise, so that
+// the compression has some, but not too much work.
+auto make_benchmark_builder(GLsizei size)
+  -> oglp::texture_image_container_builder {
+    oglp::image_data_header hdr(size, size, 1, 4);
+    hdr.format = GL_RGBA;
+    hdr.internal_format = GL_RGBA8;
+    hdr.data_type = GL_UNSIGNED_BYTE;
+
+    oglp::texture_image_container_builder builder(hdr);
+    auto pixels = builder.base_pixels();
+    std::uint32_t noise = 12345U;
+    span_size_t k = 0;
+    for(GLsizei y = 0; y < size; ++y) {
+        for(GLsizei x = 0; x < size; ++x) {
+            noise = noise * 1664525U + 1013904223U;
+            pixels[k++] = byte((x * 256) / size);
+            pixels[k++] = byte((y * 256) / size);
+            pixels[k++] = byte(((x + y) * 128) / size + (noise >> 29U));
+            pixels[k++] = byte(0xFF);
+        }
+    }
+    return builder;
+}
+//------------------------------------------------------------------------------
+template <typename Function>
+auto measure_ms(Function func) -> float {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<float, std::milli> ms{
+      std::chrono::steady_clock::now() - start};
+    return ms.count();
+}
+//------------------------------------------------------------------------------
+void print_measurement(const char* what, float ms, span_size_t bytes = 0) {
+    std::cout << "  " << std::setw(24) << std::left << what
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << ms << " ms";
+    if(bytes > 0) {
+        std::cout << std::setw(10) << float(bytes) / (1024.f * 1024.f)
+                  << " MiB" << std::setw(12)
+                  << float(bytes) / (1024.f * 1024.f) / (ms / 1000.f)
+                  << " MiB/s";
+    }
+    std::cout << std::endl;
+}
+//------------------------------------------------------------------------------
+void run_benchmark(GLsizei size, const options& opts, workshop& workers) {
+    std::cout << size << "x" << size << " RGBA, " << opts.threads.value()
+              << " thread(s), " << opts.filter.value() << " filter"
+              << std::endl;
+
+    auto builder = make_benchmark_builder(size);
+    oglp::image_mipmap_generator gen;
+    gen.set_filter(opts.mipmap_filter())
+      .use_workers(workers, opts.threads.value());
+    print_measurement("mip-map generation", measure_ms([&]() {
+                          builder.add_mipmaps(gen, opts.levels.value());
+                      }));
+
+    const auto path = std::filesystem::temp_directory_path() /
+                      "oglplus_bake_image_container.oglptexc";
+    chunked_data_compressor compressor{workers, opts.threads.value()};
+
+    for(bool packed : {false, true}) {
+        const auto bake_ms = measure_ms([&]() {
+            std::ofstream output(path, std::ios::binary);
+            if(packed) {
+                builder.write(
+                  output, compressor, data_compression_level::normal);
+            } else {
+                builder.write(output);
+            }
+        });
+        const auto file_size = span_size(std::filesystem::file_size(path));
+        print_measurement(
+          packed ? "write compressed" : "write uncompressed",
+          bake_ms,
+          file_size);
+
+        // time until the base level can be handed over to the GL
+        memory::buffer unpacked;
+        span_size_t base_size = 0;
+        const auto base_ms = measure_ms([&]() {
+            const oglp::texture_image_container container{path.string()};
+            const auto level = container.unpack_level(0, compressor, unpacked);
+            if(!level.empty()) {
+                const oglp::texture_image_block image{level};
+                base_size = image.pixel_data().data().size();
+            }
+        });
+        print_measurement(
+          packed ? "load base (compressed)" : "load base (mapped)",
+          base_ms,
+          base_size);
+
+        // time until all the levels were accessed
+        span_size_t total_size = 0;
+        unsigned checksum = 0U;
+        const auto all_ms = measure_ms([&]() {
+            const oglp::texture_image_container container{path.string()};
+            for(span_size_t l = 0; l < container.level_count(); ++l) {
+                const auto level =
+                  container.unpack_level(l, compressor, unpacked);
+                if(level.empty()) {
+                    continue;
+                }
+                const oglp::texture_image_block image{level};
+                const auto data = image.pixel_data().data();
+                for(span_size_t i = 0; i < data.size(); i += 4096) {
+                    checksum += data[i];
+                }
+                total_size += data.size();
+            }
+        });
+        print_measurement(
+          packed ? "load all (compressed)" : "load all (mapped)",
+          all_ms,
+          total_size);
+        if(checksum == 0U) {
+            std::cout << "  (blank image)" << std::endl;
+        }
+    }
+    std::filesystem::remove(path);
+}
+//------------------------------------------------------------------------------
+void run_benchmarks(const options& opts) {
+    workshop workers;
+    for(GLsizei size = 1024; size <= opts.max_size.value(); size *= 2) {
+        run_benchmark(size, opts, workers);
+    }
+}
+//------------------------------------------------------------------------------
+auto parse_options(const program_args& args, options& opts) -> int;
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    try {
+        options opts;
+
+        if(int err = parse_options(ctx.args(), opts)) {
+            return err;
+        }
+
+        if(opts.benchmark.value() > 0) {
+            run_benchmarks(opts);
+        } else if(are_equal(opts.output_path.value(), string_view("-"))) {
+            write_output(std::cout, opts);
+        } else {
+            std::ofstream output_file(
+              c_str(opts.output_path.value()), std::ios::binary);
+            write_output(output_file, opts);
+        }
+    } catch(const std::exception& err) {
+        std::cerr << "error: " << err.what() << std::endl;
+    }
+    return 0;
+}
+//------------------------------------------------------------------------------
+auto parse_argument(program_arg& a, options& opts) -> bool {
+    if(!opts.parse(a, std::cerr)) {
+        std::cerr << "Failed to parse argument '" << a.get() << "'"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+auto parse_options(const program_args& args, options& opts) -> int {
+
+    for(program_arg a = args.first(); a; a = a.next()) {
+        if(a.is_help_arg()) {
+            opts.print_usage(std::cout);
+            return 1;
+        } else if(!parse_argument(a, opts)) {
+            opts.print_usage(std::cerr);
+            return 2;
+        }
+    }
+
+    if(!opts.check(std::cerr)) {
+        opts.print_usage(std::cerr);
+        return 3;
+    }
+
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+auto main(int argc, const char** argv) -> int {
+    eagine::main_ctx_options options;
+    options.app_id = EAGINE_ID(BakeTxCntr);
+    options.logger_opts.default_no_log = true;
+    return eagine::main_impl(argc, argv, options);
+}
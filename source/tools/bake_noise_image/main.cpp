@@ -10,11 +10,16 @@
 #include <eagine/main_fwd.hpp>
 #include <eagine/program_args.hpp>
 #include <eagine/valid_if/positive.hpp>
+#include <eagine/workshop.hpp>
 #include <oglplus/gl.hpp>
 #include <oglplus/utils/image_file_io.hpp>
-#include <climits>
+#include <chrono>
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
 #include <random>
+#include <thread>
+#include <vector>
 
 namespace eagine {
 //------------------------------------------------------------------------------
@@ -23,6 +28,7 @@ struct options {
     using _pos_int_t = valid_if_positive<GLsizei>;
     using _int_param_t = program_parameter<_pos_int_t>;
     using _int_alias_t = program_parameter_alias<_pos_int_t>;
+    using _seed_param_t = program_parameter<std::uint32_t>;
     using _opt_param_t = program_option;
 
     _str_param_t output_path;
@@ -31,6 +37,8 @@ struct options {
     _int_param_t width;
     _int_param_t height;
     _int_param_t depth;
+    _int_param_t threads;
+    _seed_param_t seed;
     _opt_param_t verbosity;
 
     program_parameters all;
@@ -42,8 +50,21 @@ struct options {
       , width("-w", "--width", 256)
       , height("-h", "--height", 256)
       , depth("-d", "--depth", 1)
+      , threads(
+          "-t",
+          "--threads",
+          GLsizei(std::max(std::thread::hardware_concurrency(), 1U)))
+      , seed("-s", "--seed", std::random_device{}())
       , verbosity("-v", "--verbose")
-      , all(output_path, components, width, height, depth, verbosity) {}
+      , all(
+          output_path,
+          components,
+          width,
+          height,
+          depth,
+          threads,
+          seed,
+          verbosity) {}
 
     void print_usage(std::ostream& log) {
         log << "bake_noise_image options" << std::endl;
@@ -62,6 +83,12 @@ struct options {
         log << "   -w|--width N: Output image width." << std::endl;
         log << "   -h|--height N: Output image height." << std::endl;
         log << "   -d|--depth N: Output image depth." << std::endl;
+        log << "   -t|--threads N: Number of generating threads." << std::endl;
+        log << "   -s|--seed N: Random seed, the same seed gives the same "
+               "output regardless of the number of threads."
+            << std::endl;
+        log << "   -v|--verbose: Print the output size and throughput."
+            << std::endl;
     }
 
     auto check(std::ostream& log) const -> bool {
@@ -79,7 +106,8 @@ struct options {
                a.parse_param(components, cmpbytes, log) ||
                a.parse_param(format, fmtnames, cmpbytes, log) ||
                a.parse_param(width, log) || a.parse_param(height, log) ||
-               a.parse_param(depth, log) || a.parse_param(verbosity, log);
+               a.parse_param(depth, log) || a.parse_param(threads, log) ||
+               a.parse_param(seed, log) || a.parse_param(verbosity, log);
     }
 };
 //------------------------------------------------------------------------------
@@ -107,19 +135,46 @@ void write_output(std::ostream& output, const options& opts) {
 
     hdr.data_type = GL_UNSIGNED_BYTE;
 
-    const auto size = span_size(
-      opts.width.value() * opts.height.value() * opts.depth.value() *
-      opts.components.value());
-
-    oglp::write_and_pad_texture_image_data_header(output, hdr, size);
-
-    const unsigned mask = ((1U << unsigned(CHAR_BIT)) - 1U);
-
-    std::random_device rd;
-    std::independent_bits_engine<std::mt19937, CHAR_BIT, unsigned> ibe(rd());
-
-    for(span_size_t i = 0; i < size; ++i) {
-        output.put(char(ibe() & mask));
+    const auto start = std::chrono::steady_clock::now();
+    const auto row_size =
+      span_size(opts.width.value()) * opts.components.value();
+    const auto row_count =
+      span_size(opts.height.value()) * opts.depth.value();
+    std::vector<byte> texels(std_size(row_size * row_count));
+
+    // each row has its own generator seeded by the row index,
+    // so the output does not depend on how the rows are split
+    workshop workers;
+    workers.parallel_for(
+      row_count,
+      opts.threads.value(),
+      [&](span_size_t, span_size_t begin, span_size_t end) {
+          for(span_size_t r = begin; r < end; ++r) {
+              std::seed_seq seq{
+                opts.seed.value(),
+                std::uint32_t(r % opts.height.value()),
+                std::uint32_t(r / opts.height.value())};
+              std::mt19937 engine(seq);
+              auto* dst = texels.data() + r * row_size;
+              for(span_size_t i = 0; i < row_size; i += 4) {
+                  auto bits = engine();
+                  for(span_size_t b = i; b < std::min(i + 4, row_size); ++b) {
+                      dst[b] = byte(bits & 0xFFU);
+                      bits >>= 8U;
+                  }
+              }
+          }
+      });
+    oglp::write_texture_image_data(output, hdr, view(texels));
+
+    if(opts.verbosity.value() > 0) {
+        const std::chrono::duration<float> seconds{
+          std::chrono::steady_clock::now() - start};
+        const auto mbytes = float(texels.size()) / (1024.f * 1024.f);
+        std::cerr << std::fixed << std::setprecision(2) << mbytes << " MB in "
+                  << seconds.count() * 1000.f << " ms, "
+                  << mbytes / seconds.count() << " MB/s, "
+                  << opts.threads.value() << " thread(s)" << std::endl;
     }
 }
 //------------------------------------------------------------------------------
@@ -136,7 +191,8 @@ auto main(main_ctx& ctx) -> int {
         if(are_equal(opts.output_path.value(), string_view("-"))) {
             write_output(std::cout, opts);
         } else {
-            std::ofstream output_file(c_str(opts.output_path.value()));
+            std::ofstream output_file(
+              c_str(opts.output_path.value()), std::ios::binary);
             write_output(output_file, opts);
         }
     } catch(const std::exception& err) {
@@ -10,13 +10,23 @@
 #include <eagine/main_fwd.hpp>
 #include <eagine/program_args.hpp>
 #include <eagine/valid_if/not_empty.hpp>
+#include <eagine/valid_if/positive.hpp>
+#include <eagine/vect/data.hpp>
+#include <eagine/workshop.hpp>
 #include <oglplus/gl.hpp>
+#include <oglplus/utils/image_container.hpp>
 #include <oglplus/utils/image_file_io.hpp>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <png.h>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace eagine {
@@ -32,17 +42,50 @@ struct options {
 
     program_parameter<std::vector<valid_if_not_empty<string_view>>> input_paths;
     program_parameter<valid_if_not_empty<string_view>> output_path;
+    program_parameter<string_view> batch_list;
+    program_parameter<valid_if_positive<int>> threads;
+    program_option premultiply;
+    program_option mipmaps;
+    program_parameter<string_view> mip_filter;
+    program_option verbosity;
 
     program_parameters all;
 
     options()
       : input_paths("-i", "--input")
       , output_path("-o", "--output", string_view("a.oglptex"))
-      , all(input_paths, output_path) {
+      , batch_list("-l", "--batch-list", string_view())
+      , threads(
+          "-t",
+          "--threads",
+          int(std::max(std::thread::hardware_concurrency(), 1U)))
+      , premultiply("-p", "--premultiply")
+      , mipmaps("-m", "--mipmaps")
+      , mip_filter("-f", "--mip-filter", string_view("box"))
+      , verbosity("-v", "--verbose")
+      , all(
+          input_paths,
+          output_path,
+          batch_list,
+          threads,
+          premultiply,
+          mipmaps,
+          mip_filter,
+          verbosity) {
         input_paths.description(
           "Path to existing PNG input file, or '-' for standard input.");
         output_path.description(
           "Path to output file, or '-' for standard output.");
+        batch_list.description(
+          "Path to a file with lines consisting of an input PNG path and "
+          "an output path. The listed images are converted concurrently.");
+        threads.description("Number of conversion threads.");
+        premultiply.description(
+          "Multiply the color components by alpha (8-bit images only).");
+        mipmaps.description(
+          "Write a texture image container with the whole mip-map chain.");
+        mip_filter.description("Mip-map filter, either 'box' or 'kaiser'.");
+        verbosity.description("Print per-file and total throughput.");
     }
 
     void print_usage(std::ostream& log) {
@@ -50,7 +93,17 @@ struct options {
     }
 
     auto check(std::ostream& log) -> bool {
-        return all.validate(log);
+        if(!all.validate(log)) {
+            return false;
+        }
+        if(
+          !are_equal(mip_filter.value(), string_view("box")) &&
+          !are_equal(mip_filter.value(), string_view("kaiser"))) {
+            log << "Invalid mip-map filter '" << mip_filter.value() << "'"
+                << std::endl;
+            return false;
+        }
+        return true;
     }
 
     auto parse(program_arg& arg, std::ostream& log) -> bool {
@@ -65,6 +118,16 @@ struct options {
     auto to_stdout() const -> bool {
         return are_equal(output_path.value(), string_view("-"));
     }
+
+    auto is_batch() const -> bool {
+        return !batch_list.value().empty();
+    }
+
+    auto mipmap_filter() const -> oglp::image_mipmap_filter {
+        return are_equal(mip_filter.value(), string_view("kaiser"))
+                 ? oglp::image_mipmap_filter::kaiser
+                 : oglp::image_mipmap_filter::box;
+    }
 };
 //------------------------------------------------------------------------------
 // png_header_validator
@@ -197,11 +260,13 @@ public:
     auto gl_iformat() -> GLenum;
 };
 //------------------------------------------------------------------------------
-void do_convert_image(
-  std::istream& input,
-  std::ostream& output,
-  oglp::image_data_header& header,
-  int layer) {
+// the decoded pixels of all layers of an image
+struct decoded_image {
+    oglp::image_data_header header{};
+    std::vector<byte> pixels;
+};
+//------------------------------------------------------------------------------
+void decode_image(std::istream& input, decoded_image& image) {
     auto match_value = [](auto& original, const auto& current, auto message) {
         if(original) {
             if(original != current) {
@@ -213,6 +278,7 @@ void do_convert_image(
     };
 
     png_reader reader(input);
+    auto& header = image.header;
 
     const auto width = int(reader.image_width());
     const auto height = int(reader.image_height());
@@ -231,29 +297,209 @@ void do_convert_image(
     match_value(
       header.internal_format, iformat, "inconsistent internal format");
 
-    auto row_size = reader.row_bytes();
-    auto size = reader.data_size();
-
-    if(layer == 0) {
-        oglp::write_and_pad_texture_image_data_header(
-          output, header, span_size(size));
-    }
-
-    std::vector<::png_byte> buffer(std_size(size));
+    const auto row_size = std_size(reader.row_bytes());
+    const auto offset = image.pixels.size();
+    image.pixels.resize(offset + std_size(reader.data_size()));
 
+    // the rows are decoded directly into their flipped position
+    auto* layer = image.pixels.data() + offset;
     for(png_uint_32 r = 0, h = reader.image_height(); r < h; ++r) {
-        reader.read_row(buffer.data() + (h - 1 - r) * row_size);
+        reader.read_row(layer + (h - 1 - r) * row_size);
+    }
+}
+//------------------------------------------------------------------------------
+// multiplies the color components of 8-bit images with alpha, the whole
+// pixel is processed at once in a SIMD vector
+void premultiply_alpha(decoded_image& image) {
+    const auto channels = image.header.channels;
+    if((channels != 2) && (channels != 4)) {
+        return;
+    }
+    if(image.header.data_type != GL_UNSIGNED_BYTE) {
+        throw std::runtime_error(
+          "premultiplied alpha is supported only for 8-bit images");
     }
 
-    output.write(
-      reinterpret_cast<const char*>(buffer.data()),
-      static_cast<std::streamsize>(buffer.size()));
+    using pixel_t = vect::data_t<float, 4, true>;
+    const auto alpha = std_size(channels - 1);
+    for(std::size_t p = 0; p < image.pixels.size(); p += std_size(channels)) {
+        byte* pixel = image.pixels.data() + p;
+        pixel_t v{};
+        for(std::size_t c = 0; c < alpha; ++c) {
+            v[c] = float(pixel[c]);
+        }
+        v = v * (float(pixel[alpha]) / 255.f) + 0.5f;
+        for(std::size_t c = 0; c < alpha; ++c) {
+            pixel[c] = byte(v[c]);
+        }
+    }
 }
 //------------------------------------------------------------------------------
-void convert_image(std::istream& input, std::ostream& output) {
-    oglp::image_data_header header{};
-    header.depth = 1;
-    do_convert_image(input, output, header, 0);
+// writes the image either as a plain texture image or as a texture image
+// container with mip-maps, which are generated by the specified threads
+void write_image(
+  std::ostream& output,
+  const decoded_image& image,
+  const options& opts,
+  workshop* workers) {
+    if(opts.mipmaps.value() > 0) {
+        oglp::texture_image_container_builder builder(image.header);
+        copy(view(image.pixels), builder.base_pixels());
+
+        oglp::image_mipmap_generator gen;
+        gen.set_filter(opts.mipmap_filter());
+        if(workers) {
+            gen.use_workers(*workers, opts.threads.value());
+        }
+        if(!builder.add_mipmaps(gen, 64)) {
+            std::cerr << "Mip-maps are generated only for 8-bit images"
+                      << std::endl;
+        }
+        builder.write(output);
+    } else {
+        oglp::image_data_header header{image.header};
+        oglp::write_texture_image_data(output, header, view(image.pixels));
+    }
+}
+//------------------------------------------------------------------------------
+void convert_image(
+  const std::vector<std::istream*>& inputs,
+  std::ostream& output,
+  const options& opts) {
+    decoded_image image{};
+    image.header.depth = limit_cast<int>(inputs.size());
+    for(auto* input : inputs) {
+        decode_image(*input, image);
+    }
+    if(opts.premultiply.value() > 0) {
+        premultiply_alpha(image);
+    }
+    workshop workers;
+    write_image(output, image, opts, &workers);
+}
+//------------------------------------------------------------------------------
+// an input and output pair from the batch list, with conversion results
+struct batch_item {
+    std::string input_path;
+    std::string output_path;
+    std::string error;
+    span_size_t size{0};
+    int width{0};
+    int height{0};
+    float seconds{0.f};
+};
+//------------------------------------------------------------------------------
+auto read_batch_list(std::istream& input) -> std::vector<batch_item> {
+    std::vector<batch_item> result;
+    std::string line;
+    while(std::getline(input, line)) {
+        std::stringstream entry(line);
+        batch_item item;
+        if(entry >> item.input_path) {
+            if(!(entry >> item.output_path)) {
+                throw std::runtime_error(
+                  "missing output path for '" + item.input_path + "'");
+            }
+            result.emplace_back(std::move(item));
+        }
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+void convert_batch_item(batch_item& item, const options& opts) {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        std::ifstream input(item.input_path, std::ios::binary);
+        decoded_image image{};
+        image.header.depth = 1;
+        decode_image(input, image);
+        if(opts.premultiply.value() > 0) {
+            premultiply_alpha(image);
+        }
+        std::ofstream output(item.output_path, std::ios::binary);
+        if(!output.is_open()) {
+            throw std::runtime_error(
+              "Unable to open output file '" + item.output_path + "'");
+        }
+        // this already runs on a worker thread, the mip-maps are serial
+        write_image(output, image, opts, nullptr);
+        output.close();
+        if(output.fail()) {
+            throw std::runtime_error(
+              "Failed to write output file '" + item.output_path + "'");
+        }
+        item.size = span_size(image.pixels.size());
+        item.width = image.header.width;
+        item.height = image.header.height;
+    } catch(const std::exception& err) {
+        item.error = err.what();
+    }
+    const std::chrono::duration<float> seconds{
+      std::chrono::steady_clock::now() - start};
+    item.seconds = seconds.count();
+}
+//------------------------------------------------------------------------------
+auto convert_batch(const options& opts) -> int {
+    std::vector<batch_item> items;
+    if(are_equal(opts.batch_list.value(), string_view("-"))) {
+        items = read_batch_list(std::cin);
+    } else {
+        std::ifstream list(c_str(opts.batch_list.value()));
+        if(!list.good()) {
+            std::cerr << "error: unable to read batch list '"
+                      << opts.batch_list.value() << "'" << std::endl;
+            return 4;
+        }
+        items = read_batch_list(list);
+    }
+
+    // the images are picked dynamically since their sizes differ
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> next{0U};
+    workshop workers;
+    workers.parallel_for(
+      span_size(items.size()),
+      opts.threads.value(),
+      [&](span_size_t, span_size_t, span_size_t) {
+          for(auto i = next++; i < items.size(); i = next++) {
+              convert_batch_item(items[i], opts);
+          }
+      });
+    const std::chrono::duration<float> seconds{
+      std::chrono::steady_clock::now() - start};
+
+    int result = 0;
+    span_size_t total_size = 0;
+    std::size_t converted = 0U;
+    const auto mega = 1024.f * 1024.f;
+    for(const auto& item : items) {
+        if(!item.error.empty()) {
+            std::cerr << "error: " << item.input_path << ": " << item.error
+                      << std::endl;
+            result = 5;
+            continue;
+        }
+        if(opts.verbosity.value() > 0) {
+            std::cerr << item.input_path << " -> " << item.output_path << ": "
+                      << item.width << "x" << item.height << ", "
+                      << std::fixed << std::setprecision(2)
+                      << float(item.size) / mega << " MB in "
+                      << item.seconds * 1000.f << " ms, "
+                      << float(item.size) / mega / item.seconds << " MB/s"
+                      << std::endl;
+        }
+        total_size += item.size;
+        ++converted;
+    }
+    if(opts.verbosity.value() > 0) {
+        std::cerr << converted << " of " << items.size() << " image(s), "
+                  << std::fixed << std::setprecision(2)
+                  << float(total_size) / mega
+                  << " MB in " << seconds.count() * 1000.f << " ms, "
+                  << float(total_size) / mega / seconds.count() << " MB/s, "
+                  << opts.threads.value() << " thread(s)" << std::endl;
+    }
+    return result;
 }
 //------------------------------------------------------------------------------
 auto parse_options(const program_args& args, options& opts) -> int;
@@ -266,32 +512,35 @@ auto main(main_ctx& ctx) -> int {
             return err;
         }
 
-        const bool from_stdin = opts.from_stdin();
-        const bool to_stdout = opts.to_stdout();
-
-        if(from_stdin && to_stdout) {
-            convert_image(std::cin, std::cout);
-        } else if(from_stdin) {
-            std::ofstream output_file(c_str(opts.output_path.value()));
-            convert_image(std::cin, output_file);
-        } else if(to_stdout) {
-            oglp::image_data_header header{};
-            header.depth = limit_cast<int>(opts.input_paths.value().size());
-            int layer = 0;
-            for(auto& input_path : opts.input_paths.value()) {
-                std::ifstream input_file(c_str(input_path.value()));
-                do_convert_image(input_file, std::cout, header, layer++);
-            }
+        if(opts.is_batch()) {
+            return convert_batch(opts);
+        }
+
+        std::vector<std::ifstream> input_files;
+        std::vector<std::istream*> inputs;
+        if(opts.from_stdin()) {
+            inputs.push_back(&std::cin);
         } else {
-            oglp::image_data_header header{};
-            header.depth = limit_cast<int>(opts.input_paths.value().size());
-            std::ofstream output_file(c_str(opts.output_path.value()));
-            int layer = 0;
+            input_files.reserve(opts.input_paths.value().size());
             for(auto& input_path : opts.input_paths.value()) {
-                std::ifstream input_file(c_str(input_path.value()));
-                do_convert_image(input_file, output_file, header, layer++);
+                input_files.emplace_back(
+                  c_str(input_path.value()), std::ios::binary);
+                inputs.push_back(&input_files.back());
             }
         }
+
+        if(inputs.empty()) {
+            std::cerr << "error: no inputs" << std::endl;
+            return 3;
+        }
+
+        if(opts.to_stdout()) {
+            convert_image(inputs, std::cout, opts);
+        } else {
+            std::ofstream output_file(
+              c_str(opts.output_path.value()), std::ios::binary);
+            convert_image(inputs, output_file, opts);
+        }
     } catch(const std::exception& err) {
         std::cerr << "error: " << err.what() << std::endl;
     }
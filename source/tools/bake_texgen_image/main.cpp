@@ -0,0 +1,378 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#include <eagine/main_ctx.hpp>
+#include <eagine/main_fwd.hpp>
+#include <eagine/program_args.hpp>
+#include <eagine/valid_if/positive.hpp>
+#include <eagine/workshop.hpp>
+#include <oglplus/gl.hpp>
+#include <oglplus/texgen/blur2d_node.hpp>
+#include <oglplus/texgen/checker_node.hpp>
+#include <oglplus/texgen/coord_node.hpp>
+#include <oglplus/texgen/cpu_renderer.hpp>
+#include <oglplus/texgen/honeycomb_node.hpp>
+#include <oglplus/texgen/invert_node.hpp>
+#include <oglplus/texgen/mandelbrot_node.hpp>
+#include <oglplus/texgen/mix_node.hpp>
+#include <oglplus/texgen/newton_node.hpp>
+#include <oglplus/texgen/scale_node.hpp>
+#include <oglplus/texgen/voronoi2d_node.hpp>
+#include <oglplus/utils/image_file_io.hpp>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace eagine {
+//------------------------------------------------------------------------------
+struct options {
+    using _str_param_t = program_parameter<string_view>;
+    using _pos_int_t = valid_if_positive<GLsizei>;
+    using _int_param_t = program_parameter<_pos_int_t>;
+    using _opt_param_t = program_option;
+
+    _str_param_t output_path;
+    _str_param_t node;
+    _int_param_t components;
+    _int_param_t width;
+    _int_param_t height;
+    _int_param_t depth;
+    _int_param_t threads;
+    _int_param_t tile_size;
+    _opt_param_t benchmark;
+    _opt_param_t verbosity;
+
+    program_parameters all;
+
+    options()
+      : output_path("-o", "--output", "a.oglptex")
+      , node("-n", "--node", "checker")
+      , components("-c", "--components", 1)
+      , width("-w", "--width", 256)
+      , height("-h", "--height", 256)
+      , depth("-d", "--depth", 1)
+      , threads(
+          "-t",
+          "--threads",
+          GLsizei(std::max(std::thread::hardware_concurrency(), 1U)))
+      , tile_size("-s", "--tile-size", 64)
+      , benchmark("-b", "--benchmark")
+      , verbosity("-v", "--verbose")
+      , all(
+          output_path,
+          node,
+          components,
+          width,
+          height,
+          depth,
+          threads,
+          tile_size,
+          benchmark,
+          verbosity) {}
+
+    void print_usage(std::ostream& log) {
+        log << "bake_texgen_image options" << std::endl;
+        log << "  options:" << std::endl;
+        log << "   -o|--output PATH: Output file path "
+               "or '-' for stdout."
+            << std::endl;
+        log << "   -n|--node NAME: The rendered texgen node." << std::endl;
+        log << "     NAME is one of the following:" << std::endl;
+        for(auto name : node_names()) {
+            log << "       " << name << std::endl;
+        }
+        log << "   -c|--components N: Number of components." << std::endl;
+        log << "   -w|--width N: Output image width." << std::endl;
+        log << "   -h|--height N: Output image height." << std::endl;
+        log << "   -d|--depth N: Output image depth." << std::endl;
+        log << "   -t|--threads N: Number of rendering threads." << std::endl;
+        log << "   -s|--tile-size N: Size of the rendered tiles." << std::endl;
+        log << "   -b|--benchmark: Time the rendering of all nodes, "
+               "without writing the output."
+            << std::endl;
+        log << "   -v|--verbose: Print the rendering time." << std::endl;
+    }
+
+    static auto node_names() -> span<const string_view> {
+        static const string_view names[] = {
+          "checker",
+          "pixel_checker",
+          "coord",
+          "mandelbrot",
+          "newton3",
+          "newton4",
+          "voronoi2d",
+          "voronoi2d_cells",
+          "honeycomb",
+          "blur2d",
+          "invert",
+          "mix"};
+        return view(names);
+    }
+
+    auto check(std::ostream& log) const -> bool {
+        if(!all.validate(log)) {
+            return false;
+        }
+        if(components.value() > 4) {
+            log << "Invalid number of components '" << components.value()
+                << "'" << std::endl;
+            return false;
+        }
+        for(auto name : node_names()) {
+            if(are_equal(name, node.value())) {
+                return true;
+            }
+        }
+        log << "Invalid node name '" << node.value() << "'" << std::endl;
+        return false;
+    }
+
+    auto parse(program_arg& a, std::ostream& log) -> bool {
+        return a.parse_param(output_path, log) || a.parse_param(node, log) ||
+               a.parse_param(components, log) || a.parse_param(width, log) ||
+               a.parse_param(height, log) || a.parse_param(depth, log) ||
+               a.parse_param(threads, log) || a.parse_param(tile_size, log) ||
+               a.parse_param(benchmark, log) || a.parse_param(verbosity, log);
+    }
+};
+//------------------------------------------------------------------------------
+// The nodes of a small texgen graph, with the rendered output.
+class texgen_nodes {
+public:
+    texgen_nodes(string_view name);
+    texgen_nodes(texgen_nodes&&) = delete;
+    texgen_nodes(const texgen_nodes&) = delete;
+    auto operator=(texgen_nodes&&) = delete;
+    auto operator=(const texgen_nodes&) = delete;
+
+    ~texgen_nodes() noexcept {
+        for(auto& node : _nodes) {
+            node->disconnect_all();
+        }
+    }
+
+    auto output() noexcept -> oglp::texgen::output_intf& {
+        EAGINE_ASSERT(_output);
+        return *_output;
+    }
+
+private:
+    template <typename Node>
+    auto _add() -> Node& {
+        auto node = std::make_unique<Node>();
+        auto& result = *node;
+        _nodes.emplace_back(std::move(node));
+        return result;
+    }
+
+    std::vector<std::unique_ptr<oglp::texgen::node_intf>> _nodes;
+    oglp::texgen::output_intf* _output{nullptr};
+};
+//------------------------------------------------------------------------------
+texgen_nodes::texgen_nodes(string_view name) {
+    using namespace oglp::texgen;
+
+    if(are_equal(name, string_view("checker"))) {
+        _output = &_add<checker_node>().output(0);
+    } else if(are_equal(name, string_view("pixel_checker"))) {
+        _output = &_add<pixel_checker_node>().output(0);
+    } else if(are_equal(name, string_view("coord"))) {
+        _output = &_add<coord_node>().output(0);
+    } else if(are_equal(name, string_view("mandelbrot"))) {
+        auto& scale = _add<scale_node>().set_scale(0.4f, 0.4f, 1.f);
+        auto& mandelbrot = _add<mandelbrot_node>();
+        connect_output_to_input(mandelbrot.output(0), scale.input(0));
+        _output = &scale.output(0);
+    } else if(are_equal(name, string_view("newton3"))) {
+        _output = &_add<newton_node>()
+                     .set_function(newton_function::xe3minus1)
+                     .output(0);
+    } else if(are_equal(name, string_view("newton4"))) {
+        _output = &_add<newton_node>()
+                     .set_function(newton_function::xe4minus1)
+                     .output(0);
+    } else if(are_equal(name, string_view("voronoi2d"))) {
+        _output = &_add<voronoi2d_node>().output(1);
+    } else if(are_equal(name, string_view("voronoi2d_cells"))) {
+        _output = &_add<voronoi2d_node>().output(4);
+    } else if(are_equal(name, string_view("honeycomb"))) {
+        _output = &_add<honeycomb_node>().set_cell_count(16, 16).output(2);
+    } else if(are_equal(name, string_view("blur2d"))) {
+        auto& blur = _add<blur2d_node>();
+        auto& checker = _add<checker_node>().set_repeat(32, 32, 32);
+        connect_output_to_input(checker.output(0), blur.input(0));
+        _output = &blur.output(0);
+    } else if(are_equal(name, string_view("invert"))) {
+        auto& invert = _add<invert_node>();
+        auto& voronoi = _add<voronoi2d_node>();
+        connect_output_to_input(voronoi.output(0), invert.input(0));
+        _output = &invert.output(0);
+    } else if(are_equal(name, string_view("mix"))) {
+        auto& mix = _add<mix_node>()
+                      .set_zero(0.2f, 0.3f, 0.6f, 1.f)
+                      .set_one(0.9f, 0.8f, 0.2f, 1.f);
+        auto& honeycomb = _add<honeycomb_node>();
+        connect_output_to_input(honeycomb.output(2), mix.input(2));
+        _output = &mix.output(0);
+    }
+}
+//------------------------------------------------------------------------------
+auto make_renderer(const options& opts, workshop& workers)
+  -> oglp::texgen::cpu_renderer {
+    oglp::texgen::cpu_renderer renderer;
+    renderer.set_dimensions(opts.width, opts.height, opts.depth)
+      .set_tile_size(opts.tile_size.value())
+      .use_workers(workers, opts.threads.value());
+    return renderer;
+}
+//------------------------------------------------------------------------------
+auto render(
+  oglp::texgen::cpu_renderer& renderer,
+  string_view name,
+  GLsizei channels,
+  span<byte> texels,
+  std::ostream& log,
+  bool verbose) -> bool {
+    texgen_nodes nodes(name);
+    const auto start = std::chrono::steady_clock::now();
+    if(!renderer.render(nodes.output(), channels, texels)) {
+        log << "Node '" << name << "' cannot be rendered on the CPU"
+            << std::endl;
+        return false;
+    }
+    const std::chrono::duration<float> seconds{
+      std::chrono::steady_clock::now() - start};
+
+    if(verbose) {
+        log << std::setw(16) << std::left << name.to_string() << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2)
+            << seconds.count() * 1000.f << " ms" << std::setw(10)
+            << float(renderer.texel_count()) / seconds.count() * 1e-6f
+            << " Mtexel/s" << std::endl;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+void write_output(std::ostream& output, const options& opts) {
+    oglp::image_data_header hdr(
+      opts.width, opts.height, opts.depth, opts.components.value());
+    switch(opts.components.value()) {
+        case 1:
+            hdr.format = GL_RED;
+            hdr.internal_format = GL_R8;
+            break;
+        case 2:
+            hdr.format = GL_RG;
+            hdr.internal_format = GL_RG8;
+            break;
+        case 3:
+            hdr.format = GL_RGB;
+            hdr.internal_format = GL_RGB8;
+            break;
+        case 4:
+            hdr.format = GL_RGBA;
+            hdr.internal_format = GL_RGBA8;
+            break;
+    };
+
+    hdr.data_type = GL_UNSIGNED_BYTE;
+
+    workshop workers;
+    auto renderer = make_renderer(opts, workers);
+    std::vector<byte> texels(
+      std_size(renderer.texel_count() * opts.components.value()));
+    if(render(
+         renderer,
+         opts.node.value(),
+         opts.components.value(),
+         cover(texels),
+         std::cerr,
+         opts.verbosity.value() > 0)) {
+        oglp::write_texture_image_data(output, hdr, view(texels));
+    }
+}
+//------------------------------------------------------------------------------
+void run_benchmark(const options& opts) {
+    workshop workers;
+    auto renderer = make_renderer(opts, workers);
+    std::vector<byte> texels(std_size(renderer.texel_count() * 4));
+    std::cout << renderer.width() << "x" << renderer.height() << "x"
+              << renderer.depth() << " texels, " << opts.threads.value()
+              << " thread(s), tile size " << opts.tile_size.value()
+              << std::endl;
+    for(auto name : options::node_names()) {
+        render(renderer, name, 4, cover(texels), std::cout, true);
+    }
+}
+//------------------------------------------------------------------------------
+auto parse_options(const program_args& args, options& opts) -> int;
+//------------------------------------------------------------------------------
+auto main(main_ctx& ctx) -> int {
+    try {
+        options opts;
+
+        if(int err = parse_options(ctx.args(), opts)) {
+            return err;
+        }
+
+        if(opts.benchmark.value() > 0) {
+            run_benchmark(opts);
+        } else if(are_equal(opts.output_path.value(), string_view("-"))) {
+            write_output(std::cout, opts);
+        } else {
+            std::ofstream output_file(c_str(opts.output_path.value()));
+            write_output(output_file, opts);
+        }
+    } catch(const std::exception& err) {
+        std::cerr << "error: " << err.what() << std::endl;
+    }
+    return 0;
+}
+//------------------------------------------------------------------------------
+auto parse_argument(program_arg& a, options& opts) -> bool {
+    if(!opts.parse(a, std::cerr)) {
+        std::cerr << "Failed to parse argument '" << a.get() << "'"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+auto parse_options(const program_args& args, options& opts) -> int {
+
+    for(program_arg a = args.first(); a; a = a.next()) {
+        if(a.is_help_arg()) {
+            opts.print_usage(std::cout);
+            return 1;
+        } else if(!parse_argument(a, opts)) {
+            opts.print_usage(std::cerr);
+            return 2;
+        }
+    }
+
+    if(!opts.check(std::cerr)) {
+        opts.print_usage(std::cerr);
+        return 3;
+    }
+
+    return 0;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine
+
+auto main(int argc, const char** argv) -> int {
+    eagine::main_ctx_options options;
+    options.app_id = EAGINE_ID(BakeTxGnI);
+    options.logger_opts.default_no_log = true;
+    return eagine::main_impl(argc, argv, options);
+}
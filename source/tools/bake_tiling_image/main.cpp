@@ -12,12 +12,16 @@
 #include <eagine/program_args.hpp>
 #include <eagine/valid_if/one_of.hpp>
 #include <eagine/valid_if/positive.hpp>
+#include <eagine/workshop.hpp>
 #include <oglplus/gl.hpp>
 #include <oglplus/utils/image_file_io.hpp>
+#include <chrono>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <sstream>
+#include <thread>
 
 namespace eagine {
 //------------------------------------------------------------------------------
@@ -28,6 +32,7 @@ struct options {
     program_parameter<valid_if_one_of<int, 4>> rank;
     program_parameter<valid_if_positive<int>> width;
     program_parameter<valid_if_positive<int>> height;
+    program_parameter<valid_if_positive<int>> threads;
     program_option verbosity;
 
     program_parameters all;
@@ -38,8 +43,19 @@ struct options {
       , rank{"-r", "--rank", 4}
       , width{"-w", "--width", 256}
       , height{"-h", "--height", 256}
+      , threads{
+          "-t",
+          "--threads",
+          int(std::max(std::thread::hardware_concurrency(), 1U))}
       , verbosity{"-v", "--verbose"}
-      , all{output_path, input_paths, rank, width, height, verbosity} {}
+      , all{
+          output_path,
+          input_paths,
+          rank,
+          width,
+          height,
+          threads,
+          verbosity} {}
 
     void print_usage(std::ostream& log) {
         log << "bake_tiling_image options" << std::endl;
@@ -50,6 +66,10 @@ struct options {
         log << "   -r|--rank N: Tiling rank." << std::endl;
         log << "   -w|--width N: Output image width." << std::endl;
         log << "   -h|--height N: Output image height." << std::endl;
+        log << "   -t|--threads N: Number of input reading threads."
+            << std::endl;
+        log << "   -v|--verbose: Print the output size and throughput."
+            << std::endl;
     }
 
     auto check(std::ostream& log) const -> bool {
@@ -60,7 +80,7 @@ struct options {
         return a.parse_param(output_path, log) ||
                a.parse_param(input_paths, log) || a.parse_param(rank, log) ||
                a.parse_param(width, log) || a.parse_param(height, log) ||
-               a.parse_param(verbosity, log);
+               a.parse_param(threads, log) || a.parse_param(verbosity, log);
     }
 };
 //------------------------------------------------------------------------------
@@ -95,27 +115,58 @@ auto write_output(std::ostream& output, const options& opts) -> int {
     hdr.internal_format = GL_R8UI;
     hdr.data_type = GL_UNSIGNED_BYTE;
 
-    const auto size = span_size(opts.width.value() * opts.height.value()) *
-                      span_size(input_paths.size());
-
-    oglp::write_and_pad_texture_image_data_header(output, hdr, size);
-
-    for(auto input_path : input_paths) {
-        std::ifstream input{c_str(input_path)};
-        char c{};
-        for(const int y : integer_range(opts.height.value())) {
-            for(const int x : integer_range(opts.width.value())) {
-                if(!(input >> c).good()) {
-                    std::cerr << "error: failed to read from input file '"
-                              << input_path << "' at position " << x << "," << y
-                              << std::endl;
-                    return 4;
-                }
-                output.put(translate(c, opts));
-            }
+    const auto start = std::chrono::steady_clock::now();
+    const auto slice_size =
+      span_size(opts.width.value()) * opts.height.value();
+    std::vector<byte> texels(std_size(slice_size) * input_paths.size());
+    std::vector<std::string> errors(input_paths.size());
+
+    // each input file is read into its own slice of the output
+    workshop workers;
+    workers.parallel_for(
+      span_size(input_paths.size()),
+      opts.threads.value(),
+      [&](span_size_t, span_size_t begin, span_size_t end) {
+          for(auto i = std_size(begin); i < std_size(end); ++i) {
+              const auto input_path = input_paths[i];
+              std::ifstream input{c_str(input_path)};
+              auto* dst = texels.data() + span_size(i) * slice_size;
+              char c{};
+              for(const int y : integer_range(opts.height.value())) {
+                  for(const int x : integer_range(opts.width.value())) {
+                      if(!(input >> c).good()) {
+                          std::stringstream msg;
+                          msg << "failed to read from input file '"
+                              << input_path << "' at position " << x << ","
+                              << y;
+                          errors[i] = msg.str();
+                          return;
+                      }
+                      *dst++ = byte(translate(c, opts));
+                  }
+              }
+          }
+      });
+
+    for(const auto& error : errors) {
+        if(!error.empty()) {
+            std::cerr << "error: " << error << std::endl;
+            return 4;
         }
     }
 
+    oglp::write_texture_image_data(output, hdr, view(texels));
+
+    if(opts.verbosity.value() > 0) {
+        const std::chrono::duration<float> seconds{
+          std::chrono::steady_clock::now() - start};
+        const auto mbytes = float(texels.size()) / (1024.f * 1024.f);
+        std::cerr << std::fixed << std::setprecision(2) << mbytes << " MB in "
+                  << seconds.count() * 1000.f << " ms, "
+                  << mbytes / seconds.count() << " MB/s, "
+                  << opts.threads.value() << " thread(s)" << std::endl;
+    }
+
     return 0;
 }
 //------------------------------------------------------------------------------
@@ -132,7 +183,8 @@ auto main(main_ctx& ctx) -> int {
         if(are_equal(opts.output_path.value(), string_view("-"))) {
             return write_output(std::cout, opts);
         } else {
-            std::ofstream output_file(c_str(opts.output_path.value()));
+            std::ofstream output_file(
+              c_str(opts.output_path.value()), std::ios::binary);
             return write_output(output_file, opts);
         }
     } catch(const std::exception& err) {
@@ -0,0 +1,137 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include "../../main_ctx.hpp"
+#include <eagine/application_config.hpp>
+#include <eagine/config/platform.hpp>
+#define BOOST_TEST_MODULE EAGINE_application_config
+#include "../unit_test_begin.inl"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(application_config_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+#if EAGINE_POSIX
+static void application_config_set_env(const char* name, int value) {
+    ::setenv(name, std::to_string(value).c_str(), 1);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(application_config_memoized_value) {
+    using namespace eagine;
+    test_main_ctx ctx;
+    auto& config = ctx.config();
+
+    const int first{rg.get_int(0, 1000)};
+    const int second{first + rg.get_int(1, 1000)};
+    application_config_set_env("EAGINE_TEST_MEMO_INT", first);
+
+    for(int i = 0; i < 10; ++i) {
+        int value{-1};
+        BOOST_CHECK(config.fetch("test.memo_int", value));
+        BOOST_CHECK_EQUAL(value, first);
+    }
+
+    // the memoized value is used until reload
+    application_config_set_env("EAGINE_TEST_MEMO_INT", second);
+    int value{-1};
+    BOOST_CHECK(config.fetch("test.memo_int", value));
+    BOOST_CHECK_EQUAL(value, first);
+
+    // memoization is done per value type
+    std::string str;
+    BOOST_CHECK(config.fetch("test.memo_int", str));
+    BOOST_CHECK_EQUAL(str, std::to_string(second));
+
+    config.reload();
+    BOOST_CHECK(config.fetch("test.memo_int", value));
+    BOOST_CHECK_EQUAL(value, second);
+    BOOST_CHECK(!config.refresh());
+    BOOST_CHECK_EQUAL(extract(config.get<int>("test.memo_int")), second);
+
+    ::unsetenv("EAGINE_TEST_MEMO_INT");
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(application_config_memoized_missing) {
+    using namespace eagine;
+    test_main_ctx ctx;
+    auto& config = ctx.config();
+
+    ::unsetenv("EAGINE_TEST_MEMO_MISSING");
+    ::unsetenv("EAGINE_TEST_MEMO_FLAG");
+
+    int value{-1};
+    BOOST_CHECK(!config.fetch("test.memo_missing", value));
+    BOOST_CHECK_EQUAL(value, -1);
+    BOOST_CHECK(!config.is_set("test.memo_flag"));
+
+    const int expected{rg.get_int(0, 1000)};
+    application_config_set_env("EAGINE_TEST_MEMO_MISSING", expected);
+    ::setenv("EAGINE_TEST_MEMO_FLAG", "true", 1);
+    BOOST_CHECK(!config.fetch("test.memo_missing", value));
+    BOOST_CHECK(!config.is_set("test.memo_flag"));
+
+    config.reload();
+    BOOST_CHECK(config.fetch("test.memo_missing", value));
+    BOOST_CHECK_EQUAL(value, expected);
+    BOOST_CHECK(config.is_set("test.memo_flag"));
+
+    std::vector<int> values{-1};
+    BOOST_CHECK(config.fetch("test.memo_missing", values));
+    BOOST_CHECK(config.fetch("test.memo_missing", values));
+    BOOST_REQUIRE_EQUAL(values.size(), 3);
+    BOOST_CHECK_EQUAL(values[0], -1);
+    BOOST_CHECK_EQUAL(values[1], expected);
+    BOOST_CHECK_EQUAL(values[2], expected);
+
+    ::unsetenv("EAGINE_TEST_MEMO_MISSING");
+    ::unsetenv("EAGINE_TEST_MEMO_FLAG");
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(application_config_concurrent_reload) {
+    using namespace eagine;
+    test_main_ctx ctx;
+    auto& config = ctx.config();
+
+    const int expected{rg.get_int(0, 1000)};
+    application_config_set_env("EAGINE_TEST_MEMO_SHARED", expected);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while(!done) {
+                std::vector<int> values;
+                if(
+                  !config.fetch("test.memo_shared", values) ||
+                  (values.size() != 1U) || (values.front() != expected)) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for(int i = 0; i < test_repeats(100, 1000); ++i) {
+        config.reload();
+    }
+    done = true;
+    for(auto& reader : readers) {
+        reader.join();
+    }
+    BOOST_CHECK_EQUAL(mismatches, 0);
+
+    ::unsetenv("EAGINE_TEST_MEMO_SHARED");
+}
+#endif
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,263 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/c_api_profile.hpp>
+#define BOOST_TEST_MODULE EAGINE_c_api_profile
+#include "../unit_test_begin.inl"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(c_api_profile_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+static int stub_increment(int i) {
+    return i + 1;
+}
+
+static int stub_twice(int i) {
+    return i * 2;
+}
+
+static void stub_nothing() {}
+//------------------------------------------------------------------------------
+struct stub_api_tag {};
+
+struct stub_api_traits : eagine::default_c_api_traits {
+    template <typename Api, typename Tag, typename Signature>
+    auto link_function(
+      Api&,
+      Tag,
+      eagine::string_view name,
+      eagine::type_identity<Signature>) -> std::add_pointer_t<Signature> {
+        if constexpr(std::is_same_v<Signature, int(int)>) {
+            if(are_equal(name, eagine::string_view("twice"))) {
+                return &stub_twice;
+            }
+        }
+        if constexpr(std::is_same_v<Signature, void()>) {
+            if(are_equal(name, eagine::string_view("nothing"))) {
+                return &stub_nothing;
+            }
+        }
+        return nullptr;
+    }
+};
+
+using profiled_traits = eagine::profiling_c_api_traits<stub_api_traits>;
+
+struct stub_api {
+    profiled_traits traits;
+
+    eagine::opt_c_api_function<
+      profiled_traits,
+      stub_api_tag,
+      int(int),
+      &stub_increment,
+      true,
+      true>
+      increment;
+
+    eagine::opt_c_api_function<
+      profiled_traits,
+      stub_api_tag,
+      int(int),
+      nullptr,
+      true,
+      false>
+      twice;
+
+    eagine::opt_c_api_function<
+      profiled_traits,
+      stub_api_tag,
+      void(),
+      nullptr,
+      true,
+      false>
+      nothing;
+
+    eagine::opt_c_api_function<
+      profiled_traits,
+      stub_api_tag,
+      void(),
+      nullptr,
+      true,
+      false>
+      missing;
+
+    stub_api()
+      : increment{"increment", traits, *this}
+      , twice{"twice", traits, *this}
+      , nothing{"nothing", traits, *this}
+      , missing{"missing", traits, *this} {}
+};
+//------------------------------------------------------------------------------
+static auto find_stats(
+  const std::vector<eagine::c_api_function_stats>& stats,
+  const void* address) -> const eagine::c_api_function_stats* {
+    for(const auto& s : stats) {
+        if(s.address == address) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(c_api_profile_counts) {
+    using namespace eagine;
+
+    stub_api api;
+    auto& profile = profiled_traits::profile();
+    profile.reset();
+    profile.enable_timing(false);
+
+    BOOST_CHECK(bool(api.twice));
+    BOOST_CHECK(!bool(api.missing));
+
+    const int n_increment{rg.get_int(1, 1000)};
+    const int n_twice{rg.get_int(1, 1000)};
+    const int n_nothing{rg.get_int(1, 1000)};
+    for(int i = 0; i < n_increment; ++i) {
+        BOOST_CHECK_EQUAL(api.increment(i), i + 1);
+    }
+    for(int i = 0; i < n_twice; ++i) {
+        BOOST_CHECK_EQUAL(api.twice(i), i * 2);
+    }
+    for(int i = 0; i < n_nothing; ++i) {
+        api.nothing();
+        api.missing();
+    }
+
+    const auto stats{profile.function_stats()};
+    const auto* s_increment{
+      find_stats(stats, reinterpret_cast<const void*>(&stub_increment))};
+    const auto* s_twice{
+      find_stats(stats, reinterpret_cast<const void*>(&stub_twice))};
+    const auto* s_nothing{
+      find_stats(stats, reinterpret_cast<const void*>(&stub_nothing))};
+
+    BOOST_REQUIRE(s_increment);
+    BOOST_CHECK_EQUAL(s_increment->call_count, n_increment);
+    BOOST_CHECK(s_increment->name.empty());
+    BOOST_CHECK_EQUAL(s_increment->total_time.count(), 0);
+
+    BOOST_REQUIRE(s_twice);
+    BOOST_CHECK_EQUAL(s_twice->call_count, n_twice);
+    BOOST_CHECK_EQUAL(s_twice->name, "twice");
+
+    BOOST_REQUIRE(s_nothing);
+    BOOST_CHECK_EQUAL(s_nothing->call_count, n_nothing);
+    BOOST_CHECK_EQUAL(s_nothing->name, "nothing");
+
+    std::stringstream report;
+    profile.write_report(report, 2);
+    BOOST_CHECK(report.str().find("by call count") != std::string::npos);
+    BOOST_CHECK(report.str().find("by time") == std::string::npos);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(c_api_profile_trace) {
+    using namespace eagine;
+
+    stub_api api;
+    auto& profile = profiled_traits::profile();
+    profile.reset();
+
+    const int capacity{rg.get_int(1, 100)};
+    profile.enable_trace(capacity);
+    BOOST_CHECK(profile.is_tracing());
+    BOOST_CHECK(profile.is_timing());
+
+    const int calls{rg.get_int(1, 300)};
+    std::vector<const void*> expected;
+    for(int i = 0; i < calls; ++i) {
+        if(rg.get_bool()) {
+            api.increment(i);
+            expected.push_back(reinterpret_cast<const void*>(&stub_increment));
+        } else {
+            api.twice(i);
+            expected.push_back(reinterpret_cast<const void*>(&stub_twice));
+        }
+    }
+
+    const auto stats{profile.function_stats()};
+    const auto trace{profile.trace()};
+    BOOST_CHECK_EQUAL(trace.size(), std_size(std::min(calls, capacity)));
+
+    auto pos{expected.end() - std::ptrdiff_t(trace.size())};
+    std::uint64_t prev_start{0U};
+    for(const auto& record : trace) {
+        BOOST_REQUIRE(record.function_index < stats.size());
+        BOOST_CHECK_EQUAL(stats[record.function_index].address, *pos++);
+        BOOST_CHECK_GE(record.start_ns, prev_start);
+        prev_start = record.start_ns;
+    }
+
+    std::stringstream report;
+    profile.write_report(report);
+    BOOST_CHECK(report.str().find("twice") != std::string::npos);
+    BOOST_CHECK(report.str().find("by time") != std::string::npos);
+
+    profile.disable_trace();
+    BOOST_CHECK(!profile.is_tracing());
+    BOOST_CHECK(profile.trace().empty());
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(c_api_profile_trace_threads) {
+    using namespace eagine;
+
+    stub_api api;
+    auto& profile = profiled_traits::profile();
+    profile.reset();
+    const int capacity{rg.get_int(1, 64)};
+    profile.enable_trace(capacity);
+
+    const auto increment{reinterpret_cast<const void*>(&stub_increment)};
+    const auto twice{reinterpret_cast<const void*>(&stub_twice)};
+    std::atomic<bool> done{false};
+    std::atomic<int> invalid{0};
+    // the trace is read while the calls are traced from other threads
+    std::thread reader{[&] {
+        while(!done) {
+            const auto stats{profile.function_stats()};
+            for(const auto& record : profile.trace()) {
+                if(
+                  (record.function_index >= stats.size()) ||
+                  ((stats[record.function_index].address != increment) &&
+                   (stats[record.function_index].address != twice))) {
+                    ++invalid;
+                }
+            }
+        }
+    }};
+    std::vector<std::thread> callers;
+    for(int t = 0; t < 4; ++t) {
+        callers.emplace_back([&api, t] {
+            for(int i = 0; i < test_repeats(1000, 10000); ++i) {
+                if(t % 2 == 0) {
+                    api.increment(i);
+                } else {
+                    api.twice(i);
+                }
+            }
+        });
+    }
+    for(auto& caller : callers) {
+        caller.join();
+    }
+    done = true;
+    reader.join();
+
+    BOOST_CHECK_EQUAL(invalid, 0);
+    BOOST_CHECK_LE(profile.trace().size(), std_size(capacity));
+    profile.disable_trace();
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,114 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/chunked_compression.hpp>
+#define BOOST_TEST_MODULE EAGINE_chunked_compression
+#include "../unit_test_begin.inl"
+
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/span.hpp>
+#include <eagine/workshop.hpp>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(chunked_compression_tests)
+
+static eagine::test_random_generator rg;
+
+static void chunked_compression_fill(std::vector<eagine::byte>& data) {
+    // partially compressible data
+    for(auto& b : data) {
+        b = rg.get_byte(0x40U, 0x47U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chunked_compression_round_trip) {
+    using namespace eagine;
+
+    workshop workers;
+    std::vector<byte> orig;
+    memory::buffer packed;
+    memory::buffer unpacked;
+
+    for(int i = 0; i < test_repeats(20, 100); ++i) {
+        const auto thread_count = rg.get_span_size(1, 8);
+        const auto chunk_size = rg.get_span_size(1, 4096);
+        chunked_data_compressor comp{workers, thread_count, chunk_size};
+        BOOST_CHECK_EQUAL(comp.thread_count(), thread_count);
+        BOOST_CHECK_EQUAL(comp.chunk_size(), chunk_size);
+
+        orig.resize(rg.get_std_size(0, 100000));
+        chunked_compression_fill(orig);
+
+        const auto pck = comp.compress(view(orig), packed);
+        BOOST_CHECK(chunked_compressed_view::is_chunked(pck));
+
+        const chunked_compressed_view pview{pck};
+        BOOST_CHECK(pview.is_valid());
+        BOOST_CHECK_EQUAL(pview.total_size(), span_size(orig.size()));
+        BOOST_CHECK_EQUAL(pview.chunk_size(), chunk_size);
+        BOOST_CHECK_EQUAL(
+          pview.chunk_count(),
+          (pview.total_size() + chunk_size - 1) / chunk_size);
+
+        const auto upk = comp.decompress(pck, unpacked);
+        BOOST_CHECK_EQUAL(upk.size(), span_size(orig.size()));
+        BOOST_CHECK(are_equal(view(orig), upk));
+    }
+    workers.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(chunked_compression_random_access) {
+    using namespace eagine;
+
+    workshop workers;
+    chunked_data_compressor comp{workers, 4, 1000};
+    data_compressor single;
+    std::vector<byte> orig(10500);
+    chunked_compression_fill(orig);
+    memory::buffer packed;
+    memory::buffer unpacked;
+
+    const chunked_compressed_view pview{comp.compress(view(orig), packed)};
+    BOOST_CHECK_EQUAL(pview.chunk_count(), 11);
+
+    for(int i = 0; i < test_repeats(100, 1000); ++i) {
+        const auto offs = rg.get_span_size(0, pview.total_size() - 1);
+        const auto index = pview.chunk_index(offs);
+        BOOST_CHECK_LE(pview.chunk_offset(index), offs);
+        BOOST_CHECK_GT(
+          pview.chunk_offset(index) + pview.unpacked_size(index), offs);
+
+        const auto chunk = pview.unpack_chunk(single, index, unpacked);
+        BOOST_CHECK_EQUAL(chunk.size(), pview.unpacked_size(index));
+        BOOST_CHECK(are_equal(
+          head(skip(view(orig), pview.chunk_offset(index)), chunk.size()),
+          chunk));
+    }
+    BOOST_CHECK_EQUAL(pview.unpacked_size(10), 500);
+    workers.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(chunked_compression_invalid) {
+    using namespace eagine;
+
+    workshop workers;
+    chunked_data_compressor comp{workers, 2};
+    std::vector<byte> orig(100000);
+    chunked_compression_fill(orig);
+    memory::buffer packed;
+    memory::buffer unpacked;
+
+    BOOST_CHECK(!chunked_compressed_view{view(orig)}.is_valid());
+    BOOST_CHECK(comp.decompress(view(orig), unpacked).empty());
+
+    const auto pck = comp.compress(view(orig), packed);
+    BOOST_CHECK(!chunked_compressed_view{head(pck, pck.size() / 2)});
+    workers.shutdown();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
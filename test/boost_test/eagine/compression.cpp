@@ -0,0 +1,114 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/compression.hpp>
+#define BOOST_TEST_MODULE EAGINE_compression
+#include "../unit_test_begin.inl"
+
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/span.hpp>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compression_tests)
+
+static eagine::test_random_generator rg;
+
+static auto compression_sample(int i) -> std::string {
+    return "{\"node_id\":" + std::to_string(i) +
+           ",\"status\":\"running\",\"cpu_usage\":0." + std::to_string(i % 97) +
+           ",\"memory_usage\":" + std::to_string(i * 31) + "}";
+}
+
+BOOST_AUTO_TEST_CASE(compression_round_trip) {
+    using namespace eagine;
+
+    data_compressor comp{};
+    std::vector<byte> orig;
+    memory::buffer packed;
+    memory::buffer unpacked;
+
+    for(int i = 0; i < test_repeats(100, 1000); ++i) {
+        orig.resize(rg.get<std::size_t>(1, 10000));
+        if(i % 2) {
+            rg.fill(orig);
+        } else {
+            fill(cover(orig), byte(i));
+        }
+        const auto level = data_compression_level(i % 4);
+
+        const auto pck = comp.compress(view(orig), packed, level);
+        BOOST_CHECK(!pck.empty());
+        const auto upk = comp.decompress(pck, unpacked);
+        BOOST_CHECK(are_equal(view(orig), upk));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compression_dictionary) {
+    using namespace eagine;
+
+    std::vector<std::string> samples;
+    std::vector<memory::const_block> blocks;
+    for(int i = 0; i < 64; ++i) {
+        samples.push_back(compression_sample(i));
+    }
+    for(const auto& sample : samples) {
+        blocks.push_back(as_bytes(view(sample)));
+    }
+
+    const auto dict = data_compressor::make_dictionary(view(blocks), 1024);
+    BOOST_CHECK(!dict.empty());
+    BOOST_CHECK_LE(dict.size(), 1024);
+
+    data_compressor comp{};
+    BOOST_CHECK(!comp.add_dictionary(no_compression_dictionary(), view(dict)));
+    BOOST_CHECK(!comp.add_dictionary(1U, view(dict)));
+#if EAGINE_USE_ZLIB
+    BOOST_CHECK(comp.add_dictionary(2U, view(dict)));
+
+    memory::buffer packed;
+    memory::buffer unpacked;
+    span_size_t with_dict{0};
+    span_size_t without_dict{0};
+
+    for(int i = 100; i < 200; ++i) {
+        const auto sample = compression_sample(i);
+        const auto input = as_bytes(view(sample));
+        const auto level = data_compression_level::highest;
+
+        auto pck = comp.compress(input, packed, level);
+        without_dict += pck.size();
+        BOOST_CHECK(are_equal(input, comp.decompress(pck, unpacked)));
+
+        pck = comp.compress(input, packed, level, 2U);
+        with_dict += pck.size();
+        BOOST_CHECK_EQUAL(pck.front(), 2U);
+        BOOST_CHECK(are_equal(input, comp.decompress(pck, unpacked)));
+    }
+    BOOST_CHECK_LT(with_dict, without_dict);
+
+    const auto pck = comp.compress(
+      as_bytes(view(samples.front())),
+      packed,
+      data_compression_level::normal,
+      2U);
+    data_compressor other{};
+    BOOST_CHECK(other.decompress(pck, unpacked).empty());
+    // unknown dictionary, the data is stored uncompressed
+    const auto raw = comp.compress(
+      as_bytes(view(samples.back())),
+      packed,
+      data_compression_level::normal,
+      3U);
+    BOOST_CHECK_EQUAL(raw.front(), 0U);
+    BOOST_CHECK(are_equal(
+      as_bytes(view(samples.back())), comp.decompress(raw, unpacked)));
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
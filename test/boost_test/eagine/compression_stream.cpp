@@ -0,0 +1,199 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/compression_stream.hpp>
+#define BOOST_TEST_MODULE EAGINE_compression_stream
+#include "../unit_test_begin.inl"
+
+#include <eagine/memory/span_algo.hpp>
+#include <eagine/span.hpp>
+#include <sstream>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compression_stream_tests)
+
+static eagine::test_random_generator rg;
+
+static void compression_stream_fill(std::vector<eagine::byte>& data) {
+    for(auto& b : data) {
+        b = rg.get_byte(0x61U, 0x66U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compression_stream_push) {
+    using namespace eagine;
+
+    data_compress_stream compress{};
+    data_decompress_stream decompress{};
+    data_compressor compressor{};
+    std::vector<byte> orig;
+    std::vector<byte> packed;
+    std::vector<byte> unpacked;
+    memory::buffer buf;
+
+    auto append_packed = [&packed](memory::const_block blk) {
+        packed.insert(packed.end(), blk.begin(), blk.end());
+        return true;
+    };
+    auto append_unpacked = [&unpacked](memory::const_block blk) {
+        unpacked.insert(unpacked.end(), blk.begin(), blk.end());
+        return true;
+    };
+    const data_compress_stream::data_handler packed_handler{
+      construct_from, append_packed};
+    const data_decompress_stream::data_handler unpacked_handler{
+      construct_from, append_unpacked};
+
+    for(int i = 0; i < test_repeats(20, 100); ++i) {
+        orig.resize(rg.get_std_size(0, 200000));
+        compression_stream_fill(orig);
+        packed.clear();
+        unpacked.clear();
+        compress.reset();
+        decompress.reset();
+
+        auto input = view(orig);
+        while(!input.empty()) {
+            const auto piece = head(input, rg.get_span_size(1, 10000));
+            BOOST_CHECK(compress.push(piece, packed_handler));
+            input = skip(input, piece.size());
+        }
+        BOOST_CHECK(!compress.is_finished());
+        BOOST_CHECK(compress.finish(packed_handler));
+        BOOST_CHECK(compress.is_finished());
+        BOOST_CHECK_EQUAL(compress.input_size(), span_size(orig.size()));
+        BOOST_CHECK_EQUAL(compress.output_size(), span_size(packed.size()));
+
+        // compatible with the block compressor
+        BOOST_CHECK(
+          are_equal(view(orig), compressor.decompress(view(packed), buf)));
+
+        auto output = view(packed);
+        while(!output.empty()) {
+            const auto piece = head(output, rg.get_span_size(1, 1000));
+            BOOST_CHECK(decompress.push(piece, unpacked_handler));
+            output = skip(output, piece.size());
+        }
+        BOOST_CHECK(decompress.is_finished());
+        BOOST_CHECK(orig == unpacked);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compression_stream_flush) {
+    using namespace eagine;
+
+    data_compress_stream compress{data_compression_level::highest};
+    data_decompress_stream decompress{};
+    std::vector<byte> orig(10000);
+    std::vector<byte> unpacked;
+    compression_stream_fill(orig);
+
+    auto append_unpacked = [&unpacked](memory::const_block blk) {
+        unpacked.insert(unpacked.end(), blk.begin(), blk.end());
+        return true;
+    };
+    const data_decompress_stream::data_handler unpacked_handler{
+      construct_from, append_unpacked};
+    auto forward = [&](memory::const_block blk) {
+        return decompress.push(blk, unpacked_handler);
+    };
+    const data_compress_stream::data_handler packed_handler{
+      construct_from, forward};
+
+    BOOST_CHECK(compress.push(view(orig), packed_handler));
+    BOOST_CHECK(compress.flush(packed_handler));
+    // everything pushed before flush is available to the receiver
+    BOOST_CHECK(orig == unpacked);
+    BOOST_CHECK(!decompress.is_finished());
+
+    BOOST_CHECK(compress.push(view(orig), packed_handler));
+    BOOST_CHECK(compress.finish(packed_handler));
+    BOOST_CHECK(decompress.is_finished());
+    BOOST_CHECK_EQUAL(unpacked.size(), 2 * orig.size());
+}
+
+BOOST_AUTO_TEST_CASE(compression_stream_invalid) {
+    using namespace eagine;
+
+    data_decompress_stream decompress{};
+    std::vector<byte> unpacked;
+    auto append_unpacked = [&unpacked](memory::const_block blk) {
+        unpacked.insert(unpacked.end(), blk.begin(), blk.end());
+        return true;
+    };
+    const data_decompress_stream::data_handler unpacked_handler{
+      construct_from, append_unpacked};
+
+    std::vector<byte> garbage(1000);
+    compression_stream_fill(garbage);
+    garbage.front() = 0x01U;
+    BOOST_CHECK(!decompress.push(view(garbage), unpacked_handler));
+}
+
+BOOST_AUTO_TEST_CASE(compression_stream_stored_chunks) {
+    using namespace eagine;
+
+    data_decompress_stream decompress{};
+    data_compressor compressor{};
+    std::vector<byte> unpacked;
+    memory::buffer buf;
+    auto append_unpacked = [&unpacked](memory::const_block blk) {
+        unpacked.insert(unpacked.end(), blk.begin(), blk.end());
+        return true;
+    };
+    const data_decompress_stream::data_handler unpacked_handler{
+      construct_from, append_unpacked};
+
+    const std::vector<byte> orig{0x61U, 0x62U, 0x63U, 0x64U, 0x65U};
+    const std::vector<byte> packed{
+      stored_chunks_compression_header(),
+      0x02U, 0x00U, 0x00U, 0x00U, 0x61U, 0x62U,
+      0x03U, 0x00U, 0x00U, 0x00U, 0x63U, 0x64U, 0x65U,
+      0x00U, 0x00U, 0x00U, 0x00U};
+
+    BOOST_CHECK(
+      are_equal(view(orig), compressor.decompress(view(packed), buf)));
+    BOOST_CHECK(!compressor.decompress(head(view(packed), 10), buf));
+
+    for(const auto b : packed) {
+        BOOST_CHECK(!decompress.is_finished());
+        BOOST_CHECK(decompress.push(view_one(b), unpacked_handler));
+    }
+    BOOST_CHECK(decompress.is_finished());
+    BOOST_CHECK(orig == unpacked);
+    // nothing may follow the end of the stored data
+    BOOST_CHECK(!decompress.push(head(view(packed), 1), unpacked_handler));
+}
+
+BOOST_AUTO_TEST_CASE(compression_stream_iostream) {
+    using namespace eagine;
+
+    for(int i = 0; i < test_repeats(10, 50); ++i) {
+        std::string orig;
+        const auto line_count = rg.get_int(0, 5000);
+        for(int l = 0; l < line_count; ++l) {
+            orig.append(rg.get_string(0, 80));
+            orig.push_back('\n');
+        }
+
+        std::stringstream packed;
+        {
+            data_compress_ostream output{packed};
+            output << orig;
+            BOOST_CHECK(output.good());
+        }
+
+        data_decompress_istream input{packed};
+        std::string unpacked{
+          std::istreambuf_iterator<char>{input},
+          std::istreambuf_iterator<char>{}};
+        BOOST_CHECK(orig == unpacked);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,108 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/identifier_ctr.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/logging/ostream_backend.hpp>
+#define BOOST_TEST_MODULE EAGINE_log_entry
+#include "../unit_test_begin.inl"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(log_entry_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(log_entry_typed_args) {
+    using namespace eagine;
+
+    std::stringstream out;
+    ostream_log_backend<> backend{out, log_event_severity::trace};
+
+    const std::string str{"string"};
+    const std::int64_t ints[] = {123, 234};
+    log_entry(EAGINE_ID(Test), 0U, log_event_severity::info, "", &backend)
+      .arg(EAGINE_ID(ident), EAGINE_ID(Ident))
+      .arg(EAGINE_ID(msgId), EAGINE_MSG_ID(TestClass, testMethod))
+      .arg(EAGINE_ID(int), -12345)
+      .arg(EAGINE_ID(uint), 23456U)
+      .arg(EAGINE_ID(real), 1.5F)
+      .arg(EAGINE_ID(range), 0.F, 2.5F, 3.F)
+      .arg(EAGINE_ID(str), str)
+      .arg(EAGINE_ID(view), string_view("view"))
+      .arg(EAGINE_ID(ints), view(ints));
+
+    const auto text{out.str()};
+    std::string::size_type pos{0};
+    for(const char* expected :
+        {"Ident",
+         "TestClass",
+         "testMethod",
+         "-12345",
+         "23456",
+         "1.5",
+         "2.5",
+         ">string<",
+         ">view<",
+         "123",
+         "234"}) {
+        const auto found{text.find(expected, pos)};
+        BOOST_CHECK(found != std::string::npos);
+        pos = found;
+    }
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(log_entry_arg_order) {
+    using namespace eagine;
+
+    for(int r = 0; r < 20; ++r) {
+        std::stringstream out;
+        ostream_log_backend<> backend{out, log_event_severity::trace};
+
+        std::vector<std::string> values;
+        {
+            log_entry entry{
+              EAGINE_ID(Test), 0U, log_event_severity::info, "", &backend};
+            const int count{rg.get_int(0, 40)};
+            for(int i = 0; i < count; ++i) {
+                const auto name{dec_to_identifier(i)};
+                switch(rg.get_int(0, 2)) {
+                    case 0:
+                        entry.arg(name, std::int32_t(i));
+                        values.push_back(std::to_string(i));
+                        break;
+                    case 1:
+                        // long strings do not fit into the inline buffer
+                        values.emplace_back(
+                          std_size(rg.get_int(1, 100)), rg.get_char('a', 'z'));
+                        entry.arg(name, values.back());
+                        break;
+                    default:
+                        values.push_back("func" + std::to_string(i));
+                        entry.arg_func(
+                          [name, value{values.back()}](logger_backend& be) {
+                              be.add_string(name, EAGINE_ID(str), value);
+                          });
+                        break;
+                }
+            }
+        }
+
+        const auto text{out.str()};
+        std::string::size_type pos{0};
+        for(const auto& value : values) {
+            const auto found{text.find(">" + value + "<", pos)};
+            BOOST_CHECK(found != std::string::npos);
+            pos = found;
+        }
+    }
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,211 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/logging/filtering_backend.hpp>
+#include <eagine/logging/logger.hpp>
+#include <eagine/logging/ostream_backend.hpp>
+#define BOOST_TEST_MODULE EAGINE_log_filter
+#include "../unit_test_begin.inl"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(log_filter_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(log_filter_source_severity) {
+    using namespace eagine;
+
+    log_filter filter{log_event_severity::info};
+    BOOST_CHECK(
+      filter.is_enabled(EAGINE_ID(Source1), log_event_severity::info));
+    BOOST_CHECK(
+      !filter.is_enabled(EAGINE_ID(Source1), log_event_severity::debug));
+
+    filter.set_min_severity(EAGINE_ID(Source1), log_event_severity::debug);
+    filter.set_min_severity(EAGINE_ID(Source2), log_event_severity::error);
+    BOOST_CHECK(
+      filter.is_enabled(EAGINE_ID(Source1), log_event_severity::debug));
+    BOOST_CHECK(
+      !filter.is_enabled(EAGINE_ID(Source2), log_event_severity::warning));
+    BOOST_CHECK(
+      filter.is_enabled(EAGINE_ID(Source2), log_event_severity::error));
+    BOOST_CHECK(
+      !filter.is_enabled(EAGINE_ID(Source3), log_event_severity::debug));
+    BOOST_CHECK(
+      filter.is_enabled(EAGINE_ID(Source3), log_event_severity::info));
+
+    filter.reset_min_severity(EAGINE_ID(Source1));
+    BOOST_CHECK(
+      !filter.is_enabled(EAGINE_ID(Source1), log_event_severity::debug));
+    BOOST_CHECK(
+      !filter.is_enabled(EAGINE_ID(Source2), log_event_severity::warning));
+
+    filter.reset_min_severities();
+    filter.set_min_severity(log_event_severity::warning);
+    BOOST_CHECK(
+      filter.is_enabled(EAGINE_ID(Source2), log_event_severity::warning));
+    BOOST_CHECK(
+      !filter.is_enabled(EAGINE_ID(Source2), log_event_severity::info));
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(log_filter_source_table) {
+    using namespace eagine;
+
+    log_filter filter{log_event_severity::info};
+    std::vector<identifier> sources;
+    while(span_size(sources.size()) < log_filter::max_source_rules()) {
+        const identifier source{rg.get_identifier()};
+        if(source && !filter.is_enabled(source, log_event_severity::trace)) {
+            filter.set_min_severity(source, log_event_severity::trace);
+            sources.push_back(source);
+        }
+    }
+    for(const auto source : sources) {
+        BOOST_CHECK(filter.is_enabled(source, log_event_severity::trace));
+    }
+
+    // the table is full, the rules of new sources are ignored
+    const identifier extra{EAGINE_ID(ExtraSrc)};
+    filter.set_min_severity(extra, log_event_severity::trace);
+    BOOST_CHECK(!filter.is_enabled(extra, log_event_severity::debug));
+
+    for(const auto source : sources) {
+        if(rg.get_bool()) {
+            filter.reset_min_severity(source);
+            BOOST_CHECK(!filter.is_enabled(source, log_event_severity::debug));
+            filter.set_min_severity(source, log_event_severity::error);
+            BOOST_CHECK(!filter.is_enabled(source, log_event_severity::info));
+        }
+    }
+
+    filter.reset_min_severities();
+    for(const auto source : sources) {
+        BOOST_CHECK(filter.is_enabled(source, log_event_severity::info));
+        BOOST_CHECK(!filter.is_enabled(source, log_event_severity::debug));
+    }
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(log_filter_concurrent_rules) {
+    using namespace eagine;
+
+    log_filter filter{log_event_severity::info};
+    filter.set_min_severity(EAGINE_ID(Source1), log_event_severity::debug);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while(!done) {
+                if(!filter.is_enabled(
+                     EAGINE_ID(Source1), log_event_severity::debug)) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    // the rules of the other sources change while the readers run
+    for(int i = 0; i < test_repeats(1000, 10000); ++i) {
+        if(rg.get_bool()) {
+            filter.set_min_severity(
+              EAGINE_ID(Source2), log_event_severity::warning);
+        } else {
+            filter.reset_min_severity(EAGINE_ID(Source2));
+        }
+    }
+    done = true;
+    for(auto& reader : readers) {
+        reader.join();
+    }
+    BOOST_CHECK_EQUAL(mismatches, 0);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(log_filter_rate_limit) {
+    using namespace eagine;
+
+    log_filter filter{log_event_severity::info};
+    static const char site1{'1'};
+    static const char site2{'2'};
+    const auto sev = log_event_severity::info;
+
+    // without limit everything passes
+    for(int i = 0; i < 100; ++i) {
+        BOOST_CHECK(std::get<0>(filter.throttle(EAGINE_ID(Src), sev, &site1)));
+    }
+
+    const int burst = rg.get_int(1, 20);
+    filter.set_rate_limit(0.001F, float(burst));
+    for(int i = 0; i < burst; ++i) {
+        BOOST_CHECK(std::get<0>(filter.throttle(EAGINE_ID(Src), sev, &site1)));
+    }
+    const int flood = rg.get_int(1, 100);
+    for(int i = 0; i < flood; ++i) {
+        BOOST_CHECK(!std::get<0>(filter.throttle(EAGINE_ID(Src), sev, &site1)));
+    }
+    BOOST_CHECK_EQUAL(filter.suppressed_count(), flood);
+
+    // other call sites and errors are not affected
+    BOOST_CHECK(std::get<0>(filter.throttle(EAGINE_ID(Src), sev, &site2)));
+    BOOST_CHECK(std::get<0>(
+      filter.throttle(EAGINE_ID(Src), log_event_severity::error, &site1)));
+
+    // after refill the suppressed count is reported once
+    filter.set_rate_limit(1000.F, 1.F);
+    BOOST_CHECK(std::get<0>(filter.throttle(EAGINE_ID(Src), sev, &site1)));
+    BOOST_CHECK(!std::get<0>(filter.throttle(EAGINE_ID(Src), sev, &site1)));
+    BOOST_CHECK(!std::get<0>(filter.throttle(EAGINE_ID(Src), sev, &site1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    const auto [passes, suppressed] =
+      filter.throttle(EAGINE_ID(Src), sev, &site1);
+    BOOST_CHECK(passes);
+    BOOST_CHECK_EQUAL(suppressed, 2);
+
+    filter.set_rate_limit(0.F, 0.F);
+    BOOST_CHECK(!filter.is_rate_limited());
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(log_filter_backend) {
+    using namespace eagine;
+
+    std::stringstream out;
+    auto backend{std::make_shared<filtering_log_backend>(
+      std::make_unique<ostream_log_backend<>>(out, log_event_severity::trace),
+      log_event_severity::warning)};
+    auto& filter = extract(backend->filter());
+    logger log{EAGINE_ID(TestLog), logger_shared_backend_getter{backend}};
+
+    int captured{0};
+    auto count_capture = [&captured](logger_backend&) { ++captured; };
+
+    log.log(log_event_severity::info, "filtered").arg_func(count_capture);
+    BOOST_CHECK_EQUAL(captured, 0);
+    log.log(log_event_severity::warning, "passed").arg_func(count_capture);
+    BOOST_CHECK_EQUAL(captured, 1);
+
+    filter.set_min_severity(EAGINE_ID(TestLog), log_event_severity::trace);
+    log.log(log_event_severity::info, "enabled").arg_func(count_capture);
+    BOOST_CHECK_EQUAL(captured, 2);
+
+    filter.set_rate_limit(0.001F, 2.F);
+    for(int i = 0; i < 10; ++i) {
+        log.log(log_event_severity::info, "flood").arg_func(count_capture);
+    }
+    BOOST_CHECK_EQUAL(captured, 4);
+    BOOST_CHECK_EQUAL(filter.suppressed_count(), 8);
+
+    const auto text{out.str()};
+    BOOST_CHECK(text.find("filtered") == std::string::npos);
+    BOOST_CHECK(text.find("passed") != std::string::npos);
+    BOOST_CHECK(text.find("enabled") != std::string::npos);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,101 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/log_histogram.hpp>
+#define BOOST_TEST_MODULE EAGINE_log_histogram
+#include "../unit_test_begin.inl"
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(log_histogram_tests)
+
+static eagine::test_random_generator rg;
+
+BOOST_AUTO_TEST_CASE(log_histogram_empty) {
+    using namespace eagine;
+
+    log_histogram<> h;
+    BOOST_CHECK_EQUAL(h.count(), 0U);
+    BOOST_CHECK_EQUAL(h.sum(), 0U);
+    BOOST_CHECK_EQUAL(h.max(), 0U);
+    BOOST_CHECK_EQUAL(h.quantile(0.5), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(log_histogram_bucket_bounds) {
+    using namespace eagine;
+    using H = log_histogram<3U, 20U>;
+
+    for(span_size_t i = 0; i < H::bucket_count(); ++i) {
+        BOOST_CHECK_LE(H::bucket_min(i), H::bucket_max(i));
+        BOOST_CHECK_EQUAL(H::bucket_index(H::bucket_min(i)), i);
+        BOOST_CHECK_EQUAL(H::bucket_index(H::bucket_max(i)), i);
+        if(i > 0) {
+            BOOST_CHECK_EQUAL(H::bucket_max(i - 1) + 1U, H::bucket_min(i));
+        }
+    }
+    BOOST_CHECK_EQUAL(H::bucket_index(1U << 20U), H::bucket_count() - 1);
+    BOOST_CHECK_EQUAL(H::bucket_index(~0ULL), H::bucket_count() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(log_histogram_random_values) {
+    using namespace eagine;
+    using H = log_histogram<3U, 40U>;
+
+    for(int r = 0; r < test_repeats(100, 10000); ++r) {
+        const auto v = rg.get_any<std::uint32_t>();
+        const auto i = H::bucket_index(v);
+        BOOST_CHECK_LE(H::bucket_min(i), v);
+        BOOST_CHECK_GE(H::bucket_max(i), v);
+        // the relative width of the bucket is bound by the sub-bucket bits
+        BOOST_CHECK_LE((H::bucket_max(i) - H::bucket_min(i)) * 8U, v);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(log_histogram_quantiles) {
+    using namespace eagine;
+
+    log_histogram<> h;
+    for(std::uint64_t v = 1U; v <= 1000U; ++v) {
+        h.add(v);
+    }
+    BOOST_CHECK_EQUAL(h.count(), 1000U);
+    BOOST_CHECK_EQUAL(h.sum(), 500500U);
+    BOOST_CHECK_EQUAL(h.max(), 1000U);
+    BOOST_CHECK_CLOSE(h.mean(), 500.5, 0.001);
+    BOOST_CHECK_CLOSE(double(h.quantile(0.5)), 500.0, 12.5);
+    BOOST_CHECK_CLOSE(double(h.quantile(0.9)), 900.0, 12.5);
+    BOOST_CHECK_CLOSE(double(h.quantile(0.99)), 990.0, 12.5);
+    BOOST_CHECK_EQUAL(h.quantile(1.0), 1000U);
+
+    h.reset();
+    BOOST_CHECK_EQUAL(h.count(), 0U);
+    BOOST_CHECK_EQUAL(h.max(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(log_histogram_concurrent) {
+    using namespace eagine;
+
+    log_histogram<> h;
+    const std::uint64_t per_thread = test_repeats(1000U, 100000U);
+    std::vector<std::thread> threads;
+    for(std::uint64_t t = 1U; t <= 4U; ++t) {
+        threads.emplace_back([&h, t, per_thread]() {
+            for(std::uint64_t i = 0U; i < per_thread; ++i) {
+                h.add(t * 100U);
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(h.count(), 4U * per_thread);
+    BOOST_CHECK_EQUAL(h.sum(), 1000U * per_thread);
+    BOOST_CHECK_EQUAL(h.max(), 400U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
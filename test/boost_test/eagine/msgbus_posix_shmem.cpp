@@ -0,0 +1,90 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include "../../main_ctx.hpp"
+#include <eagine/message_bus/posix_shmem.hpp>
+#define BOOST_TEST_MODULE EAGINE_msgbus_posix_shmem
+#include "../unit_test_begin.inl"
+
+#include <memory>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(msgbus_posix_shmem_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+static auto msgbus_posix_shmem_accept(
+  eagine::msgbus::posix_shmem_acceptor& acceptor,
+  eagine::msgbus::posix_shmem_connector& connector)
+  -> std::unique_ptr<eagine::msgbus::connection> {
+    using namespace eagine;
+    std::unique_ptr<msgbus::connection> accepted;
+    auto handle_accepted = [&accepted](std::unique_ptr<msgbus::connection> c) {
+        accepted = std::move(c);
+    };
+    for(int i = 0; i < 1000 && !accepted; ++i) {
+        connector.update();
+        acceptor.update();
+        acceptor.process_accepted({construct_from, handle_accepted});
+    }
+    return accepted;
+}
+//------------------------------------------------------------------------------
+static auto msgbus_posix_shmem_deliver(
+  eagine::msgbus::connection& sender,
+  eagine::msgbus::connection& receiver,
+  eagine::string_view content) -> bool {
+    using namespace eagine;
+    const auto msg_id{EAGINE_MSG_ID(Test, shmemMsg)};
+    if(!sender.send(msg_id, msgbus::message_view(content))) {
+        return false;
+    }
+    bool received = false;
+    auto handle_fetched = [&](
+                            message_id mid,
+                            msgbus::message_age,
+                            const msgbus::message_view& msg) -> bool {
+        received = (mid == msg_id) &&
+                   are_equal(msg.data(), as_bytes(memory::view(content)));
+        return true;
+    };
+    for(int i = 0; i < 1000 && !received; ++i) {
+        sender.update();
+        receiver.update();
+        receiver.fetch_messages({construct_from, handle_fetched});
+    }
+    return received;
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(msgbus_posix_shmem_reconnect) {
+    using namespace eagine;
+    test_main_ctx tmc;
+
+    const auto name{rg.get_identifier()};
+    msgbus::posix_shmem_acceptor acceptor{tmc, name};
+    msgbus::posix_shmem_connector connector{tmc, name};
+
+    auto accepted = msgbus_posix_shmem_accept(acceptor, connector);
+    BOOST_REQUIRE(accepted);
+    BOOST_CHECK(connector.is_usable());
+    BOOST_CHECK(msgbus_posix_shmem_deliver(connector, *accepted, "first"));
+    BOOST_CHECK(msgbus_posix_shmem_deliver(*accepted, connector, "second"));
+
+    // the peer goes away and closes its writer
+    accepted.reset();
+    connector.update();
+    BOOST_CHECK(!connector.is_usable());
+
+    accepted = msgbus_posix_shmem_accept(acceptor, connector);
+    BOOST_REQUIRE(accepted);
+    BOOST_CHECK(connector.is_usable());
+    BOOST_CHECK(msgbus_posix_shmem_deliver(connector, *accepted, "third"));
+    BOOST_CHECK(msgbus_posix_shmem_deliver(*accepted, connector, "fourth"));
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,107 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/message_bus/service/resource_transfer.hpp>
+#define BOOST_TEST_MODULE EAGINE_msgbus_resource_transfer
+#include "../unit_test_begin.inl"
+
+#include <eagine/workshop.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(msgbus_resource_transfer_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+static auto msgbus_resource_file(
+  const char* name,
+  eagine::memory::const_block content) -> std::filesystem::path {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream file{path, std::ios::out | std::ios::binary};
+    eagine::write_to_stream(file, content);
+    return path;
+}
+//------------------------------------------------------------------------------
+static void msgbus_resource_check_fragments(
+  eagine::msgbus::blob_io& io,
+  eagine::memory::const_block expected) {
+    using namespace eagine;
+    BOOST_CHECK_EQUAL(io.total_size(), expected.size());
+
+    std::vector<byte> fetched(std_size(expected.size()));
+    span_size_t offs{0};
+    while(!io.is_at_eod(offs)) {
+        const auto size{rg.get_span_size(1, 3000)};
+        const auto done{io.fetch_fragment(
+          offs, head(skip(cover(fetched), offs), size))};
+        BOOST_REQUIRE(done > 0);
+        offs += done;
+    }
+    BOOST_CHECK_EQUAL(offs, expected.size());
+    BOOST_CHECK(are_equal(view(fetched), expected));
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(msgbus_resource_chunked_file) {
+    using namespace eagine;
+
+    workshop workers;
+    memory::buffer packed;
+    for(int i = 0; i < test_repeats(5, 20); ++i) {
+        std::vector<byte> orig(std_size(rg.get_span_size(1, 64 * 1024)));
+        for(auto& b : orig) {
+            b = rg.get_byte(0x40U, 0x47U);
+        }
+        chunked_data_compressor comp{
+          workers, rg.get_span_size(1, 4), rg.get_span_size(64, 4096)};
+        const auto container{comp.compress(view(orig), packed)};
+        BOOST_REQUIRE(!container.empty());
+
+        const auto path{
+          msgbus_resource_file("eagine_test_chunked.blob", container)};
+        const auto offs{rg.get_span_size(0, span_size(orig.size()) / 2)};
+        const auto size{rg.get_span_size(offs, span_size(orig.size()))};
+
+        // the unpacked content is served
+        auto whole{msgbus::make_file_blob_io(
+          std::fstream{path, std::ios::in | std::ios::binary}, {}, {})};
+        BOOST_REQUIRE(whole);
+        msgbus_resource_check_fragments(extract(whole), view(orig));
+
+        // the offset and size apply to the unpacked content
+        auto part{msgbus::make_file_blob_io(
+          std::fstream{path, std::ios::in | std::ios::binary},
+          {offs, true},
+          {size, true})};
+        BOOST_REQUIRE(part);
+        msgbus_resource_check_fragments(
+          extract(part), head(skip(view(orig), offs), size - offs));
+
+        std::filesystem::remove(path);
+    }
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(msgbus_resource_plain_file) {
+    using namespace eagine;
+
+    std::vector<byte> orig(std_size(rg.get_span_size(1, 16 * 1024)));
+    for(auto& b : orig) {
+        b = rg.get_byte(0x00U, 0xFFU);
+    }
+    const auto path{msgbus_resource_file("eagine_test_plain.blob", view(orig))};
+
+    // files without the container header are served as they are
+    auto io{msgbus::make_file_blob_io(
+      std::fstream{path, std::ios::in | std::ios::binary}, {}, {})};
+    BOOST_REQUIRE(io);
+    msgbus_resource_check_fragments(extract(io), view(orig));
+
+    std::filesystem::remove(path);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -50,7 +50,7 @@ BOOST_AUTO_TEST_CASE(msgbus_serialized_storage_1) {
         BOOST_ASSERT(!msg_infos.empty());
         auto& [cmpid, cmpsz] = msg_infos[msg.sequence_no];
         BOOST_CHECK(msgid == cmpid);
-        BOOST_CHECK_EQUAL(msg.data.size(), cmpsz);
+        BOOST_CHECK_EQUAL(msg.data().size(), cmpsz);
         msg_infos.erase(msg.sequence_no);
         ++total_rcvd;
         return true;
@@ -101,6 +101,78 @@ BOOST_AUTO_TEST_CASE(msgbus_serialized_storage_1) {
     BOOST_CHECK_EQUAL(msg_infos.size(), 0);
 }
 //------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(msgbus_serialized_storage_latest_wins) {
+    using namespace eagine;
+
+    test_main_ctx tmc;
+    main_ctx_object mco{EAGINE_ID(TestObj), tmc};
+    std::array<byte, 1024> temp_buffer{};
+    std::array<byte, 4 * 1024> pack_buffer{};
+    msgbus::connection_outgoing_messages com;
+    msgbus::connection_incoming_messages cim;
+
+    const auto status_id{EAGINE_MSG_ID(eagiTest, status)};
+    const auto other_id{EAGINE_MSG_ID(eagiTest, other)};
+
+    auto enqueue = [&](
+                     message_id msg_id,
+                     identifier_t source_id,
+                     msgbus::message_sequence_t seq,
+                     bool latest_wins) {
+        msgbus::message_view msg{};
+        msg.set_source_id(source_id);
+        msg.set_sequence_no(seq);
+        msg.set_latest_wins(latest_wins);
+        const auto enqueued = com.enqueue(mco, msg_id, msg, cover(temp_buffer));
+        BOOST_ASSERT(enqueued);
+    };
+
+    // the status updates from the same source replace each other
+    for(msgbus::message_sequence_t seq = 0; seq < 10; ++seq) {
+        enqueue(status_id, 1U, seq, true);
+        enqueue(status_id, 2U, seq, true);
+        enqueue(other_id, 1U, seq, false);
+    }
+    BOOST_CHECK_EQUAL(com.count(), 12);
+    BOOST_CHECK_EQUAL(com.replaced_count(), 18);
+
+    // packed messages must not be replaced until cleaned up
+    const auto packed = com.pack_into(cover(pack_buffer));
+    BOOST_ASSERT(packed);
+    enqueue(status_id, 1U, 10, true);
+    BOOST_CHECK_EQUAL(com.count(), 13);
+    cim.push(view(pack_buffer));
+    com.cleanup(packed);
+
+    while(!com.empty()) {
+        const auto more = com.pack_into(cover(pack_buffer));
+        BOOST_ASSERT(more);
+        cim.push(view(pack_buffer));
+        com.cleanup(more);
+    }
+
+    std::map<identifier_t, std::vector<msgbus::message_sequence_t>> statuses;
+    span_size_t others{0};
+    auto handler = [&](message_id msg_id, auto, auto msg) -> bool {
+        if(msg_id == status_id) {
+            statuses[msg.source_id].push_back(msg.sequence_no);
+        } else {
+            ++others;
+        }
+        return true;
+    };
+    while(!cim.empty()) {
+        cim.fetch_messages(mco, {construct_from, handler});
+    }
+
+    BOOST_CHECK_EQUAL(others, 10);
+    BOOST_CHECK_EQUAL(statuses[1U].size(), 2);
+    BOOST_CHECK_EQUAL(statuses[1U].front(), 9U);
+    BOOST_CHECK_EQUAL(statuses[1U].back(), 10U);
+    BOOST_CHECK_EQUAL(statuses[2U].size(), 1);
+    BOOST_CHECK_EQUAL(statuses[2U].front(), 9U);
+}
+//------------------------------------------------------------------------------
 BOOST_AUTO_TEST_SUITE_END()
 
 #include "../unit_test_end.inl"
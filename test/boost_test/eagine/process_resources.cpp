@@ -0,0 +1,104 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/message_bus/serialize.hpp>
+#include <eagine/message_bus/types.hpp>
+#include <eagine/process_resources.hpp>
+#define BOOST_TEST_MODULE EAGINE_process_resources
+#include "../unit_test_begin.inl"
+
+#include <array>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(process_resources_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(process_resources_sample) {
+    using namespace eagine;
+
+    process_resource_sampler sampler;
+    // the first two samples are the same
+    BOOST_CHECK(sampler.current().time == sampler.previous().time);
+    BOOST_CHECK(!sampler.cpu_usage());
+
+    std::vector<std::FILE*> files;
+    for(int i = 0; i < rg.get_int(2, 8); ++i) {
+        files.push_back(std::tmpfile());
+    }
+    volatile float busy{0.F};
+    for(int i = 0; i < 1000000; ++i) {
+        busy = busy + 1.F / float(i + 1);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    const auto before = sampler.current();
+    const auto& after = sampler.update().current();
+    BOOST_CHECK(after.time > before.time);
+    BOOST_CHECK(sampler.interval().count() > 0.F);
+    BOOST_CHECK(sampler.previous().time == before.time);
+
+    if(after.user_cpu_time.count() >= 0) {
+        BOOST_CHECK(after.user_cpu_time >= before.user_cpu_time);
+        BOOST_CHECK(sampler.cpu_usage());
+    }
+    if(after.voluntary_context_switches >= 0) {
+        // the sleep yields the CPU at least once
+        BOOST_CHECK_GT(
+          after.voluntary_context_switches, before.voluntary_context_switches);
+        BOOST_CHECK(sampler.context_switches_per_second());
+    }
+    if(after.open_file_count >= 0) {
+        BOOST_CHECK_EQUAL(
+          after.open_file_count,
+          before.open_file_count + std::int64_t(files.size()));
+    }
+    if(after.resident_size >= 0) {
+        BOOST_CHECK_GT(after.resident_size, 0);
+    }
+
+    for(auto file : files) {
+        std::fclose(file);
+    }
+    BOOST_CHECK_EQUAL(
+      sampler.update().current().open_file_count, before.open_file_count);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(process_resources_serialize) {
+    using namespace eagine;
+
+    for(int i = 0; i < test_repeats(100, 1000); ++i) {
+        msgbus::process_resource_usage usage{};
+        usage.cpu_time_us = rg.get_int(0, 1000000000);
+        usage.resident_size = rg.get_int(0, 1000000000);
+        usage.context_switches = rg.get_int(0, 1000000);
+        usage.open_file_count = rg.get_int(0, 1000);
+        usage.cpu_usage = rg.get_float(0.F, 16.F);
+        usage.read_bytes_per_second = rg.get_float(0.F, 1000000.F);
+
+        std::array<byte, 256> temp{};
+        auto serialized{msgbus::default_serialize(usage, cover(temp))};
+        BOOST_ASSERT(serialized);
+
+        msgbus::process_resource_usage copy{};
+        BOOST_CHECK(msgbus::default_deserialize(copy, extract(serialized)));
+        BOOST_CHECK_EQUAL(copy.cpu_time_us, usage.cpu_time_us);
+        BOOST_CHECK_EQUAL(copy.resident_size, usage.resident_size);
+        BOOST_CHECK_EQUAL(copy.context_switches, usage.context_switches);
+        BOOST_CHECK_EQUAL(copy.read_bytes, -1);
+        BOOST_CHECK_EQUAL(copy.open_file_count, usage.open_file_count);
+        BOOST_CHECK_EQUAL(copy.cpu_usage, usage.cpu_usage);
+        BOOST_CHECK_EQUAL(
+          copy.read_bytes_per_second, usage.read_bytes_per_second);
+        BOOST_CHECK_EQUAL(copy.written_bytes_per_second, -1.F);
+    }
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,290 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/shapes/vertex_transform.hpp>
+#define BOOST_TEST_MODULE EAGINE_shapes_baking
+#include "../unit_test_begin.inl"
+
+#include <eagine/shapes/centered.hpp>
+#include <eagine/shapes/scaled.hpp>
+#include <eagine/shapes/sphere.hpp>
+#include <eagine/shapes/torus.hpp>
+#include <eagine/shapes/translated.hpp>
+#include <eagine/span.hpp>
+#include <eagine/workshop.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(shapes_baking_tests)
+
+static eagine::test_random_generator rg;
+
+static auto shapes_random_values(eagine::span_size_t count)
+  -> std::vector<float> {
+    std::vector<float> result(eagine::std_size(count));
+    for(auto& v : result) {
+        v = float(rg.get_int(-100000, 100000)) / 1000.F;
+    }
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(shapes_vertex_transform_kernels) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    for(int i = 0; i < test_repeats(100, 1000); ++i) {
+        const auto m = rg.get_span_size(1, 4);
+        const auto n = rg.get_span_size(0, 1000) * m;
+        const auto orig = shapes_random_values(n);
+        const std::array<float, 4> params{
+          {float(rg.get_int(-8, 8)),
+           float(rg.get_int(-8, 8)),
+           float(rg.get_int(-8, 8)),
+           float(rg.get_int(-8, 8))}};
+
+        auto scaled = orig;
+        scale_vertex_values(cover(scaled), m, params);
+        auto translated = orig;
+        translate_vertex_values(cover(translated), m, params);
+
+        std::array<float, 4> min{};
+        std::array<float, 4> max{};
+        vertex_value_bounds(view(orig), m, min, max);
+
+        for(span_size_t k = 0; k < n; ++k) {
+            const auto c = std_size(k % m);
+            const auto o = orig[std_size(k)];
+            BOOST_CHECK_EQUAL(scaled[std_size(k)], o * params[c]);
+            BOOST_CHECK_EQUAL(translated[std_size(k)], o + params[c]);
+            BOOST_CHECK(min[c] <= o);
+            BOOST_CHECK(max[c] >= o);
+        }
+        for(span_size_t c = 0; c < m; ++c) {
+            bool has_min = n == 0;
+            bool has_max = n == 0;
+            for(span_size_t k = c; k < n; k += m) {
+                has_min |= orig[std_size(k)] == min[std_size(c)];
+                has_max |= orig[std_size(k)] == max[std_size(c)];
+            }
+            BOOST_CHECK(has_min);
+            BOOST_CHECK(has_max);
+        }
+    }
+}
+
+static void shapes_check_parallel_baking(
+  eagine::workshop& workers,
+  eagine::shapes::generator& serial,
+  eagine::shapes::generator& parallel) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    parallel.use_workers(workers, rg.get_span_size(2, 8));
+    BOOST_CHECK_EQUAL(serial.vertex_count(), parallel.vertex_count());
+
+    std::vector<float> expected;
+    std::vector<float> baked;
+    for(auto attr : {vertex_attrib_kind::position,
+                     vertex_attrib_kind::normal,
+                     vertex_attrib_kind::tangential,
+                     vertex_attrib_kind::bitangential,
+                     vertex_attrib_kind::wrap_coord,
+                     vertex_attrib_kind::vertex_pivot}) {
+        if(!serial.has(attr)) {
+            continue;
+        }
+        const auto variants = serial.attribute_variants(attr);
+        for(span_size_t v = 0; v < variants; ++v) {
+            const vertex_attrib_variant vav{attr, v};
+            const auto size =
+              serial.vertex_count() * serial.values_per_vertex(vav);
+            expected.assign(std_size(size), 0.F);
+            baked.assign(std_size(size), 1.F);
+            serial.attrib_values(vav, cover(expected));
+            parallel.attrib_values(vav, cover(baked));
+            BOOST_CHECK(expected == baked);
+        }
+    }
+
+    std::vector<std::uint32_t> expected_idx;
+    std::vector<std::uint32_t> baked_idx;
+    for(span_size_t d = 0; d < serial.draw_variant_count(); ++d) {
+        expected_idx.assign(std_size(serial.index_count(d)), 0U);
+        baked_idx.assign(std_size(parallel.index_count(d)), 1U);
+        serial.indices(d, cover(expected_idx));
+        parallel.indices(d, cover(baked_idx));
+        BOOST_CHECK(expected_idx == baked_idx);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shapes_parallel_torus) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    workshop workers;
+    for(int i = 0; i < test_repeats(5, 20); ++i) {
+        const auto rings = rg.get_int(5, 96);
+        const auto sections = rg.get_int(4, 96);
+        for(bool restart : {false, true}) {
+            const auto attrs = vertex_attrib_kind::position |
+                               vertex_attrib_kind::normal |
+                               vertex_attrib_kind::tangential |
+                               vertex_attrib_kind::bitangential |
+                               vertex_attrib_kind::wrap_coord |
+                               vertex_attrib_kind::vertex_pivot;
+            unit_torus_gen s{attrs, rings, sections};
+            unit_torus_gen p{attrs, rings, sections};
+            s.enable(generator_capability::primitive_restart, restart);
+            p.enable(generator_capability::primitive_restart, restart);
+            shapes_check_parallel_baking(workers, s, p);
+        }
+    }
+    workers.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(shapes_parallel_sphere) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    workshop workers;
+    for(int i = 0; i < test_repeats(5, 20); ++i) {
+        const auto rings = rg.get_int(3, 96);
+        const auto sections = rg.get_int(4, 96);
+        const auto attrs = vertex_attrib_kind::position |
+                           vertex_attrib_kind::normal |
+                           vertex_attrib_kind::tangential |
+                           vertex_attrib_kind::bitangential |
+                           vertex_attrib_kind::wrap_coord;
+        unit_sphere_gen s{attrs, rings, sections};
+        unit_sphere_gen p{attrs, rings, sections};
+        shapes_check_parallel_baking(workers, s, p);
+    }
+    workers.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(shapes_parallel_modifiers) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    workshop workers;
+    const auto attrs = vertex_attrib_kind::position |
+                       vertex_attrib_kind::normal |
+                       vertex_attrib_kind::vertex_pivot;
+    auto make = [&]() {
+        return center(translate(
+          scale(
+            std::make_unique<unit_torus_gen>(attrs, 37, 53),
+            {{2.F, 0.5F, 3.F}}),
+          {{1.F, -2.F, 5.F}}));
+    };
+    auto s = make();
+    auto p = make();
+    shapes_check_parallel_baking(workers, *s, *p);
+
+    std::vector<float> positions(std_size(s->vertex_count() * 3));
+    s->attrib_values(vertex_attrib_kind::position, cover(positions));
+    std::array<float, 4> min{};
+    std::array<float, 4> max{};
+    vertex_value_bounds(view(positions), 3, min, max);
+    for(std::size_t c = 0; c < 3; ++c) {
+        BOOST_CHECK_SMALL(min[c] + max[c], 0.0001F);
+    }
+    workers.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(shapes_parallel_for_throw) {
+    using namespace eagine;
+
+    workshop workers;
+    for(int r = 0; r < test_repeats(10, 100); ++r) {
+        const auto count{span_size(rg.get_int(100, 10000))};
+        std::vector<int> visited(std_size(count), 0);
+        // the tasks on the workers must be done before parallel_for throws
+        BOOST_CHECK_THROW(
+          workers.parallel_for(
+            count,
+            4,
+            [&](span_size_t task, span_size_t begin, span_size_t end) {
+                if(task == 0) {
+                    throw std::runtime_error("failed task");
+                }
+                for(span_size_t i = begin; i < end; ++i) {
+                    visited[std_size(i)] = 1;
+                }
+            }),
+          std::runtime_error);
+        BOOST_CHECK_EQUAL(
+          std::count(visited.begin(), visited.end(), 1),
+          count - count / 4);
+    }
+    workers.shutdown();
+}
+
+struct shapes_test_work : eagine::work_unit {
+    std::atomic<bool>* release{nullptr};
+    std::atomic<bool> started{false};
+    std::atomic<bool> delivered{false};
+    std::atomic<bool> cancelled{false};
+
+    auto do_it() -> bool final {
+        started = true;
+        while(release && !*release) {
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    void deliver() final {
+        delivered = true;
+    }
+
+    void cancel() final {
+        cancelled = true;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(shapes_workshop_shutdown_cancels) {
+    using namespace eagine;
+
+    std::atomic<bool> release{false};
+    shapes_test_work blocking;
+    blocking.release = &release;
+    std::vector<shapes_test_work> queued(std_size(rg.get_int(1, 10)));
+
+    workshop workers;
+    workers.add_worker();
+    workers.enqueue(blocking);
+    for(auto& work : queued) {
+        workers.enqueue(work);
+    }
+    while(!blocking.started) {
+        std::this_thread::yield();
+    }
+    // the only worker is busy, so the other units are still queued
+    workers.shutdown();
+    for(auto& work : queued) {
+        BOOST_CHECK(work.cancelled);
+        BOOST_CHECK(!work.started);
+        BOOST_CHECK(!work.delivered);
+    }
+
+    shapes_test_work late;
+    workers.enqueue(late);
+    BOOST_CHECK(late.cancelled);
+
+    release = true;
+    workers.wait_until_closed();
+    BOOST_CHECK(blocking.delivered);
+    BOOST_CHECK(!blocking.cancelled);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,231 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/shapes/mesh_cache.hpp>
+#define BOOST_TEST_MODULE EAGINE_shapes_mesh_cache
+#include "../unit_test_begin.inl"
+
+#include <eagine/memory/copy.hpp>
+#include <eagine/shapes/cube.hpp>
+#include <eagine/shapes/sphere.hpp>
+#include <eagine/shapes/torus.hpp>
+#include <eagine/span.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(shapes_mesh_cache_tests)
+
+static eagine::test_random_generator rg;
+
+static void shapes_check_cached(
+  eagine::shapes::generator& orig,
+  eagine::shapes::generator& cached) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    BOOST_CHECK(orig.attrib_bits() == cached.attrib_bits());
+    BOOST_CHECK_EQUAL(orig.vertex_count(), cached.vertex_count());
+
+    std::vector<float> expected;
+    std::vector<float> loaded;
+    for(const auto& info : enumerator_mapping(
+          type_identity<vertex_attrib_kind>{}, default_selector)) {
+        if(!orig.has(info.enumerator)) {
+            BOOST_CHECK_EQUAL(cached.attribute_variants(info.enumerator), 0);
+            continue;
+        }
+        const auto variants = orig.attribute_variants(info.enumerator);
+        BOOST_CHECK_EQUAL(cached.attribute_variants(info.enumerator), variants);
+        for(span_size_t v = 0; v < variants; ++v) {
+            const vertex_attrib_variant vav{info.enumerator, v};
+            BOOST_CHECK(
+              are_equal(orig.variant_name(vav), cached.variant_name(vav)));
+            BOOST_CHECK_EQUAL(
+              orig.values_per_vertex(vav), cached.values_per_vertex(vav));
+            BOOST_CHECK(orig.attrib_type(vav) == cached.attrib_type(vav));
+            expected.assign(std_size(orig.value_count(vav)), 0.F);
+            loaded.assign(std_size(cached.value_count(vav)), 1.F);
+            orig.attrib_values(vav, cover(expected));
+            cached.attrib_values(vav, cover(loaded));
+            BOOST_CHECK(expected == loaded);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(orig.draw_variant_count(), cached.draw_variant_count());
+    std::vector<std::uint32_t> expected_idx;
+    std::vector<std::uint32_t> loaded_idx;
+    std::vector<draw_operation> expected_ops;
+    std::vector<draw_operation> loaded_ops;
+    for(span_size_t d = 0; d < orig.draw_variant_count(); ++d) {
+        BOOST_CHECK(orig.index_type(d) == cached.index_type(d));
+        expected_idx.assign(std_size(orig.index_count(d)), 0U);
+        loaded_idx.assign(std_size(cached.index_count(d)), 1U);
+        orig.indices(d, cover(expected_idx));
+        cached.indices(d, cover(loaded_idx));
+        BOOST_CHECK(expected_idx == loaded_idx);
+
+        expected_ops.resize(std_size(orig.operation_count(d)));
+        loaded_ops.resize(std_size(cached.operation_count(d)));
+        BOOST_CHECK_EQUAL(expected_ops.size(), loaded_ops.size());
+        orig.instructions(d, cover(expected_ops));
+        cached.instructions(d, cover(loaded_ops));
+        for(std::size_t i = 0; i < expected_ops.size(); ++i) {
+            const auto& e = expected_ops[i];
+            const auto& l = loaded_ops[i];
+            BOOST_CHECK_EQUAL(e.first, l.first);
+            BOOST_CHECK_EQUAL(e.count, l.count);
+            BOOST_CHECK_EQUAL(e.phase, l.phase);
+            BOOST_CHECK(e.mode == l.mode);
+            BOOST_CHECK(e.idx_type == l.idx_type);
+            BOOST_CHECK_EQUAL(e.primitive_restart, l.primitive_restart);
+            if(e.primitive_restart) {
+                BOOST_CHECK_EQUAL(
+                  e.primitive_restart_index, l.primitive_restart_index);
+            }
+            BOOST_CHECK_EQUAL(e.cw_face_winding, l.cw_face_winding);
+            BOOST_CHECK_EQUAL(e.patch_vertices, l.patch_vertices);
+        }
+    }
+
+    const auto expected_bs = orig.bounding_sphere();
+    const auto loaded_bs = cached.bounding_sphere();
+    BOOST_CHECK_EQUAL(expected_bs.radius(), loaded_bs.radius());
+    BOOST_CHECK_EQUAL(expected_bs.center().x(), loaded_bs.center().x());
+    BOOST_CHECK_EQUAL(expected_bs.center().y(), loaded_bs.center().y());
+    BOOST_CHECK_EQUAL(expected_bs.center().z(), loaded_bs.center().z());
+}
+
+BOOST_AUTO_TEST_CASE(shapes_mesh_cache_torus) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    for(int i = 0; i < test_repeats(5, 20); ++i) {
+        const auto attrs = vertex_attrib_kind::position |
+                           vertex_attrib_kind::normal |
+                           vertex_attrib_kind::tangential |
+                           vertex_attrib_kind::wrap_coord;
+        unit_torus_gen torus{
+          attrs, rg.get_int(4, 64), rg.get_int(4, 64), 0.25F};
+        torus.enable(
+          generator_capability::primitive_restart, rg.get_bool());
+
+        memory::buffer data;
+        BOOST_CHECK(store_mesh_cache(torus, data));
+        mesh_cache_loader loader{memory::const_block(data)};
+        BOOST_CHECK(loader.is_valid());
+        shapes_check_cached(torus, loader);
+
+        // the attribute data is viewed without copying
+        const auto block = loader.attrib_data(vertex_attrib_kind::position);
+        BOOST_CHECK_EQUAL(
+          block.size(), torus.value_count(vertex_attrib_kind::position) * 4);
+        BOOST_CHECK(block.begin() >= memory::const_block(data).begin());
+        BOOST_CHECK(block.end() <= memory::const_block(data).end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shapes_mesh_cache_file) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    const auto path =
+      std::filesystem::temp_directory_path() / "eagine_test_mesh.cache";
+    const auto attrs = vertex_attrib_kind::position |
+                       vertex_attrib_kind::normal |
+                       vertex_attrib_kind::bitangential |
+                       vertex_attrib_kind::box_coord;
+    unit_cube_gen cube{attrs};
+    unit_sphere_gen sphere{attrs, 18, 36};
+    for(generator* gen : {static_cast<generator*>(&cube),
+                          static_cast<generator*>(&sphere)}) {
+        BOOST_CHECK(save_mesh_cache(*gen, string_view(path.string())));
+        auto loader = from_mesh_cache(string_view(path.string()));
+        BOOST_ASSERT(loader);
+        BOOST_CHECK(loader->is_valid());
+        shapes_check_cached(*gen, *loader);
+    }
+    std::filesystem::remove(path);
+
+    auto missing = from_mesh_cache(string_view(path.string()));
+    BOOST_CHECK(!missing->is_valid());
+    BOOST_CHECK_EQUAL(missing->vertex_count(), 0);
+    BOOST_CHECK_EQUAL(missing->draw_variant_count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(shapes_mesh_cache_invalid) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    unit_cube_gen cube{
+      vertex_attrib_kind::position | vertex_attrib_kind::normal};
+    memory::buffer data;
+    BOOST_CHECK(store_mesh_cache(cube, data));
+
+    for(int i = 0; i < test_repeats(10, 100); ++i) {
+        const auto size = rg.get_span_size(0, data.size() - 1);
+        mesh_cache_loader loader{head(memory::const_block(data), size)};
+        BOOST_CHECK(!loader.is_valid());
+        BOOST_CHECK_EQUAL(loader.vertex_count(), 0);
+        BOOST_CHECK_EQUAL(loader.draw_variant_count(), 0);
+        BOOST_CHECK_EQUAL(
+          loader.attribute_variants(vertex_attrib_kind::position), 0);
+    }
+
+    memory::buffer garbage;
+    garbage.resize(data.size());
+    for(auto& b : cover(garbage)) {
+        b = rg.get_byte(0x00, 0xFF);
+    }
+    BOOST_CHECK(!mesh_cache_loader{memory::const_block(garbage)}.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(shapes_mesh_cache_corrupted) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    unit_torus_gen torus{
+      vertex_attrib_kind::position | vertex_attrib_kind::normal,
+      rg.get_int(6, 24),
+      rg.get_int(6, 36),
+      0.5F};
+    memory::buffer data;
+    BOOST_CHECK(store_mesh_cache(torus, data));
+
+    memory::buffer corrupted;
+    std::vector<draw_operation> ops;
+    for(int i = 0; i < test_repeats(1000, 10000); ++i) {
+        memory::copy_into(view(data), corrupted);
+        for(int j = 0, n = rg.get_int(1, 4); j < n; ++j) {
+            cover(corrupted)[rg.get_span_size(0, corrupted.size() - 1)] =
+              rg.get_byte(0x00, 0xFF);
+        }
+        // whatever passes validation must be safe to use
+        mesh_cache_loader loader{memory::const_block(corrupted)};
+        for(const auto d : integer_range(loader.draw_variant_count())) {
+            const auto type = loader.index_type(d);
+            BOOST_CHECK(
+              (type == index_data_type::none) ||
+              (type == index_data_type::unsigned_8) ||
+              (type == index_data_type::unsigned_16) ||
+              (type == index_data_type::unsigned_32));
+            ops.resize(std_size(loader.operation_count(d)));
+            loader.instructions(d, cover(ops));
+            for(const auto& op : ops) {
+                const auto limit = (op.idx_type == index_data_type::none)
+                                     ? loader.vertex_count()
+                                     : loader.index_count(d);
+                BOOST_CHECK_GE(op.first, 0);
+                BOOST_CHECK_GE(op.count, 0);
+                BOOST_CHECK_LE(op.first + op.count, limit);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
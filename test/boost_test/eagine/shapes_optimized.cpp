@@ -0,0 +1,258 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/shapes/optimized.hpp>
+#define BOOST_TEST_MODULE EAGINE_shapes_optimized
+#include "../unit_test_begin.inl"
+
+#include <eagine/shapes/cube.hpp>
+#include <eagine/shapes/sphere.hpp>
+#include <eagine/shapes/topology.hpp>
+#include <eagine/shapes/torus.hpp>
+#include <eagine/span.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(shapes_optimized_tests)
+
+static eagine::test_random_generator rg;
+
+using shapes_test_triangle = std::array<float, 9>;
+
+// triangle positions, rotated so that the smallest vertex is first
+static auto shapes_test_triangle_of(
+  const std::vector<float>& positions,
+  unsigned a,
+  unsigned b,
+  unsigned c) -> shapes_test_triangle {
+    std::array<unsigned, 3> v{{a, b, c}};
+    std::array<shapes_test_triangle, 3> rotations{};
+    for(std::size_t r = 0; r < 3; ++r) {
+        for(std::size_t k = 0; k < 3; ++k) {
+            for(std::size_t i = 0; i < 3; ++i) {
+                rotations[r][k * 3 + i] = positions[v[(k + r) % 3] * 3 + i];
+            }
+        }
+    }
+    return *std::min_element(rotations.begin(), rotations.end());
+}
+
+static auto shapes_test_positions(eagine::shapes::generator& gen)
+  -> std::vector<float> {
+    using namespace eagine;
+    std::vector<float> positions(std_size(gen.vertex_count() * 3));
+    gen.attrib_values(
+      shapes::vertex_attrib_kind::position, cover(positions));
+    return positions;
+}
+
+static auto shapes_test_original_triangles(
+  const std::shared_ptr<eagine::shapes::generator>& gen,
+  eagine::shapes::drawing_variant var) -> std::vector<shapes_test_triangle> {
+    using namespace eagine;
+    using namespace eagine::shapes;
+    const auto positions = shapes_test_positions(*gen);
+    const topology topo{gen, var, {vertex_attrib_kind::position}};
+    std::vector<shapes_test_triangle> result;
+    for(span_size_t t = 0; t < topo.triangle_count(); ++t) {
+        const auto& tri = topo.triangle(t);
+        result.push_back(shapes_test_triangle_of(
+          positions,
+          tri.vertex_index(0),
+          tri.vertex_index(1),
+          tri.vertex_index(2)));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static auto shapes_test_optimized_triangles(
+  eagine::shapes::optimized_gen& gen,
+  eagine::shapes::drawing_variant var) -> std::vector<shapes_test_triangle> {
+    using namespace eagine;
+    using namespace eagine::shapes;
+    const auto positions = shapes_test_positions(gen);
+
+    BOOST_CHECK_EQUAL(gen.operation_count(var), 1);
+    draw_operation op{};
+    gen.instructions(var, cover_one(op));
+    BOOST_CHECK(op.mode == primitive_type::triangles);
+    BOOST_CHECK(op.cw_face_winding);
+    BOOST_CHECK_EQUAL(op.count, gen.index_count(var));
+
+    std::vector<unsigned> indices(std_size(gen.index_count(var)));
+    gen.indices(var, cover(indices));
+    std::vector<shapes_test_triangle> result;
+    for(std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        BOOST_CHECK(indices[i + 0] < unsigned(gen.vertex_count()));
+        BOOST_CHECK(indices[i + 1] < unsigned(gen.vertex_count()));
+        BOOST_CHECK(indices[i + 2] < unsigned(gen.vertex_count()));
+        result.push_back(shapes_test_triangle_of(
+          positions, indices[i + 0], indices[i + 1], indices[i + 2]));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// positions of the vertices drawn by the operations, -1 marks a restart
+static auto shapes_test_drawn_positions(
+  eagine::shapes::generator& gen,
+  eagine::shapes::drawing_variant var) -> std::vector<float> {
+    using namespace eagine;
+    using namespace eagine::shapes;
+    const auto positions = shapes_test_positions(gen);
+    std::vector<draw_operation> ops(std_size(gen.operation_count(var)));
+    gen.instructions(var, cover(ops));
+    std::vector<unsigned> indices(std_size(gen.index_count(var)));
+    gen.indices(var, cover(indices));
+
+    std::vector<float> result;
+    for(const auto& op : ops) {
+        result.push_back(float(op.mode));
+        for(span_size_t i = 0; i < op.count; ++i) {
+            const auto v = op.idx_type != index_data_type::none
+                             ? indices[std_size(op.first + i)]
+                             : unsigned(op.first + i);
+            if(op.primitive_restart && v == op.primitive_restart_index) {
+                result.push_back(-1.F);
+            } else {
+                BOOST_CHECK(v < unsigned(gen.vertex_count()));
+                result.insert(
+                  result.end(),
+                  positions.begin() + v * 3,
+                  positions.begin() + v * 3 + 3);
+            }
+        }
+    }
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(shapes_vertex_cache_miss_ratio) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    const std::array<unsigned, 3> one{{0U, 1U, 2U}};
+    BOOST_CHECK_EQUAL(vertex_cache_miss_ratio(view(one), 16), 3.F);
+
+    const std::array<unsigned, 9> same{{0U, 1U, 2U, 2U, 1U, 0U, 1U, 2U, 0U}};
+    BOOST_CHECK_EQUAL(vertex_cache_miss_ratio(view(same), 16), 1.F);
+
+    const std::array<unsigned, 6> evicted{{0U, 1U, 2U, 3U, 0U, 1U}};
+    BOOST_CHECK_EQUAL(vertex_cache_miss_ratio(view(evicted), 3), 3.F);
+    BOOST_CHECK_EQUAL(vertex_cache_miss_ratio(view(evicted), 4), 2.F);
+}
+
+BOOST_AUTO_TEST_CASE(shapes_optimized_torus) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    for(int i = 0; i < test_repeats(3, 10); ++i) {
+        const auto rings = rg.get_int(5, 36);
+        const auto sections = rg.get_int(4, 36);
+        for(bool restart : {false, true}) {
+            std::shared_ptr<generator> torus = unit_torus(
+              vertex_attrib_kind::position | vertex_attrib_kind::normal,
+              rings,
+              sections,
+              0.5F);
+            torus->enable(generator_capability::primitive_restart, restart);
+
+            mesh_optimization_options options;
+            options.cache_size = rg.get_span_size(8, 32);
+            options.reduce_overdraw = rg.get_int(0, 1) > 0;
+            optimized_gen optimized{torus, options};
+
+            BOOST_CHECK_EQUAL(optimized.vertex_count(), torus->vertex_count());
+            BOOST_CHECK(
+              shapes_test_original_triangles(torus, 0) ==
+              shapes_test_optimized_triangles(optimized, 0));
+
+            const auto& stats = optimized.statistics(0);
+            BOOST_CHECK_EQUAL(stats.triangle_count, 2 * rings * sections);
+            BOOST_CHECK(stats.acmr_after >= 0.5F);
+            if(!options.reduce_overdraw) {
+                BOOST_CHECK_LE(stats.acmr_after, stats.acmr_before + 0.1F);
+            }
+
+            // the other variant draws line loops, only re-indexed
+            BOOST_CHECK(
+              shapes_test_drawn_positions(*torus, 1) ==
+              shapes_test_drawn_positions(optimized, 1));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shapes_optimized_acmr) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    // the strips are longer than the cache, there is room for improvement
+    optimized_gen optimized{
+      unit_torus(vertex_attrib_kind::position, 64, 48, 0.5F), {}};
+    const auto& stats = optimized.statistics(0);
+    BOOST_CHECK_GT(stats.acmr_before, 0.9F);
+    BOOST_CHECK_LT(stats.acmr_after, 0.8F);
+}
+
+BOOST_AUTO_TEST_CASE(shapes_optimized_vertex_order) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    std::shared_ptr<generator> sphere =
+      unit_sphere(vertex_attrib_kind::position, 24, 36);
+    optimized_gen optimized{sphere, {}};
+
+    // vertices are numbered in the order of their first use
+    std::vector<unsigned> indices(std_size(optimized.index_count(0)));
+    optimized.indices(0, cover(indices));
+    unsigned next{0U};
+    for(const auto v : indices) {
+        BOOST_CHECK(v <= next);
+        if(v == next) {
+            ++next;
+        }
+    }
+    BOOST_CHECK(
+      shapes_test_original_triangles(sphere, 0) ==
+      shapes_test_optimized_triangles(optimized, 0));
+}
+
+BOOST_AUTO_TEST_CASE(shapes_optimized_deduplicate) {
+    using namespace eagine;
+    using namespace eagine::shapes;
+
+    std::shared_ptr<generator> cube =
+      unit_cube(vertex_attrib_kind::position | vertex_attrib_kind::normal);
+    mesh_optimization_options options;
+    options.deduplicate_vertices = true;
+    optimized_gen optimized{cube, options};
+
+    BOOST_CHECK_EQUAL(cube->vertex_count(), 36);
+    BOOST_CHECK_EQUAL(optimized.vertex_count(), 24);
+    BOOST_CHECK_EQUAL(optimized.statistics(0).vertex_count, 24);
+    BOOST_CHECK_EQUAL(optimized.statistics(0).original_vertex_count, 36);
+    BOOST_CHECK_EQUAL(optimized.statistics(0).triangle_count, 12);
+    BOOST_CHECK(
+      shapes_test_original_triangles(cube, 0) ==
+      shapes_test_optimized_triangles(optimized, 0));
+    BOOST_CHECK(
+      shapes_test_drawn_positions(*cube, 1) ==
+      shapes_test_drawn_positions(optimized, 1));
+
+    std::vector<float> normals(std_size(optimized.vertex_count() * 3));
+    optimized.attrib_values(vertex_attrib_kind::normal, cover(normals));
+    for(std::size_t v = 0; v < normals.size(); v += 3) {
+        BOOST_CHECK_EQUAL(
+          std::abs(normals[v]) + std::abs(normals[v + 1]) +
+            std::abs(normals[v + 2]),
+          1.F);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,106 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <eagine/sudoku.hpp>
+#define BOOST_TEST_MODULE EAGINE_sudoku
+#include "../unit_test_begin.inl"
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(sudoku_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+template <unsigned S>
+void sudoku_glyph_alternatives() {
+    using namespace eagine;
+    using glyph_type = basic_sudoku_glyph<S>;
+
+    for(int r = 0; r < 100; ++r) {
+        glyph_type glyph;
+        std::vector<unsigned> indices;
+        for(const auto index : integer_range(glyph_type::glyph_count)) {
+            if(rg.get_bool()) {
+                glyph.add(index);
+                indices.push_back(index);
+            }
+        }
+        BOOST_CHECK_EQUAL(glyph.alternative_count(), indices.size());
+        BOOST_CHECK_EQUAL(glyph.is_empty(), indices.empty());
+        BOOST_CHECK_EQUAL(glyph.is_single(), indices.size() == 1U);
+
+        std::vector<unsigned> visited;
+        glyph.for_each_alternative(
+          [&](unsigned index) { visited.push_back(index); });
+        BOOST_CHECK(visited == indices);
+
+        const auto index{rg.get_uint(0U, glyph_type::glyph_count - 1U)};
+        BOOST_CHECK_EQUAL(glyph.set(index).get_index(), index);
+    }
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(sudoku_glyph_alternatives_3) {
+    sudoku_glyph_alternatives<3>();
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(sudoku_glyph_alternatives_6) {
+    sudoku_glyph_alternatives<6>();
+}
+//------------------------------------------------------------------------------
+template <unsigned S>
+void sudoku_solve_generated(int count) {
+    using namespace eagine;
+    default_sudoku_board_traits<S> traits;
+    auto generator{traits.make_generator()};
+    basic_sudoku_solver<S> solver;
+
+    for(int r = 0; r < count; ++r) {
+        const auto board{generator.generate_few()};
+        BOOST_REQUIRE(!board.has_empty());
+
+        const auto solved{solver.solve(board)};
+        BOOST_REQUIRE(solved.is_solved());
+        solved.for_each_coord([&](const auto& coord) {
+            const auto glyph{solved.get(coord)};
+            BOOST_CHECK(solved.is_possible(coord, glyph));
+            if(board.get(coord).is_single()) {
+                BOOST_CHECK_EQUAL(
+                  glyph.get_index(), board.get(coord).get_index());
+            }
+            return true;
+        });
+    }
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(sudoku_solve_generated_3) {
+    sudoku_solve_generated<3>(20);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(sudoku_solve_generated_4) {
+    sudoku_solve_generated<4>(5);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(sudoku_diagonal_propagation) {
+    using namespace eagine;
+    default_sudoku_board_traits<3> traits;
+    auto board{traits.make_diagonal()};
+    BOOST_CHECK(!board.has_empty());
+
+    // the alternatives of the open cells exclude the singles in their units
+    board.for_each_coord([&](const auto& coord) {
+        const auto glyph{board.get(coord)};
+        if(!glyph.is_single()) {
+            glyph.for_each_alternative([&](unsigned index) {
+                BOOST_CHECK(board.is_possible(coord, index));
+            });
+        }
+        return true;
+    });
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
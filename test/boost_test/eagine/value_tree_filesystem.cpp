@@ -0,0 +1,132 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include "../../main_ctx.hpp"
+#include <eagine/value_tree/filesystem.hpp>
+#define BOOST_TEST_MODULE EAGINE_value_tree_filesystem
+#include "../unit_test_begin.inl"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(value_tree_filesystem_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+static auto value_tree_filesystem_dir() -> std::filesystem::path {
+    auto result = std::filesystem::temp_directory_path() /
+                  ("eagine_valtree_" + std::to_string(rg.get_int(0, 99999)));
+    std::filesystem::remove_all(result);
+    std::filesystem::create_directories(result);
+    return result;
+}
+//------------------------------------------------------------------------------
+static void
+value_tree_filesystem_write(const std::filesystem::path& path, int value) {
+    std::ofstream file(path);
+    file << value << std::endl;
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(value_tree_filesystem_listing) {
+    using namespace eagine;
+
+    const auto dir = value_tree_filesystem_dir();
+    std::vector<std::string> names;
+    for(int i = 0; i < test_repeats(20, 100); ++i) {
+        names.push_back("entry" + std::to_string(rg.get_int(0, 999999)));
+        value_tree_filesystem_write(dir / names.back(), i);
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    test_main_ctx tmc;
+    auto tree{valtree::from_filesystem_path(dir.string(), tmc)};
+    BOOST_ASSERT(tree);
+    auto root{tree.structure()};
+    BOOST_CHECK_EQUAL(tree.nested_count(root), span_size(names.size()));
+
+    // the entries are ordered by name
+    for(std::size_t i = 0; i < names.size(); ++i) {
+        auto entry{tree.nested(root, span_size(i))};
+        BOOST_ASSERT(entry);
+        BOOST_CHECK(
+          are_equal(tree.attribute_name(entry), string_view(names[i])));
+        BOOST_CHECK(tree.nested(root, string_view(names[i])));
+        BOOST_CHECK(tree.get<int>(entry));
+    }
+    BOOST_CHECK(!tree.nested(root, span_size(names.size())));
+    BOOST_CHECK(!tree.nested(root, string_view("missing")));
+
+    // the listing is updated when the directory changes
+    value_tree_filesystem_write(dir / "added", 42);
+    BOOST_CHECK_EQUAL(tree.nested_count(root), span_size(names.size() + 1));
+    BOOST_CHECK_EQUAL(extract_or(tree.get<int>("added"), 0), 42);
+
+    std::filesystem::remove(dir / names.front());
+    BOOST_CHECK_EQUAL(tree.nested_count(root), span_size(names.size()));
+    BOOST_CHECK(!tree.nested(root, string_view(names.front())));
+
+    std::filesystem::remove_all(dir);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(value_tree_filesystem_values) {
+    using namespace eagine;
+
+    const auto dir = value_tree_filesystem_dir();
+    std::filesystem::create_directories(dir / "sub");
+    value_tree_filesystem_write(dir / "sub" / "value", 0);
+
+    test_main_ctx tmc;
+    auto tree{valtree::from_filesystem_path(dir.string(), tmc)};
+    BOOST_ASSERT(tree);
+    auto value{
+      tree.find(basic_string_path("sub/value", EAGINE_TAG(split_by), "/"))};
+    BOOST_ASSERT(value);
+    BOOST_CHECK(!tree.has_nested(value));
+
+    // the same attribute reads the current contents of the file
+    for(int i = 0; i < test_repeats(10, 100); ++i) {
+        const int expected = rg.get_int(-100000, 100000);
+        value_tree_filesystem_write(dir / "sub" / "value", expected);
+        BOOST_CHECK_EQUAL(extract_or(tree.get<int>(value), 0), expected);
+        BOOST_CHECK_EQUAL(
+          tree.value_count(value),
+          span_size(std::filesystem::file_size(dir / "sub" / "value")));
+    }
+
+    std::filesystem::remove_all(dir);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(value_tree_filesystem_replaced_values) {
+    using namespace eagine;
+
+    const auto dir = value_tree_filesystem_dir();
+    value_tree_filesystem_write(dir / "value", 0);
+
+    test_main_ctx tmc;
+    auto tree{valtree::from_filesystem_path(dir.string(), tmc)};
+    BOOST_ASSERT(tree);
+    auto value{tree.nested(tree.structure(), string_view("value"))};
+    BOOST_ASSERT(value);
+    BOOST_CHECK_EQUAL(extract_or(tree.get<int>(value), -1), 0);
+
+    // the files replaced by rename are read from the new file
+    for(int i = 0; i < test_repeats(10, 100); ++i) {
+        const int expected = rg.get_int(-100000, 100000);
+        value_tree_filesystem_write(dir / "value.tmp", expected);
+        std::filesystem::rename(dir / "value.tmp", dir / "value");
+        BOOST_CHECK_EQUAL(extract_or(tree.get<int>(value), 0), expected);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,310 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+// the functions are linked and called only through the stub traits
+#define OGLPLUS_HAS_STATIC_GL 0
+#include <GL/glcorearb.h>
+#include <oglplus/gl.hpp>
+//
+#include <oglplus/gl_api/api.hpp>
+#include <oglplus/gl_api/c_api.inl>
+#include <oglplus/gl_api/api.inl>
+#include <oglplus/gl_api/state_cache.hpp>
+#define BOOST_TEST_MODULE OGLPLUS_gl_state_cache
+#include "../unit_test_begin.inl"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(gl_state_cache_tests)
+
+static eagine::test_random_generator rg;
+//------------------------------------------------------------------------------
+// records the calls instead of calling the GL, so no context is required
+struct stub_gl_call {
+    std::string function;
+    std::vector<std::uintmax_t> args;
+};
+
+struct stub_gl_traits : eagine::oglp::gl_api_traits {
+    static auto names() -> std::vector<std::string>& {
+        static std::vector<std::string> the_names;
+        return the_names;
+    }
+
+    static auto calls() -> std::vector<stub_gl_call>& {
+        static std::vector<stub_gl_call> the_calls;
+        return the_calls;
+    }
+
+    // the returned pointers only identify the function and are never called
+    template <typename Api, typename Tag, typename Signature>
+    auto link_function(
+      Api&,
+      Tag,
+      eagine::string_view name,
+      eagine::type_identity<Signature>) -> std::add_pointer_t<Signature> {
+        names().push_back(eagine::to_string(name));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<std::add_pointer_t<Signature>>(
+          std::uintptr_t(names().size()));
+    }
+
+    template <typename RV, typename Tag, typename... Params, typename... Args>
+    static auto
+    call_dynamic(Tag tag, RV (*function)(Params...), Args&&... args) -> RV {
+        if(function) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const auto index{reinterpret_cast<std::uintptr_t>(function) - 1U};
+            const auto& name = names()[index];
+            if(name != "GetError") {
+                calls().push_back({name, {std::uintmax_t(args)...}});
+            }
+        }
+        return fallback(tag, eagine::type_identity<RV>());
+    }
+};
+
+using stub_gl_operations = eagine::oglp::basic_gl_operations<stub_gl_traits>;
+using stub_gl_state_cache = eagine::oglp::basic_gl_state_cache<stub_gl_traits>;
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(gl_state_cache_bind_buffer) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    stub_gl_traits traits;
+    stub_gl_operations api{traits};
+    stub_gl_state_cache cache{api};
+    stub_gl_traits::calls().clear();
+
+    const buffer_target targets[] = {
+      buffer_target(GL_ARRAY_BUFFER),
+      buffer_target(GL_ELEMENT_ARRAY_BUFFER),
+      buffer_target(GL_UNIFORM_BUFFER)};
+
+    std::vector<stub_gl_call> expected;
+    GLuint bound[3] = {~0U, ~0U, ~0U};
+    const int count{rg.get_int(1, 1000)};
+    for(int i = 0; i < count; ++i) {
+        const auto t{std_size(rg.get_int(0, 2))};
+        const auto n{rg.get_uint(0U, 3U)};
+        BOOST_CHECK(cache.bind_buffer(targets[t], buffer_name(n)));
+        if(bound[t] != n) {
+            bound[t] = n;
+            expected.push_back(
+              {"BindBuffer",
+               {std::uintmax_t(GLenum(targets[t])), std::uintmax_t(n)}});
+        }
+    }
+
+    const auto& calls{stub_gl_traits::calls()};
+    BOOST_REQUIRE_EQUAL(calls.size(), expected.size());
+    for(std_size_t c = 0; c < calls.size(); ++c) {
+        BOOST_CHECK_EQUAL(calls[c].function, expected[c].function);
+        BOOST_CHECK(calls[c].args == expected[c].args);
+    }
+    BOOST_CHECK_EQUAL(cache.issued_count(), expected.size());
+    BOOST_CHECK_EQUAL(cache.issued_count() + cache.elided_count(), count);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(gl_state_cache_textures) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    stub_gl_traits traits;
+    stub_gl_operations api{traits};
+    stub_gl_state_cache cache{api};
+    stub_gl_traits::calls().clear();
+
+    // the active unit is not known, so the binding cannot be elided
+    cache.bind_texture(texture_target(GL_TEXTURE_2D), texture_name(1));
+    cache.bind_texture(texture_target(GL_TEXTURE_2D), texture_name(1));
+    BOOST_CHECK_EQUAL(cache.issued_count(), 2);
+    BOOST_CHECK_EQUAL(cache.elided_count(), 0);
+
+    cache.active_texture(texture_unit(GL_TEXTURE0));
+    cache.bind_texture(texture_target(GL_TEXTURE_2D), texture_name(1));
+    cache.bind_texture(texture_target(GL_TEXTURE_2D), texture_name(1));
+    cache.active_texture(texture_unit(GL_TEXTURE0 + 1));
+    cache.bind_texture(texture_target(GL_TEXTURE_2D), texture_name(1));
+    cache.bind_texture(texture_target(GL_TEXTURE_3D), texture_name(2));
+    cache.active_texture(texture_unit(GL_TEXTURE0 + 1));
+    cache.bind_texture(texture_target(GL_TEXTURE_3D), texture_name(2));
+    cache.active_texture(texture_unit(GL_TEXTURE0));
+    cache.bind_texture(texture_target(GL_TEXTURE_2D), texture_name(1));
+
+    const std::vector<std::string> expected{
+      "BindTexture",
+      "BindTexture",
+      "ActiveTexture",
+      "BindTexture",
+      "ActiveTexture",
+      "BindTexture",
+      "BindTexture",
+      "ActiveTexture"};
+
+    const auto& calls{stub_gl_traits::calls()};
+    BOOST_REQUIRE_EQUAL(calls.size(), expected.size());
+    for(std_size_t c = 0; c < calls.size(); ++c) {
+        BOOST_CHECK_EQUAL(calls[c].function, expected[c]);
+    }
+    BOOST_CHECK_EQUAL(cache.issued_count(), 8);
+    BOOST_CHECK_EQUAL(cache.elided_count(), 4);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(gl_state_cache_program_capability) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    stub_gl_traits traits;
+    stub_gl_operations api{traits};
+    stub_gl_state_cache cache{api};
+    stub_gl_traits::calls().clear();
+
+    const capability caps[] = {
+      capability(GL_DEPTH_TEST),
+      capability(GL_BLEND),
+      capability(GL_CULL_FACE)};
+
+    int expected_issued{0};
+    std::optional<bool> enabled[3];
+    std::optional<GLuint> program;
+    const int count{rg.get_int(1, 1000)};
+    for(int i = 0; i < count; ++i) {
+        if(rg.get_int(0, 50) == 0) {
+            cache.invalidate();
+            for(auto& e : enabled) {
+                e.reset();
+            }
+            program.reset();
+        }
+        const auto c{std_size(rg.get_int(0, 2))};
+        const bool enable{rg.get_bool()};
+        if(enable) {
+            cache.enable(caps[c]);
+        } else {
+            cache.disable(caps[c]);
+        }
+        if(enabled[c] != enable) {
+            enabled[c] = enable;
+            ++expected_issued;
+        }
+        const auto n{rg.get_uint(0U, 2U)};
+        cache.use_program(program_name(n));
+        if(program != n) {
+            program = n;
+            ++expected_issued;
+        }
+    }
+
+    BOOST_CHECK_EQUAL(stub_gl_traits::calls().size(), expected_issued);
+    BOOST_CHECK_EQUAL(cache.issued_count(), expected_issued);
+    BOOST_CHECK_EQUAL(cache.elided_count(), 2 * count - expected_issued);
+
+    cache.reset_counters();
+    BOOST_CHECK_EQUAL(cache.issued_count(), 0);
+    BOOST_CHECK_EQUAL(cache.elided_count(), 0);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(gl_state_cache_vertex_array_element_buffer) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    stub_gl_traits traits;
+    stub_gl_operations api{traits};
+    stub_gl_state_cache cache{api};
+    stub_gl_traits::calls().clear();
+
+    const buffer_target array_buffer(GL_ARRAY_BUFFER);
+    const buffer_target element_buffer(GL_ELEMENT_ARRAY_BUFFER);
+
+    cache.bind_vertex_array(vertex_array_name(1));
+    cache.bind_buffer(element_buffer, buffer_name(1));
+    cache.bind_buffer(array_buffer, buffer_name(2));
+    // the same vertex array keeps the element array buffer binding
+    cache.bind_vertex_array(vertex_array_name(1));
+    cache.bind_buffer(element_buffer, buffer_name(1));
+    BOOST_CHECK_EQUAL(cache.issued_count(), 3);
+    BOOST_CHECK_EQUAL(cache.elided_count(), 2);
+
+    // a different vertex array has its own element array buffer binding
+    cache.bind_vertex_array(vertex_array_name(2));
+    cache.bind_buffer(element_buffer, buffer_name(1));
+    cache.bind_buffer(array_buffer, buffer_name(2));
+    cache.bind_vertex_array(vertex_array_name(1));
+    cache.bind_buffer(element_buffer, buffer_name(1));
+
+    const std::vector<std::string> expected{
+      "BindVertexArray",
+      "BindBuffer",
+      "BindBuffer",
+      "BindVertexArray",
+      "BindBuffer",
+      "BindVertexArray",
+      "BindBuffer"};
+
+    const auto& calls{stub_gl_traits::calls()};
+    BOOST_REQUIRE_EQUAL(calls.size(), expected.size());
+    for(std_size_t c = 0; c < calls.size(); ++c) {
+        BOOST_CHECK_EQUAL(calls[c].function, expected[c]);
+    }
+    BOOST_CHECK_EQUAL(cache.issued_count(), 7);
+    BOOST_CHECK_EQUAL(cache.elided_count(), 3);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(gl_state_cache_framebuffer_targets) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    stub_gl_traits traits;
+    stub_gl_operations api{traits};
+    stub_gl_state_cache cache{api};
+    stub_gl_traits::calls().clear();
+
+    const framebuffer_target targets[] = {
+      framebuffer_target(GL_FRAMEBUFFER),
+      framebuffer_target(GL_DRAW_FRAMEBUFFER),
+      framebuffer_target(GL_READ_FRAMEBUFFER)};
+
+    int expected_issued{0};
+    std::optional<GLuint> draw;
+    std::optional<GLuint> read;
+    const int count{rg.get_int(1, 1000)};
+    for(int i = 0; i < count; ++i) {
+        const auto t{std_size(rg.get_int(0, 2))};
+        const auto n{rg.get_uint(0U, 2U)};
+        cache.bind_framebuffer(targets[t], framebuffer_name(n));
+        switch(t) {
+            case 0:
+                if(draw != n || read != n) {
+                    draw = read = n;
+                    ++expected_issued;
+                }
+                break;
+            case 1:
+                if(draw != n) {
+                    draw = n;
+                    ++expected_issued;
+                }
+                break;
+            default:
+                if(read != n) {
+                    read = n;
+                    ++expected_issued;
+                }
+                break;
+        }
+    }
+
+    BOOST_CHECK_EQUAL(stub_gl_traits::calls().size(), expected_issued);
+    BOOST_CHECK_EQUAL(cache.issued_count(), expected_issued);
+    BOOST_CHECK_EQUAL(cache.elided_count(), count - expected_issued);
+}
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
@@ -0,0 +1,289 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <oglplus/gl.hpp>
+#include <oglplus/utils/image_container.hpp>
+#define BOOST_TEST_MODULE OGLPLUS_image_container
+#include "../unit_test_begin.inl"
+
+#include <eagine/memory/span_algo.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(image_container_tests)
+
+static eagine::test_random_generator rg;
+
+static auto image_container_builder(
+  int width,
+  int height,
+  int layers,
+  int channels,
+  const std::vector<eagine::byte>& pixels) {
+    using namespace eagine;
+    oglp::image_data_header hdr(width, height, layers, channels);
+    hdr.format = GL_RGBA;
+    hdr.internal_format = GL_RGBA8;
+    hdr.data_type = GL_UNSIGNED_BYTE;
+    oglp::texture_image_container_builder builder(hdr);
+    copy(view(pixels), builder.base_pixels());
+    return builder;
+}
+
+static auto
+image_container_pixels(int width, int height, int layers, int channels)
+  -> std::vector<eagine::byte> {
+    std::vector<eagine::byte> result(
+      eagine::std_size(width * height * layers * channels));
+    for(auto& b : result) {
+        b = rg.get_byte(0x00, 0xFF);
+    }
+    return result;
+}
+
+static auto image_container_equal(
+  const eagine::oglp::texture_image_block& a,
+  const eagine::oglp::texture_image_block& b) -> bool {
+    const auto ad = a.dimensions();
+    const auto bd = b.dimensions();
+    return (ad.width() == bd.width()) && (ad.height() == bd.height()) &&
+           (ad.depth() == bd.depth()) && (ad.channels() == bd.channels()) &&
+           eagine::are_equal(a.pixel_data().data(), b.pixel_data().data());
+}
+
+BOOST_AUTO_TEST_CASE(image_container_mipmap_box) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    const auto pixels = image_container_pixels(8, 4, 2, 3);
+    auto builder = image_container_builder(8, 4, 2, 3, pixels);
+    image_mipmap_generator gen;
+    BOOST_CHECK(builder.add_mipmaps(gen, 16));
+    BOOST_CHECK_EQUAL(builder.level_count(), 4);
+
+    const std::array<int, 4> widths{{8, 4, 2, 1}};
+    const std::array<int, 4> heights{{4, 2, 1, 1}};
+    for(span_size_t l = 0; l < builder.level_count(); ++l) {
+        const auto dims = builder.level(l).dimensions();
+        BOOST_CHECK_EQUAL(dims.width(), widths[std_size(l)]);
+        BOOST_CHECK_EQUAL(dims.height(), heights[std_size(l)]);
+        BOOST_CHECK_EQUAL(dims.depth(), 2);
+        BOOST_CHECK_EQUAL(dims.channels(), 3);
+    }
+
+    // each pixel of the second level is the average of four base pixels
+    const auto next = builder.level(1).pixel_data().data();
+    for(int z = 0; z < 2; ++z) {
+        for(int y = 0; y < 2; ++y) {
+            for(int x = 0; x < 4; ++x) {
+                for(int c = 0; c < 3; ++c) {
+                    int sum = 0;
+                    for(int dy = 0; dy < 2; ++dy) {
+                        for(int dx = 0; dx < 2; ++dx) {
+                            const auto k =
+                              ((z * 4 + 2 * y + dy) * 8 + 2 * x + dx) * 3 + c;
+                            sum += pixels[std_size(k)];
+                        }
+                    }
+                    const auto k = ((z * 2 + y) * 4 + x) * 3 + c;
+                    BOOST_CHECK_LE(std::abs(int(next[k]) - sum / 4), 1);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(image_container_mipmap_kaiser) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    // a constant image stays constant with the normalized filter
+    const std::vector<byte> pixels(std_size(24 * 20 * 4), 0x7F);
+    auto builder = image_container_builder(24, 20, 1, 4, pixels);
+    image_mipmap_generator gen;
+    gen.set_filter(image_mipmap_filter::kaiser);
+    BOOST_CHECK(builder.add_mipmaps(gen, 3));
+    BOOST_CHECK_EQUAL(builder.level_count(), 3);
+    for(span_size_t l = 0; l < builder.level_count(); ++l) {
+        for(auto b : builder.level(l).pixel_data().data()) {
+            BOOST_CHECK_EQUAL(int(b), 0x7F);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(image_container_mipmap_threads) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    workshop workers;
+    for(int i = 0; i < test_repeats(4, 10); ++i) {
+        const int width = rg.get_int(1, 100);
+        const int height = rg.get_int(1, 100);
+        const int layers = rg.get_int(1, 3);
+        const int channels = rg.get_int(1, 4);
+        const auto pixels =
+          image_container_pixels(width, height, layers, channels);
+        for(auto filter :
+            {image_mipmap_filter::box, image_mipmap_filter::kaiser}) {
+            auto serial =
+              image_container_builder(width, height, layers, channels, pixels);
+            auto parallel =
+              image_container_builder(width, height, layers, channels, pixels);
+            image_mipmap_generator serial_gen;
+            serial_gen.set_filter(filter);
+            image_mipmap_generator parallel_gen;
+            parallel_gen.set_filter(filter).use_workers(
+              workers, rg.get_int(2, 5));
+            BOOST_CHECK(serial.add_mipmaps(serial_gen, 32));
+            BOOST_CHECK(parallel.add_mipmaps(parallel_gen, 32));
+            BOOST_CHECK_EQUAL(
+              serial.level_count(),
+              image_mipmap_generator::level_count(width, height));
+            BOOST_CHECK_EQUAL(serial.level_count(), parallel.level_count());
+            for(span_size_t l = 0; l < serial.level_count(); ++l) {
+                BOOST_CHECK(
+                  image_container_equal(serial.level(l), parallel.level(l)));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(image_container_write_read) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    workshop workers;
+    chunked_data_compressor compressor{workers, 2, 4096};
+    for(int i = 0; i < test_repeats(2, 5); ++i) {
+        const int width = rg.get_int(1, 128);
+        const int height = rg.get_int(1, 128);
+        const int layers = rg.get_int(1, 3);
+        // half of the levels compress well, the random ones do not
+        auto pixels = image_container_pixels(width, height, layers, 4);
+        if(i % 2 == 0) {
+            std::fill(pixels.begin(), pixels.end(), byte(0x42));
+        }
+        auto builder =
+          image_container_builder(width, height, layers, 4, pixels);
+        image_mipmap_generator gen;
+        builder.add_mipmaps(gen, 32);
+
+        for(bool packed : {false, true}) {
+            std::stringstream output;
+            if(packed) {
+                builder.write(
+                  output, compressor, data_compression_level::normal);
+            } else {
+                builder.write(output);
+            }
+            const auto str = output.str();
+            memory::buffer data;
+            data.resize(span_size(str.size()));
+            copy(as_bytes(view(str)), cover(data));
+
+            texture_image_container container{view(data)};
+            BOOST_ASSERT(container.is_valid());
+            BOOST_CHECK_EQUAL(container.level_count(), builder.level_count());
+            BOOST_CHECK_EQUAL(container.layer_count(), layers);
+
+            memory::buffer unpacked;
+            for(span_size_t l = 0; l < container.level_count(); ++l) {
+                const auto dims = container.dimensions(l);
+                BOOST_CHECK_EQUAL(dims.depth(), layers);
+                BOOST_CHECK_EQUAL(dims.channels(), 4);
+                if(!packed || (i % 2 != 0)) {
+                    BOOST_CHECK(packed || !container.is_packed(l));
+                }
+                if(!container.is_packed(l)) {
+                    const auto image = container.level(l);
+                    BOOST_CHECK(image.is_valid());
+                    BOOST_CHECK(image_container_equal(image, builder.level(l)));
+                    // the pixels point directly into the container data
+                    const auto blk = image.pixel_data().data();
+                    BOOST_CHECK(blk.begin() >= view(data).begin());
+                    BOOST_CHECK(blk.end() <= view(data).end());
+                }
+                const auto level =
+                  container.unpack_level(l, compressor, unpacked);
+                BOOST_REQUIRE(!level.empty());
+                const texture_image_block image{level};
+                BOOST_CHECK(image.is_valid());
+                BOOST_CHECK(image_container_equal(image, builder.level(l)));
+            }
+            if(packed && (i % 2 == 0)) {
+                BOOST_CHECK(container.is_packed(0));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(image_container_unpack_mismatch) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    workshop workers;
+    chunked_data_compressor compressor{workers, 2, 4096};
+    auto pixels = image_container_pixels(64, 64, 1, 4);
+    std::fill(pixels.begin(), pixels.end(), byte(0x42));
+    auto builder = image_container_builder(64, 64, 1, 4, pixels);
+
+    std::stringstream output;
+    builder.write(output, compressor, data_compression_level::normal);
+    const auto str = output.str();
+    memory::buffer data;
+    data.resize(span_size(str.size()));
+    copy(as_bytes(view(str)), cover(data));
+
+    texture_image_container container{view(data)};
+    BOOST_ASSERT(container.is_valid());
+    BOOST_ASSERT(container.is_packed(0));
+    memory::buffer unpacked;
+    BOOST_CHECK(!container.unpack_level(0, compressor, unpacked).empty());
+
+    // the level does not unpack into the recorded size
+    auto* header = reinterpret_cast<image_container_header*>(data.data());
+    const_cast<image_container_level&>(header->levels[0]).unpacked_size += 1;
+    BOOST_CHECK(container.unpack_level(0, compressor, unpacked).empty());
+}
+
+BOOST_AUTO_TEST_CASE(image_container_file) {
+    using namespace eagine;
+    using namespace eagine::oglp;
+
+    const auto pixels = image_container_pixels(64, 32, 2, 2);
+    auto builder = image_container_builder(64, 32, 2, 2, pixels);
+    image_mipmap_generator gen;
+    builder.add_mipmaps(gen, 4);
+
+    const auto path =
+      std::filesystem::temp_directory_path() / "oglplus_test.oglptexc";
+    {
+        std::ofstream output(path, std::ios::binary);
+        builder.write(output);
+    }
+    {
+        texture_image_container container{path.string()};
+        BOOST_ASSERT(container.is_valid());
+        BOOST_CHECK_EQUAL(container.level_count(), 4);
+        for(span_size_t l = 0; l < container.level_count(); ++l) {
+            BOOST_CHECK(!container.is_packed(l));
+            BOOST_CHECK(
+              image_container_equal(container.level(l), builder.level(l)));
+        }
+    }
+    std::filesystem::remove(path);
+
+    // invalid data is rejected
+    std::vector<byte> garbage(256, 0x11);
+    BOOST_CHECK(!texture_image_container(view(garbage)).is_valid());
+    BOOST_CHECK(!texture_image_container(path.string()).is_valid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"
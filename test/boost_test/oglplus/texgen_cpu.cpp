@@ -0,0 +1,153 @@
+/*
+ *  Copyright Matus Chochlik.
+ *  Distributed under the Boost Software License, Version 1.0.
+ *  See accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt
+ */
+#include <oglplus/texgen/cpu_renderer.hpp>
+#define BOOST_TEST_MODULE OGLPLUS_texgen_cpu
+#include "../unit_test_begin.inl"
+
+#include <oglplus/texgen/checker_node.hpp>
+#include <oglplus/texgen/honeycomb_node.hpp>
+#include <oglplus/texgen/invert_node.hpp>
+#include <oglplus/texgen/mandelbrot_node.hpp>
+#include <oglplus/texgen/mix_node.hpp>
+#include <oglplus/texgen/newton_node.hpp>
+#include <oglplus/texgen/offset_node.hpp>
+#include <oglplus/texgen/stripes_node.hpp>
+#include <oglplus/texgen/voronoi2d_node.hpp>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(texgen_cpu_tests)
+
+static eagine::test_random_generator rg;
+
+static auto texgen_cpu_render(
+  eagine::oglp::texgen::cpu_renderer& renderer,
+  eagine::oglp::texgen::output_intf& output) -> std::vector<float> {
+    using namespace eagine;
+    std::vector<float> values(std_size(renderer.texel_count() * 4), -1.f);
+    BOOST_CHECK(renderer.render(output, cover(values)));
+    return values;
+}
+
+BOOST_AUTO_TEST_CASE(texgen_cpu_checker) {
+    using namespace eagine;
+    using namespace eagine::oglp::texgen;
+
+    checker_node checker;
+    checker.set_repeat(8, 8, 8);
+    cpu_renderer renderer;
+    renderer.set_dimensions(64, 64);
+
+    const auto values = texgen_cpu_render(renderer, checker.output(0));
+    for(int y = 0; y < 64; ++y) {
+        for(int x = 0; x < 64; ++x) {
+            const auto k = std_size((y * 64 + x) * 4);
+            BOOST_CHECK_EQUAL(values[k + 0], float(((x / 8) + (y / 8)) % 2));
+            BOOST_CHECK_EQUAL(values[k + 1], 0.f);
+            BOOST_CHECK_EQUAL(values[k + 2], 0.f);
+            BOOST_CHECK_EQUAL(values[k + 3], 0.f);
+        }
+    }
+
+    std::vector<byte> bytes(std_size(renderer.texel_count() * 2));
+    BOOST_CHECK(renderer.render(checker.output(0), 2, cover(bytes)));
+    for(std::size_t i = 0; i < bytes.size(); i += 2) {
+        BOOST_CHECK_EQUAL(int(bytes[i]), values[i * 2] > 0.5f ? 0xFF : 0x00);
+        BOOST_CHECK_EQUAL(int(bytes[i + 1]), 0x00);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(texgen_cpu_tiles_and_threads) {
+    using namespace eagine;
+    using namespace eagine::oglp::texgen;
+
+    mandelbrot_node mandelbrot;
+    newton_node newton;
+    voronoi2d_node voronoi;
+    honeycomb_node honeycomb;
+    const std::array<output_intf*, 5> outputs{
+      {&mandelbrot.output(0),
+       &newton.output(0),
+       &voronoi.output(0),
+       &voronoi.output(4),
+       &honeycomb.output(0)}};
+
+    workshop workers;
+    for(int i = 0; i < test_repeats(2, 5); ++i) {
+        const int width = rg.get_int(1, 96);
+        const int height = rg.get_int(1, 96);
+        cpu_renderer serial;
+        serial.set_dimensions(width, height);
+        cpu_renderer parallel;
+        parallel.set_dimensions(width, height)
+          .set_tile_size(rg.get_int(1, 48))
+          .use_workers(workers, rg.get_int(2, 6));
+
+        for(auto* output : outputs) {
+            BOOST_CHECK(
+              texgen_cpu_render(serial, *output) ==
+              texgen_cpu_render(parallel, *output));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(texgen_cpu_combined) {
+    using namespace eagine;
+    using namespace eagine::oglp::texgen;
+
+    checker_node checker;
+    invert_node invert;
+    offset_node offset;
+    mix_node mix;
+    connect_output_to_input(checker.output(0), invert.input(0));
+    connect_output_to_input(checker.output(0), offset.input(0));
+    connect_output_to_input(checker.output(0), mix.input(2));
+    offset.set_offset(1.f / 8.f, 0.f, 0.f);
+    mix.set_zero(0.25f, 0.5f, 0.75f, 1.f);
+    mix.set_one(1.f, 0.75f, 0.5f, 0.25f);
+
+    cpu_renderer renderer;
+    renderer.set_dimensions(32, 16);
+    const auto checked = texgen_cpu_render(renderer, checker.output(0));
+    const auto inverted = texgen_cpu_render(renderer, invert.output(0));
+    const auto shifted = texgen_cpu_render(renderer, offset.output(0));
+    const auto mixed = texgen_cpu_render(renderer, mix.output(0));
+
+    for(std::size_t k = 0; k < checked.size(); k += 4) {
+        BOOST_CHECK_EQUAL(inverted[k], 1.f - checked[k]);
+        BOOST_CHECK_EQUAL(shifted[k], 1.f - checked[k]);
+        const bool one = checked[k] > 0.5f;
+        BOOST_CHECK_EQUAL(mixed[k + 0], one ? 1.00f : 0.25f);
+        BOOST_CHECK_EQUAL(mixed[k + 1], one ? 0.75f : 0.50f);
+        BOOST_CHECK_EQUAL(mixed[k + 2], one ? 0.50f : 0.75f);
+        BOOST_CHECK_EQUAL(mixed[k + 3], one ? 0.25f : 1.00f);
+    }
+
+    disconnect_output_from_input(checker.output(0), invert.input(0));
+    disconnect_output_from_input(checker.output(0), offset.input(0));
+    disconnect_output_from_input(checker.output(0), mix.input(2));
+}
+
+BOOST_AUTO_TEST_CASE(texgen_cpu_unsupported) {
+    using namespace eagine;
+    using namespace eagine::oglp::texgen;
+
+    stripes_node stripes;
+    invert_node invert;
+    connect_output_to_input(stripes.output(0), invert.input(0));
+
+    cpu_renderer renderer;
+    renderer.set_dimensions(16, 16);
+    std::vector<float> values(std_size(renderer.texel_count() * 4));
+    BOOST_CHECK(!renderer.render(stripes.output(0), cover(values)));
+    BOOST_CHECK(!renderer.render(invert.output(0), cover(values)));
+
+    disconnect_output_from_input(stripes.output(0), invert.input(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#include "../unit_test_end.inl"